@@ -206,8 +206,44 @@ Application::SetRecipe(RecipePtr_t & _recipe, AppPtr_t & papp) {
 	return APP_SUCCESS;
 }
 
+/**
+ * The status captured for the shadow scheduling run of the calling thread,
+ * if any (@see ShadowContext_t)
+ */
+static inline ShadowContext_t::AppState_t const * GetShadowState(AppUid_t uid) {
+	ShadowContext_t const * shadow = ShadowContext_t::current;
+	if (likely(shadow == nullptr))
+		return nullptr;
+	auto app_it = shadow->apps.find(uid);
+	if (app_it == shadow->apps.end())
+		return nullptr;
+	return &(app_it->second);
+}
+
+AwmPtrList_t const & Application::WorkingModes() noexcept {
+	auto shadow = GetShadowState(Uid());
+	if (unlikely(shadow != nullptr))
+		return shadow->awms;
+	return awms.enabled_list;
+}
+
+AwmPtr_t const & Application::LowValueAWM() noexcept {
+	return WorkingModes().front();
+}
+
+AwmPtr_t const & Application::HighValueAWM() noexcept {
+	return WorkingModes().back();
+}
+
+void Application::SetValue(float sched_metrics) noexcept {
+	// Not a scheduling outcome
+	if (unlikely(ShadowContext_t::current != nullptr))
+		return;
+	schedule.value = sched_metrics;
+}
+
 AwmPtr_t Application::GetWorkingMode(uint8_t wmId) {
-	for (auto & awm: awms.enabled_list) {
+	for (auto & awm: WorkingModes()) {
 		if (awm->Id() == wmId)
 			return awm;
 	}
@@ -225,6 +261,9 @@ bool Application::_Disabled() const {
 }
 
 bool Application::Disabled() {
+	auto shadow = GetShadowState(Uid());
+	if (unlikely(shadow != nullptr))
+		return ((shadow->state == DISABLED) || (shadow->state == FINISHED));
 	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
 	return _Disabled();
 }
@@ -235,6 +274,9 @@ bool Application::_Active() const {
 }
 
 bool Application::Active() {
+	auto shadow = GetShadowState(Uid());
+	if (unlikely(shadow != nullptr))
+		return ((shadow->state == READY) || (shadow->state == RUNNING));
 	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
 	return _Active();
 }
@@ -244,6 +286,9 @@ bool Application::_Running() const {
 }
 
 bool Application::Running() {
+	auto shadow = GetShadowState(Uid());
+	if (unlikely(shadow != nullptr))
+		return (shadow->state == RUNNING);
 	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
 	return _Running();
 }
@@ -253,6 +298,9 @@ bool Application::_Synching() const {
 }
 
 bool Application::Synching() {
+	auto shadow = GetShadowState(Uid());
+	if (unlikely(shadow != nullptr))
+		return (shadow->state == SYNC);
 	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
 	return _Synching();
 }
@@ -262,6 +310,9 @@ bool Application::_Starting() const {
 }
 
 bool Application::Starting() {
+	auto shadow = GetShadowState(Uid());
+	if (unlikely(shadow != nullptr))
+		return ((shadow->state == SYNC) && (shadow->sync_state == STARTING));
 	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
 	return _Starting();
 }
@@ -271,6 +322,9 @@ bool Application::_Blocking() const {
 }
 
 bool Application::Blocking() {
+	auto shadow = GetShadowState(Uid());
+	if (unlikely(shadow != nullptr))
+		return ((shadow->state == SYNC) && (shadow->sync_state == BLOCKED));
 	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
 	return _Blocking();
 }
@@ -280,6 +334,9 @@ Application::State_t Application::_State() const {
 }
 
 Application::State_t Application::State() {
+	auto shadow = GetShadowState(Uid());
+	if (unlikely(shadow != nullptr))
+		return shadow->state;
 	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
 	return _State();
 }
@@ -298,6 +355,9 @@ Application::SyncState_t Application::_SyncState() const {
 }
 
 Application::SyncState_t Application::SyncState() {
+	auto shadow = GetShadowState(Uid());
+	if (unlikely(shadow != nullptr))
+		return shadow->sync_state;
 	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
 	return _SyncState();
 }
@@ -307,6 +367,9 @@ AwmPtr_t const & Application::_CurrentAWM() const {
 }
 
 AwmPtr_t const & Application::CurrentAWM() {
+	auto shadow = GetShadowState(Uid());
+	if (unlikely(shadow != nullptr))
+		return shadow->awm;
 	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
 	return _CurrentAWM();
 }
@@ -316,6 +379,9 @@ AwmPtr_t const & Application::_NextAWM() const {
 }
 
 AwmPtr_t const & Application::NextAWM() {
+	auto shadow = GetShadowState(Uid());
+	if (unlikely(shadow != nullptr))
+		return shadow->next_awm;
 	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
 	return _NextAWM();
 }
@@ -517,7 +583,9 @@ bool Application::Reshuffling(AwmPtr_t const & next_awm) {
 	return false;
 }
 
-Application::SyncState_t Application::SyncRequired(AwmPtr_t const & awm) {
+Application::SyncState_t Application::SyncRequired(
+		AwmPtr_t const & awm,
+		br::RViewToken_t status_view) {
 	// This must be called only by running applications
 	assert(_State() == RUNNING);
 	assert(_CurrentAWM().get());
@@ -547,13 +615,34 @@ Application::SyncState_t Application::SyncRequired(AwmPtr_t const & awm) {
 		return RECONF;
 	}
 
+#ifndef CONFIG_BBQUE_CGROUPS_DISTRIBUTED_ACTUATION
+	// Check for a change of the amounts only, to be enforced in place
+	ResourceAccounter &ra(ResourceAccounter::GetInstance());
+	switch (ra.CheckResize(awm->Owner(), awm->GetResourceBinding(), status_view)) {
+	case ResourceAccounter::RA_SUCCESS:
+		logger->Debug("SynchRequired: [%s] SYNC_NONE (resizing)", StrId());
+		schedule.resize = true;
+		return SYNC_NONE;
+	case ResourceAccounter::RA_ERR_USAGE_EXC:
+		logger->Debug("SynchRequired: [%s] to RECONF (resizing)", StrId());
+		return RECONF;
+	default:
+		break;
+	}
+#else
+	(void) status_view;
+#endif
+
+
 	logger->Debug("SynchRequired: [%s] SYNC_NONE", StrId());
 	// NOTE: By default no reconfiguration is assumed to be required, thus we
 	// return the SYNC_STATE_COUNT which must be read as false values
 	return SYNC_NONE;
 }
 
-Application::ExitCode_t Application::Reschedule(AwmPtr_t const & awm) {
+Application::ExitCode_t Application::Reschedule(
+		AwmPtr_t const & awm,
+		br::RViewToken_t status_view) {
 	SyncState_t sync;
 
 	// Ready application could be synchronized to start
@@ -569,7 +658,7 @@ Application::ExitCode_t Application::Reschedule(AwmPtr_t const & awm) {
 	}
 
 	// Checking if a synchronization is required
-	sync = SyncRequired(awm);
+	sync = SyncRequired(awm, status_view);
 	if (sync == SYNC_NONE)
 		return APP_SUCCESS;
 
@@ -602,12 +691,32 @@ Application::ExitCode_t Application::Unschedule() {
 
 Application::ExitCode_t Application::ScheduleRequest(AwmPtr_t const & awm,
 		br::RViewToken_t status_view, size_t b_refn) {
-	std::unique_lock<std::recursive_mutex> schedule_ul(schedule.mtx);
 	ResourceAccounter &ra(ResourceAccounter::GetInstance());
 	ResourceAccounter::ExitCode_t booking;
 	AppSPtr_t papp(awm->Owner());
+
+	// Shadow scheduling run: book into the policy view and record the
+	// request, without changing the status of the EXC. The accounting is
+	// not serialized: no booking once the system is being reconfigured.
+	ShadowContext_t * shadow = ShadowContext_t::current;
+	if (unlikely(shadow != nullptr)) {
+		br::ResourceAssignmentMapPtr_t binding(
+			awm->GetSchedResourceBinding(b_refn));
+		std::unique_lock<std::mutex> shadow_ul(shadow->mtx);
+		if (!shadow->dropped && !ra.IsReady())
+			shadow->dropped = true;
+		if (shadow->dropped ||
+				(ra.BookResources(papp, binding, status_view)
+					!= ResourceAccounter::RA_SUCCESS))
+			return APP_WM_REJECTED;
+		shadow->requests[Uid()] = { awm, binding };
+		return APP_SUCCESS;
+	}
+
+	std::unique_lock<std::recursive_mutex> schedule_ul(schedule.mtx);
 	logger->Info("ScheduleRequest: %s request for binding @[%d] view=%ld",
 		papp->StrId(), b_refn, status_view);
+	schedule.resize = false;
 
 	// App is SYNC/BLOCKED for a previously failed scheduling.
 	// Reset state and syncState for this new attempt.
@@ -649,7 +758,7 @@ Application::ExitCode_t Application::ScheduleRequest(AwmPtr_t const & awm,
 	// Reschedule accordingly to "awm"
 	logger->Debug("ScheduleRequest: rescheduling [%s] into AWM [%d:%s]...",
 			papp->StrId(), awm->Id(), awm->Name().c_str());
-	if (Reschedule(awm) != APP_SUCCESS) {
+	if (Reschedule(awm, status_view) != APP_SUCCESS) {
 		ra.ReleaseResources(papp, status_view);
 		awm->ClearResourceBinding();
 		return APP_WM_REJECTED;
@@ -758,6 +867,31 @@ void Application::ScheduleAbort() {
 	logger->Info("ScheduleAbort: completed ");
 }
 
+bool Application::Resizing() {
+	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
+	return schedule.resize;
+}
+
+void Application::ClearResizing() {
+	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
+	schedule.resize = false;
+}
+
+Application::ExitCode_t Application::ResizeReconf() {
+	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
+	schedule.resize = false;
+	if (_State() != RUNNING) {
+		logger->Error("ResizeReconf: [%s] is not running. State {%s/%s}",
+				StrId(), StateStr(_State()), SyncStateStr(_SyncState()));
+		return APP_ABORT;
+	}
+
+	// The next AWM has been already cleared by the running commit
+	schedule.next_awm = schedule.awm;
+	logger->Debug("ResizeReconf: [%s] to RECONF (resizing)", StrId());
+	return RequestSync(RECONF);
+}
+
 Application::ExitCode_t Application::ScheduleContinue() {
 	std::unique_lock<std::recursive_mutex> state_ul(schedule.mtx);
 
@@ -68,11 +68,19 @@ WorkingMode::WorkingMode(
 
 WorkingMode::~WorkingMode() {
 	resources.requested.clear();
-	if (resources.sync_bindings)
-		resources.sync_bindings->clear();
-	if (!resources.sched_bindings.empty()) {
-		resources.sched_bindings.clear();
-	}
+	resources.sync_bindings.reset();
+	resources.sched_bindings.clear();
+	binding_cache.maps.clear();
+}
+
+std::shared_ptr<WorkingMode> WorkingMode::Clone() const {
+	auto awm_copy = std::make_shared<WorkingMode>(*this);
+	for (auto & resource_entry: awm_copy->resources.requested)
+		resource_entry.second =
+			std::make_shared<br::ResourceAssignment>(*resource_entry.second);
+	// The cached maps are bound to the requests of this working mode
+	awm_copy->binding_cache.maps.clear();
+	return awm_copy;
 }
 
 WorkingMode::ExitCode_t WorkingMode::AddResourceRequest(
@@ -99,6 +107,8 @@ WorkingMode::ExitCode_t WorkingMode::AddResourceRequest(
 	// Insert a new resource usage object in the map
 	auto r_assign = std::make_shared<br::ResourceAssignment>(amount, split_policy);
 	resources.requested.emplace(resource_path, r_assign);
+	// The bindings of the previous requests are not valid anymore
+	binding_cache.maps.clear();
 	logger->Debug("AddResourceRequest: %s added {%s} \t[usage: %" PRIu64 "] [c=%2d]",
 			str_id, resource_path->ToString().c_str(),amount,
 			resources.requested.size());
@@ -157,20 +167,36 @@ int32_t WorkingMode::BindResource(
 		br::ResourceBitset * filter_mask) {
 	logger->Debug("BindResource: %s owner is %s", str_id, owner->StrId());
 
-	br::ResourceAssignmentMapPtr_t out_map = nullptr;
+	br::ResourceAssignmentMapPtr_t source_ptr;
 	br::ResourceAssignmentMap_t const * source_map =
-		GetSourceAndOutBindingMaps(out_map, prev_refn);
-	if (!source_map || !out_map) {
+		GetSourceBindingMap(source_ptr, prev_refn);
+	if (!source_map) {
 		logger->Error("BindingResource: source map = @%p", source_map);
-		logger->Error("BindingResource: out map = @%p", out_map.get());
 		return -1;
 	}
 
-	br::ResourceBinder::Bind(*source_map, r_type, source_id, out_id, out_map,
-			filter_rtype, filter_mask);
-	if (out_map->empty()) {
-		logger->Warn("BindResource: %s nothing to bind", str_id);
-		return -1;
+	BindingKey_t key;
+	key.source_map = source_map;
+	key.r_type     = r_type;
+	key.source_id  = source_id;
+	key.out_id     = out_id;
+	if ((filter_rtype != br::ResourceType::UNDEFINED) && filter_mask) {
+		key.filter_rtype = filter_rtype;
+		key.filter_mask  = *filter_mask;
+	}
+
+	auto out_map = LookupBinding(key);
+	if (!out_map) {
+		out_map = source_ptr ?
+			std::make_shared<br::ResourceAssignmentMap_t>(*source_ptr):
+			std::make_shared<br::ResourceAssignmentMap_t>();
+		br::ResourceBinder::Bind(*source_map, r_type, source_id, out_id,
+				out_map, filter_rtype, filter_mask);
+		if (out_map->empty()) {
+			logger->Warn("BindResource: %s nothing to bind", str_id);
+			return -1;
+		}
+		CacheBinding(key, source_ptr, out_map);
 	}
 
 	int32_t refn = StoreBinding(out_map, prev_refn);
@@ -188,19 +214,31 @@ int32_t WorkingMode::BindResource(
 	logger->Debug("BindResource: <%s> to mask='%s'",
 		resource_path->ToString().c_str(), filter_mask.ToString().c_str());
 
-	br::ResourceAssignmentMapPtr_t out_map = nullptr;
+	br::ResourceAssignmentMapPtr_t source_ptr;
 	br::ResourceAssignmentMap_t const * source_map =
-		GetSourceAndOutBindingMaps(out_map, prev_refn);
-	if (!source_map || !out_map) {
+		GetSourceBindingMap(source_ptr, prev_refn);
+	if (!source_map) {
 		logger->Error("BindingResource: source map = @%p", source_map);
-		logger->Error("BindingResource: out map = @%p", out_map.get());
 		return -1;
 	}
 
-	br::ResourceBinder::Bind(*source_map, resource_path, filter_mask, out_map);
-	if (out_map->empty()) {
-		logger->Warn("BindResource: nothing to bind");
-		return -1;
+	BindingKey_t key;
+	key.source_map    = source_map;
+	key.resource_path = resource_path->ToString();
+	key.filter_mask   = filter_mask;
+
+	auto out_map = LookupBinding(key);
+	if (!out_map) {
+		out_map = source_ptr ?
+			std::make_shared<br::ResourceAssignmentMap_t>(*source_ptr):
+			std::make_shared<br::ResourceAssignmentMap_t>();
+		br::ResourceBinder::Bind(*source_map, resource_path, filter_mask,
+				out_map);
+		if (out_map->empty()) {
+			logger->Warn("BindResource: nothing to bind");
+			return -1;
+		}
+		CacheBinding(key, source_ptr, out_map);
 	}
 
 	int32_t refn = StoreBinding(out_map, prev_refn);
@@ -210,25 +248,77 @@ int32_t WorkingMode::BindResource(
 }
 
 
-br::ResourceAssignmentMap_t const * WorkingMode::GetSourceAndOutBindingMaps(
-		br::ResourceAssignmentMapPtr_t & out_map,
+br::ResourceAssignmentMap_t const * WorkingMode::GetSourceBindingMap(
+		br::ResourceAssignmentMapPtr_t & source_ptr,
 		int32_t prev_refn) {
 
 	if (prev_refn < 0) {
 		logger->Debug("BindResource: first binding");
-		out_map = std::make_shared<br::ResourceAssignmentMap_t>();
+		source_ptr = nullptr;
 		return &resources.requested;
 	}
 	else {
 		logger->Debug("BindResource: resuming binding @[%d]", prev_refn);
-		out_map = GetSchedResourceBinding(prev_refn);
-		if (!out_map) {
+		source_ptr = GetSchedResourceBinding(prev_refn);
+		if (!source_ptr) {
 			logger->Error("BindingResource: wrong reference number [%d]",
 				prev_refn);
 			return nullptr;
 		}
-		return out_map.get();
+		return source_ptr.get();
+	}
+}
+
+
+bool WorkingMode::BindingKey_t::operator< (BindingKey_t const & other) const {
+	if (source_map != other.source_map)
+		return source_map < other.source_map;
+	if (r_type != other.r_type)
+		return r_type < other.r_type;
+	if (source_id != other.source_id)
+		return source_id < other.source_id;
+	if (out_id != other.out_id)
+		return out_id < other.out_id;
+	if (filter_rtype != other.filter_rtype)
+		return filter_rtype < other.filter_rtype;
+	if (filter_mask != other.filter_mask)
+		return filter_mask < other.filter_mask;
+	return resource_path < other.resource_path;
+}
+
+
+br::ResourceAssignmentMapPtr_t WorkingMode::LookupBinding(
+		BindingKey_t const & key) {
+	ResourceAccounter & ra(ResourceAccounter::GetInstance());
+
+	// Platform resources changed: the bindings must be rebuilt
+	uint32_t generation = ra.GetPlatformGeneration();
+	if (binding_cache.generation != generation) {
+		if (!binding_cache.maps.empty())
+			logger->Debug("BindResource: %s binding cache invalidated "
+				"[generation=%d]", str_id, generation);
+		binding_cache.maps.clear();
+		binding_cache.generation = generation;
+		return nullptr;
+	}
+
+	auto cache_it = binding_cache.maps.find(key);
+	if (cache_it == binding_cache.maps.end())
+		return nullptr;
+	logger->Debug("BindResource: %s binding found in cache", str_id);
+	return cache_it->second.second;
+}
+
+
+void WorkingMode::CacheBinding(
+		BindingKey_t const & key,
+		br::ResourceAssignmentMapPtr_t source_ptr,
+		br::ResourceAssignmentMapPtr_t out_map) {
+	if (binding_cache.maps.size() >= BBQUE_AWM_BINDING_CACHE_SIZE) {
+		logger->Debug("BindResource: %s binding cache full", str_id);
+		binding_cache.maps.clear();
 	}
+	binding_cache.maps.emplace(key, std::make_pair(source_ptr, out_map));
 }
 
 
@@ -252,6 +342,19 @@ int32_t WorkingMode::StoreBinding(
 }
 
 
+int32_t WorkingMode::RestoreBinding(br::ResourceAssignmentMapPtr_t binding) {
+	if (!binding || binding->empty()) {
+		logger->Warn("RestoreBinding: %s nothing to restore", str_id);
+		return -1;
+	}
+	resources.sched_bindings.push_back(binding);
+	int32_t refn = resources.sched_bindings.size() - 1;
+	logger->Debug("RestoreBinding: %s map size = %d [refn = %d]",
+			str_id, binding->size(), refn);
+	return refn;
+}
+
+
 br::ResourceAssignmentMapPtr_t WorkingMode::GetSchedResourceBinding(uint32_t b_refn) const {
 	if (b_refn >= resources.sched_bindings.size()) {
 		logger->Error("SchedResourceBinding: %s invalid reference [%ld]",
@@ -292,6 +395,10 @@ void WorkingMode::UpdateBindingInfo(
 	br::ResourceBitset new_mask;
 	logger->Debug("UpdateBinding: mask update required (%s)",
 			update_changed ? "Y" : "N");
+	if (!resources.sync_bindings) {
+		logger->Warn("UpdateBinding: %s no resource binding set", str_id);
+		return;
+	}
 
 	// Update the resource binding bitmask (for each type)
 	for (int r_type_index = 0; r_type_index < R_TYPE_COUNT; ++r_type_index) {
@@ -302,14 +409,14 @@ void WorkingMode::UpdateBindingInfo(
 					str_id, br::GetResourceTypeString(r_type));
 			// 'Deep' get bit-mask in this case
 			new_mask = br::ResourceBinder::GetMask(
-				resources.sched_bindings[resources.sync_refn],
+				resources.sync_bindings,
 				static_cast<br::ResourceType>(r_type),
 				br::ResourceType::CPU,
 				R_ID_ANY, owner, status_view);
 		}
 		else {
 			new_mask = br::ResourceBinder::GetMask(
-				resources.sched_bindings[resources.sync_refn],
+				resources.sync_bindings,
 				static_cast<br::ResourceType>(r_type));
 		}
 		logger->Debug("UpdateBinding: %s R{%-3s}: %s",
@@ -332,7 +439,8 @@ void WorkingMode::UpdateBindingInfo(
 }
 
 void WorkingMode::ClearResourceBinding() {
-	resources.sync_bindings->clear();
+	// The binding map can be shared with the binding cache
+	resources.sync_bindings = std::make_shared<br::ResourceAssignmentMap_t>();
 	for (int r_type_index = 0; r_type_index < R_TYPE_COUNT; ++r_type_index) {
 		br::ResourceType r_type = static_cast<br::ResourceType>(r_type_index);
 		resources.binding_masks[r_type].RestorePreviousSet();
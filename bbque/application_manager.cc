@@ -21,7 +21,9 @@
 
 #include "bbque/config.h"
 #include "bbque/configuration_manager.h"
+#include "bbque/interference_model.h"
 #include "bbque/modules_factory.h"
+#include "bbque/overcommit_model.h"
 #include "bbque/plugin_manager.h"
 #include "bbque/platform_manager.h"
 #include "bbque/scheduler_manager.h"
@@ -66,6 +68,8 @@ using std::chrono::milliseconds;
 
 namespace bbque {
 
+thread_local ShadowContext_t * ShadowContext_t::current = nullptr;
+
 ApplicationManager & ApplicationManager::GetInstance() {
 	static ApplicationManager instance;
 	return instance;
@@ -223,23 +227,20 @@ ApplicationManager::~ApplicationManager() {
 	logger->Debug("Clearing SYNC vector...");
 	for (uint8_t state = 0;
 			state < Application::SYNC_STATE_COUNT; ++state) {
-		sync_vec[state].clear();
-		sync_ret[state].clear();
+		sync_vec[state].Clear();
 	}
 
 	// Clear the status vector
 	logger->Debug("Clearing STATUS vector...");
 	for (uint8_t state = 0;
 			state < Application::STATE_COUNT; ++state) {
-		status_vec[state].clear();
-		status_ret[state].clear();
+		status_vec[state].Clear();
 	}
 
 	// Clear the priority vector
 	logger->Debug("Clearing PRIO vector...");
 	for (uint8_t level = 0; level < BBQUE_APP_PRIO_LEVELS; ++level) {
-		prio_vec[level].clear();
-		prio_ret[level].clear();
+		prio_vec[level].Clear();
 	}
 
 	// Clear the APPs map
@@ -248,8 +249,7 @@ ApplicationManager::~ApplicationManager() {
 
 	// Clear the applications map
 	logger->Debug("Clearing UIDs map...");
-	uids.clear();
-	uids_ret.clear();
+	uids.Clear();
 
 	// Clear the recipes
 	logger->Debug("Clearing RECIPES...");
@@ -321,231 +321,145 @@ bp::RecipeLoaderIF::ExitCode_t ApplicationManager::LoadRecipe(
   *     Queued Access Functions
   *****************************************************************************/
 
-void
-ApplicationManager::UpdateIterators(AppsUidMapItRetainer_t & ret,
-		AppPtr_t papp) {
-	AppsUidMapItRetainer_t::iterator it;
-	AppsUidMapIt* pati;
-
-	logger->Debug("Checking [%d] iterators...", ret.size());
-	// Lookup for iterators on the specified map which pointes to the
-	// specified apps
-	for (it = ret.begin(); it != ret.end(); ++it) {
-		pati = (*it);
-
-		// Ignore iterators not pointing to the application of interest
-		if (pati->it->first != papp->Uid())
-			continue;
-
-		// Update the iterator position one step backward
-		logger->Debug("~ Updating iterator [@%p => %d]", pati->it, papp->Uid());
-
-		// Move the iterator forward
-		pati->Update();
-	}
-
-}
-
 AppPtr_t ApplicationManager::GetFirst(AppsUidMapIt & ait) {
-	std::unique_lock<std::recursive_mutex> uids_ul(uids_mtx);
-	AppPtr_t papp;
-
-	ait.Init(uids, uids_ret);
+	ShadowContext_t const * shadow = ShadowContext_t::current;
+	if (unlikely(shadow != nullptr))
+		ait.Init(shadow->all);
+	else
+		ait.Init(uids);
 	if (ait.End())
 		return AppPtr_t();
-
-	// Return the pointer application
-	papp = ait.Get();
-
-	// Add iterator to the retainers list
-	ait.Retain();
-	logger->Debug(">>>>> ADD retained UIDs iterator [@%p => %d]",
-			&(ait.it), papp->Uid());
-
-	return papp;
+	return ait.Get();
 }
 
 AppPtr_t ApplicationManager::GetNext(AppsUidMapIt & ait) {
-	std::unique_lock<std::recursive_mutex> uids_ul(uids_mtx);
-	AppPtr_t papp;
-
 	ait++;
 	if (ait.End()) {
-		// Release the iterator retainer
+		// Release the snapshot
 		ait.Release();
-		logger->Debug("<<<<< DEL retained UIDs iterator [@%p => %d]",
-				&(ait.it));
 		return AppPtr_t();
 	}
-
-	papp = ait.Get();
-	return papp;
+	return ait.Get();
 }
 
 AppPtr_t ApplicationManager::GetFirst(AppPrio_t prio,
 		AppsUidMapIt & ait) {
 	assert(prio < BBQUE_APP_PRIO_LEVELS);
-	std::unique_lock<std::mutex> prio_ul(prio_mtx[prio]);
-	AppPtr_t papp;
-
-	ait.Init(prio_vec[prio], prio_ret[prio]);
+	ShadowContext_t const * shadow = ShadowContext_t::current;
+	if (unlikely(shadow != nullptr))
+		ait.Init(shadow->prio[prio]);
+	else
+		ait.Init(prio_vec[prio]);
 	if (ait.End())
 		return AppPtr_t();
-
-	papp = ait.Get();
-
-	// Add iterator to the retainers list
-	ait.Retain();
-	logger->Debug(">>>>> ADD retained PRIO[%d] iterator [@%p => %d]",
-			prio, &(ait.it), papp->Uid());
-
-	return papp;
+	return ait.Get();
 }
 
 AppPtr_t ApplicationManager::GetNext(AppPrio_t prio,
 		AppsUidMapIt & ait) {
 	assert(prio < BBQUE_APP_PRIO_LEVELS);
-	std::unique_lock<std::mutex> prio_ul(prio_mtx[prio]);
-	AppPtr_t papp;
-
-	ait++;
-	if (ait.End()) {
-		// Release the iterator retainer
-		ait.Release();
-		logger->Debug("<<<<< DEL retained PRIO[%d] iterator [@%p]",
-			prio, &(ait.it));
-		return AppPtr_t();
-	}
-
-	papp = ait.Get();
-	return papp;
+	(void) prio;
+	return GetNext(ait);
 }
 
 AppPtr_t ApplicationManager::GetFirst(ApplicationStatusIF::State_t state,
 		AppsUidMapIt & ait) {
 	assert(state < Application::STATE_COUNT);
-	std::unique_lock<std::mutex> status_ul(status_mtx[state]);
-	AppPtr_t papp;
-
-	ait.Init(status_vec[state], status_ret[state]);
+	ShadowContext_t const * shadow = ShadowContext_t::current;
+	if (unlikely(shadow != nullptr))
+		ait.Init(shadow->status[state]);
+	else
+		ait.Init(status_vec[state]);
 	if (ait.End())
 		return AppPtr_t();
-
-	papp = ait.Get();
-
-	// Add iterator to the retainers list
-	ait.Retain();
-	logger->Debug(">>>>> ADD retained STATUS[%s] iterator [@%p => %d]",
-			Application::StateStr(state), &(ait.it), papp->Uid());
-
-	return papp;
+	return ait.Get();
 }
 
 AppPtr_t ApplicationManager::GetNext(ApplicationStatusIF::State_t state,
 		AppsUidMapIt & ait) {
 	assert(state < Application::STATE_COUNT);
-	std::unique_lock<std::mutex> status_ul(status_mtx[state]);
-	AppPtr_t papp;
-
-	ait++;
-	if (ait.End()) {
-		// Release the iterator retainer
-		ait.Release();
-		logger->Debug("<<<<< DEL retained STATUS[%s] iterator [@%p]",
-			Application::StateStr(state), &(ait.it));
-		return AppPtr_t();
-	}
-
-	papp = ait.Get();
-	return papp;
+	(void) state;
+	return GetNext(ait);
 }
 
 AppPtr_t ApplicationManager::GetFirst(ApplicationStatusIF::SyncState_t state,
 		AppsUidMapIt & ait) {
 	assert(state < Application::SYNC_STATE_COUNT);
-	std::unique_lock<std::mutex> sync_ul(sync_mtx[state]);
-	AppPtr_t papp;
-
-	ait.Init(sync_vec[state], sync_ret[state]);
+	ShadowContext_t const * shadow = ShadowContext_t::current;
+	if (unlikely(shadow != nullptr))
+		ait.Init(shadow->sync[state]);
+	else
+		ait.Init(sync_vec[state]);
 	if (ait.End())
 		return AppPtr_t();
-
-	papp = ait.Get();
-
-	// Add iterator to the retainers list
-	ait.Retain();
-	logger->Debug(">>>>> ADD retained SYNCS[%s] iterator [@%p => %d]",
-			Application::SyncStateStr(state), &(ait.it),
-			papp->Uid());
-
-	return papp;
+	return ait.Get();
 }
 
 AppPtr_t ApplicationManager::GetNext(ApplicationStatusIF::SyncState_t state,
 		AppsUidMapIt & ait) {
 	assert(state < Application::SYNC_STATE_COUNT);
-	std::unique_lock<std::mutex> sync_ul(sync_mtx[state]);
-	AppPtr_t papp;
-
-	ait++;
-	if (ait.End()) {
-		// Release the iterator retainer
-		ait.Release();
-		logger->Debug("<<<<< DEL retained SYNCS[%s] iterator [@%p]",
-			Application::SyncStateStr(state), &(ait.it));
-		return AppPtr_t();
-	}
-
-	papp = ait.Get();
-	return papp;
+	(void) state;
+	return GetNext(ait);
 }
 
 bool ApplicationManager::HasApplications (
 		AppPrio_t prio) {
 	assert(prio < BBQUE_APP_PRIO_LEVELS);
-	return !(prio_vec[prio].empty());
+	ShadowContext_t const * shadow = ShadowContext_t::current;
+	if (unlikely(shadow != nullptr))
+		return !(shadow->prio[prio]->empty());
+	return !(prio_vec[prio].Empty());
 }
 
 bool ApplicationManager::HasApplications (
 		ApplicationStatusIF::State_t state) {
 	assert(state < Application::STATE_COUNT);
-	return !(status_vec[state].empty());
+	ShadowContext_t const * shadow = ShadowContext_t::current;
+	if (unlikely(shadow != nullptr))
+		return !(shadow->status[state]->empty());
+	return !(status_vec[state].Empty());
 }
 
 bool ApplicationManager::HasApplications (
 		ApplicationStatusIF::SyncState_t state) {
 	assert(state < Application::SYNC_STATE_COUNT);
-	return !(sync_vec[state].empty());
+	return !(sync_vec[state].Empty());
 }
 
 bool ApplicationManager::HasApplications (
 		RTLIB_ProgrammingLanguage_t lang) {
 	assert(lang < RTLIB_LANG_COUNT);
-	return !(lang_vec[lang].empty());
+	return !(lang_vec[lang].Empty());
 }
 
 uint16_t ApplicationManager::AppsCount (
 		AppPrio_t prio) const {
 	assert(prio < BBQUE_APP_PRIO_LEVELS);
-	return prio_vec[prio].size();
+	ShadowContext_t const * shadow = ShadowContext_t::current;
+	if (unlikely(shadow != nullptr))
+		return shadow->prio[prio]->size();
+	return prio_vec[prio].Size();
 }
 
 uint16_t ApplicationManager::AppsCount (
 		ApplicationStatusIF::State_t state) const {
 	assert(state < Application::STATE_COUNT);
-	return status_vec[state].size();
+	ShadowContext_t const * shadow = ShadowContext_t::current;
+	if (unlikely(shadow != nullptr))
+		return shadow->status[state]->size();
+	return status_vec[state].Size();
 }
 
 uint16_t ApplicationManager::AppsCount (
 		ApplicationStatusIF::SyncState_t state) const {
 	assert(state < Application::SYNC_STATE_COUNT);
-	return sync_vec[state].size();
+	return sync_vec[state].Size();
 }
 
 uint16_t ApplicationManager::AppsCount (
 		RTLIB_ProgrammingLanguage_t lang) const {
 	assert(lang < RTLIB_LANG_COUNT);
-	return lang_vec[lang].size();
+	return lang_vec[lang].Size();
 }
 
 AppPtr_t ApplicationManager::HighestPrio(
@@ -618,14 +532,12 @@ AppPtr_t ApplicationManager::HighestPrio(
  ******************************************************************************/
 
 AppPtr_t const ApplicationManager::GetApplication(AppUid_t uid) {
-	std::unique_lock<std::recursive_mutex> uids_ul(uids_mtx);
-	AppsUidMap_t::const_iterator it = uids.find(uid);
-	AppPtr_t papp;
+	AppPtr_t papp(uids.Find(uid));
 
 	logger->Debug("Looking for UID [%07d]...", uid);
 
 	//----- Find the required EXC
-	if (it == uids.end()) {
+	if (!papp) {
 		DB(logger->Debug("Lookup for EXC [%05d:*:%02d] (UID: %07d) FAILED"
 				" (Error: UID not registered)",
 				Application::Uid2Pid(uid),
@@ -634,7 +546,6 @@ AppPtr_t const ApplicationManager::GetApplication(AppUid_t uid) {
 		return AppPtr_t();
 	}
 
-	papp = (*it).second;
 	logger->Debug("Found UID [%07d] => [%s]", uid, papp->StrId());
 
 	return papp;
@@ -721,17 +632,13 @@ ApplicationManager::UpdateStatusMaps(AppPtr_t papp,
 	assert(papp);
 	assert(prev != next);
 
-	// Retrieve the runtime map from the status vector
-	AppsUidMap_t *currStateMap = &(status_vec[prev]);
-	AppsUidMap_t *nextStateMap = &(status_vec[next]);
-	assert(currStateMap != nextStateMap);
-
 	// Move it from the current to the next status map
 	// FIXME: maybe we could avoid to enqueue FINISHED EXCs
-	nextStateMap->insert(UidsMapEntry_t(papp->Uid(), papp));
+	status_vec[next].Insert(papp);
+	status_vec[prev].Erase(papp->Uid());
 
-	UpdateIterators(status_ret[prev], papp);
-	currStateMap->erase(papp->Uid());
+	// Update the scheduling statistics
+	UpdateSchedStats(papp, next);
 
 	ReportStatusQ();
 	ReportSyncQ();
@@ -739,6 +646,103 @@ ApplicationManager::UpdateStatusMaps(AppPtr_t papp,
 	return AM_SUCCESS;
 }
 
+void ApplicationManager::UpdateSchedStats(AppPtr_t papp,
+		Application::State_t state) {
+	ba::AwmPtr_t awm(papp->CurrentAWM());
+	SchedStatsContrib_t contrib;
+	contrib.prio    = papp->Priority();
+	contrib.active  = (state == Application::READY) ||
+		(state == Application::RUNNING);
+	contrib.running = (state == Application::RUNNING) && awm;
+	contrib.app_value = contrib.running ? papp->Value() : 0;
+	contrib.awm_value = contrib.running ? awm->Value() : 0;
+
+	std::unique_lock<std::mutex> stats_ul(sched_stats_mtx);
+	auto contrib_it = sched_stats_contrib.find(papp->Uid());
+
+	// Remove the previous contribution...
+	if (contrib_it != sched_stats_contrib.end()) {
+		SchedStatsContrib_t const & prev(contrib_it->second);
+		SchedStats_t & stats(sched_stats[prev.prio]);
+		stats.active_count -= prev.active;
+		if (prev.running) {
+			--stats.running_count;
+			stats.app_value_sum  -= prev.app_value;
+			stats.app_value_sum2 -= prev.app_value * prev.app_value;
+			stats.awm_value_sum  -= prev.awm_value;
+			stats.awm_value_sum2 -= prev.awm_value * prev.awm_value;
+		}
+	}
+
+	// ...and add the current one
+	SchedStats_t & stats(sched_stats[contrib.prio]);
+	stats.active_count += contrib.active;
+	if (contrib.running) {
+		++stats.running_count;
+		stats.app_value_sum  += contrib.app_value;
+		stats.app_value_sum2 += contrib.app_value * contrib.app_value;
+		stats.awm_value_sum  += contrib.awm_value;
+		stats.awm_value_sum2 += contrib.awm_value * contrib.awm_value;
+	}
+
+	// Reset the sums once empty, to avoid accumulating rounding errors
+	if (stats.running_count == 0)
+		stats.app_value_sum = stats.app_value_sum2 =
+			stats.awm_value_sum = stats.awm_value_sum2 = 0;
+
+	sched_stats_contrib[papp->Uid()] = contrib;
+}
+
+void ApplicationManager::RemoveSchedStats(AppPtr_t papp) {
+	UpdateSchedStats(papp, Application::FINISHED);
+	std::unique_lock<std::mutex> stats_ul(sched_stats_mtx);
+	sched_stats_contrib.erase(papp->Uid());
+}
+
+ApplicationManager::SchedStats_t
+ApplicationManager::GetSchedStats(AppPrio_t prio) {
+	std::unique_lock<std::mutex> stats_ul(sched_stats_mtx);
+	return sched_stats[prio];
+}
+
+void ApplicationManager::GetShadowContext(ShadowContext_t & ctx) {
+	ctx.apps.clear();
+	ctx.requests.clear();
+
+	ctx.all = uids.Snapshot();
+	for (AppPrio_t prio = 0; prio < BBQUE_APP_PRIO_LEVELS; ++prio)
+		ctx.prio[prio] = prio_vec[prio].Snapshot();
+	for (uint8_t state = 0; state < Application::STATE_COUNT; ++state)
+		ctx.status[state] = status_vec[state].Snapshot();
+	for (uint8_t state = 0; state < Application::SYNC_STATE_COUNT; ++state)
+		ctx.sync[state] = sync_vec[state].Snapshot();
+
+	// The policy works on copies of the AWMs
+	auto copy_awm = [](ShadowContext_t::AppState_t const & app_state,
+			ba::AwmPtr_t const & pawm) -> ba::AwmPtr_t {
+		if (!pawm)
+			return pawm;
+		for (ba::AwmPtr_t const & awm_copy: app_state.awms) {
+			if (awm_copy->Id() == pawm->Id())
+				return awm_copy;
+		}
+		return pawm->Clone();
+	};
+
+	for (AppPtr_t const & papp: *(ctx.all)) {
+		ShadowContext_t::AppState_t & app_state(ctx.apps[papp->Uid()]);
+		app_state.state      = papp->State();
+		app_state.sync_state = papp->SyncState();
+		app_state.awms.clear();
+		for (ba::AwmPtr_t const & pawm: papp->WorkingModes())
+			app_state.awms.push_back(pawm->Clone());
+		app_state.awm        = copy_awm(app_state, papp->CurrentAWM());
+		app_state.next_awm   = copy_awm(app_state, papp->NextAWM());
+		if (app_state.awm)
+			app_state.binding = app_state.awm->GetResourceBinding();
+	}
+}
+
 inline void BuildStateStr(AppPtr_t papp, char * state_str) {
 	ApplicationStatusIF::State_t state;
 	ApplicationStatusIF::SyncState_t sync_state;
@@ -928,9 +932,6 @@ AppPtr_t ApplicationManager::CreateEXC(
 		app::AppPrio_t _prio,
 		bool _weak_load,
 		bool container) {
-	std::unique_lock<std::mutex> lang_ul(lang_mtx[_lang], std::defer_lock);
-	std::unique_lock<std::mutex> prio_ul(prio_mtx[_prio], std::defer_lock);
-	std::unique_lock<std::recursive_mutex> uids_ul(uids_mtx, std::defer_lock);
 	std::unique_lock<std::mutex> status_ul(status_mtx[Application::DISABLED], std::defer_lock);
 	std::unique_lock<std::mutex> apps_ul(apps_mtx, std::defer_lock);
 	Application::ExitCode_t app_result;
@@ -972,25 +973,19 @@ AppPtr_t ApplicationManager::CreateEXC(
 	// Save application descriptors
 	apps.insert(AppsMapEntry_t(papp->Pid(), papp));
 
-	uids_ul.lock();
-	uids.insert(UidsMapEntry_t(papp->Uid(), papp));
-	uids_ul.unlock();
+	uids.Insert(papp);
 
 	// Priority vector
-	prio_ul.lock();
-	prio_vec[papp->Priority()].insert(UidsMapEntry_t(papp->Uid(), papp));
-	prio_ul.unlock();
+	prio_vec[papp->Priority()].Insert(papp);
 
 	// Status vector (all new EXC are initially disabled)
 	assert(papp->State() == Application::DISABLED);
 	status_ul.lock();
-	status_vec[papp->State()].insert(UidsMapEntry_t(papp->Uid(), papp));
+	status_vec[papp->State()].Insert(papp);
 	status_ul.unlock();
 
 	// Language vector
-	lang_ul.lock();
-	lang_vec[papp->Language()].insert(UidsMapEntry_t(papp->Uid(), papp));
-	lang_ul.unlock();
+	lang_vec[papp->Language()].Insert(papp);
 	logger->Info("EXC [%s] CREATED", papp->StrId());
 
 	return papp;
@@ -1003,11 +998,8 @@ AppPtr_t ApplicationManager::CreateEXC(
 
 ApplicationManager::ExitCode_t
 ApplicationManager::PriorityRemove(AppPtr_t papp) {
-	std::unique_lock<std::mutex> prio_ul(prio_mtx[papp->Priority()]);
-
 	logger->Debug("Releasing [%s] EXCs from PRIORITY map...", papp->StrId());
-	UpdateIterators(prio_ret[papp->Priority()], papp);
-	prio_vec[papp->Priority()].erase(papp->Uid());
+	prio_vec[papp->Priority()].Erase(papp->Uid());
 
 	return AM_SUCCESS;
 }
@@ -1017,19 +1009,15 @@ ApplicationManager::StatusRemove(AppPtr_t papp) {
 	std::unique_lock<std::mutex> status_ul(status_mtx[papp->State()]);
 
 	logger->Debug("Releasing [%s] EXCs from STATUS map...", papp->StrId());
-	UpdateIterators(status_ret[papp->State()], papp);
-	status_vec[papp->State()].erase(papp->Uid());
+	status_vec[papp->State()].Erase(papp->Uid());
 
 	return AM_SUCCESS;
 }
 
 ApplicationManager::ExitCode_t
 ApplicationManager::LangRemove(AppPtr_t papp) {
-	std::unique_lock<std::mutex> lang_ul(lang_mtx[papp->Language()]);
-
 	logger->Debug("Releasing [%s] EXCs from LANGUAGE map...", papp->StrId());
-	UpdateIterators(lang_ret[papp->Language()], papp);
-	lang_vec[papp->Language()].erase(papp->Uid());
+	lang_vec[papp->Language()].Erase(papp->Uid());
 
 	return AM_SUCCESS;
 }
@@ -1060,7 +1048,6 @@ ApplicationManager::AppsRemove(AppPtr_t papp) {
 
 ApplicationManager::ExitCode_t
 ApplicationManager::CleanupEXC(AppPtr_t papp) {
-	std::unique_lock<std::recursive_mutex> uids_ul(uids_mtx, std::defer_lock);
 	PlatformManager::ExitCode_t pp_result;
 	ExitCode_t am_result;
 
@@ -1077,12 +1064,13 @@ ApplicationManager::CleanupEXC(AppPtr_t papp) {
 		return AM_PLAT_PROXY_ERROR;
 	}
 
+	// Remove the scheduling statistics contribution
+	RemoveSchedStats(papp);
+	OvercommitModel::GetInstance().Remove(papp);
+
 	logger->Debug("EXC [%s] cleaning up from UIDs map...", papp->StrId());
 
-	uids_ul.lock();
-	UpdateIterators(uids_ret, papp);
-	uids.erase(papp->Uid());
-	uids_ul.unlock();
+	uids.Erase(papp->Uid());
 	logger->Info("EXC [%s] cleaned up", papp->StrId());
 
 	return AM_SUCCESS;
@@ -1314,6 +1302,29 @@ ApplicationManager::GetRuntimeProfile(
 	return GetRuntimeProfile(papp, profile);
 }
 
+ApplicationManager::ExitCode_t
+ApplicationManager::GetResourceUsage(
+		AppPid_t pid, uint8_t exc_id, struct app::ResourceUsage_t &usage) {
+	AppPtr_t papp = GetApplication(Application::Uid(pid, exc_id));
+	if (!papp) {
+		logger->Warn("EXC [%d:*:%d] resource usage not available: EXC not found",
+			pid, exc_id);
+		return AM_EXC_NOT_FOUND;
+	}
+	return GetResourceUsage(papp, usage);
+}
+
+ApplicationManager::ExitCode_t
+ApplicationManager::SetResourceUsage(
+		AppPtr_t papp, struct app::ResourceUsage_t const & usage) {
+	papp->SetResourceUsage(usage);
+
+	// Usage-based admission of the CPU bandwidth
+	if (usage.is_valid && (usage.cpu_usage > 0))
+		OvercommitModel::GetInstance().AddSample(papp, usage.cpu_usage);
+	return AM_SUCCESS;
+}
+
 ApplicationManager::ExitCode_t
 ApplicationManager::SetRuntimeProfile(
 		AppPid_t pid, uint8_t exc_id, struct app::RuntimeProfiling_t profile) {
@@ -1333,7 +1344,9 @@ ApplicationManager::SetRuntimeProfile(
 		uint8_t exc_id,
 		int gap,
 		int cusage,
-		int ctime_ms) {
+		int ctime_ms,
+		float llc_mpkc,
+		uint32_t mem_bw_mbps) {
 	// Getting current runtime profile information
 	ExitCode_t result;
 	struct app::RuntimeProfiling_t rt_prof;
@@ -1353,6 +1366,20 @@ ApplicationManager::SetRuntimeProfile(
 	rt_prof.ctime_ms = ctime_ms;
 	rt_prof.is_valid = true;
 
+	// Interference profile of the current AWM, if counted by the RTLib
+	AppPtr_t papp(GetApplication(Application::Uid(pid, exc_id)));
+	if ((llc_mpkc > 0) || (mem_bw_mbps > 0)) {
+		rt_prof.llc_mpkc    = llc_mpkc;
+		rt_prof.mem_bw_mbps = mem_bw_mbps;
+		if (papp && papp->CurrentAWM())
+			InterferenceModel::GetInstance().AddSample(
+				papp, papp->CurrentAWM()->Id(), llc_mpkc, mem_bw_mbps);
+	}
+
+	// CPU bandwidth used, as measured by the RTLib
+	if (papp && (cusage > 0))
+		OvercommitModel::GetInstance().AddSample(papp, cusage);
+
 	if (rt_prof.ggap_percent < 0) {
 		// Update lower bound value and age
 		rt_prof.gap_history.lower_cpu = rt_prof.cpu_usage;
@@ -1528,6 +1555,14 @@ ApplicationManager::CheckEXC(AppPtr_t papp, bool release) {
 	logger->Debug("EXC [%s] is %s",
 			papp->StrId(), dead ? "DEAD" : "still ALIVE");
 
+#ifdef CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+	// The shared memory page would be left behind by a dead application
+	if (dead) {
+		ApplicationProxy & ap(ApplicationProxy::GetInstance());
+		ap.ShmAllocCleanup(papp, true);
+	}
+#endif
+
 	// If required, return application resources to the system view
 	if (likely(dead && release)) {
 		logger->Debug("EXC [%s] check => release...", papp->StrId());
@@ -1563,12 +1598,10 @@ ApplicationManager::CheckEXC(AppPid_t pid, uint8_t exc_id, bool release) {
 
 void
 ApplicationManager::SyncRemove(AppPtr_t papp, Application::SyncState_t state) {
-	std::unique_lock<std::mutex> sync_ul(sync_mtx[state]);
 	assert(papp);
-	UpdateIterators(sync_ret[state], papp);
 
 	// Get the applications map
-	if (sync_vec[state].erase(papp->Uid())) {
+	if (sync_vec[state].Erase(papp->Uid())) {
 		logger->Debug("EXC [%s, %s] removed sync request",
 			papp->StrId(), papp->SyncStateStr());
 		return;
@@ -1592,9 +1625,8 @@ ApplicationManager::SyncRemove(AppPtr_t papp) {
 
 void
 ApplicationManager::SyncAdd(AppPtr_t papp, Application::SyncState_t state) {
-	std::unique_lock<std::mutex> sync_ul(sync_mtx[state]);
 	assert(papp);
-	sync_vec[state].insert(UidsMapEntry_t(papp->Uid(), papp));
+	sync_vec[state].Insert(papp);
 }
 
 void
@@ -1667,6 +1699,46 @@ ApplicationManager::RunningCommit(AppPtr_t papp) {
 	if (app_result != Application::APP_SUCCESS)
 		return AM_ABORT;
 
+	// The application value could have been updated by the scheduling
+	UpdateSchedStats(papp, Application::RUNNING);
+
+	return AM_SUCCESS;
+}
+
+ApplicationManager::ExitCode_t
+ApplicationManager::ResizeCommit(AppPtr_t papp) {
+	ResourceAccounter & ra(ResourceAccounter::GetInstance());
+	PlatformManager & plm(PlatformManager::GetInstance());
+	ApplicationProxy & ap(ApplicationProxy::GetInstance());
+	br::ResourceAssignmentMapPtr_t const & binding(
+		papp->CurrentAWM()->GetResourceBinding());
+	papp->ClearResizing();
+
+	// Account for the new amounts in the system view, if they still fit.
+	// Otherwise, the resize is synchronized as a reconfiguration.
+	if (ra.ResizeResources(papp, ra.GetScheduledView())
+			!= ResourceAccounter::RA_SUCCESS) {
+		logger->Warn("ResizeCommit: [%s] resize not applicable, "
+			"reconfiguring...", papp->StrId());
+		papp->ResizeReconf();
+		return AM_ABORT;
+	}
+
+	// Enforce the new amounts. On failure, the synchronization maps the
+	// resources again, and replaces the system view accounting.
+	if (plm.MapResources(papp, binding) != PlatformManager::PLATFORM_OK) {
+		logger->Error("ResizeCommit: [%s] platform mapping FAILED, "
+			"reconfiguring...", papp->StrId());
+		papp->ResizeReconf();
+		return AM_PLAT_PROXY_ERROR;
+	}
+
+	// Notify the RTLib (no response expected)
+	if (ap.ResizeNotify(papp) != RTLIB_OK)
+		logger->Warn("ResizeCommit: [%s] RTLib not notified", papp->StrId());
+
+	logger->Info("ResizeCommit: [%s] resized in AWM [%d]",
+		papp->StrId(), papp->CurrentAWM()->Id());
 	return AM_SUCCESS;
 }
 
@@ -30,6 +30,12 @@
 #include "bbque/pp/opencl_platform_proxy.h"
 #endif
 
+#ifdef CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #define MODULE_NAMESPACE APPLICATION_PROXY_NAMESPACE
 
 namespace ba = bbque::app;
@@ -209,6 +215,65 @@ ApplicationProxy::StopExecution(AppPtr_t papp) {
 	return RTLIB_OK;
 }
 
+RTLIB_ExitCode_t ApplicationProxy::ResizeNotify(AppPtr_t papp) {
+	std::unique_lock<std::mutex> conCtxMap_ul(conCtxMap_mtx,
+			std::defer_lock);
+	ResourceAccounter &ra(ResourceAccounter::GetInstance());
+	conCtxMap_t::iterator it;
+	pconCtx_t pcon;
+	ssize_t result;
+	bl::rpc_msg_BBQ_RESIZE_t resize_msg = {
+		{
+			bl::RPC_BBQ_RESIZE,
+			static_cast<unsigned int>(gettid()),
+			static_cast<int>(papp->Pid()),
+			papp->ExcId()
+		},
+		static_cast<int8_t>(papp->CurrentAWM()->Id()),
+		// Resource amount (PROC_ELEMENT, MEMORY)
+		0, 0
+	};
+
+#ifndef CONFIG_BBQUE_TEST_PLATFORM_DATA
+	resize_msg.r_proc = ra.GetAssignedAmount(
+		papp->CurrentAWM()->GetResourceBinding(),
+		papp, ra.GetScheduledView(),
+		br::ResourceType::PROC_ELEMENT);
+	resize_msg.r_mem = ra.GetAssignedAmount(
+		papp->CurrentAWM()->GetResourceBinding(),
+		papp, ra.GetScheduledView(),
+		br::ResourceType::MEMORY);
+#endif // CONFIG_BBQUE_TEST_PLATFORM_DATA
+
+	// Recover the communication context for this application
+	conCtxMap_ul.lock();
+	it = conCtxMap.find(papp->Pid());
+	conCtxMap_ul.unlock();
+	if (it == conCtxMap.end()) {
+		logger->Error("APPs PRX: Send Command [RPC_BBQ_RESIZE] "
+				"to EXC [%s] FAILED (Error: connection context not found)",
+				papp->StrId());
+		return RTLIB_BBQUE_CHANNEL_UNAVAILABLE;
+	}
+	pcon = (*it).second;
+
+	// Send the notification (no response expected)
+	logger->Debug("APPs PRX: Send Command [RPC_BBQ_RESIZE] to "
+			"EXC [%s], PROCs=<%d%%>, MEM=<%d>",
+			papp->StrId(), resize_msg.r_proc, resize_msg.r_mem);
+	assert(rpc);
+	result = rpc->SendMessage(pcon->pd, &resize_msg.hdr,
+			(size_t)RPC_PKT_SIZE(BBQ_RESIZE));
+	if (result == -1) {
+		logger->Error("APPs PRX: Send Command [RPC_BBQ_RESIZE] "
+				"to EXC [%s] FAILED (Error: write failed)",
+				papp->StrId());
+		return RTLIB_BBQUE_CHANNEL_WRITE_FAILED;
+	}
+
+	return RTLIB_OK;
+}
+
 
 /*******************************************************************************
  * Runtime profiling - OpenCL
@@ -474,6 +539,10 @@ ApplicationProxy::SyncP_PreChangeSend(pcmdSn_t pcs) {
 
 	// Sending message on the application connection context
 	pcon = (*it).second;
+#ifdef CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+	// Published once committed, i.e., at PostChange time
+	SyncP_PreChangeStage(pcon, papp, syncp_prechange_msg, local_sys_msg);
+#endif
 	result = rpc->SendMessage(pcon->pd, &syncp_prechange_msg.hdr,
 			(size_t)RPC_PKT_SIZE(BBQ_SYNCP_PRECHANGE));
 	if (result == -1) {
@@ -496,6 +565,47 @@ ApplicationProxy::SyncP_PreChangeSend(pcmdSn_t pcs) {
 	return RTLIB_OK;
 }
 
+#ifdef CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+
+void ApplicationProxy::SyncP_PreChangeStage(
+		pconCtx_t pcon,
+		AppPtr_t papp,
+		bl::rpc_msg_BBQ_SYNCP_PRECHANGE_t const & msg,
+		bl::rpc_msg_BBQ_SYNCP_PRECHANGE_SYSTEM_t const & sys_msg) {
+	std::unique_lock<std::mutex> shm_ul(pcon->shm_mtx);
+	if (!pcon->shm_alloc)
+		return;
+	bl::rpc_shm_alloc_exc_t & slot(pcon->shm_pending[papp->ExcId()]);
+
+	slot = bl::rpc_shm_alloc_exc_t();
+	slot.exc_id = papp->ExcId();
+	if (papp->Blocking()) {
+		slot.awm_id = -1;
+		slot.nr_sys = 0;
+		return;
+	}
+
+	slot.awm_id = msg.awm;
+	slot.nr_sys = 1;
+	slot.systems[0].sys_id   = sys_msg.sys_id;
+	slot.systems[0].nr_cpus  = sys_msg.nr_cpus;
+	slot.systems[0].nr_procs = sys_msg.nr_procs;
+	slot.systems[0].r_proc   = sys_msg.r_proc;
+	slot.systems[0].r_mem    = sys_msg.r_mem;
+#ifdef CONFIG_BBQUE_CGROUPS_DISTRIBUTED_ACTUATION
+	slot.cpu_ids = msg.cpu_ids;
+	slot.cpu_ids_isolation = msg.cpu_ids_isolation;
+	slot.mem_ids = msg.mem_ids;
+#else
+	slot.cpu_ids = papp->NextAWM()->BindingSet(
+		br::ResourceType::PROC_ELEMENT).ToULong();
+	slot.mem_ids = papp->NextAWM()->BindingSet(
+		br::ResourceType::MEMORY).ToULong();
+#endif // CONFIG_BBQUE_CGROUPS_DISTRIBUTED_ACTUATION
+}
+
+#endif // CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+
 RTLIB_ExitCode_t
 ApplicationProxy::SyncP_PreChangeRecv(pcmdSn_t pcs,
 		pPreChangeRsp_t presp) {
@@ -951,6 +1061,46 @@ ApplicationProxy::SyncP_PostChangeSend(pcmdSn_t pcs) {
 	return RTLIB_OK;
 }
 
+#ifdef CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+
+void ApplicationProxy::SyncP_PostChangePublish(AppPtr_t papp) {
+	std::unique_lock<std::mutex> conCtxMap_ul(conCtxMap_mtx);
+	auto it = conCtxMap.find(papp->Pid());
+	if (it == conCtxMap.end())
+		return;
+	pconCtx_t pcon = it->second;
+	conCtxMap_ul.unlock();
+
+	SyncP_PostChangePublish(pcon, papp);
+}
+
+void ApplicationProxy::SyncP_PostChangePublish(pconCtx_t pcon, AppPtr_t papp) {
+	std::unique_lock<std::mutex> shm_ul(pcon->shm_mtx);
+	auto pending_it = pcon->shm_pending.find(papp->ExcId());
+	if (!pcon->shm_alloc || (pending_it == pcon->shm_pending.end()))
+		return;
+	bl::rpc_shm_alloc_exc_t const & pending(pending_it->second);
+	bl::rpc_shm_alloc_exc_t * slot =
+		bl::RpcShmAllocSlot(pcon->shm_alloc, papp->ExcId());
+
+	bl::RpcShmAllocWriteBegin(slot);
+	++slot->generation;
+	slot->exc_id  = pending.exc_id;
+	slot->awm_id  = pending.awm_id;
+	slot->nr_sys  = pending.nr_sys;
+	slot->cpu_ids = pending.cpu_ids;
+	slot->cpu_ids_isolation = pending.cpu_ids_isolation;
+	slot->mem_ids = pending.mem_ids;
+	::memcpy(slot->systems, pending.systems, sizeof(slot->systems));
+	bl::RpcShmAllocWriteEnd(slot);
+	pcon->shm_pending.erase(pending_it);
+
+	logger->Debug("APPs PRX: [%s] assignment published, generation=%u",
+			papp->StrId(), slot->generation);
+}
+
+#endif // CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+
 RTLIB_ExitCode_t
 ApplicationProxy::SyncP_PostChangeRecv(pcmdSn_t pcs,
 		pPostChangeRsp_t presp) {
@@ -1234,6 +1384,11 @@ void ApplicationProxy::RpcExcUnregister(prqsSn_t prqs) {
 	// FIXME we should deliver the error code to the application
 	// This is tracked by Issues tiket #10
 
+#ifdef CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+	// Release the EXC slot of the shared memory page
+	ShmAllocClear(pcon, pmsg_hdr->exc_id);
+#endif
+
 	// Sending ACK response to application
 	RpcACK(pcon, pmsg_hdr, bl::RPC_EXC_RESP);
 
@@ -1331,7 +1486,8 @@ void ApplicationProxy::RpcExcRuntimeProfileNotify(prqsSn_t prqs) {
 			"[app: %s, pid: %d, exc: %d]",
 			pcon->app_name, pcon->app_pid, pmsg_hdr->exc_id);
 	result = am.SetRuntimeProfile(pcon->app_pid, pmsg_hdr->exc_id,
-				pmsg_pyl->gap, pmsg_pyl->cusage, pmsg_pyl->ctime_ms);
+				pmsg_pyl->gap, pmsg_pyl->cusage, pmsg_pyl->ctime_ms,
+				pmsg_pyl->llc_mpkc, pmsg_pyl->mem_bw_mbps);
 
 	switch (result) {
 		case ApplicationManager::AM_SUCCESS:
@@ -1507,6 +1663,11 @@ void ApplicationProxy::RpcAppPair(prqsSn_t prqs) {
 		return;
 	}
 
+#ifdef CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+	// The page must exist before the application gets the ACK
+	ShmAllocSetup(pcon);
+#endif
+
 	// Backup communication context for further messages
 	conCtxMap_ul.lock();
 	conCtxMap.insert(std::pair<pid_t, pconCtx_t>(
@@ -1535,6 +1696,9 @@ void ApplicationProxy::RpcAppExit(prqsSn_t prqs) {
 	// Cleanup communication channel resources
 	pconCtx = (*conCtxIt).second;
 	rpc->ReleasePluginData(pconCtx->pd);
+#ifdef CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+	ShmAllocRelease(pconCtx);
+#endif
 
 	// Removing the connection context
 	conCtxMap.erase(conCtxIt);
@@ -1545,6 +1709,90 @@ void ApplicationProxy::RpcAppExit(prqsSn_t prqs) {
 
 }
 
+#ifdef CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+
+void ApplicationProxy::ShmAllocSetup(pconCtx_t pcon) {
+	char shm_name[RPC_SHM_ALLOC_NAME_LENGTH];
+	snprintf(shm_name, RPC_SHM_ALLOC_NAME_LENGTH,
+			RPC_SHM_ALLOC_NAME_FMT, pcon->app_pid);
+
+	// Readable by the application, writable only by the daemon
+	int fd = ::shm_open(shm_name, O_CREAT | O_RDWR | O_TRUNC, 0644);
+	if (fd < 0) {
+		logger->Warn("APPs PRX: [%s] shared memory creation FAILED",
+				shm_name);
+		return;
+	}
+	if (::ftruncate(fd, sizeof(bl::rpc_shm_alloc_t)) != 0) {
+		logger->Warn("APPs PRX: [%s] shared memory sizing FAILED",
+				shm_name);
+		::close(fd);
+		::shm_unlink(shm_name);
+		return;
+	}
+
+	void * addr = ::mmap(nullptr, sizeof(bl::rpc_shm_alloc_t),
+			PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (addr == MAP_FAILED) {
+		logger->Warn("APPs PRX: [%s] shared memory mapping FAILED",
+				shm_name);
+		::shm_unlink(shm_name);
+		return;
+	}
+
+	pcon->shm_alloc = static_cast<bl::rpc_shm_alloc_t *>(addr);
+	for (auto & slot: pcon->shm_alloc->excs)
+		slot.exc_id = -1;
+	__atomic_store_n(&pcon->shm_alloc->magic, RPC_SHM_ALLOC_MAGIC,
+			__ATOMIC_RELEASE);
+	logger->Debug("APPs PRX: [%s] shared memory ready", shm_name);
+}
+
+void ApplicationProxy::ShmAllocRelease(pconCtx_t pcon) {
+	std::unique_lock<std::mutex> shm_ul(pcon->shm_mtx);
+	pcon->shm_pending.clear();
+	if (!pcon->shm_alloc)
+		return;
+	char shm_name[RPC_SHM_ALLOC_NAME_LENGTH];
+	snprintf(shm_name, RPC_SHM_ALLOC_NAME_LENGTH,
+			RPC_SHM_ALLOC_NAME_FMT, pcon->app_pid);
+
+	::munmap(pcon->shm_alloc, sizeof(bl::rpc_shm_alloc_t));
+	::shm_unlink(shm_name);
+	pcon->shm_alloc = nullptr;
+	logger->Debug("APPs PRX: [%s] shared memory removed", shm_name);
+}
+
+void ApplicationProxy::ShmAllocClear(pconCtx_t pcon, uint8_t exc_id) {
+	std::unique_lock<std::mutex> shm_ul(pcon->shm_mtx);
+	pcon->shm_pending.erase(exc_id);
+	if (!pcon->shm_alloc)
+		return;
+	bl::rpc_shm_alloc_exc_t * slot =
+		bl::RpcShmAllocSlot(pcon->shm_alloc, exc_id);
+	bl::RpcShmAllocWriteBegin(slot);
+	if (slot->exc_id == exc_id)
+		slot->exc_id = -1;
+	bl::RpcShmAllocWriteEnd(slot);
+}
+
+void ApplicationProxy::ShmAllocCleanup(AppPtr_t papp, bool dead) {
+	std::unique_lock<std::mutex> conCtxMap_ul(conCtxMap_mtx);
+	auto it = conCtxMap.find(papp->Pid());
+	if (it == conCtxMap.end())
+		return;
+	pconCtx_t pcon = it->second;
+	conCtxMap_ul.unlock();
+
+	ShmAllocClear(pcon, papp->ExcId());
+	// A dead application will never send the exit message
+	if (dead)
+		ShmAllocRelease(pcon);
+}
+
+#endif // CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+
 void ApplicationProxy::RequestExecutor(prqsSn_t prqs) {
 	std::unique_lock<std::mutex> snCtxMap_ul(snCtxMap_mtx);
 	snCtxMap_t::iterator it;
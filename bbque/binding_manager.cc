@@ -18,8 +18,12 @@
 
 #include "bbque/binding_manager.h"
 #include "bbque/configuration_manager.h"
+#include "bbque/platform_manager.h"
 #include "bbque/res/resource_path.h"
 
+#include <algorithm>
+#include <vector>
+
 #define MODULE_NAMESPACE   "bq.bdm"
 #define MODULE_CONFIG      "BindingManager"
 
@@ -91,9 +95,60 @@ void BindingManager::InitBindingOptions() {
 }
 
 
+void BindingManager::LoadDistances() {
+#ifdef CONFIG_BBQUE_PIL_TOPOLOGY_DISCOVERY
+	pp::PlatformDescription::System const & local_sys(
+		PlatformManager::GetPlatformDescription().GetLocalSystem());
+	pe_distances  = local_sys.GetPEDistances();
+	mem_distances = local_sys.GetMemoryDistances();
+	if (HasTopology())
+		logger->Info("Topology: distances of %d PEs and %d memory nodes",
+				pe_distances.Size(), mem_distances.Size());
+#endif
+}
+
+
+uint16_t BindingManager::GetDistance(
+		br::ResourceType r_type,
+		BBQUE_RID_TYPE id_a,
+		BBQUE_RID_TYPE id_b) const {
+	switch (r_type) {
+	case br::ResourceType::PROC_ELEMENT:
+		return pe_distances.Get(id_a, id_b);
+	case br::ResourceType::CPU:
+	case br::ResourceType::MEMORY:
+		return mem_distances.Get(id_a, id_b);
+	default:
+		return (id_a == id_b) ? 0 : BBQUE_PP_DISTANCE_UNKNOWN;
+	}
+}
+
+
+br::ResourceBitset BindingManager::GetClosest(
+		br::ResourceType r_type,
+		BBQUE_RID_TYPE ref_id,
+		br::ResourceBitset const & candidates,
+		size_t count) const {
+	br::ResourceBitset selected;
+	if (candidates.None())
+		return selected;
+
+	std::vector<std::pair<uint16_t, BBQUE_RID_TYPE>> by_distance;
+	for (BBQUE_RID_TYPE id = candidates.FirstSet();
+			id >= 0; id = candidates.NextSet(id))
+		by_distance.emplace_back(GetDistance(r_type, ref_id, id), id);
+	std::sort(by_distance.begin(), by_distance.end());
+
+	for (size_t i = 0; (i < count) && (i < by_distance.size()); ++i)
+		selected.Set(by_distance[i].second);
+	return selected;
+}
+
+
 BindingManager::ExitCode_t BindingManager::LoadBindingOptions() {
 
 	InitBindingOptions();
+	LoadDistances();
 	if (binding_options.empty()) {
 		logger->Fatal("Missing binding domains");
 		return ERR_MISSING_OPTIONS;
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bbque/interference_model.h"
+
+#include "bbque/configuration_manager.h"
+
+#include <algorithm>
+
+#define MODULE_CONFIG "InterferenceModel"
+
+namespace po = boost::program_options;
+
+namespace bbque {
+
+
+InterferenceModel & InterferenceModel::GetInstance() {
+	static InterferenceModel instance;
+	return instance;
+}
+
+InterferenceModel::InterferenceModel() {
+	logger = bu::Logger::GetLogger(INTERFERENCE_MODEL_NAMESPACE);
+	assert(logger);
+
+	ConfigurationManager & cm(ConfigurationManager::GetInstance());
+	po::options_description opts_desc("Interference model options");
+	opts_desc.add_options()
+		(MODULE_CONFIG ".llc_mpkc_high",
+		 po::value<float>(&llc_mpkc_high)->default_value(BBQUE_IM_LLC_MPKC_HIGH),
+		 "The LLC misses per kilo-cycle of a memory-bound AWM")
+		(MODULE_CONFIG ".mem_bw_high_mbps",
+		 po::value<uint32_t>(&mem_bw_high_mbps)->default_value(
+			 BBQUE_IM_MEM_BW_HIGH_MBPS),
+		 "The memory bandwidth [MB/s] of a memory-bound AWM")
+		(MODULE_CONFIG ".min_samples",
+		 po::value<uint16_t>(&min_samples)->default_value(BBQUE_IM_MIN_SAMPLES),
+		 "The number of samples before a profile is trusted");
+	po::variables_map opts_vm;
+	cm.ParseConfigurationFile(opts_desc, opts_vm);
+	if (llc_mpkc_high <= 0)
+		llc_mpkc_high = BBQUE_IM_LLC_MPKC_HIGH;
+	if (mem_bw_high_mbps == 0)
+		mem_bw_high_mbps = BBQUE_IM_MEM_BW_HIGH_MBPS;
+}
+
+void InterferenceModel::AddSample(
+		ba::AppSPtr_t papp,
+		int8_t awm_id,
+		float llc_mpkc,
+		uint32_t mem_bw_mbps) {
+	std::unique_lock<std::mutex> profiles_ul(profiles_mtx);
+	Profile_t & profile(profiles[std::make_pair(papp->RecipeName(), awm_id)]);
+
+	// The first samples are averaged, the following ones smoothed
+	float weight = std::max<float>(1.0 / (profile.count + 1),
+		BBQUE_IM_EWMA_WEIGHT);
+	profile.llc_mpkc    += weight * (llc_mpkc - profile.llc_mpkc);
+	profile.mem_bw_mbps += weight * (mem_bw_mbps - profile.mem_bw_mbps);
+	if (profile.count < UINT32_MAX)
+		++profile.count;
+
+	logger->Debug("AddSample: [%s] AWM %d llc=%.2f[MPKC] bw=%u[MB/s] "
+		"(avg: llc=%.2f, bw=%.0f, count=%d)", papp->StrId(), awm_id,
+		llc_mpkc, mem_bw_mbps,
+		profile.llc_mpkc, profile.mem_bw_mbps, profile.count);
+}
+
+bool InterferenceModel::GetProfile(
+		ba::AppSPtr_t papp,
+		int8_t awm_id,
+		Profile_t & profile) {
+	std::unique_lock<std::mutex> profiles_ul(profiles_mtx);
+	auto prof_it = profiles.find(std::make_pair(papp->RecipeName(), awm_id));
+	if ((prof_it == profiles.end()) || (prof_it->second.count < min_samples))
+		return false;
+	profile = prof_it->second;
+	return true;
+}
+
+float InterferenceModel::GetPressure(ba::AppSPtr_t papp, int8_t awm_id) {
+	Profile_t profile;
+	if (!GetProfile(papp, awm_id, profile))
+		return -1.0;
+	float pressure = std::max<float>(
+		profile.llc_mpkc / llc_mpkc_high,
+		profile.mem_bw_mbps / mem_bw_high_mbps);
+	return std::min<float>(pressure, 1.0);
+}
+
+} // namespace bbque
@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bbque/overcommit_model.h"
+
+#include "bbque/configuration_manager.h"
+#include "bbque/resource_accounter.h"
+#include "bbque/resource_manager.h"
+#include "bbque/app/application.h"
+#include "bbque/app/working_mode.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+
+#define MODULE_CONFIG "OvercommitModel"
+
+namespace po = boost::program_options;
+
+namespace bbque {
+
+
+OvercommitModel & OvercommitModel::GetInstance() {
+	static OvercommitModel instance;
+	return instance;
+}
+
+OvercommitModel::OvercommitModel() {
+	std::string opt_ratios;
+
+	logger = bu::Logger::GetLogger(OVERCOMMIT_MODEL_NAMESPACE);
+	assert(logger);
+
+	ConfigurationManager & cm(ConfigurationManager::GetInstance());
+	po::options_description opts_desc("Overcommit model options");
+	opts_desc.add_options()
+		(MODULE_CONFIG ".ratios",
+		 po::value<std::string>(&opt_ratios)->default_value("1"),
+		 "The CPU bandwidth overcommit ratio of each priority class "
+		 "(comma separated)")
+		(MODULE_CONFIG ".usage_margin_pct",
+		 po::value<uint16_t>(&usage_margin_pct)->default_value(
+			 BBQUE_OM_USAGE_MARGIN_PCT),
+		 "The margin [%] added to the measured usage")
+		(MODULE_CONFIG ".reclaim_threshold_pct",
+		 po::value<uint16_t>(&reclaim_threshold_pct)->default_value(
+			 BBQUE_OM_RECLAIM_THRESHOLD_PCT),
+		 "The measured load [%] of a processing element triggering a reclaim")
+		(MODULE_CONFIG ".reclaim_period_ms",
+		 po::value<uint32_t>(&reclaim_period_ms)->default_value(
+			 BBQUE_OM_RECLAIM_PERIOD_MS),
+		 "The minimum time [ms] between two reclaims");
+	po::variables_map opts_vm;
+	cm.ParseConfigurationFile(opts_desc, opts_vm);
+
+	// Overcommit ratio per priority class (strict if lower than one)
+	std::istringstream ratios_iss(opt_ratios);
+	std::string ratio_str;
+	while (std::getline(ratios_iss, ratio_str, ',')) {
+		float ratio = std::strtof(ratio_str.c_str(), nullptr);
+		ratios.push_back(std::max<float>(ratio, 1.0));
+		enabled |= (ratios.back() > 1.0);
+	}
+	if (reclaim_threshold_pct == 0)
+		reclaim_threshold_pct = BBQUE_OM_RECLAIM_THRESHOLD_PCT;
+
+	if (enabled)
+		logger->Info("CPU bandwidth overcommit ratios: [%s]",
+			opt_ratios.c_str());
+}
+
+float OvercommitModel::GetRatio(ba::AppPrio_t prio) const {
+	if (ratios.empty())
+		return 1.0;
+	return ratios[std::min<size_t>(prio, ratios.size() - 1)];
+}
+
+float OvercommitModel::GetUsageRatio(AppUid_t app_uid) {
+	std::unique_lock<std::mutex> usage_ul(usage_mtx);
+	auto usage_it = usage_ratios.find(app_uid);
+	if (usage_it == usage_ratios.end())
+		return 1.0;
+	return usage_it->second;
+}
+
+float OvercommitModel::GetChargeRatio(ba::AppSPtr_t const & papp) {
+	float ratio = GetRatio(papp->Priority());
+	if (ratio <= 1.0)
+		return 1.0;
+	return std::max<float>(1.0 / ratio, GetUsageRatio(papp->Uid()));
+}
+
+uint64_t OvercommitModel::GetCharge(
+		br::ResourcePtr_t const & rsrc,
+		ba::AppSPtr_t const & papp,
+		uint64_t amount,
+		br::RViewToken_t status_view) {
+	if (!enabled || !papp ||
+			(rsrc->Type() != br::ResourceType::PROC_ELEMENT))
+		return amount;
+	uint64_t charge = std::ceil(amount * GetChargeRatio(papp));
+
+	// The usage may have been updated since the availability check
+	uint64_t available = rsrc->Available(papp, status_view);
+	if ((charge > available) && (amount <= Available(rsrc, papp, status_view)))
+		return available;
+	return charge;
+}
+
+uint64_t OvercommitModel::Available(
+		br::ResourcePtr_t const & rsrc,
+		ba::AppSPtr_t const & papp,
+		br::RViewToken_t status_view) {
+	uint64_t available = rsrc->Available(papp, status_view);
+	if (!enabled || !papp ||
+			(rsrc->Type() != br::ResourceType::PROC_ELEMENT))
+		return available;
+
+	// From the amount not charged yet, to the amount that can be booked
+	uint64_t bookable = static_cast<double>(available) / GetChargeRatio(papp);
+	return std::min(bookable, rsrc->Unreserved());
+}
+
+uint64_t OvercommitModel::GetGuaranteed(
+		ba::AppSPtr_t const & papp,
+		uint64_t amount) const {
+	return amount / GetRatio(papp->Priority());
+}
+
+void OvercommitModel::AddSample(ba::AppSPtr_t papp, uint32_t cpu_usage) {
+	ResourceAccounter & ra(ResourceAccounter::GetInstance());
+	if (!enabled)
+		return;
+
+	// The CPU bandwidth booked in the current AWM
+	ba::AwmPtr_t const & awm(papp->CurrentAWM());
+	if (!awm || !awm->GetResourceBinding())
+		return;
+	uint64_t booked = ra.GetAssignedAmount(
+		awm->GetResourceBinding(), br::ResourceType::PROC_ELEMENT);
+	if (booked == 0)
+		return;
+	float sample = std::min<float>(
+		(cpu_usage + (booked * usage_margin_pct) / 100.0) / booked, 1.0);
+
+	// Higher samples are taken immediately, lower ones smoothed
+	std::unique_lock<std::mutex> usage_ul(usage_mtx);
+	auto usage_it = usage_ratios.find(papp->Uid());
+	if ((usage_it == usage_ratios.end()) || (sample >= usage_it->second))
+		usage_ratios[papp->Uid()] = sample;
+	else
+		usage_it->second += BBQUE_OM_EWMA_WEIGHT * (sample - usage_it->second);
+	logger->Debug("AddSample: [%s] usage=%u%% booked=%lu%% ratio=%.2f",
+		papp->StrId(), cpu_usage, booked, usage_ratios[papp->Uid()]);
+	usage_ul.unlock();
+
+	CheckReclaim(papp);
+}
+
+void OvercommitModel::Remove(ba::AppSPtr_t papp) {
+	std::unique_lock<std::mutex> usage_ul(usage_mtx);
+	usage_ratios.erase(papp->Uid());
+}
+
+void OvercommitModel::CheckReclaim(ba::AppSPtr_t const & papp) {
+	ba::AwmPtr_t const & awm(papp->CurrentAWM());
+	if (!awm || !awm->GetResourceBinding())
+		return;
+
+	for (auto const & ru_entry: *(awm->GetResourceBinding())) {
+		if (ru_entry.first->Type() != br::ResourceType::PROC_ELEMENT)
+			continue;
+
+		for (br::ResourcePtr_t const & rsrc:
+				ru_entry.second->GetResourcesList()) {
+			// Not oversubscribed
+			if (rsrc->Used() <= rsrc->Unreserved())
+				continue;
+
+			// Measured load of the EXCs holding the processing element
+			br::AppUsageQtyMap_t apps_map;
+			rsrc->Applications(apps_map);
+			double load = 0;
+			for (auto const & app_entry: apps_map)
+				load += app_entry.second * GetUsageRatio(app_entry.first);
+			if (load * 100 < rsrc->Unreserved() * reclaim_threshold_pct)
+				continue;
+
+			std::unique_lock<std::mutex> usage_ul(usage_mtx);
+			if (reclaim_tmr.Running() &&
+					(reclaim_tmr.getElapsedTimeMs() < reclaim_period_ms))
+				return;
+			reclaim_tmr.start();
+			usage_ul.unlock();
+
+			logger->Notice("Reclaim: <%s> load=%.0f%% [booked=%lu%% | "
+				"total=%lu%%], rescheduling...", rsrc->Path().c_str(),
+				load, rsrc->Used(), rsrc->Unreserved());
+			ResourceManager::GetInstance().NotifyEvent(
+				ResourceManager::BBQ_OPTS);
+			return;
+		}
+	}
+}
+
+} // namespace bbque
@@ -350,16 +350,14 @@ PlatformManager::ExitCode_t PlatformManager::MapResources(
 	bool is_remote = false;
 
 	// Check if application is local or remote.
-	for (int i = 0; i < systems.Count(); i++) {
-		if (systems.Test(i)) {
-			logger->Debug("Mapping: Checking system %d...", i);
-			if (GetPlatformDescription().GetSystemsAll()[i].IsLocal() ) {
-				is_local  = true;
-				logger->Debug("Mapping: System %d is local", i);
-			} else {
-				is_remote = true;
-				logger->Debug("Mapping: System %d is remote", i);
-			}
+	for (int i = systems.FirstSet(); i >= 0; i = systems.NextSet(i)) {
+		logger->Debug("Mapping: Checking system %d...", i);
+		if (GetPlatformDescription().GetSystemsAll()[i].IsLocal() ) {
+			is_local  = true;
+			logger->Debug("Mapping: System %d is local", i);
+		} else {
+			is_remote = true;
+			logger->Debug("Mapping: System %d is remote", i);
 		}
 	}
 
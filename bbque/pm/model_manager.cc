@@ -15,14 +15,24 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <sstream>
+
+#include <boost/program_options/options_description.hpp>
+#include <boost/program_options/variables_map.hpp>
+
 #include "bbque/config.h"
+#include "bbque/configuration_manager.h"
 #include "bbque/pm/model_manager.h"
 #include "bbque/pm/models/model_arm_cortexa15.h"
+#include "bbque/pm/models/model_table.h"
 #ifdef CONFIG_TARGET_ODROID_XU
 #include "bbque/pm/models/system_model_odroid_xu3.h"
 #endif
 
 #define MODULE_MANAGER_NAMESPACE "bq.mm"
+#define MODULE_CONFIG "PowerManager"
+
+namespace po = boost::program_options;
 
 namespace bbque  { namespace pm {
 
@@ -41,6 +51,7 @@ ModelManager::ModelManager() {
 #ifdef CONFIG_TARGET_ARM_BIG_LITTLE
 	Register(ModelPtr_t(new ARM_CortexA15_Model()));
 #endif
+	LoadTableModels();
 
 #ifdef CONFIG_TARGET_ODROID_XU
 	system_model = std::make_shared<ODROID_XU3_SystemModel>();
@@ -55,13 +66,60 @@ ModelManager::~ModelManager() {
 	models.clear();
 }
 
+void ModelManager::LoadTableModels() {
+	ConfigurationManager & cfm(ConfigurationManager::GetInstance());
+	std::string tables, default_id;
+	double lambda;
+
+	po::options_description opts_desc("Power-thermal models options");
+	opts_desc.add_options()
+		(MODULE_CONFIG ".models.tables",
+		 po::value<std::string>(&tables)->default_value(""),
+		 "Comma separated list of the power-thermal table files")
+		(MODULE_CONFIG ".models.default",
+		 po::value<std::string>(&default_id)->default_value(""),
+		 "The model of the resources without a specific one")
+		(MODULE_CONFIG ".models.forgetting",
+		 po::value<double>(&lambda)->default_value(
+			 BBQUE_MODEL_TABLE_FORGETTING),
+		 "Forgetting factor of the models online calibration");
+	po::variables_map opts_vm;
+	cfm.ParseConfigurationFile(opts_desc, opts_vm);
+
+	std::istringstream iss(tables);
+	std::string filepath;
+	while (std::getline(iss, filepath, ',')) {
+		if (filepath.empty())
+			continue;
+		ModelPtr_t model(TableModel::Load(filepath, lambda));
+		if (model == nullptr) {
+			logger->Error("Table model '%s': missing or malformed file",
+					filepath.c_str());
+			continue;
+		}
+		Register(model);
+	}
+
+	if (default_id.empty())
+		return;
+	auto it = models.find(default_id);
+	if (it == models.end()) {
+		logger->Warn("Default model '%s' not registered", default_id.c_str());
+		return;
+	}
+	default_model = it->second;
+	logger->Info("Default model is '%s'", default_id.c_str());
+}
+
 ModelPtr_t ModelManager::GetModel(std::string const & id) {
-	if (models[id] == nullptr) {
+	// Look up only, since the samplers may call this concurrently
+	auto it = models.find(id);
+	if ((it == models.end()) || (it->second == nullptr)) {
 		logger->Debug("Model '%s' missing. Using default model (%s)",
 				id.c_str(), default_model->GetID().c_str());
 		return default_model;
 	}
-	return models[id];
+	return it->second;
 }
 
 void ModelManager::Register(ModelPtr_t model) {
@@ -76,6 +76,17 @@ uint32_t Model::GetResourceFromPower(
 	return total_amount;
 }
 
+void Model::AddSample(
+		uint32_t freq_khz,
+		uint32_t load,
+		uint32_t temp_mc,
+		uint32_t power_mw) {
+	(void) freq_khz;
+	(void) load;
+	(void) temp_mc;
+	(void) power_mw;
+}
+
 } // namespace pm
 
 } // namespace bbque
@@ -0,0 +1,340 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bbque/pm/models/model_table.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+/** Initial covariance of the power model calibration */
+#define TABLE_POWER_RLS_DELTA    1.0
+/** Initial covariance of the thermal model calibration */
+#define TABLE_THERMAL_RLS_DELTA  1.0
+/** Minimum gain of the calibrated power model, to be inverted */
+#define TABLE_POWER_GAIN_MIN     0.1
+
+namespace bbque  { namespace pm {
+
+
+std::shared_ptr<TableModel> TableModel::Load(
+		std::string const & filepath,
+		double lambda) {
+	std::ifstream table_file(filepath);
+	if (!table_file.is_open())
+		return nullptr;
+
+	// Default identifier: the file name, without extension
+	std::string id(filepath.substr(filepath.find_last_of('/') + 1));
+	id = id.substr(0, id.find_last_of('.'));
+	uint32_t tpd = 0;
+
+	// Measurements: frequency -> load -> (power sum, count)
+	std::map<uint32_t, std::map<double, std::pair<double, uint32_t>>> points;
+	std::vector<double> temps, powers;
+	double power_max = 0.0;
+
+	std::string line;
+	while (std::getline(table_file, line)) {
+		line = line.substr(0, line.find('#'));
+		std::istringstream iss(line);
+		std::string key;
+		if (!(iss >> key))
+			continue;
+
+		if (key == "id") {
+			std::getline(iss >> std::ws, id);
+			continue;
+		}
+		if (key == "tpd") {
+			if (!(iss >> tpd))
+				return nullptr;
+			continue;
+		}
+
+		// Measurement: frequency [KHz], load [%], temperature [C], power [mW]
+		uint32_t freq_khz;
+		double load, temp, power;
+		std::istringstream iss_data(line);
+		if (!(iss_data >> freq_khz >> load >> temp >> power))
+			return nullptr;
+		power /= 1e3;
+		auto & point(points[freq_khz][std::min(std::max(load, 0.0), 100.0)]);
+		point.first  += power;
+		point.second += 1;
+		temps.push_back(temp);
+		powers.push_back(power);
+		power_max = std::max(power_max, power);
+	}
+
+	if (points.empty())
+		return nullptr;
+	if (tpd == 0)
+		tpd = power_max * 1e3;
+
+	std::shared_ptr<TableModel> model(new TableModel(id, tpd, lambda));
+
+	// Power lookup tables, averaging the measurements of the same point
+	for (auto const & freq_entry: points) {
+		std::vector<double> loads, freq_powers;
+		for (auto const & load_entry: freq_entry.second) {
+			loads.push_back(load_entry.first);
+			freq_powers.push_back(
+				load_entry.second.first / load_entry.second.second);
+		}
+		model->AddFrequency(freq_entry.first, loads, freq_powers);
+	}
+	model->last_freq_idx = model->tables.size() - 1;
+
+	// Thermal model: least squares fitting of T = T_amb + R_th * P
+	double mean_p = 0.0, mean_t = 0.0;
+	for (size_t i = 0; i < powers.size(); ++i) {
+		mean_p += powers[i];
+		mean_t += temps[i];
+	}
+	mean_p /= powers.size();
+	mean_t /= powers.size();
+
+	double cov_pt = 0.0, var_p = 0.0;
+	for (size_t i = 0; i < powers.size(); ++i) {
+		cov_pt += (powers[i] - mean_p) * (temps[i] - mean_t);
+		var_p  += (powers[i] - mean_p) * (powers[i] - mean_p);
+	}
+	double r_th = (var_p > 0.0) ? cov_pt / var_p : 0.0;
+	model->thermal_rls.Reset({{ mean_t - r_th * mean_p, r_th }});
+
+	return model;
+}
+
+TableModel::TableModel(std::string const & id, uint32_t tpd, double lambda):
+	Model(id, tpd),
+	power_rls({{ 0.0, 1.0, 0.0 }}, lambda, TABLE_POWER_RLS_DELTA),
+	thermal_rls({{ 0.0, 0.0 }}, lambda, TABLE_THERMAL_RLS_DELTA),
+	last_freq_idx(0) {
+}
+
+void TableModel::AddFrequency(
+		uint32_t freq_khz,
+		std::vector<double> const & loads,
+		std::vector<double> const & powers) {
+	FrequencyTable table;
+	size_t n = loads.size();
+	table.freq_khz = freq_khz;
+
+	// The power does not decrease with the load (measurement noise)
+	std::vector<double> p(powers);
+	for (size_t k = 1; k < n; ++k)
+		p[k] = std::max(p[k], p[k-1]);
+
+	// Monotone cubic interpolation (Fritsch-Carlson): secants and slopes
+	std::vector<double> h(n), d(n), m(n, 0.0);
+	for (size_t k = 0; k + 1 < n; ++k) {
+		h[k] = loads[k+1] - loads[k];
+		d[k] = (p[k+1] - p[k]) / h[k];
+	}
+	if (n > 1) {
+		m[0]   = d[0];
+		m[n-1] = d[n-2];
+	}
+	for (size_t k = 1; k + 1 < n; ++k) {
+		if (d[k-1] * d[k] <= 0.0)
+			continue;
+		double w1 = 2 * h[k] + h[k-1];
+		double w2 = h[k] + 2 * h[k-1];
+		m[k] = (w1 + w2) / (w1 / d[k-1] + w2 / d[k]);
+	}
+
+	// Power lookup table, constant outside the measured load range
+	size_t k = 0;
+	for (size_t l = 0; l < BBQUE_MODEL_TABLE_LOAD_STEPS; ++l) {
+		double x = l;
+		if (x <= loads.front()) {
+			table.power[l] = p.front();
+			continue;
+		}
+		if (x >= loads.back()) {
+			table.power[l] = p.back();
+			continue;
+		}
+		while (loads[k+1] < x)
+			++k;
+		double t  = (x - loads[k]) / h[k];
+		double t2 = t * t;
+		double t3 = t2 * t;
+		table.power[l] =
+			(2*t3 - 3*t2 + 1) * p[k] + (t3 - 2*t2 + t) * h[k] * m[k] +
+			(-2*t3 + 3*t2) * p[k+1] + (t3 - t2) * h[k] * m[k+1];
+	}
+
+	// Load lookup table: the highest load not exceeding each power step
+	table.power_min  = table.power.front();
+	table.power_step = (table.power.back() - table.power.front()) /
+		(BBQUE_MODEL_TABLE_POWER_STEPS - 1);
+	size_t l = 0;
+	for (size_t j = 0; j < BBQUE_MODEL_TABLE_POWER_STEPS; ++j) {
+		if (table.power_step <= 0.0) {
+			table.load[j] = 100.0;
+			continue;
+		}
+		double target = table.power_min + j * table.power_step;
+		while ((l + 1 < BBQUE_MODEL_TABLE_LOAD_STEPS) &&
+				(table.power[l+1] <= target))
+			++l;
+		if (l + 1 == BBQUE_MODEL_TABLE_LOAD_STEPS) {
+			table.load[j] = l;
+			continue;
+		}
+		double delta = table.power[l+1] - table.power[l];
+		table.load[j] = l + ((delta > 0.0) ?
+			std::min((target - table.power[l]) / delta, 1.0) : 0.0);
+	}
+
+	tables.push_back(table);
+}
+
+TableModel::FrequencyTable const & TableModel::GetTable(
+		std::string const & freq_governor) {
+	// Lowest frequency for "powersave", the last sampled for "userspace"
+	// and the highest one (worst case) for the others
+	if (freq_governor.compare(0, 3, "pow") == 0)
+		return tables.front();
+	if (freq_governor.compare(0, 3, "use") == 0) {
+		std::unique_lock<std::mutex> calib_ul(calib_mtx);
+		return tables[last_freq_idx];
+	}
+	return tables.back();
+}
+
+size_t TableModel::GetTableIndex(uint32_t freq_khz) const {
+	auto it = std::lower_bound(tables.begin(), tables.end(), freq_khz,
+		[](FrequencyTable const & table, uint32_t freq) {
+			return table.freq_khz < freq;
+		});
+	if (it == tables.end())
+		return tables.size() - 1;
+	if ((it != tables.begin()) &&
+			(freq_khz - (it - 1)->freq_khz < it->freq_khz - freq_khz))
+		--it;
+	return it - tables.begin();
+}
+
+double TableModel::TablePower(FrequencyTable const & table, double load) {
+	load = std::min(std::max(load, 0.0), 100.0);
+	size_t l = load;
+	if (l + 1 >= BBQUE_MODEL_TABLE_LOAD_STEPS)
+		return table.power.back();
+	double frac = load - l;
+	return table.power[l] + frac * (table.power[l+1] - table.power[l]);
+}
+
+double TableModel::TableLoad(FrequencyTable const & table, double power) {
+	if (power < table.power_min)
+		return 0.0;
+	if (table.power_step <= 0.0)
+		return 100.0;
+	double pos = (power - table.power_min) / table.power_step;
+	size_t j = pos;
+	if (j + 1 >= BBQUE_MODEL_TABLE_POWER_STEPS)
+		return table.load.back();
+	double frac = pos - j;
+	return table.load[j] + frac * (table.load[j+1] - table.load[j]);
+}
+
+uint32_t TableModel::GetPowerFromTemperature(
+		uint32_t temp_mc,
+		std::string const & freq_governor) {
+	(void) freq_governor;
+	std::unique_lock<std::mutex> calib_ul(calib_mtx);
+	auto const thermal(thermal_rls.Parameters());
+	calib_ul.unlock();
+
+	// The power leading to the given steady-state temperature
+	if (thermal[1] <= 0.0)
+		return tpd;
+	double power = (temp_mc / 1e3 - thermal[0]) / thermal[1];
+	return std::min<double>(std::max(power * 1e3, 0.0), tpd);
+}
+
+uint32_t TableModel::GetPowerFromSystemBudget(
+		uint32_t power_mw,
+		std::string const & freq_governor) {
+	(void) freq_governor;
+	return std::min(power_mw, tpd);
+}
+
+uint32_t TableModel::GetTemperatureFromPower(
+		uint32_t power_mw,
+		std::string const & freq_governor) {
+	(void) freq_governor;
+	std::unique_lock<std::mutex> calib_ul(calib_mtx);
+	auto const thermal(thermal_rls.Parameters());
+	calib_ul.unlock();
+
+	double temp = thermal[0] + thermal[1] * power_mw / 1e3;
+	return std::max(temp * 1e3, 0.0);
+}
+
+float TableModel::GetResourcePercentageFromPower(
+		uint32_t power_mw,
+		std::string const & freq_governor) {
+	FrequencyTable const & table(GetTable(freq_governor));
+	std::unique_lock<std::mutex> calib_ul(calib_mtx);
+	auto const coeffs(power_rls.Parameters());
+	auto const thermal(thermal_rls.Parameters());
+	calib_ul.unlock();
+
+	// Steady-state temperature at the given power, to account for the
+	// leakage, and then the corresponding power of the table
+	double power = power_mw / 1e3;
+	double temp  = thermal[0] + thermal[1] * power;
+	if (coeffs[1] >= TABLE_POWER_GAIN_MIN)
+		power = (power - coeffs[0] - coeffs[2] * temp) / coeffs[1];
+
+	return TableLoad(table, power) / 100.0;
+}
+
+uint32_t TableModel::GetResourceFromPower(
+		uint32_t power_mw,
+		uint32_t total_amount,
+		std::string const & freq_governor) {
+	return GetResourcePercentageFromPower(power_mw, freq_governor) *
+		total_amount;
+}
+
+void TableModel::AddSample(
+		uint32_t freq_khz,
+		uint32_t load,
+		uint32_t temp_mc,
+		uint32_t power_mw) {
+	size_t freq_idx = GetTableIndex(freq_khz);
+	double table_power = TablePower(tables[freq_idx], load);
+	double power = power_mw / 1e3;
+	// Some sensors report the temperature in degrees
+	double temp  = (temp_mc > 1000) ? temp_mc / 1e3 : temp_mc;
+
+	std::unique_lock<std::mutex> calib_ul(calib_mtx);
+	power_rls.Update({{ 1.0, table_power, temp }}, power);
+	thermal_rls.Update({{ 1.0, power }}, temp);
+	last_freq_idx = freq_idx;
+	++samples_count;
+}
+
+} // namespace pm
+
+} // namespace bbque
@@ -62,6 +62,7 @@ PowerMonitor & PowerMonitor::GetInstance() {
 PowerMonitor::PowerMonitor():
 		Worker(),
 		pm(PowerManager::GetInstance()),
+		mm(bbque::pm::ModelManager::GetInstance()),
 #ifdef CONFIG_BBQUE_PM_BATTERY
 		bm(BatteryManager::GetInstance()),
 #endif
@@ -405,6 +406,8 @@ void  PowerMonitor::SampleResourcesStatus(
 				ExecuteTrigger(rsrc, info_type);
 			}
 
+			CalibrateModel(rsrc);
+
 			logger->Debug("[T%d] sampling <%s> ", thd_id, (log_i + i_values).c_str());
 			logger->Debug("[T%d] sampling <%s> ", thd_id, (log_m + m_values).c_str());
 			if (wm_info.log_enabled) {
@@ -419,6 +422,22 @@ void  PowerMonitor::SampleResourcesStatus(
 
 
 
+void PowerMonitor::CalibrateModel(br::ResourcePtr_t rsrc) {
+	// The calibration requires the power consumption
+	if (rsrc->GetPowerInfoSamplesWindowSize(PowerManager::InfoType::POWER) <= 0)
+		return;
+	uint32_t power = rsrc->GetPowerInfo(
+		PowerManager::InfoType::POWER, br::Resource::INSTANT);
+	if (power == 0)
+		return;
+
+	mm.GetModel(rsrc->Model())->AddSample(
+		rsrc->GetPowerInfo(PowerManager::InfoType::FREQUENCY, br::Resource::INSTANT),
+		rsrc->GetPowerInfo(PowerManager::InfoType::LOAD, br::Resource::INSTANT),
+		rsrc->GetPowerInfo(PowerManager::InfoType::TEMPERATURE, br::Resource::INSTANT),
+		power);
+}
+
 void PowerMonitor::BuildLogString(
 		br::ResourcePtr_t rsrc,
 		uint info_idx,
@@ -0,0 +1,324 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bbque/pp/cgroup_stats_collector.h"
+
+#include "bbque/application_manager.h"
+#include "bbque/modules_factory.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <libcgroup.h>
+#include <unistd.h>
+
+#define MODULE_NAMESPACE "bq.pp.linux_cgs"
+
+namespace bbque {
+namespace pp {
+
+/**
+ * The controller and the file names of each statistics file, in the legacy
+ * (v1) and in the unified (v2) hierarchy. An empty name means that the
+ * statistic is provided by another file.
+ */
+static struct {
+	char const * controller;
+	char const * v1_name;
+	char const * v2_name;
+} const stat_files[] = {
+	{ "cpuacct", "cpuacct.usage",                   ""               },
+	{ "cpu",     "cpu.stat",                        "cpu.stat"       },
+	{ "cpu",     "cpu.cfs_quota_us",                "cpu.max"        },
+	{ "cpu",     "cpu.cfs_period_us",               ""               },
+	{ "memory",  "memory.usage_in_bytes",           "memory.current" },
+	{ "memory",  "memory.stat",                     "memory.stat"    },
+	{ "blkio",   "blkio.throttle.io_service_bytes", "io.stat"        },
+};
+
+
+CGroupStatsCollector & CGroupStatsCollector::GetInstance() {
+	static CGroupStatsCollector instance;
+	return instance;
+}
+
+CGroupStatsCollector::CGroupStatsCollector() {
+	// Setup the worker thread (calling Task())
+	Worker::Setup(BBQUE_MODULE_NAME("pp.linux_cgs"), MODULE_NAMESPACE);
+}
+
+CGroupStatsCollector::~CGroupStatsCollector() {
+	std::unique_lock<std::mutex> excs_ul(excs_mtx);
+	for (auto & exc_entry: excs)
+		CloseFiles(exc_entry.second);
+	excs.clear();
+}
+
+void CGroupStatsCollector::SetPeriod(uint32_t period_ms) {
+	this->period_ms = (period_ms > 0) ? period_ms : BBQUE_LINUX_CG_STATS_PERIOD_MS;
+}
+
+void CGroupStatsCollector::Register(
+		ba::AppPtr_t papp,
+		std::string const & cgpath) {
+	std::unique_lock<std::mutex> excs_ul(excs_mtx);
+	if (excs.find(papp->Uid()) != excs.end())
+		return;
+
+	ExcStats_t & exc_stats(excs[papp->Uid()]);
+	exc_stats.papp   = papp;
+	exc_stats.cgpath = cgpath;
+	exc_stats.fds.fill(-1);
+	logger->Debug("CGroupStats: [%s] registered, cgroup [%s]",
+		papp->StrId(), cgpath.c_str());
+}
+
+void CGroupStatsCollector::Unregister(ba::AppPtr_t papp) {
+	std::unique_lock<std::mutex> excs_ul(excs_mtx);
+	auto exc_it = excs.find(papp->Uid());
+	if (exc_it == excs.end())
+		return;
+
+	CloseFiles(exc_it->second);
+	excs.erase(exc_it);
+	logger->Debug("CGroupStats: [%s] unregistered", papp->StrId());
+}
+
+void CGroupStatsCollector::InitMountPoints() {
+	// Mount points of the controllers (libcgroup already initialized)
+	for (int i = 0; i < STAT_FILES_COUNT; ++i) {
+		char * mount_path = nullptr;
+		if (cgroup_get_subsys_mount_point(
+					stat_files[i].controller, &mount_path) != 0) {
+			logger->Warn("CGroupStats: controller [%s] not mounted",
+				stat_files[i].controller);
+			continue;
+		}
+		mount_points[i] = mount_path;
+		free(mount_path);
+	}
+
+	// Unified hierarchy: all the controllers are mounted in the same place
+	std::string controllers_path(mount_points[CPU_STAT] + "/cgroup.controllers");
+	cgroup_v2 = (access(controllers_path.c_str(), F_OK) == 0);
+	if (cgroup_v2)
+		mount_points.fill(mount_points[CPU_STAT]);
+	logger->Info("CGroupStats: sampling control groups %s statistics",
+		cgroup_v2 ? "v2" : "v1");
+}
+
+bool CGroupStatsCollector::OpenFiles(ExcStats_t & exc_stats) {
+	bool available = false;
+
+	// The control group is created lazily by the platform proxy, thus the
+	// files are opened at the first sampling finding them
+	for (int i = 0; i < STAT_FILES_COUNT; ++i) {
+		char const * name = cgroup_v2 ?
+			stat_files[i].v2_name : stat_files[i].v1_name;
+		if ((exc_stats.fds[i] >= 0) || mount_points[i].empty() || !name[0])
+			continue;
+		std::string file_path(
+			mount_points[i] + "/" + exc_stats.cgpath + "/" + name);
+		exc_stats.fds[i] = ::open(file_path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (exc_stats.fds[i] < 0) {
+			logger->Debug("CGroupStats: [%s] cannot open [%s]",
+				exc_stats.papp->StrId(), file_path.c_str());
+			continue;
+		}
+		available = true;
+	}
+
+	exc_stats.opened = available;
+	return available;
+}
+
+void CGroupStatsCollector::CloseFiles(ExcStats_t & exc_stats) {
+	for (int & fd: exc_stats.fds) {
+		if (fd >= 0)
+			::close(fd);
+		fd = -1;
+	}
+	exc_stats.opened = false;
+}
+
+ssize_t CGroupStatsCollector::ReadFile(int fd) {
+	if (fd < 0)
+		return -1;
+
+	// The statistics are generated at each read from the beginning
+	ssize_t len = ::pread(fd, buff, sizeof(buff) - 1, 0);
+	buff[(len > 0) ? len : 0] = '\0';
+	return len;
+}
+
+bool CGroupStatsCollector::ParseKey(
+		char const * content,
+		char const * key,
+		uint64_t & value) {
+	size_t key_len = strlen(key);
+	char const * line = content;
+	while (line && *line) {
+		if ((strncmp(line, key, key_len) == 0) && (line[key_len] == ' ')) {
+			value = strtoull(line + key_len + 1, nullptr, 10);
+			return true;
+		}
+		line = strchr(line, '\n');
+		if (line)
+			++line;
+	}
+	return false;
+}
+
+void CGroupStatsCollector::ParseIO(
+		char const * content,
+		uint64_t & rbytes,
+		uint64_t & wbytes) {
+	rbytes = wbytes = 0;
+	char const * line = content;
+	while (line && *line) {
+		// Skip the device number
+		char const * field = strchr(line, ' ');
+		char const * line_end = strchr(line, '\n');
+		if (!field || (line_end && (field > line_end)))
+			field = nullptr;
+
+		while (field && (!line_end || (field < line_end))) {
+			++field;
+			if (cgroup_v2) {
+				// "<major>:<minor> rbytes=<n> wbytes=<n> rios=<n> ..."
+				if (strncmp(field, "rbytes=", 7) == 0)
+					rbytes += strtoull(field + 7, nullptr, 10);
+				else if (strncmp(field, "wbytes=", 7) == 0)
+					wbytes += strtoull(field + 7, nullptr, 10);
+			}
+			else {
+				// "<major>:<minor> Read|Write|Sync|Async|Total <n>"
+				if (strncmp(field, "Read ", 5) == 0)
+					rbytes += strtoull(field + 5, nullptr, 10);
+				else if (strncmp(field, "Write ", 6) == 0)
+					wbytes += strtoull(field + 6, nullptr, 10);
+				break;
+			}
+			field = strchr(field, ' ');
+		}
+
+		line = line_end ? line_end + 1 : nullptr;
+	}
+}
+
+void CGroupStatsCollector::Sample(
+		ExcStats_t & exc_stats,
+		std::chrono::steady_clock::time_point now) {
+	ba::ResourceUsage_t usage;
+	uint64_t value = 0, period = 0;
+
+	// CPU time and throttling
+	if (cgroup_v2) {
+		if (ReadFile(exc_stats.fds[CPU_STAT]) > 0) {
+			if (ParseKey(buff, "usage_usec", value))
+				usage.cpu_time_us = value;
+			if (ParseKey(buff, "throttled_usec", value))
+				usage.cpu_throttled_us = value;
+		}
+	}
+	else {
+		if (ReadFile(exc_stats.fds[CPU_USAGE]) > 0)
+			usage.cpu_time_us = strtoull(buff, nullptr, 10) / 1000;
+		if ((ReadFile(exc_stats.fds[CPU_STAT]) > 0) &&
+				ParseKey(buff, "throttled_time", value))
+			usage.cpu_throttled_us = value / 1000;
+	}
+
+	// CPU bandwidth quota: "<quota|max> <period>" (v2) or two files (v1)
+	if (ReadFile(exc_stats.fds[CPU_QUOTA]) > 0) {
+		char * next = nullptr;
+		int64_t quota = strtoll(buff, &next, 10);
+		if (cgroup_v2)
+			period = (next != buff) ? strtoull(next, nullptr, 10) : 0;
+		else if (ReadFile(exc_stats.fds[CPU_PERIOD]) > 0)
+			period = strtoull(buff, nullptr, 10);
+		if ((quota > 0) && (period > 0))
+			usage.cpu_quota = (100 * quota) / period;
+	}
+
+	// Memory
+	if (ReadFile(exc_stats.fds[MEM_CURRENT]) > 0)
+		usage.mem_current = strtoull(buff, nullptr, 10);
+	if (ReadFile(exc_stats.fds[MEM_STAT]) > 0) {
+		if (ParseKey(buff, cgroup_v2 ? "anon" : "rss", value))
+			usage.mem_anon = value;
+	}
+
+	// Block I/O
+	if (ReadFile(exc_stats.fds[IO_STAT]) > 0)
+		ParseIO(buff, usage.io_read_bytes, usage.io_write_bytes);
+
+	// Rates, from the previous sampling
+	ba::ResourceUsage_t const & prev(exc_stats.usage);
+	uint64_t elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(
+		now - exc_stats.last_sample).count();
+	if (prev.is_valid && (elapsed_us > 0)) {
+		if (usage.cpu_time_us >= prev.cpu_time_us)
+			usage.cpu_usage = (100 * (usage.cpu_time_us - prev.cpu_time_us))
+				/ elapsed_us;
+		if (usage.io_read_bytes >= prev.io_read_bytes)
+			usage.io_read_bps = (1000000 *
+				(usage.io_read_bytes - prev.io_read_bytes)) / elapsed_us;
+		if (usage.io_write_bytes >= prev.io_write_bytes)
+			usage.io_write_bps = (1000000 *
+				(usage.io_write_bytes - prev.io_write_bytes)) / elapsed_us;
+	}
+	usage.is_valid = true;
+
+	exc_stats.usage       = usage;
+	exc_stats.last_sample = now;
+	logger->Debug("CGroupStats: [%s] cpu=%u%% (quota=%u%%) mem=%lu "
+		"io_r=%lu[B/s] io_w=%lu[B/s]",
+		exc_stats.papp->StrId(), usage.cpu_usage, usage.cpu_quota,
+		usage.mem_current, usage.io_read_bps, usage.io_write_bps);
+}
+
+void CGroupStatsCollector::Task() {
+	ApplicationManager & am(ApplicationManager::GetInstance());
+	InitMountPoints();
+	logger->Info("CGroupStats: sampling period = %d[ms]", period_ms);
+
+	while (!done) {
+		std::unique_lock<std::mutex> excs_ul(excs_mtx);
+		auto now = std::chrono::steady_clock::now();
+		for (auto & exc_entry: excs) {
+			ExcStats_t & exc_stats(exc_entry.second);
+			if (!exc_stats.opened && !OpenFiles(exc_stats))
+				continue;
+			Sample(exc_stats, now);
+			am.SetResourceUsage(exc_stats.papp, exc_stats.usage);
+		}
+		excs_ul.unlock();
+
+		std::unique_lock<std::mutex> worker_status_ul(worker_status_mtx);
+		if (done)
+			break;
+		worker_status_cv.wait_for(worker_status_ul,
+			std::chrono::milliseconds(period_ms));
+	}
+
+	logger->Info("CGroupStats: sampling terminated");
+}
+
+} // namespace pp
+
+} // namespace bbque
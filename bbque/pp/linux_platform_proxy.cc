@@ -1,5 +1,6 @@
 #include "bbque/config.h"
 
+#include "bbque/overcommit_model.h"
 #include "bbque/power_monitor.h"
 #include "bbque/pp/linux_platform_proxy.h"
 #include "bbque/res/binder.h"
@@ -41,6 +42,7 @@
 #define BBQUE_LINUXPP_CPUS_PARAM 		"cpuset.cpus"
 #define BBQUE_LINUXPP_CPUP_PARAM 		"cpu.cfs_period_us"
 #define BBQUE_LINUXPP_CPUQ_PARAM 		"cpu.cfs_quota_us"
+#define BBQUE_LINUXPP_CPUS_SHARES_PARAM 	"cpu.shares"
 #define BBQUE_LINUXPP_MEMN_PARAM 		"cpuset.mems"
 #define BBQUE_LINUXPP_MEMB_PARAM 		"memory.limit_in_bytes"
 #define BBQUE_LINUXPP_CPU_EXCLUSIVE_PARAM 	"cpuset.cpu_exclusive"
@@ -53,6 +55,9 @@
 // The default CFS bandwidth period [us]
 #define BBQUE_LINUXPP_CPUP_DEFAULT		100000
 #define BBQUE_LINUXPP_CPUP_MAX			1000000
+// The CFS shares of a fully used CPU, and the minimum ones
+#define BBQUE_LINUXPP_CPUS_SHARES_CPU		1024
+#define BBQUE_LINUXPP_CPUS_SHARES_MIN		2
 
 // Checking for kernel version requirements
 
@@ -89,6 +94,10 @@ LinuxPlatformProxy::LinuxPlatformProxy() :
 	,
 	proc_listener(ProcessListener::GetInstance())
 #endif
+#ifdef CONFIG_BBQUE_LINUX_CG_STATS
+	,
+	cg_stats(CGroupStatsCollector::GetInstance())
+#endif
 {
 
 	//---------- Get a logger module
@@ -114,10 +123,19 @@ LinuxPlatformProxy::LinuxPlatformProxy() :
 	InitNetworkManagement();
 #endif
 
+#ifdef CONFIG_BBQUE_LINUX_RESCTRL
+	InitResctrl();
+#endif
+
 #ifdef CONFIG_BBQUE_LINUX_PROC_LISTENER
 	proc_listener.Start();
 #endif
 
+#ifdef CONFIG_BBQUE_LINUX_CG_STATS
+	cg_stats.SetPeriod(cg_stats_period_ms);
+	cg_stats.Start();
+#endif
+
 }
 
 LinuxPlatformProxy::~LinuxPlatformProxy() {
@@ -367,6 +385,12 @@ LinuxPlatformProxy::ExitCode_t LinuxPlatformProxy::Setup(AppPtr_t papp) noexcept
 	// Setup the kernel CGroup with an empty resources assignement
 	SetupCGroup(pcgd, prlb, false, false);
 
+#ifdef CONFIG_BBQUE_LINUX_CG_STATS
+	// Account the resource usage of the application
+	if (pcgd)
+		cg_stats.Register(papp, pcgd->cgpath);
+#endif
+
 	// Reclaim application resource, thus moving this app into the silos
 	result = this->ReclaimResources(papp);
 	if (unlikely(result != PLATFORM_OK)) {
@@ -389,6 +413,20 @@ void LinuxPlatformProxy::LoadConfiguration() noexcept {
 		(MODULE_CONFIG ".cfs_bandwidth.threshold_pct",
 		po::value<int> (&cfs_threshold_pct)->default_value(100),
 		"The threshold [%] under which we enable CFS bandwidth enforcement");
+#ifdef CONFIG_BBQUE_LINUX_CG_STATS
+	opts_desc.add_options()
+		(MODULE_CONFIG ".usage_stats.period_ms",
+		po::value<int> (&cg_stats_period_ms)->default_value(
+			BBQUE_LINUX_CG_STATS_PERIOD_MS),
+		"The sampling period [ms] of the EXCs resource usage statistics");
+#endif
+#ifdef CONFIG_BBQUE_LINUX_RESCTRL
+	opts_desc.add_options()
+		(MODULE_CONFIG ".resctrl.root",
+		po::value<std::string> (&resctrl_root)->default_value(
+			BBQUE_RESCTRL_ROOT),
+		"The mount point of the resctrl filesystem");
+#endif
 	po::variables_map opts_vm;
 	ConfigurationManager::GetInstance().
 	ParseConfigurationFile(opts_desc, opts_vm);
@@ -408,6 +446,14 @@ void LinuxPlatformProxy::LoadConfiguration() noexcept {
 
 LinuxPlatformProxy::ExitCode_t
 LinuxPlatformProxy::Release(AppPtr_t papp) noexcept {
+#ifdef CONFIG_BBQUE_LINUX_CG_STATS
+	// Stop the usage accounting before removing the control group
+	cg_stats.Unregister(papp);
+#endif
+#ifdef CONFIG_BBQUE_LINUX_RESCTRL
+	if (resctrl)
+		resctrl->RemoveGroup(ResctrlGroupName(papp));
+#endif
 	// Release CGroup plugin data
 	// ... thus releasing the corresponding control group
 	papp->ClearPluginData(LINUX_PP_NAMESPACE);
@@ -424,6 +470,12 @@ LinuxPlatformProxy::ReclaimResources(AppPtr_t papp) noexcept {
 
 	logger->Debug("PLAT LNX: CGroup resource claiming START");
 
+#ifdef CONFIG_BBQUE_LINUX_RESCTRL
+	// Back to the cache ways and bandwidth shared by all
+	if (resctrl)
+		resctrl->RemoveGroup(ResctrlGroupName(papp));
+#endif
+
 	// Move this app into "silos" CGroup
 	cgroup_set_value_uint64(psilos->pc_cpuset,
 	BBQUE_LINUXPP_PROCS_PARAM,
@@ -475,9 +527,8 @@ LinuxPlatformProxy::MapResources(AppPtr_t papp, ResourceAssignmentMapPtr_t pres,
 	// Map resources for each node (e.g., CPU)
 	RLinuxBindingsPtr_t prlb = std::make_shared<RLinuxBindings_t>
 	(MaxCpusCount, MaxMemsCount);
-	for (; node_id <= nodes.LastSet(); ++node_id) {
+	for (; node_id >= 0; node_id = nodes.NextSet(node_id)) {
 		logger->Debug("PLAT LNX: CGroup resource mapping node [%d]", node_id);
-		if (!nodes.Test(node_id)) continue;
 
 		// Node resource mapping
 		result = GetResourceMapping(papp, pres, prlb, node_id, rvt);
@@ -503,6 +554,14 @@ LinuxPlatformProxy::MapResources(AppPtr_t papp, ResourceAssignmentMapPtr_t pres,
 
 #endif
 
+#ifdef CONFIG_BBQUE_LINUX_RESCTRL
+	result = SetResctrlGroup(papp, pres);
+	if (PLATFORM_OK != result) {
+		logger->Warn("Unable to enforce cache/memory bandwidth partitioning"
+			     " [%d], ignoring...", result);
+	}
+#endif
+
 	logger->Debug("PLAT LNX: CGroup resource mapping DONE!");
 
 #ifdef CONFIG_BBQUE_CGROUPS_DISTRIBUTED_ACTUATION
@@ -529,11 +588,7 @@ LinuxPlatformProxy::MapResources(AppPtr_t papp, ResourceAssignmentMapPtr_t pres,
 	proc_elements_exclusive.Reset();
 
 	for (BBQUE_RID_TYPE pe_id = proc_elements.FirstSet();
-		 pe_id <= proc_elements.LastSet(); pe_id++) {
-
-		// Skip if this processing element is not allocated to this app
-		if (! proc_elements.Test(pe_id))
-			continue;
+		 pe_id >= 0; pe_id = proc_elements.NextSet(pe_id)) {
 
 		// Getting a reference to the resource status
 		std::string path = "sys.cpu.pe" + std::to_string(pe_id);
@@ -596,10 +651,9 @@ LinuxPlatformProxy::SetCGNetworkBandwidth(AppPtr_t papp, CGroupDataPtr_t pcgd,
 		return PLATFORM_MAPPING_FAILED;
 	}
 
-	for (; interface_id <= net_ifs.LastSet(); ++interface_id) {
+	for (; interface_id >= 0; interface_id = net_ifs.NextSet(interface_id)) {
 		logger->Debug("PLAT LNX: CGroup resource mapping interface [%d]",
 				interface_id);
-		if (!net_ifs.Test(interface_id)) continue;
 
 		logger->Debug("PLAT LNX: CLASS handle %d, bandwith %d, interface : %d",
 				papp->Pid(), prlb->amount_net_bw, interface_id);
@@ -671,6 +725,18 @@ LinuxPlatformProxy::GetResourceMapping(
 		br::ResourceBinder::GetMask(assign_map,
 		br::ResourceType::PROC_ELEMENT,
 		br::ResourceType::MEMORY, node_id, papp, rvt));
+#ifdef CONFIG_BBQUE_PIL_TOPOLOGY_DISCOVERY
+	// No memory assigned: the nodes local to the assigned cores
+	if ((mem_ids.Count() == 0) && !core_ids.None() &&
+			!local_memory_ids.empty()) {
+		for (BBQUE_RID_TYPE core_id = core_ids.FirstSet();
+				core_id >= 0; core_id = core_ids.NextSet(core_id)) {
+			auto mem_it = local_memory_ids.find(core_id);
+			if (mem_it != local_memory_ids.end())
+				mem_ids.Set(mem_it->second);
+		}
+	}
+#endif
 	if (mem_ids.Count() == 0)
 		strncpy(prlb->mems, memory_ids_all.c_str(), memory_ids_all.length());
 	else
@@ -756,6 +822,17 @@ LinuxPlatformProxy::ScanPlatformDescription() noexcept {
 				logger->Fatal("Register CPU %d failed", cpu.GetId());
 				return result;
 			}
+#ifdef CONFIG_BBQUE_LINUX_RESCTRL
+			if (sys.IsLocal() && resctrl)
+				this->RegisterResctrl(cpu);
+#endif
+#ifdef CONFIG_BBQUE_PIL_TOPOLOGY_DISCOVERY
+			if (sys.IsLocal() && !sys.GetPEDistances().Empty() &&
+					cpu.GetMemory()) {
+				for (const auto & pe : cpu.GetProcessingElementsAll())
+					local_memory_ids[pe.GetId()] = cpu.GetMemory()->GetId();
+			}
+#endif
 		}
 		logger->Debug("[%s@%s] Scanning the memories...",
 				sys.GetHostname().c_str(), sys.GetNetAddress().c_str());
@@ -819,6 +896,105 @@ LinuxPlatformProxy::RegisterCPU(const PlatformDescription::CPU &cpu) noexcept {
 	return PLATFORM_OK;
 }
 
+#ifdef CONFIG_BBQUE_LINUX_RESCTRL
+
+void LinuxPlatformProxy::InitResctrl() noexcept {
+	resctrl = std::unique_ptr<Resctrl>(new Resctrl(resctrl_root));
+	if (!resctrl->Scan()) {
+		logger->Warn("resctrl: cache/memory bandwidth allocation not "
+			"available in <%s>", resctrl_root.c_str());
+		resctrl.reset();
+		return;
+	}
+	logger->Info("resctrl: <%s> cache domains=%d (ways=%d), "
+		"memory bandwidth domains=%d, groups=%d",
+		resctrl_root.c_str(),
+		resctrl->GetCacheDomains().size(), resctrl->GetCacheWays(),
+		resctrl->GetMemBWDomains().size(), resctrl->GetMaxGroups());
+}
+
+LinuxPlatformProxy::ExitCode_t
+LinuxPlatformProxy::RegisterResctrl(const PlatformDescription::CPU &cpu) noexcept {
+	ResourceAccounter &ra(ResourceAccounter::GetInstance());
+
+	// A domain for each socket, registered under its first CPU
+	uint16_t domain_id = cpu.GetSocketId();
+	auto domain_it = resctrl_domains.emplace(domain_id, cpu.GetPath()).first;
+	if (domain_it->second != cpu.GetPath())
+		return PLATFORM_OK;
+
+	std::vector<std::pair<std::string, uint64_t>> resources;
+	if (resctrl->GetCacheDomains().count(domain_id))
+		resources.emplace_back(
+			cpu.GetPath() + ".cache" + std::to_string(domain_id),
+			resctrl->GetCacheWays());
+	if (resctrl->GetMemBWDomains().count(domain_id))
+		resources.emplace_back(
+			cpu.GetPath() + ".membw" + std::to_string(domain_id), 100);
+
+	for (auto const & resource: resources) {
+		logger->Debug("Registration of <%s>: %d",
+			resource.first.c_str(), resource.second);
+		if (refreshMode)
+			ra.UpdateResource(resource.first, "", resource.second);
+		else
+			ra.RegisterResource(resource.first, "", resource.second);
+	}
+
+	return PLATFORM_OK;
+}
+
+std::string LinuxPlatformProxy::ResctrlGroupName(AppPtr_t papp) {
+	return "bbque_" + std::to_string(papp->Pid()) +
+		"_" + std::to_string(papp->ExcId());
+}
+
+LinuxPlatformProxy::ExitCode_t
+LinuxPlatformProxy::SetResctrlGroup(
+		AppPtr_t papp,
+		ResourceAssignmentMapPtr_t pres) noexcept {
+	ResourceAccounter &ra(ResourceAccounter::GetInstance());
+	if (!resctrl)
+		return PLATFORM_OK;
+
+	// Cache ways and memory bandwidth assigned in each domain
+	Resctrl::Allocation_t alloc;
+	bool partitioned = false;
+	for (uint16_t domain_id: resctrl->GetCacheDomains()) {
+		alloc.cache_ways[domain_id] = ra.GetAssignedAmount(
+			pres, br::ResourceType::CACHE,
+			br::ResourceType::CACHE, domain_id);
+		partitioned |= (alloc.cache_ways[domain_id] > 0);
+	}
+	for (uint16_t domain_id: resctrl->GetMemBWDomains()) {
+		alloc.mem_bw_pct[domain_id] = ra.GetAssignedAmount(
+			pres, br::ResourceType::MEMORY_BW,
+			br::ResourceType::MEMORY_BW, domain_id);
+		partitioned |= (alloc.mem_bw_pct[domain_id] > 0);
+	}
+
+	std::string group_name(ResctrlGroupName(papp));
+	if (!partitioned) {
+		resctrl->RemoveGroup(group_name);
+		return PLATFORM_OK;
+	}
+
+	if (!resctrl->SetupGroup(group_name, alloc, papp->Pid())) {
+		logger->Error("PLAT LNX: [%s] resctrl group <%s> setup FAILED",
+			papp->StrId(), group_name.c_str());
+		return PLATFORM_MAPPING_FAILED;
+	}
+	for (uint16_t domain_id: resctrl->GetCacheDomains())
+		logger->Debug("PLAT LNX: [%s] resctrl domain %d: ways=0x%lx bw=%d%%",
+			papp->StrId(), domain_id,
+			resctrl->GetCacheMask(group_name, domain_id),
+			alloc.mem_bw_pct[domain_id]);
+
+	return PLATFORM_OK;
+}
+
+#endif // CONFIG_BBQUE_LINUX_RESCTRL
+
 LinuxPlatformProxy::ExitCode_t
 LinuxPlatformProxy::RegisterMEM(const PlatformDescription::Memory &mem) noexcept {
 	ResourceAccounter &ra(ResourceAccounter::GetInstance());
@@ -1266,6 +1442,20 @@ LinuxPlatformProxy::SetupCGroup(
 					pcgd->papp->StrId(),
 					cfs_c);
 		}
+
+		// Oversubscription: under contention, the CPU time is shared
+		// according to the amount guaranteed to each EXC
+		OvercommitModel & om(OvercommitModel::GetInstance());
+		if (om.Enabled() && (prlb->amount_cpus > 0)) {
+			uint64_t cpus_shares = std::max<uint64_t>(
+				(BBQUE_LINUXPP_CPUS_SHARES_CPU *
+				 om.GetGuaranteed(pcgd->papp, prlb->amount_cpus)) / 100,
+				BBQUE_LINUXPP_CPUS_SHARES_MIN);
+			cgroup_set_value_uint64(pcgd->pc_cpu,
+				BBQUE_LINUXPP_CPUS_SHARES_PARAM, cpus_shares);
+			logger->Debug("PLAT LNX: Setup CPU for [%s]: {shares [%lu]}",
+					pcgd->papp->StrId(), cpus_shares);
+		}
 	} else {
 		logger->Warn("Unable to enforce CFS quota (not supported by the kernel).");
 	}
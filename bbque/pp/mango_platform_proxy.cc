@@ -508,9 +508,8 @@ MangoPlatformProxy::MangoPartitionSkimmer::Skim(const TaskGraph &tg,
 							std::list<Partition>&part_list) noexcept {
 	hn_st_request_t req;
 	hn_st_response_t res[MANGO_BASE_NUM_PARTITIONS];
-	uint32_t ids[MANGO_BASE_NUM_PARTITIONS];		// TODO multiple partition
-	uint32_t num_parts = 1;					// TODO multiple partition;
-	uint32_t part_id;
+	uint32_t ids[MANGO_BASE_NUM_PARTITIONS];
+	uint32_t num_parts = 0;
 
 	bbque_assert(part_list.empty());
 
@@ -535,14 +534,13 @@ MangoPlatformProxy::MangoPartitionSkimmer::Skim(const TaskGraph &tg,
 	}
 
 	int err;
-	// TODO: Change to multiple-partitions version of this function
-	if ( (err = hn_find_partitions(req, res, &part_id, 1, &num_parts)) ) {
+	// Enumerate several candidate partitions, the policy selects the best one
+	err = hn_find_partitions(req, res, ids, MANGO_BASE_NUM_PARTITIONS, &num_parts);
+	if (err) {
 		logger->Error("hn_find_partitions FAILED with error %d", err);
 		return SK_GENERIC_ERROR;
 	}
 
-	ids[0] = part_id;	// Just an hack for the single find_partition version
-
 	logger->Debug("Found %d partitions", num_parts);
 
 	// No feasible partition found
@@ -575,6 +573,15 @@ MangoPlatformProxy::MangoPartitionSkimmer::SetPartition(const TaskGraph &tg,
 		task.second->SetMappedProcessor( partition.GetUnit(task.second) );
 	}
 
+#ifdef CONFIG_BBQUE_MANGO_HN_SIM
+	// The simulated HN library reserves the resources of the partition only
+	// once allocated
+	if (HN_SUCCEEDED != hn_allocate_partition(partition.GetId())) {
+		logger->Error("Unable to allocate partition [id=%d]", partition.GetId());
+		return SK_GENERIC_ERROR;
+	}
+#endif
+
 	// TODO: with the find_partitions we should allocate the selected partition, but
 	//	 unfortunately this is not currently supported by HN library
 /*	uint32_t part_id = partition.GetId();
@@ -210,12 +210,31 @@ RemotePlatformProxy::SendScheduleRequest(
 		std::string const & system_path,
 		agent::ApplicationScheduleRequest const & request) {
 	if (agent_proxy == nullptr) {
-		logger->Error("SendDisjoinRequest failed. AgentProxy plugin missing");
+		logger->Error("SendScheduleRequest failed. AgentProxy plugin missing");
 		return bbque::agent::ExitCode_t::PROXY_NOT_READY;
 	}
 	return agent_proxy->SendScheduleRequest(system_path, request);
 }
 
+bbque::agent::ExitCode_t
+RemotePlatformProxy::SendNodeStatus(
+		int system_id, agent::NodeStatus const & status) {
+	if (agent_proxy == nullptr) {
+		logger->Error("SendNodeStatus failed. AgentProxy plugin missing");
+		return bbque::agent::ExitCode_t::PROXY_NOT_READY;
+	}
+	return agent_proxy->SendNodeStatus(system_id, status);
+}
+
+void RemotePlatformProxy::GetNodesStatus(
+		std::map<int16_t, agent::NodeStatus> & nodes) {
+	if (agent_proxy == nullptr) {
+		logger->Error("GetNodesStatus failed. AgentProxy plugin missing");
+		return;
+	}
+	agent_proxy->GetNodesStatus(nodes);
+}
+
 } // namespace pp
 } // namespace bbque
 
@@ -0,0 +1,311 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bbque/pp/resctrl.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bbque {
+namespace pp {
+
+
+Resctrl::Resctrl(std::string const & root):
+	root(root) {
+}
+
+bool Resctrl::ReadLine(std::string const & path, std::string & line) const {
+	std::ifstream ifs(root + "/" + path);
+	if (!ifs.is_open())
+		return false;
+	return static_cast<bool>(std::getline(ifs, line));
+}
+
+bool Resctrl::Write(std::string const & path, std::string const & value,
+		bool append) const {
+	std::ofstream ofs(path, append ? std::ios::app : std::ios::trunc);
+	if (!ofs.is_open())
+		return false;
+	ofs << value;
+	ofs.close();
+	return !ofs.fail();
+}
+
+void Resctrl::ParseDomains(std::string const & line,
+		std::set<uint16_t> & domain_ids) {
+	size_t pos = line.find(':');
+	if (pos == std::string::npos)
+		return;
+	std::istringstream iss(line.substr(pos + 1));
+	std::string domain;
+	while (std::getline(iss, domain, ';')) {
+		char * next = nullptr;
+		long domain_id = strtol(domain.c_str(), &next, 10);
+		if ((next != domain.c_str()) && (*next == '=') && (domain_id >= 0))
+			domain_ids.insert(domain_id);
+	}
+}
+
+bool Resctrl::Scan() {
+	std::string line;
+	cache_domains.clear();
+	mem_bw_domains.clear();
+	num_closids = 0;
+
+	// Cache allocation capabilities
+	bool has_cat = ReadLine("info/L3/cbm_mask", line);
+	if (has_cat) {
+		cbm_mask = strtoull(line.c_str(), nullptr, 16);
+		if (ReadLine("info/L3/min_cbm_bits", line))
+			min_cbm_bits = std::max(atoi(line.c_str()), 1);
+		if (ReadLine("info/L3/num_closids", line))
+			num_closids = atoi(line.c_str());
+		has_cat = (cbm_mask != 0);
+	}
+
+	// Memory bandwidth allocation capabilities
+	bool has_mba = ReadLine("info/MB/min_bandwidth", line);
+	if (has_mba) {
+		min_bandwidth = std::max(atoi(line.c_str()), 1);
+		if (ReadLine("info/MB/bandwidth_gran", line))
+			bandwidth_gran = std::max(atoi(line.c_str()), 1);
+		if (ReadLine("info/MB/num_closids", line)) {
+			uint16_t mb_closids = atoi(line.c_str());
+			num_closids = (num_closids == 0) ?
+				mb_closids : std::min(num_closids, mb_closids);
+		}
+	}
+
+	// Domains, from the schemata of the default group
+	std::ifstream schemata(root + "/schemata");
+	while (std::getline(schemata, line)) {
+		line.erase(0, line.find_first_not_of(" \t"));
+		if (has_cat && (line.compare(0, 3, "L3:") == 0))
+			ParseDomains(line, cache_domains);
+		else if (has_mba && (line.compare(0, 3, "MB:") == 0))
+			ParseDomains(line, mem_bw_domains);
+	}
+
+	return (HasCacheAllocation() || HasMemBWAllocation()) &&
+		(GetMaxGroups() > 0);
+}
+
+uint16_t Resctrl::GetCacheWays() const {
+	return __builtin_popcountll(cbm_mask);
+}
+
+uint64_t Resctrl::FindWays(uint16_t domain_id, uint16_t ways) const {
+	if ((ways == 0) || (ways > GetCacheWays()))
+		return 0;
+	auto used_it = domains_used.find(domain_id);
+	uint64_t used = (used_it != domains_used.end()) ? used_it->second : 0;
+
+	// The lowest ways are always left to the default group
+	int bottom = __builtin_ctzll(cbm_mask);
+	used |= ((1ULL << min_cbm_bits) - 1) << bottom;
+
+	// Highest ways first
+	int top = 64 - __builtin_clzll(cbm_mask);
+	uint64_t run = (ways >= 64) ? ~0ULL : ((1ULL << ways) - 1);
+	for (int shift = top - ways; shift >= 0; --shift) {
+		uint64_t mask = run << shift;
+		if (((mask & cbm_mask) == mask) && ((mask & used) == 0))
+			return mask;
+	}
+	return 0;
+}
+
+void Resctrl::ReleaseWays(std::string const & name) {
+	auto group_it = groups_masks.find(name);
+	if (group_it == groups_masks.end())
+		return;
+	for (auto const & domain_mask: group_it->second)
+		domains_used[domain_mask.first] &= ~domain_mask.second;
+	groups_masks.erase(group_it);
+}
+
+uint64_t Resctrl::DefaultWays(uint16_t domain_id) const {
+	auto used_it = domains_used.find(domain_id);
+	uint64_t used = (used_it != domains_used.end()) ? used_it->second : 0;
+	uint64_t mask = 0;
+	for (int way = __builtin_ctzll(cbm_mask); way < 64; ++way) {
+		uint64_t bit = 1ULL << way;
+		if (!(cbm_mask & bit) || (used & bit))
+			break;
+		mask |= bit;
+	}
+	return mask;
+}
+
+bool Resctrl::UpdateDefaultGroup() const {
+	if (!HasCacheAllocation())
+		return true;
+	std::map<uint16_t, uint64_t> default_masks;
+	for (uint16_t domain_id: cache_domains)
+		default_masks[domain_id] = DefaultWays(domain_id);
+
+	// The groups share with the default group the domains not assigned:
+	// only these domains are updated in their schemata
+	bool result = true;
+	for (auto const & group: groups_masks) {
+		std::ostringstream schemata;
+		char const * sep = "";
+		for (auto const & domain_mask: default_masks) {
+			if (group.second.count(domain_mask.first) != 0)
+				continue;
+			schemata << sep << domain_mask.first << "=" << std::hex <<
+				domain_mask.second << std::dec;
+			sep = ";";
+		}
+		if (*sep != '\0')
+			result &= Write(root + "/" + group.first + "/schemata",
+				"L3:" + schemata.str() + "\n");
+	}
+
+	std::ostringstream schemata;
+	char const * sep = "";
+	schemata << "L3:";
+	for (auto const & domain_mask: default_masks) {
+		schemata << sep << domain_mask.first << "=" << std::hex <<
+			domain_mask.second << std::dec;
+		sep = ";";
+	}
+	schemata << "\n";
+	return Write(root + "/schemata", schemata.str()) && result;
+}
+
+bool Resctrl::MoveTasks(std::string const & group_dir, pid_t pid) const {
+	// A single thread for each write
+	std::string task_dir(
+		BBQUE_RESCTRL_PROC_ROOT "/" + std::to_string(pid) + "/task");
+	DIR * dir = opendir(task_dir.c_str());
+	if (dir == nullptr)
+		return Write(group_dir + "/tasks", std::to_string(pid) + "\n", true);
+
+	bool result = true;
+	struct dirent * entry;
+	while ((entry = readdir(dir)) != nullptr) {
+		if (entry->d_name[0] == '.')
+			continue;
+		result &= Write(group_dir + "/tasks",
+			std::string(entry->d_name) + "\n", true);
+	}
+	closedir(dir);
+	return result;
+}
+
+bool Resctrl::SetupGroup(std::string const & name, Allocation_t const & alloc,
+		pid_t pid) {
+	std::unique_lock<std::mutex> groups_ul(groups_mtx);
+	if ((groups_masks.find(name) == groups_masks.end()) &&
+			(groups_masks.size() >= GetMaxGroups()))
+		return false;
+	ReleaseWays(name);
+
+	// Cache ways
+	std::map<uint16_t, uint64_t> masks;
+	for (auto const & domain_ways: alloc.cache_ways) {
+		if ((domain_ways.second == 0) ||
+				(cache_domains.count(domain_ways.first) == 0))
+			continue;
+		uint64_t mask = FindWays(domain_ways.first,
+			std::max(domain_ways.second, min_cbm_bits));
+		if (mask == 0) {
+			for (auto const & domain_mask: masks)
+				domains_used[domain_mask.first] &= ~domain_mask.second;
+			return false;
+		}
+		masks[domain_ways.first] = mask;
+		domains_used[domain_ways.first] |= mask;
+	}
+
+	// Schemata: the domains not assigned are shared with the default group
+	std::ostringstream schemata;
+	char const * sep = "";
+	if (HasCacheAllocation()) {
+		schemata << "L3:";
+		for (uint16_t domain_id: cache_domains) {
+			auto mask_it = masks.find(domain_id);
+			schemata << sep << domain_id << "=" << std::hex <<
+				((mask_it != masks.end()) ?
+					mask_it->second : DefaultWays(domain_id)) <<
+				std::dec;
+			sep = ";";
+		}
+		schemata << "\n";
+	}
+	sep = "";
+	if (HasMemBWAllocation()) {
+		schemata << "MB:";
+		for (uint16_t domain_id: mem_bw_domains) {
+			auto pct_it = alloc.mem_bw_pct.find(domain_id);
+			uint16_t pct = 100;
+			if ((pct_it != alloc.mem_bw_pct.end()) && (pct_it->second > 0)) {
+				pct = ((pct_it->second + bandwidth_gran - 1) / bandwidth_gran) *
+					bandwidth_gran;
+				pct = std::min<uint16_t>(std::max(pct, min_bandwidth), 100);
+			}
+			schemata << sep << domain_id << "=" << pct;
+			sep = ";";
+		}
+		schemata << "\n";
+	}
+
+	std::string group_dir(root + "/" + name);
+	if (((mkdir(group_dir.c_str(), 0755) != 0) && (errno != EEXIST)) ||
+			!Write(group_dir + "/schemata", schemata.str()) ||
+			!MoveTasks(group_dir, pid)) {
+		for (auto const & domain_mask: masks)
+			domains_used[domain_mask.first] &= ~domain_mask.second;
+		return false;
+	}
+
+	groups_masks[name] = masks;
+	return UpdateDefaultGroup();
+}
+
+bool Resctrl::RemoveGroup(std::string const & name) {
+	std::unique_lock<std::mutex> groups_ul(groups_mtx);
+	ReleaseWays(name);
+
+	// The ways released are given back to the default group
+	std::string group_dir(root + "/" + name);
+	if ((rmdir(group_dir.c_str()) != 0) && (errno != ENOENT))
+		return false;
+	return UpdateDefaultGroup();
+}
+
+uint64_t Resctrl::GetCacheMask(std::string const & name,
+		uint16_t domain_id) const {
+	std::unique_lock<std::mutex> groups_ul(groups_mtx);
+	auto group_it = groups_masks.find(name);
+	if (group_it == groups_masks.end())
+		return 0;
+	auto mask_it = group_it->second.find(domain_id);
+	return (mask_it != group_it->second.end()) ? mask_it->second : 0;
+}
+
+} // namespace pp
+
+} // namespace bbque
@@ -0,0 +1,301 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bbque/pp/sysfs_topology.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+namespace bbque {
+namespace pp {
+
+typedef PlatformDescription PD;
+
+
+SysfsTopology::SysfsTopology(std::string const & root):
+	root(root) {
+}
+
+bool SysfsTopology::ParseList(std::string const & str, std::set<uint16_t> & ids) {
+	std::istringstream iss(str);
+	std::string range;
+	while (std::getline(iss, range, ',')) {
+		if (range.empty() || (range == "\n"))
+			continue;
+		char * next = nullptr;
+		long first = strtol(range.c_str(), &next, 10);
+		if ((next == range.c_str()) || (first < 0))
+			return false;
+		long last = first;
+		if (*next == '-') {
+			char const * last_str = next + 1;
+			last = strtol(last_str, &next, 10);
+			if ((next == last_str) || (last < first))
+				return false;
+		}
+		for (long id = first; id <= last; ++id)
+			ids.insert(id);
+	}
+	return true;
+}
+
+bool SysfsTopology::ReadLine(std::string const & path, std::string & line) const {
+	std::ifstream ifs(root + "/" + path);
+	if (!ifs.is_open())
+		return false;
+	return static_cast<bool>(std::getline(ifs, line));
+}
+
+bool SysfsTopology::Scan() {
+	pes.clear();
+	nodes_mem.clear();
+	if (!ScanCPUs())
+		return false;
+	ScanNodes();
+
+	// The remaining pairs: same node, or the distance of the nodes
+	for (auto const & pe_a: pes) {
+		for (auto const & pe_b: pes) {
+			if (pe_dist.Get(pe_a.first, pe_b.first) != BBQUE_PP_DISTANCE_UNKNOWN)
+				continue;
+			uint16_t node_a = pe_a.second.node_id;
+			uint16_t node_b = pe_b.second.node_id;
+			pe_dist.Set(pe_a.first, pe_b.first, (node_a == node_b) ?
+				PD::PE_DIST_NODE :
+				PD::PE_DIST_NODE + node_dist.Get(node_a, node_b));
+		}
+	}
+
+	return true;
+}
+
+bool SysfsTopology::ScanCPUs() {
+	std::string line;
+	std::set<uint16_t> pe_ids;
+	if (!ReadLine("cpu/online", line) || !ParseList(line, pe_ids) ||
+			pe_ids.empty())
+		return false;
+	pe_dist.Resize(*pe_ids.rbegin() + 1);
+
+	// Cache sharing sets, by cache level
+	std::set<std::pair<int, std::set<uint16_t>>> cache_sets;
+	int llc_level = 0;
+
+	for (uint16_t pe_id: pe_ids) {
+		std::string cpu_dir("cpu/cpu" + std::to_string(pe_id));
+		PEInfo_t & pe_info(pes[pe_id]);
+
+		if (ReadLine(cpu_dir + "/topology/core_id", line))
+			pe_info.core_id = std::max(atoi(line.c_str()), 0);
+		else
+			pe_info.core_id = pe_id;
+		// Some architectures do not report the package (-1)
+		if (ReadLine(cpu_dir + "/topology/physical_package_id", line))
+			pe_info.package_id = std::max(atoi(line.c_str()), 0);
+
+		// SMT siblings
+		std::set<uint16_t> siblings;
+		if (ReadLine(cpu_dir + "/topology/thread_siblings_list", line) &&
+				ParseList(line, siblings))
+			SetCloser(siblings, PD::PE_DIST_SMT);
+
+		// Caches
+		for (int index = 0; ; ++index) {
+			std::string cache_dir(
+				cpu_dir + "/cache/index" + std::to_string(index));
+			if (!ReadLine(cache_dir + "/level", line))
+				break;
+			int level = atoi(line.c_str());
+			std::set<uint16_t> shared;
+			if (!ReadLine(cache_dir + "/shared_cpu_list", line) ||
+					!ParseList(line, shared) || (shared.size() < 2))
+				continue;
+			cache_sets.emplace(level, shared);
+			llc_level = std::max(llc_level, level);
+		}
+	}
+
+	for (auto const & cache_set: cache_sets) {
+		SetCloser(cache_set.second, (cache_set.first == llc_level) ?
+			PD::PE_DIST_LLC : PD::PE_DIST_CACHE);
+	}
+
+	return true;
+}
+
+void SysfsTopology::ScanNodes() {
+	std::string line;
+	std::set<uint16_t> node_ids;
+	if (!ReadLine("node/online", line) || !ParseList(line, node_ids) ||
+			node_ids.empty()) {
+		// No NUMA support: a single node, of unknown memory size
+		node_dist.Resize(1);
+		nodes_mem[0] = 0;
+		return;
+	}
+	node_dist.Resize(*node_ids.rbegin() + 1);
+
+	for (uint16_t node_id: node_ids) {
+		std::string node_dir("node/node" + std::to_string(node_id));
+		nodes_mem[node_id] = 0;
+
+		// CPUs of the node
+		std::set<uint16_t> cpu_ids;
+		if (ReadLine(node_dir + "/cpulist", line) && ParseList(line, cpu_ids)) {
+			for (uint16_t pe_id: cpu_ids) {
+				auto pe_it = pes.find(pe_id);
+				if (pe_it != pes.end())
+					pe_it->second.node_id = node_id;
+			}
+		}
+
+		// Memory size: "Node <n> MemTotal: <size> kB"
+		std::ifstream meminfo(root + "/" + node_dir + "/meminfo");
+		while (std::getline(meminfo, line)) {
+			size_t pos = line.find("MemTotal:");
+			if (pos == std::string::npos)
+				continue;
+			nodes_mem[node_id] = strtoull(
+				line.c_str() + pos + 9, nullptr, 10) << 10;
+			break;
+		}
+
+		// Distances: one value for each online node, in order
+		for (uint16_t other_id: node_ids) {
+			if (other_id != node_id)
+				node_dist.Set(node_id, other_id,
+					BBQUE_SYSFS_TOPOLOGY_REMOTE_DISTANCE);
+		}
+		if (!ReadLine(node_dir + "/distance", line))
+			continue;
+		std::istringstream iss(line);
+		uint16_t distance;
+		for (uint16_t other_id: node_ids) {
+			if (!(iss >> distance))
+				break;
+			node_dist.Set(node_id, other_id, distance);
+		}
+	}
+}
+
+void SysfsTopology::SetCloser(std::set<uint16_t> const & pe_ids, uint16_t distance) {
+	for (uint16_t pe_a: pe_ids) {
+		if (pes.find(pe_a) == pes.end())
+			continue;
+		for (uint16_t pe_b: pe_ids) {
+			if ((pes.find(pe_b) == pes.end()) ||
+					(pe_dist.Get(pe_a, pe_b) <= distance))
+				continue;
+			pe_dist.Set(pe_a, pe_b, distance);
+		}
+	}
+}
+
+std::set<uint16_t> SysfsTopology::GetProcessingElements() const {
+	std::set<uint16_t> pe_ids;
+	for (auto const & pe_entry: pes)
+		pe_ids.insert(pe_entry.first);
+	return pe_ids;
+}
+
+std::set<uint16_t> SysfsTopology::GetNodes() const {
+	std::set<uint16_t> node_ids;
+	for (auto const & node_entry: nodes_mem)
+		node_ids.insert(node_entry.first);
+	return node_ids;
+}
+
+uint16_t SysfsTopology::GetNode(uint16_t pe_id) const {
+	auto pe_it = pes.find(pe_id);
+	return (pe_it != pes.end()) ? pe_it->second.node_id : 0;
+}
+
+uint16_t SysfsTopology::GetPEDistance(uint16_t pe_a, uint16_t pe_b) const {
+	return pe_dist.Get(pe_a, pe_b);
+}
+
+uint16_t SysfsTopology::GetNodeDistance(uint16_t node_a, uint16_t node_b) const {
+	return node_dist.Get(node_a, node_b);
+}
+
+void SysfsTopology::BuildSystem(PD::System & sys) const {
+	// Keep the partitioning of the processing elements already described
+	std::map<uint16_t, PD::ProcessingElement> described_pes;
+	std::string arch;
+	for (auto const & cpu: sys.GetCPUsAll()) {
+		if (arch.empty())
+			arch = cpu.GetArchitecture();
+		for (auto const & pe: cpu.GetProcessingElementsAll())
+			described_pes.emplace(pe.GetId(), pe);
+	}
+
+	// Memory nodes, unless the size is unknown (no NUMA support)
+	bool mem_known = true;
+	for (auto const & node_entry: nodes_mem)
+		mem_known &= (node_entry.second > 0);
+	if (mem_known) {
+		sys.GetMemoriesAll().clear();
+		for (auto const & node_entry: nodes_mem) {
+			auto mem = std::make_shared<PD::Memory>(
+				node_entry.first, node_entry.second);
+			mem->SetPrefix(sys.GetPath());
+			sys.AddMemory(mem);
+		}
+	}
+
+	// A CPU for each NUMA node including processing elements
+	sys.GetCPUsAll().clear();
+	for (auto const & node_entry: nodes_mem) {
+		PD::CPU cpu(node_entry.first);
+		cpu.SetPrefix(sys.GetPath());
+		cpu.SetArchitecture(arch);
+		cpu.SetMemory(sys.GetMemoryById(node_entry.first));
+		if (!cpu.GetMemory() && !sys.GetMemoriesAll().empty())
+			cpu.SetMemory(sys.GetMemoriesAll().front());
+
+		for (auto const & pe_entry: pes) {
+			PEInfo_t const & pe_info(pe_entry.second);
+			if (pe_info.node_id != node_entry.first)
+				continue;
+			if (cpu.GetProcessingElementsAll().empty())
+				cpu.SetSocketId(pe_info.package_id);
+
+			PD::ProcessingElement pe(
+				pe_entry.first, pe_info.core_id, 100, PD::SHARED);
+			auto described_it = described_pes.find(pe_entry.first);
+			if (described_it != described_pes.end()) {
+				pe.SetShare(described_it->second.GetShare());
+				pe.SetPartitionType(described_it->second.GetPartitionType());
+			}
+			pe.SetPrefix(cpu.GetPath());
+			cpu.AddProcessingElement(pe);
+		}
+
+		if (!cpu.GetProcessingElementsAll().empty())
+			sys.AddCPU(cpu);
+	}
+
+	sys.GetPEDistances()     = pe_dist;
+	sys.GetMemoryDistances() = node_dist;
+}
+
+} // namespace pp
+
+} // namespace bbque
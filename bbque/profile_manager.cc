@@ -21,6 +21,8 @@
 
 #include "bbque/utils/utility.h"
 
+#include <algorithm>
+
 #define PROFILE_MANAGER_NAMESPACE "bq.om"
 
 static const char *prioLevels[] = {
@@ -63,17 +65,19 @@ ProfileManager & ProfileManager::GetInstance() {
 ProfileManager::ProfileManager() :
 	sm(SchedulerManager::GetInstance()),
 	am(ApplicationManager::GetInstance()),
-	mc(bu::MetricsCollector::GetInstance()) {
+	mc(bu::MetricsCollector::GetInstance()),
+	sched_stats(BBQUE_APP_PRIO_LEVELS) {
 
-	//---------- Get a logger module
-	logger = bu::Logger::GetLogger(PROFILE_MANAGER_NAMESPACE);
-	assert(logger);
+	//---------- Setup the worker (and the logger module)
+	Worker::Setup(BBQUE_MODULE_NAME("om"), PROFILE_MANAGER_NAMESPACE);
 
 	logger->Debug("Starting profile manager...");
 
 	//---------- Setup all the module metrics
 	mc.Register(metrics, PM_METRICS_COUNT);
 
+	// Start the reporting thread
+	Worker::Start();
 }
 
 ProfileManager::~ProfileManager() {
@@ -81,61 +85,37 @@ ProfileManager::~ProfileManager() {
 
 
 ProfileManager::ExitCode_t
-ProfileManager::ProfileScheduleClass(uint16_t prio) {
-	accumulator_set<double, stats<tag::min, tag::max, tag::variance>>
-		appValueStats, awmValueStats;
-	uint16_t actives_count = 0;
-	uint16_t running_count = 0;
+ProfileManager::ProfileScheduleClass(uint16_t prio,
+		ApplicationManager::SchedStats_t const & stats) {
 	double app_avg = 0, app_var = 0;
 	double awm_avg = 0, awm_var = 0;
 	double wmix_idx = 0;
 	double fnes_idx = 0;
-	AppsUidMapIt app_it;
-	AppPtr_t papp;
-
-	// Profiling ACTIVE applications
-	papp = am.GetFirst(prio, app_it);
-	while (papp) {
-		if (papp->Active()) {
-			++actives_count;
-
-			//logger->Debug("Prio[%d], accounting [%s] as ACTIVE",
-			//		prio, papp->StrId(), papp->Value());
-
-			// Stats are computed just on RUNNING applications
-			if (papp->State() == ApplicationStatusIF::RUNNING) {
-				++running_count;
-
-				//logger->Debug("Prio[%d], adding [%s] to stats, value [%.4f]",
-				//		prio, papp->StrId(), papp->Value());
-				appValueStats(papp->Value());
-				awmValueStats(papp->CurrentAWM()->Value());
-			}
-		}
-
-		papp = am.GetNext(prio, app_it);
-	}
 
 	// We could have applications on a prio level which are just
 	// BLOCKED or DISABLED
-	if (actives_count == 0)
+	if (stats.active_count == 0)
 		return OK;
 
-	// Computing statistics on Applications Value
-	app_avg = mean(appValueStats);
-	app_var = variance(appValueStats);
-
-	// Computing statistics on AWMs Value
-	awm_avg = mean(awmValueStats);
-	awm_var = variance(awmValueStats);
+	// Computing statistics on Applications and AWMs Value (stats are
+	// computed just on RUNNING applications)
+	if (stats.running_count > 0) {
+		app_avg = stats.app_value_sum / stats.running_count;
+		app_var = std::max(0.0,
+			stats.app_value_sum2 / stats.running_count - app_avg * app_avg);
+		awm_avg = stats.awm_value_sum / stats.running_count;
+		awm_var = std::max(0.0,
+			stats.awm_value_sum2 / stats.running_count - awm_avg * awm_avg);
+	}
 
 	// Workload Mix INDEX: WMix = Apps[RUNNING] / Apps[ACTIVE]
-	wmix_idx = static_cast<double>(running_count) / actives_count;
+	wmix_idx = static_cast<double>(stats.running_count) / stats.active_count;
 
 	// Fairness INDEX:
 	// a) lower running/active apps ratio => lower index
 	// b) same running/active ratios and higher AWM variance => lower index
-	fnes_idx =  (running_count + (1 - 3 * awm_var)) / (1 + actives_count);
+	fnes_idx = (stats.running_count + (1 - 3 * awm_var)) /
+		(1 + stats.active_count);
 
 	// Adding SAMPLES to metrics collector
 	PM_ADD_SAMPLE(metrics, PM_SCHED_APP_VALUE, app_avg,
@@ -150,8 +130,8 @@ ProfileManager::ProfileScheduleClass(uint16_t prio) {
 	logger->Notice(
 		"|  %3d | %3d | %3d | %5.3f | %5.3f | %5.3f | %5.3f | %5.3f | %5.3f |",
 		prio,
-		actives_count,
-		running_count,
+		stats.active_count,
+		stats.running_count,
 		app_avg, app_var,
 		awm_avg, awm_var,
 		wmix_idx,
@@ -163,27 +143,47 @@ ProfileManager::ProfileScheduleClass(uint16_t prio) {
 
 ProfileManager::ExitCode_t
 ProfileManager::ProfileSchedule() {
-	uint16_t prio;
-
-	logger->Notice(
-		"====================================================================");
-	logger->Notice(
-		"|      |  Apps Cnt |  Apps Values  |  AWMs Values  | WLMix | Fness |");
-	logger->Notice(
-		"| Prio | Act | Run |  Avg  |  Var  |  Avg  |  Var  |   Idx |   Idx |");
-	logger->Notice(
-		"|------+-----+-----+-------+-------+-------+-------+-------+-------+");
+	std::unique_lock<std::mutex> worker_status_ul(worker_status_mtx);
 
-	// Compute per-priority classes scheduler profiling statistics
-	for (prio = 0; prio <= am.LowestPriority(); ++prio) {
-		if (!am.HasApplications(prio))
-			continue;
-		ProfileScheduleClass(prio);
-	}
+	// Snapshot of the per-priority running aggregates, to be reported by
+	// the profiling worker
+	for (AppPrio_t prio = 0; prio <= am.LowestPriority(); ++prio)
+		sched_stats[prio] = am.GetSchedStats(prio);
+	sched_stats_pending = true;
 
-	logger->Notice(
-		"====================================================================");
+	worker_status_cv.notify_one();
 	return OK;
 }
 
+void ProfileManager::Task() {
+	std::vector<ApplicationManager::SchedStats_t> stats;
+
+	while (!done) {
+		std::unique_lock<std::mutex> worker_status_ul(worker_status_mtx);
+		while (!sched_stats_pending && !done)
+			worker_status_cv.wait(worker_status_ul);
+		if (done)
+			break;
+		stats = sched_stats;
+		sched_stats_pending = false;
+		worker_status_ul.unlock();
+
+		logger->Notice(
+			"====================================================================");
+		logger->Notice(
+			"|      |  Apps Cnt |  Apps Values  |  AWMs Values  | WLMix | Fness |");
+		logger->Notice(
+			"| Prio | Act | Run |  Avg  |  Var  |  Avg  |  Var  |   Idx |   Idx |");
+		logger->Notice(
+			"|------+-----+-----+-------+-------+-------+-------+-------+-------+");
+
+		// Report per-priority classes scheduler profiling statistics
+		for (uint16_t prio = 0; prio <= am.LowestPriority(); ++prio)
+			ProfileScheduleClass(prio, stats[prio]);
+
+		logger->Notice(
+			"====================================================================");
+	}
+}
+
 } // namespace bbque
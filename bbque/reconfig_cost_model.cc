@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bbque/reconfig_cost_model.h"
+
+#include "bbque/configuration_manager.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#define MODULE_CONFIG "ReconfigCostModel"
+
+namespace po = boost::program_options;
+
+namespace bbque {
+
+
+ReconfigCostModel & ReconfigCostModel::GetInstance() {
+	static ReconfigCostModel instance;
+	return instance;
+}
+
+ReconfigCostModel::ReconfigCostModel() {
+	logger = bu::Logger::GetLogger(RECONFIG_COST_MODEL_NAMESPACE);
+	assert(logger);
+
+	ConfigurationManager & cm(ConfigurationManager::GetInstance());
+	po::options_description opts_desc("Reconfiguration cost model options");
+	opts_desc.add_options()
+		(MODULE_CONFIG ".file",
+		 po::value<std::string>(&file_path)->default_value(BBQUE_RCM_FILE),
+		 "The file storing the transition costs")
+		(MODULE_CONFIG ".horizon_ms",
+		 po::value<uint32_t>(&horizon_ms)->default_value(BBQUE_RCM_HORIZON_MS),
+		 "The time horizon [ms] the transition costs are normalized to")
+		(MODULE_CONFIG ".min_samples",
+		 po::value<uint16_t>(&min_samples)->default_value(BBQUE_RCM_MIN_SAMPLES),
+		 "The number of samples before a transition cost is trusted");
+	po::variables_map opts_vm;
+	cm.ParseConfigurationFile(opts_desc, opts_vm);
+	if (horizon_ms == 0)
+		horizon_ms = BBQUE_RCM_HORIZON_MS;
+
+	Load();
+}
+
+ReconfigCostModel::~ReconfigCostModel() {
+	Save();
+}
+
+ReconfigCostModel::TransitionKey_t ReconfigCostModel::GetKey(
+		ba::AppSPtr_t papp,
+		int8_t src_awm_id,
+		int8_t dst_awm_id) {
+	return std::make_tuple(papp->RecipeName(), src_awm_id, dst_awm_id);
+}
+
+void ReconfigCostModel::AddSample(
+		ba::AppSPtr_t papp,
+		int8_t src_awm_id,
+		int8_t dst_awm_id,
+		double cost_ms) {
+	std::unique_lock<std::mutex> costs_ul(costs_mtx);
+	TransitionKey_t key(GetKey(papp, src_awm_id, dst_awm_id));
+
+	auto cost_it = costs.find(key);
+	if (cost_it == costs.end()) {
+		cost_it = costs.emplace(key, ba::TransitionOverheads(cost_ms)).first;
+	}
+	else {
+		// Halve the weight of the history before the counter overflows
+		ba::TransitionOverheads & to(cost_it->second);
+		if (to.Count() == UINT16_MAX)
+			to = ba::TransitionOverheads(to.Count() / 2, to.AvgTime(),
+				to.MinTime(), to.MaxTime(), to.LastTime());
+		to.SetSwitchTime(cost_ms);
+		to.IncCount();
+	}
+	logger->Debug("AddSample: [%s] AWM %d->%d cost=%.3f[ms] "
+		"(avg=%.3f, count=%d)", papp->StrId(), src_awm_id, dst_awm_id,
+		cost_ms, cost_it->second.AvgTime(), cost_it->second.Count());
+
+	if (++unsaved >= BBQUE_RCM_SAVE_PERIOD)
+		_Save();
+}
+
+bool ReconfigCostModel::GetCost(
+		ba::AppSPtr_t papp,
+		int8_t src_awm_id,
+		int8_t dst_awm_id,
+		double & cost_ms) {
+	std::unique_lock<std::mutex> costs_ul(costs_mtx);
+	auto cost_it = costs.find(GetKey(papp, src_awm_id, dst_awm_id));
+	if ((cost_it == costs.end()) || (cost_it->second.Count() < min_samples))
+		return false;
+	cost_ms = cost_it->second.AvgTime();
+	return true;
+}
+
+float ReconfigCostModel::GetNormalCost(
+		ba::AppSPtr_t papp,
+		int8_t src_awm_id,
+		int8_t dst_awm_id) {
+	double cost_ms;
+	if (!GetCost(papp, src_awm_id, dst_awm_id, cost_ms))
+		return -1.0;
+	return std::min<float>(cost_ms / horizon_ms, 1.0);
+}
+
+void ReconfigCostModel::Load() {
+	std::ifstream ifs(file_path);
+	if (!ifs.is_open()) {
+		logger->Info("Load: no transition costs in [%s]", file_path.c_str());
+		return;
+	}
+
+	// <src_awm> <dst_awm> <count> <avg> <min> <max> <last> <recipe>
+	// The recipe name is the rest of the line, which may include blanks
+	std::string line;
+	while (std::getline(ifs, line)) {
+		if (line.empty() || (line[0] == '#'))
+			continue;
+		std::istringstream iss(line);
+		std::string recipe;
+		int src_awm_id, dst_awm_id;
+		uint16_t count;
+		double avg_time, min_time, max_time, last_time;
+		if (!(iss >> src_awm_id >> dst_awm_id >> count
+				>> avg_time >> min_time >> max_time >> last_time) ||
+				!std::getline(iss >> std::ws, recipe) ||
+				(count == 0)) {
+			logger->Warn("Load: skipping malformed line [%s]", line.c_str());
+			continue;
+		}
+		costs.emplace(
+			std::make_tuple(recipe, src_awm_id, dst_awm_id),
+			ba::TransitionOverheads(
+				count, avg_time, min_time, max_time, last_time));
+	}
+	logger->Info("Load: %d transition costs loaded from [%s]",
+		costs.size(), file_path.c_str());
+}
+
+void ReconfigCostModel::Save() {
+	std::unique_lock<std::mutex> costs_ul(costs_mtx);
+	if (unsaved > 0)
+		_Save();
+}
+
+void ReconfigCostModel::_Save() {
+	// Write a new file, then replace the previous one
+	std::string tmp_path(file_path + ".tmp");
+	std::ofstream ofs(tmp_path);
+	if (!ofs.is_open()) {
+		logger->Error("Save: cannot write [%s]", tmp_path.c_str());
+		return;
+	}
+
+	ofs << "# <src_awm> <dst_awm> <count> <avg> <min> <max> <last> [ms] <recipe>\n";
+	for (auto const & cost_entry: costs) {
+		ba::TransitionOverheads const & to(cost_entry.second);
+		ofs << static_cast<int>(std::get<1>(cost_entry.first)) << " "
+			<< static_cast<int>(std::get<2>(cost_entry.first)) << " "
+			<< to.Count() << " " << to.AvgTime() << " "
+			<< to.MinTime() << " " << to.MaxTime() << " "
+			<< to.LastTime() << " "
+			<< std::get<0>(cost_entry.first) << "\n";
+	}
+	ofs.close();
+
+	if (ofs.fail() || (std::rename(tmp_path.c_str(), file_path.c_str()) != 0)) {
+		logger->Error("Save: cannot update [%s]", file_path.c_str());
+		return;
+	}
+	unsaved = 0;
+	logger->Debug("Save: %d transition costs saved", costs.size());
+}
+
+} // namespace bbque
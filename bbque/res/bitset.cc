@@ -15,6 +15,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cstring>
 
 #include "bbque/res/bitset.h"
@@ -28,7 +29,15 @@ ResourceBitset::ResourceBitset():
 	first_set(R_ID_NONE),
 	last_set(R_ID_NONE),
 	count(0),
-	none(true) {
+	cg_valid(true) {
+}
+
+ResourceBitset::ResourceBitset(size_t nr_bits):
+	words((nr_bits + WordBits - 1) / WordBits, 0),
+	first_set(R_ID_NONE),
+	last_set(R_ID_NONE),
+	count(0),
+	cg_valid(true) {
 }
 
 ResourceBitset::~ResourceBitset() {}
@@ -37,32 +46,111 @@ ResourceBitset::~ResourceBitset() {}
  *         Operators          *
  ******************************/
 
-ResourceBitset ResourceBitset::operator|= (const ResourceBitset & rbs) {
-	int _bit = rbs.FirstSet();
-	while ((_bit >= 0) && (_bit <= rbs.LastSet())) {
-		if (rbs.Test(_bit)) Set(_bit);
-		_bit++;
+bool ResourceBitset::operator== (ResourceBitset const & rbs) const {
+	if ((count != rbs.count) || (first_set != rbs.first_set)
+			|| (last_set != rbs.last_set))
+		return false;
+	if (count == 0)
+		return true;
+	// Words beyond the last bit set are zero on both sides
+	size_t last_word = WordIndex(last_set);
+	for (size_t i = WordIndex(first_set); i <= last_word; ++i) {
+		if (words[i] != rbs.words[i])
+			return false;
+	}
+	return true;
+}
+
+bool ResourceBitset::operator< (ResourceBitset const & rbs) const {
+	if (count != rbs.count)
+		return count < rbs.count;
+	if (count == 0)
+		return false;
+	if (last_set != rbs.last_set)
+		return last_set < rbs.last_set;
+	// Same highest bit set: compare the words from the most significant one
+	for (size_t i = WordIndex(last_set) + 1; i-- > 0; ) {
+		if (words[i] != rbs.words[i])
+			return words[i] < rbs.words[i];
 	}
+	return false;
+}
+
+ResourceBitset & ResourceBitset::operator|= (const ResourceBitset & rbs) {
+	if (rbs.count == 0)
+		return *this;
+	size_t nr_words = WordIndex(rbs.last_set) + 1;
+	if (words.size() < nr_words)
+		words.resize(nr_words, 0);
+
+	Word_t * __restrict__ dst = words.data();
+	Word_t const * __restrict__ src = rbs.words.data();
+	for (size_t i = 0; i < nr_words; ++i)
+		dst[i] |= src[i];
+
+	UpdateSummary();
+	return *this;
+}
+
+ResourceBitset & ResourceBitset::operator&= (const ResourceBitset & rbs) {
+	if (count == 0)
+		return *this;
+	size_t nr_words = std::min(words.size(), rbs.words.size());
+
+	Word_t * __restrict__ dst = words.data();
+	Word_t const * __restrict__ src = rbs.words.data();
+	for (size_t i = 0; i < nr_words; ++i)
+		dst[i] &= src[i];
+	std::fill(words.begin() + nr_words, words.end(), 0);
+
+	UpdateSummary();
 	return *this;
 }
 
-ResourceBitset ResourceBitset::operator&= (const ResourceBitset & rbs) {
-	Reset();
-	return (*this |= rbs);
+ResourceBitset & ResourceBitset::operator-= (const ResourceBitset & rbs) {
+	if ((count == 0) || (rbs.count == 0))
+		return *this;
+	size_t nr_words = std::min(words.size(), rbs.words.size());
+
+	Word_t * __restrict__ dst = words.data();
+	Word_t const * __restrict__ src = rbs.words.data();
+	for (size_t i = 0; i < nr_words; ++i)
+		dst[i] &= ~src[i];
+
+	UpdateSummary();
+	return *this;
 }
 
 /**/
 
-ResourceBitset::ExitCode_t ResourceBitset::Set(BBQUE_RID_TYPE pos) {
-	char buff[4] = "";
+bool ResourceBitset::Intersects(ResourceBitset const & rbs) const {
+	if ((count == 0) || (rbs.count == 0))
+		return false;
+	if ((last_set < rbs.first_set) || (rbs.last_set < first_set))
+		return false;
+	size_t first_word = WordIndex(std::max(first_set, rbs.first_set));
+	size_t last_word  = WordIndex(std::min(last_set, rbs.last_set));
+	for (size_t i = first_word; i <= last_word; ++i) {
+		if (words[i] & rbs.words[i])
+			return true;
+	}
+	return false;
+}
 
+ResourceBitset::ExitCode_t ResourceBitset::Set(BBQUE_RID_TYPE pos) {
 	// Boundary check
-	if (pos > BBQUE_MAX_R_ID_NUM)
+	if (pos < 0)
 		return OUT_OF_RANGE;
+
+	// Grow the set if needed
+	size_t word_id = WordIndex(pos);
+	if (word_id >= words.size())
+		words.resize(word_id + 1, 0);
+
 	// Set bit
-	if (bit_set.test(pos))
+	if (words[word_id] & BitMask(pos))
 		return OK;
-	bit_set.set(pos);
+	words[word_id] |= BitMask(pos);
 
 	// Track set boundaries
 	if (pos > last_set)
@@ -70,29 +158,141 @@ ResourceBitset::ExitCode_t ResourceBitset::Set(BBQUE_RID_TYPE pos) {
 	if ((pos < first_set) || (first_set < 0))
 		first_set = pos;
 
-	// Update CG string
-	if (count > 0)
-		snprintf(buff, 4, ",%d", pos);
-	else
-		snprintf(buff, 4, "%d", pos);
-	cg_str.append(buff);
-
 	++count;
-	if (none) none = false;
+	cg_valid = false;
 	return OK;
 }
 
 ResourceBitset::ExitCode_t ResourceBitset::Reset() {
-	bit_set.reset();
+	std::fill(words.begin(), words.end(), 0);
 	first_set = last_set = R_ID_NONE;
-	none  = true;
 	count = 0;
+	cg_str.clear();
+	cg_valid = true;
+	return OK;
+}
+
+ResourceBitset::ExitCode_t ResourceBitset::Reset(BBQUE_RID_TYPE pos) {
+	// Boundary check
+	if (pos < 0)
+		return OUT_OF_RANGE;
+	if (!Test(pos))
+		return OK;
+	words[WordIndex(pos)] &= ~BitMask(pos);
+
+	// Track set boundaries
+	--count;
+	if (count == 0) {
+		first_set = last_set = R_ID_NONE;
+	}
+	else {
+		if (pos == first_set)
+			first_set = NextSet(pos);
+		if (pos == last_set)
+			last_set  = PrevSet(pos);
+	}
+
+	cg_valid = false;
 	return OK;
 }
 
+BBQUE_RID_TYPE ResourceBitset::NextSet(BBQUE_RID_TYPE pos) const {
+	if ((count == 0) || (pos >= last_set))
+		return R_ID_NONE;
+	if (pos < first_set)
+		return first_set;
+
+	// Mask out the bits up to 'pos' in the first word to scan
+	++pos;
+	size_t word_id = WordIndex(pos);
+	Word_t word = words[word_id] & (~Word_t(0) << (pos % WordBits));
+	while (word == 0) {
+		if (++word_id >= words.size())
+			return R_ID_NONE;
+		word = words[word_id];
+	}
+	return word_id * WordBits + __builtin_ctzll(word);
+}
+
+BBQUE_RID_TYPE ResourceBitset::PrevSet(BBQUE_RID_TYPE pos) const {
+	if ((count == 0) || (pos <= first_set))
+		return R_ID_NONE;
+
+	// Mask out the bits from 'pos' on in the first word to scan
+	--pos;
+	int word_id = WordIndex(pos);
+	Word_t word = words[word_id] &
+		(~Word_t(0) >> (WordBits - 1 - (pos % WordBits)));
+	while (word == 0) {
+		if (--word_id < 0)
+			return R_ID_NONE;
+		word = words[word_id];
+	}
+	return word_id * WordBits + (WordBits - 1 - __builtin_clzll(word));
+}
+
+void ResourceBitset::UpdateSummary() {
+	int first_word = -1, last_word = -1;
+	count = 0;
+	for (size_t i = 0; i < words.size(); ++i) {
+		if (words[i] == 0)
+			continue;
+		count += __builtin_popcountll(words[i]);
+		if (first_word < 0)
+			first_word = i;
+		last_word = i;
+	}
+
+	if (count == 0) {
+		first_set = last_set = R_ID_NONE;
+	}
+	else {
+		first_set = first_word * WordBits + __builtin_ctzll(words[first_word]);
+		last_set  = last_word * WordBits +
+			(WordBits - 1 - __builtin_clzll(words[last_word]));
+	}
+	cg_valid = false;
+}
 
+std::string ResourceBitset::ToString() const {
+	if (count == 0)
+		return std::string("0");
+	std::string str(last_set + 1, '0');
+	for (BBQUE_RID_TYPE pos = first_set; pos >= 0; pos = NextSet(pos))
+		str[last_set - pos] = '1';
+	return str;
+}
+
+std::string const & ResourceBitset::ToStringCG() const {
+	char buff[16];
+	if (cg_valid)
+		return cg_str;
+
+	// Build the string of ranges, e.g., "0-3,8,10-11"
+	cg_str.clear();
+	BBQUE_RID_TYPE pos = first_set;
+	while (pos >= 0) {
+		BBQUE_RID_TYPE range_end = pos;
+		BBQUE_RID_TYPE next = NextSet(pos);
+		while ((next >= 0) && (next == range_end + 1)) {
+			range_end = next;
+			next = NextSet(next);
+		}
+
+		if (range_end == pos)
+			snprintf(buff, sizeof(buff), "%s%d",
+				cg_str.empty() ? "" : ",", pos);
+		else
+			snprintf(buff, sizeof(buff), "%s%d-%d",
+				cg_str.empty() ? "" : ",", pos, range_end);
+		cg_str.append(buff);
+		pos = next;
+	}
+
+	cg_valid = true;
+	return cg_str;
+}
 
 } // namespace res
 
 } // namespace bbque
-
@@ -15,6 +15,8 @@ static const char * r_type_str[] = {
 	"net" ,
 	"icn" ,
 	"io"  ,
+	"cache",
+	"membw",
 	"cst"
 };
 
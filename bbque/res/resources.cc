@@ -136,13 +136,16 @@ uint64_t Resource::Available(AppSPtr_t papp, RViewToken_t view_id) {
 		return total_available;
 
 	// Remove resources already allocated in this vew
-	total_available -= view->used;
+	if (view->charged >= total_available)
+		total_available = 0;
+	else
+		total_available -= view->charged;
 	// Return the amount of available resource
 	if (!papp)
 		return total_available;
 
 	// Add resources allocated by requesting applicatiion
-	total_available += ApplicationUsage(papp, view->apps);
+	total_available += ApplicationUsage(papp, view->charges);
 	return total_available;
 
 }
@@ -159,6 +162,13 @@ uint64_t Resource::ApplicationUsage(AppSPtr_t const & papp, RViewToken_t view_id
 	return ApplicationUsage(papp, view->apps);
 }
 
+uint64_t Resource::ApplicationCharge(AppSPtr_t const & papp, RViewToken_t view_id) {
+	ResourceStatePtr_t view(GetStateView(view_id));
+	if (!view)
+		return 0;
+	return ApplicationUsage(papp, view->charges);
+}
+
 Resource::ExitCode_t Resource::UsedBy(AppUid_t & app_uid,
 		uint64_t & amount,
 		uint8_t nth,
@@ -191,21 +201,25 @@ Resource::ExitCode_t Resource::UsedBy(AppUid_t & app_uid,
 
 
 uint64_t Resource::Acquire(AppSPtr_t const & papp, uint64_t amount,
-		RViewToken_t view_id) {
+		RViewToken_t view_id, uint64_t charge) {
 	ResourceStatePtr_t view(GetStateView(view_id));
 	if (!view) {
 		view = std::make_shared<ResourceState>();
 		state_views[view_id] = view;
 	}
 
-	// Try to set the new "used" value
-	uint64_t fut_used = view->used + amount;
-	if (fut_used > total)
+	// Try to set the new "charged" value
+	if (charge == 0)
+		charge = amount;
+	uint64_t fut_charged = view->charged + charge;
+	if (fut_charged > total)
 		return 0;
 
 	// Set new used value and application that requested the resource
-	view->used = fut_used;
-	view->apps[papp->Uid()] = amount;
+	view->used   += amount;
+	view->charged = fut_charged;
+	view->apps[papp->Uid()]    = amount;
+	view->charges[papp->Uid()] = charge;
 	return amount;
 }
 
@@ -245,6 +259,12 @@ uint64_t Resource::Release(AppUid_t app_uid, ResourceStatePtr_t view) {
 	view->used -= used_by_app;
 	view->apps.erase(app_uid);
 
+	auto charge_it = view->charges.find(app_uid);
+	if (charge_it != view->charges.end()) {
+		view->charged -= charge_it->second;
+		view->charges.erase(charge_it);
+	}
+
 	// Return the amount of resource released
 	return used_by_app;
 }
@@ -32,6 +32,7 @@
 #include "bbque/app/working_mode.h"
 #include "bbque/res/resource_path.h"
 #include "bbque/application_manager.h"
+#include "bbque/overcommit_model.h"
 
 
 #undef  MODULE_CONFIG
@@ -67,7 +68,8 @@ ResourceAccounter::ResourceAccounter() :
 		am(ApplicationManager::GetInstance()),
 		cm(CommandManager::GetInstance()),
 		fm(ConfigurationManager::GetInstance()),
-		status(State::NOT_READY) {
+		status(State::NOT_READY),
+		platform_generation(0) {
 
 	// Get a logger
 	logger = bu::Logger::GetLogger(RESOURCE_ACCOUNTER_NAMESPACE);
@@ -125,6 +127,11 @@ void ResourceAccounter::WaitForPlatformReady() {
 	}
 }
 
+bool ResourceAccounter::IsReady() {
+	std::unique_lock<std::mutex> status_ul(status_mtx);
+	return (status == State::READY);
+}
+
 inline void ResourceAccounter::SetReady() {
 	std::unique_lock<std::mutex> status_ul(status_mtx);
 	status = State::READY;
@@ -462,6 +469,7 @@ inline uint64_t ResourceAccounter::QueryStatus(
 		QueryOption_t _att,
 		br::RViewToken_t status_view,
 		ba::AppSPtr_t papp) const {
+	OvercommitModel & om(OvercommitModel::GetInstance());
 	uint64_t value = 0;
 
 	// For all the descriptors in the list add the quantity of resource in the
@@ -469,7 +477,7 @@ inline uint64_t ResourceAccounter::QueryStatus(
 	for (br::ResourcePtr_t const & rsrc: resources_list) {
 		switch(_att) {
 		case RA_AVAIL:
-			value += rsrc->Available(papp, status_view);
+			value += om.Available(rsrc, papp, status_view);
 			break;
 		case RA_USED:
 			value += rsrc->Used(status_view);
@@ -663,6 +671,7 @@ br::ResourcePtr_t ResourceAccounter::RegisterResource(
 		else
 			r_ids_per_type[id->Type()].insert(id->ID());
 	}
+	++platform_generation;
 
 	return resource_ptr;
 }
@@ -720,6 +729,7 @@ ResourceAccounter::ExitCode_t ResourceAccounter::UpdateResource(
 	reserved = resource_ptr->Total() - availability;
 	ReserveResources(resource_path_ptr, reserved);
 	resource_ptr->SetOnline();
+	++platform_generation;
 
 	// Back to READY
 	SetReady();
@@ -751,6 +761,7 @@ ResourceAccounter::ExitCode_t  ResourceAccounter::ReserveResources(
 			return RA_FAILED;
 		}
 	}
+	++platform_generation;
 
 	return RA_SUCCESS;
 }
@@ -807,6 +818,7 @@ ResourceAccounter::ExitCode_t  ResourceAccounter::OfflineResources(
 		logger->Debug("OfflineResources: setting on %s",
 			resource_ptr->Path().c_str());
 	}
+	++platform_generation;
 
 	return RA_SUCCESS;
 }
@@ -826,6 +838,7 @@ ResourceAccounter::ExitCode_t  ResourceAccounter::OnlineResources(
 		logger->Debug("OnlineResources: setting on %s",
 			resource_ptr->Path().c_str());
 	}
+	++platform_generation;
 
 	return RA_SUCCESS;
 }
@@ -951,6 +964,11 @@ void ResourceAccounter::SetScheduledView(br::RViewToken_t svt) {
 	br::RViewToken_t old_svt = sch_view_token;
 	sch_view_token = svt;
 
+	// The resizes admitted are enforced one by one from now on, each one
+	// checked against the system view only
+	resize_growth.clear();
+	resize_view = 0;
+
 	// Release the old scheduled view if it is not the current system view
 	if (old_svt != sys_view_token)
 		_PutView(old_svt);
@@ -1363,6 +1381,135 @@ bool ResourceAccounter::IsReshuffling(
 	return false;
 }
 
+ResourceAccounter::ExitCode_t ResourceAccounter::CheckResize(
+		ba::AppSPtr_t const & papp,
+		br::ResourceAssignmentMapPtr_t const & next_map,
+		br::RViewToken_t status_view) {
+	// A new scheduling: forget the resizes previously admitted
+	if (status_view != resize_view) {
+		resize_growth.clear();
+		resize_view = status_view;
+	}
+	resize_growth.erase(papp->Uid());
+
+	ResizeGrowth_t growth;
+	ExitCode_t result = _CheckResize(papp, next_map, status_view, &growth);
+	if ((result == RA_SUCCESS) && !growth.empty())
+		resize_growth.emplace(papp->Uid(), std::move(growth));
+	return result;
+}
+
+ResourceAccounter::ExitCode_t ResourceAccounter::_CheckResize(
+		ba::AppSPtr_t const & papp,
+		br::ResourceAssignmentMapPtr_t const & next_map,
+		br::RViewToken_t status_view,
+		ResizeGrowth_t * growth) {
+	if (Synching() || (status_view == sys_view_token) || !next_map)
+		return RA_FAILED;
+
+	// The resources currently assigned
+	auto curr_it(sys_assign_view->find(papp->Uid()));
+	if (curr_it == sys_assign_view->end())
+		return RA_FAILED;
+
+	// The same resources must be used, with some amounts changed
+	bool resized = false;
+	bool fitting = true;
+	for (auto const & assign_map: { curr_it->second, next_map }) {
+		for (auto const & ru_entry: *(assign_map.get())) {
+			br::ResourceAssignmentPtr_t const & r_assign(ru_entry.second);
+			for (br::ResourcePtr_t const & rsrc: r_assign->GetResourcesList()) {
+				uint64_t curr_usage = rsrc->ApplicationUsage(papp, sys_view_token);
+				uint64_t next_usage = rsrc->ApplicationUsage(papp, status_view);
+				if ((curr_usage == 0) != (next_usage == 0))
+					return RA_FAILED;
+				if (curr_usage == next_usage)
+					continue;
+				resized = true;
+
+				// The next amount must fit the system view, along with the
+				// growth of the other resizes admitted
+				uint64_t curr_charge = rsrc->ApplicationCharge(papp, sys_view_token);
+				uint64_t next_charge = rsrc->ApplicationCharge(papp, status_view);
+				uint64_t others_growth = 0;
+				if (growth != nullptr) {
+					for (auto const & app_growth: resize_growth) {
+						auto rsrc_growth(app_growth.second.find(rsrc));
+						if (rsrc_growth != app_growth.second.end())
+							others_growth += rsrc_growth->second;
+					}
+					if (next_charge > curr_charge)
+						(*growth)[rsrc] = next_charge - curr_charge;
+				}
+				if ((next_charge + others_growth) >
+						rsrc->Available(papp, sys_view_token)) {
+					logger->Debug("CheckResize: [%s] <%s> not fitting "
+						"[%" PRIu64 " -> %" PRIu64 "]", papp->StrId(),
+						rsrc->Path().c_str(), curr_usage, next_usage);
+					fitting = false;
+				}
+			}
+		}
+	}
+
+	if (!resized)
+		return RA_FAILED;
+	logger->Debug("CheckResize: [%s] resizing (%s)", papp->StrId(),
+		fitting ? "in place" : "not fitting");
+	return fitting ? RA_SUCCESS : RA_ERR_USAGE_EXC;
+}
+
+ResourceAccounter::ExitCode_t ResourceAccounter::ResizeResources(
+		ba::AppSPtr_t const & papp,
+		br::RViewToken_t status_view) {
+	std::unique_lock<std::mutex> status_ul(status_mtx);
+	if (status != State::READY) {
+		logger->Error("Resize: [%s] accounting not ready", papp->StrId());
+		return RA_FAILED;
+	}
+
+	// Check the scheduled amounts still fit the system view (the growth of
+	// the resizes already enforced is accounted there)
+	br::ResourceAssignmentMapPtr_t const & assign_map(
+		papp->CurrentAWM()->GetResourceBinding());
+	ExitCode_t result = _CheckResize(papp, assign_map, status_view, nullptr);
+	if (result != RA_SUCCESS) {
+		logger->Warn("Resize: [%s] scheduled amounts not applicable",
+			papp->StrId());
+		return result;
+	}
+
+	auto rsrc_view(rsrc_per_views.find(sys_view_token));
+	if (rsrc_view == rsrc_per_views.end()) {
+		logger->Fatal("Resize: system resource state view missing");
+		return RA_ERR_MISS_VIEW;
+	}
+	auto & rsrc_set(rsrc_view->second);
+
+	// Release the current amounts...
+	auto curr_it(sys_assign_view->find(papp->Uid()));
+	DecBookingCounts(curr_it->second, papp, sys_view_token);
+	sys_assign_view->erase(curr_it);
+
+	// ...and acquire the ones assigned (and charged) by the scheduler
+	for (auto const & ru_entry: *(assign_map.get())) {
+		br::ResourceAssignmentPtr_t const & r_assign(ru_entry.second);
+		for (br::ResourcePtr_t const & rsrc: r_assign->GetResourcesList()) {
+			uint64_t sched_usage = rsrc->ApplicationUsage(papp, status_view);
+			if (sched_usage == 0)
+				continue;
+			rsrc->Acquire(papp, sched_usage, sys_view_token,
+				rsrc->ApplicationCharge(papp, status_view));
+			rsrc_set->insert(rsrc);
+		}
+	}
+	sys_assign_view->emplace(papp->Uid(), assign_map);
+
+	logger->Info("Resize: [%s] resources resized in view=[%ld]",
+		papp->StrId(), sys_view_token);
+	return RA_SUCCESS;
+}
+
 inline void ResourceAccounter::SchedResourceBooking(
 		ba::AppSPtr_t const & papp,
 		br::ResourcePtr_t & rsrc,
@@ -1370,7 +1517,8 @@ inline void ResourceAccounter::SchedResourceBooking(
 		uint64_t & requested,
 		uint64_t alloc_amount_per_resource) {
 	// Check the available amount in the current resource binding
-	uint64_t available = rsrc->Available(papp, status_view);
+	OvercommitModel & om(OvercommitModel::GetInstance());
+	uint64_t available = om.Available(rsrc, papp, status_view);
 	logger->Debug("DRBooking (sched): [%s] request for <%s> [view=%ld] ",
 			papp->StrId(), rsrc->Path().c_str(), status_view);
 
@@ -1379,13 +1527,14 @@ inline void ResourceAccounter::SchedResourceBooking(
 			papp->StrId(), rsrc->Path().c_str(), requested,
 			alloc_amount_per_resource, available);
 
+	uint64_t amount = available;
 	if ((alloc_amount_per_resource > 0) &&
 			(alloc_amount_per_resource <= available))
-		requested -= rsrc->Acquire(papp, alloc_amount_per_resource, status_view);
+		amount = alloc_amount_per_resource;
 	else if (requested < available)
-		requested -= rsrc->Acquire(papp, requested, status_view);
-	else
-		requested -= rsrc->Acquire(papp, available, status_view);
+		amount = requested;
+	requested -= rsrc->Acquire(papp, amount, status_view,
+		om.GetCharge(rsrc, papp, amount, status_view));
 }
 
 inline void ResourceAccounter::SyncResourceBooking(
@@ -1400,9 +1549,10 @@ inline void ResourceAccounter::SyncResourceBooking(
 		return;
 	}
 
-	// Acquire the resource according to the amount assigned by the
-	// scheduler
-	requested -= rsrc->Acquire(papp, sched_usage, sync_ssn.view);
+	// Acquire the resource according to the amount assigned (and charged)
+	// by the scheduler
+	requested -= rsrc->Acquire(papp, sched_usage, sync_ssn.view,
+		rsrc->ApplicationCharge(papp, sch_view_token));
 	logger->Debug("DRBooking (sync): %s acquires %s (%d left) in view=[%ld]",
 			papp->StrId(), rsrc->Name().c_str(), requested, sch_view_token);
 }
@@ -141,6 +141,7 @@ ResourceManager::ResourceManager() :
 	cm(CommandManager::GetInstance()),
 	sm(SchedulerManager::GetInstance()),
 	ym(SynchronizationManager::GetInstance()),
+	ss(ShadowScheduler::GetInstance()),
 #ifdef CONFIG_BBQUE_SCHED_PROFILING
 	om(ProfileManager::GetInstance()),
 #endif
@@ -333,10 +334,12 @@ void ResourceManager::Optimize() {
 	case SchedulerManager::FAILED:
 		logger->Warn("Schedule FAILED (Error: scheduling policy failed)");
 		RM_COUNT_EVENT(metrics, RM_SCHED_FAILED);
+		ss.Resume();
 		return;
 	case SchedulerManager::DELAYED:
 		logger->Error("Schedule DELAYED");
 		RM_COUNT_EVENT(metrics, RM_SCHED_DELAYED);
+		ss.Resume();
 		return;
 	default:
 		assert(schedResult == SchedulerManager::DONE);
@@ -366,6 +369,7 @@ void ResourceManager::Optimize() {
 			RM_COUNT_EVENT(metrics, RM_SYNCH_FAILED);
 			// FIXME here we should implement some counter-meaure to
 			// ensure consistency
+			ss.Resume();
 			return;
 		}
 		logger->Info(LNSYNE);
@@ -375,6 +379,9 @@ void ResourceManager::Optimize() {
 
 	}
 
+	// The system has been reconfigured: compare with the shadow policy
+	ss.Resume();
+
 #ifdef CONFIG_BBQUE_SCHED_PROFILING
 	//--- Profiling
 	logger->Debug(LNPROB);
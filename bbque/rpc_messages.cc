@@ -73,6 +73,9 @@ const char *RPC_messageStr[] = {
 
 	//RPC_BBQ_RESP
 	"BResp",
+
+	//RPC_BBQ_RESIZE
+	"BResize",
 	//RPC_BBQ_MSGS_COUNT
 	"BCount",
 
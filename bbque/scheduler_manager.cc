@@ -20,10 +20,16 @@
 #include "bbque/configuration_manager.h"
 #include "bbque/plugin_manager.h"
 #include "bbque/modules_factory.h"
+#include "bbque/shadow_scheduler.h"
 #include "bbque/system.h"
 
+
 #include "bbque/utils/utility.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+
 // The prefix for configuration file attributes
 #define MODULE_CONFIG "SchedulerManager"
 
@@ -70,6 +76,12 @@ SchedulerManager::metrics[SM_METRICS_COUNT] = {
 	SM_COUNTER_METRIC("migrate","MIGRATE count"),
 	SM_COUNTER_METRIC("migrec",	"MIGREC count"),
 	SM_COUNTER_METRIC("block",	"BLOCK count"),
+	SM_COUNTER_METRIC("resize",	"RESIZE (without sync) count"),
+	SM_COUNTER_METRIC("budget.expired",	"Runs truncated by the time budget"),
+	SM_COUNTER_METRIC("budget.overrun",	"Runs exceeding the time budget"),
+	SM_COUNTER_METRIC("memo.hit",	"Runs applying a memoized outcome"),
+	SM_COUNTER_METRIC("memo.miss",	"Runs without a memoized outcome"),
+	SM_COUNTER_METRIC("memo.invalid",	"Memoized outcomes no longer valid"),
 	//----- Timing metrics
 	SM_SAMPLE_METRIC("time",	"Scheduler execution t[ms]"),
 	SM_SAMPLE_METRIC("period",	"Scheduler activation period t[ms]"),
@@ -79,6 +91,9 @@ SchedulerManager::metrics[SM_METRICS_COUNT] = {
 	SM_SAMPLE_METRIC("avg.migrec",	"Avg MIGREC per schedule"),
 	SM_SAMPLE_METRIC("avg.migrate",	"Avg MIGRATE per schedule"),
 	SM_SAMPLE_METRIC("avg.block",	"Avg BLOCK per schedule"),
+	//----- Quality statistics
+	SM_SAMPLE_METRIC("quality",	"Schedule quality [0..1]"),
+	SM_SAMPLE_METRIC("quality.gap",	"Quality gap of truncated runs"),
 
 };
 
@@ -94,6 +109,7 @@ SchedulerManager::SchedulerManager() :
 	sched_count(0) {
 	std::string opt_namespace((SCHEDULER_POLICY_NAMESPACE"."));
 	std::string opt_policy;
+	std::string opt_budgets;
 
 	//---------- Get a logger module
 	logger = bu::Logger::GetLogger(SCHEDULER_MANAGER_NAMESPACE);
@@ -106,10 +122,26 @@ SchedulerManager::SchedulerManager() :
 	opts_desc.add_options()
 		(MODULE_CONFIG".policy",
 		 po::value<std::string>(&opt_policy)->default_value(
-			 BBQUE_SCHEDPOL_DEFAULT), "The optimization policy to use");
+			 BBQUE_SCHEDPOL_DEFAULT), "The optimization policy to use")
+		(MODULE_CONFIG".budget_ms",
+		 po::value<std::string>(&opt_budgets)->default_value("0"),
+		 "The time budget [ms] of each priority class (comma separated)")
+		(MODULE_CONFIG".memo_size",
+		 po::value<uint32_t>(&memo_size)->default_value(BBQUE_SCHED_MEMO_SIZE),
+		 "The number of scheduling outcomes memoized (0 to disable)");
 	po::variables_map opts_vm;
 	cm.ParseConfigurationFile(opts_desc, opts_vm);
 
+	// Time budget per priority class
+	std::istringstream budgets_iss(opt_budgets);
+	std::string budget_str;
+	while (std::getline(budgets_iss, budget_str, ','))
+		budgets_ms.push_back(std::strtoul(budget_str.c_str(), nullptr, 10));
+	if (budgets_ms.size() > 1 || (!budgets_ms.empty() && budgets_ms[0] > 0))
+		logger->Info("Scheduling time budget: [%s] ms", opt_budgets.c_str());
+	if (memo_size > 0)
+		logger->Info("Scheduling outcomes memoized: %d", memo_size);
+
 	//---------- Load the required optimization plugin
 	logger->Info("Loading optimization policy [%s%s]...",
 			opt_namespace.c_str(), opt_policy.c_str());
@@ -182,13 +214,44 @@ SchedulerManager::Schedule() {
 	System &sv = System::GetInstance();
 	br::RViewToken_t sched_view_id;
 
-	SchedulerPolicyIF::ExitCode result = policy->Schedule(sv, sched_view_id);
-	if (result != SchedulerPolicyIF::SCHED_DONE) {
-		logger->Error("Scheduling [%d] FAILED", sched_count);
-		SetState(State_t::READY);     // --> Applications in a consistent state again
-		return FAILED;
+	// Same schedulable state of a previous run: apply the same outcome
+	SchedApps_t apps;
+	size_t fingerprint = 0;
+	bool memo_applied = false;
+	uint32_t budget_ms = GetTimeBudget();
+
+	// Capture the applications status for the shadow policy
+	ShadowScheduler & ss(ShadowScheduler::GetInstance());
+	if (ss.Enabled())
+		ss.Prepare();
+
+	if (memo_size > 0) {
+		fingerprint = GetSchedulableState(apps);
+		memo_applied = ApplyMemoizedSchedule(fingerprint, apps, sched_view_id);
+	}
+
+	if (!memo_applied) {
+		SchedulerPolicyIF::ExitCode result =
+			policy->Schedule(sv, sched_view_id, budget_ms);
+		if (result != SchedulerPolicyIF::SCHED_DONE) {
+			logger->Error("Scheduling [%d] FAILED", sched_count);
+			SetState(State_t::READY);     // --> Applications in a consistent state again
+			return FAILED;
+		}
+
+		// Account for the time budget (before clearing the next AWMs)
+		CollectBudgetStats(budget_ms);
+
+		// Only complete runs are worth to be reused
+		if ((memo_size > 0) && !policy->BudgetTruncated())
+			MemoizeSchedule(fingerprint, apps);
 	}
 
+	// Compare with the shadow policy (before clearing the next AWMs)
+	if (ss.Enabled())
+		ss.Evaluate(policy->Name(), sched_count,
+			sm_tmr.getElapsedTimeMs(), budget_ms);
+
 	// Clear the next AWM from the RUNNING Apps/EXC
 	CommitRunningApplications();
 
@@ -196,6 +259,9 @@ SchedulerManager::Schedule() {
 	ResourceAccounter &ra(ResourceAccounter::GetInstance());
 	ra.SetScheduledView(sched_view_id);
 
+	// Enforce the resources resized (this requires the scheduled view)
+	CommitResizedApplications();
+
 	SetState(State_t::READY);     // --> Applications in a consistent state again
 
 	SM_GET_TIMING(metrics, SM_SCHED_TIME, sm_tmr); 	// Collecing execution metrics
@@ -208,6 +274,232 @@ SchedulerManager::Schedule() {
 	return DONE;
 }
 
+uint32_t SchedulerManager::GetTimeBudget() {
+	if (budgets_ms.empty())
+		return 0;
+
+	// The highest priority class among the applications waiting to start
+	AppPrio_t prio = am.LowestPriority();
+	AppsUidMapIt apps_it;
+	AppPtr_t papp = am.GetFirst(ApplicationStatusIF::READY, apps_it);
+	if (papp) {
+		for (; papp; papp = am.GetNext(ApplicationStatusIF::READY, apps_it))
+			prio = std::min(prio, papp->Priority());
+	}
+	else {
+		papp = am.GetFirst(apps_it);
+		for (; papp; papp = am.GetNext(apps_it))
+			prio = std::min(prio, papp->Priority());
+	}
+
+	return budgets_ms[std::min<size_t>(prio, budgets_ms.size() - 1)];
+}
+
+double SchedulerManager::GetScheduleQuality() {
+	double quality_sum = 0;
+	uint16_t count = 0;
+
+	AppsUidMapIt apps_it;
+	AppPtr_t papp = am.GetFirst(apps_it);
+	for (; papp; papp = am.GetNext(apps_it)) {
+		if ((papp->State() != ApplicationStatusIF::READY) &&
+				(papp->State() != ApplicationStatusIF::SYNC) &&
+				(papp->State() != ApplicationStatusIF::RUNNING))
+			continue;
+		++count;
+
+		if (!papp->NextAWM() || papp->WorkingModes().empty())
+			continue;
+		ba::AwmPtr_t const & high_awm(papp->HighValueAWM());
+		if (high_awm->Value() <= 0)
+			continue;
+		quality_sum += papp->NextAWM()->Value() / high_awm->Value();
+	}
+
+	return (count > 0) ? quality_sum / count : 1.0;
+}
+
+void SchedulerManager::CollectBudgetStats(uint32_t budget_ms) {
+	double elapsed_ms = sm_tmr.getElapsedTimeMs();
+	double quality = GetScheduleQuality();
+	SM_ADD_SCHED(metrics, SM_SCHED_QUALITY, quality);
+
+	if ((budget_ms > 0) && (elapsed_ms > budget_ms)) {
+		logger->Warn("Scheduling [%d] time budget overrun: %.3f > %d [ms]",
+			sched_count, elapsed_ms, budget_ms);
+		SM_COUNT_EVENT(metrics, SM_SCHED_BUDGET_OVERRUN);
+	}
+
+	// Completed runs: reference quality of the unbounded scheduling
+	if (!policy->BudgetTruncated()) {
+		unbounded_quality_sum += quality;
+		++unbounded_runs;
+		return;
+	}
+
+	SM_COUNT_EVENT(metrics, SM_SCHED_BUDGET_EXPIRED);
+	if (unbounded_runs == 0)
+		return;
+	double quality_gap = unbounded_quality_sum / unbounded_runs - quality;
+	SM_ADD_SCHED(metrics, SM_SCHED_QUALITY_GAP, quality_gap);
+	logger->Info("Scheduling [%d] truncated: quality %.3f (gap %.3f)",
+		sched_count, quality, quality_gap);
+}
+
+size_t SchedulerManager::GetSchedulableState(SchedApps_t & apps) {
+	ResourceAccounter & ra(ResourceAccounter::GetInstance());
+	apps.clear();
+
+	AppsUidMapIt apps_it;
+	AppPtr_t papp = am.GetFirst(apps_it);
+	for (; papp; papp = am.GetNext(apps_it)) {
+		if ((papp->State() != ApplicationStatusIF::READY) &&
+				(papp->State() != ApplicationStatusIF::RUNNING))
+			continue;
+
+		// Recipe, priority and enabled AWMs
+		std::ostringstream key;
+		key << (papp->GetRecipe() ? papp->GetRecipe()->Path() : "")
+			<< ":" << static_cast<int>(papp->Priority()) << ":";
+		for (auto const & pawm: papp->WorkingModes())
+			key << static_cast<int>(pawm->Id()) << ",";
+		apps.emplace_back(key.str(), papp);
+	}
+
+	// The same state regardless of the order of arrival
+	std::stable_sort(apps.begin(), apps.end(),
+		[](SchedApps_t::value_type const & a, SchedApps_t::value_type const & b) {
+			return a.first < b.first;
+		});
+
+	std::string state(std::to_string(ra.GetPlatformGeneration()));
+	for (auto const & app_entry: apps)
+		state += "|" + app_entry.first;
+	return std::hash<std::string>()(state);
+}
+
+bool SchedulerManager::ApplyMemoizedSchedule(
+		size_t fingerprint,
+		SchedApps_t const & apps,
+		br::RViewToken_t & sched_view_id) {
+	ResourceAccounter & ra(ResourceAccounter::GetInstance());
+
+	auto memo_it = memo_index.find(fingerprint);
+	if ((memo_it == memo_index.end()) || apps.empty()) {
+		SM_COUNT_EVENT(metrics, SM_SCHED_MEMO_MISS);
+		return false;
+	}
+	MemoEntry_t & entry(*(memo_it->second));
+
+	// Validation: the bindings must still fit all together
+	bool valid = (entry.outcomes.size() == apps.size());
+	if (valid) {
+		br::RViewToken_t check_view;
+		if (!GetMemoView(check_view))
+			return false;
+		for (size_t i = 0; valid && (i < apps.size()); ++i) {
+			MemoOutcome_t const & outcome(entry.outcomes[i]);
+			AppPtr_t const & papp(apps[i].second);
+			// Not expected, unless the fingerprint collides
+			if (outcome.key != apps[i].first) {
+				valid = false;
+				continue;
+			}
+			if (outcome.awm_id < 0)
+				continue;
+			valid = papp->GetWorkingMode(outcome.awm_id) &&
+				(ra.BookResources(papp, outcome.binding, check_view)
+				 == ResourceAccounter::RA_SUCCESS);
+			if (!valid)
+				logger->Debug("Memoization: [%s] AWM %d no longer fits",
+					papp->StrId(), outcome.awm_id);
+		}
+		ra.PutView(check_view);
+	}
+
+	if (!valid) {
+		logger->Info("Memoization: outcome [%016zx] no longer valid",
+			fingerprint);
+		SM_COUNT_EVENT(metrics, SM_SCHED_MEMO_INVALID);
+		memo_lru.erase(memo_it->second);
+		memo_index.erase(memo_it);
+		return false;
+	}
+
+	// Apply the outcome
+	if (!GetMemoView(sched_view_id))
+		return false;
+	for (size_t i = 0; i < apps.size(); ++i) {
+		MemoOutcome_t const & outcome(entry.outcomes[i]);
+		AppPtr_t const & papp(apps[i].second);
+		if (outcome.awm_id < 0)
+			continue;
+		ba::AwmPtr_t pawm(papp->GetWorkingMode(outcome.awm_id));
+		int32_t refn = pawm->RestoreBinding(outcome.binding);
+		if ((refn < 0) ||
+				(papp->ScheduleRequest(pawm, sched_view_id, refn)
+				 != ApplicationStatusIF::APP_SUCCESS))
+			logger->Warn("Memoization: [%s] AWM %d scheduling failed",
+				papp->StrId(), outcome.awm_id);
+	}
+
+	// Most recently used
+	memo_lru.splice(memo_lru.begin(), memo_lru, memo_it->second);
+	logger->Info("Memoization: outcome [%016zx] applied to %d EXCs",
+		fingerprint, apps.size());
+	SM_COUNT_EVENT(metrics, SM_SCHED_MEMO_HIT);
+	return true;
+}
+
+bool SchedulerManager::GetMemoView(br::RViewToken_t & view_id) {
+	ResourceAccounter & ra(ResourceAccounter::GetInstance());
+	char token_path[40];
+
+	// A new view each time, since the scheduled one becomes the system view
+	snprintf(token_path, 40, "SchedulerManager.memo%d", ++memo_view_count);
+	if (ra.GetView(token_path, view_id) != ResourceAccounter::RA_SUCCESS) {
+		logger->Error("Memoization: cannot get a resource state view");
+		return false;
+	}
+	return true;
+}
+
+void SchedulerManager::MemoizeSchedule(
+		size_t fingerprint,
+		SchedApps_t const & apps) {
+	if (apps.empty())
+		return;
+
+	MemoEntry_t entry;
+	entry.fingerprint = fingerprint;
+	for (auto const & app_entry: apps) {
+		MemoOutcome_t outcome;
+		outcome.key = app_entry.first;
+		ba::AwmPtr_t const & next_awm(app_entry.second->NextAWM());
+		if (next_awm && next_awm->GetResourceBinding() &&
+				!next_awm->GetResourceBinding()->empty()) {
+			outcome.awm_id  = next_awm->Id();
+			outcome.binding = next_awm->GetResourceBinding();
+		}
+		entry.outcomes.push_back(outcome);
+	}
+
+	// Replace the outcome of the same state, or the least recently used
+	auto memo_it = memo_index.find(fingerprint);
+	if (memo_it != memo_index.end()) {
+		memo_lru.erase(memo_it->second);
+		memo_index.erase(memo_it);
+	}
+	else if (memo_lru.size() >= memo_size) {
+		memo_index.erase(memo_lru.back().fingerprint);
+		memo_lru.pop_back();
+	}
+	memo_lru.push_front(std::move(entry));
+	memo_index[fingerprint] = memo_lru.begin();
+	logger->Debug("Memoization: outcome [%016zx] stored (%d/%d)",
+		fingerprint, memo_lru.size(), memo_size);
+}
+
 void SchedulerManager::CommitRunningApplications() {
 	AppsUidMapIt apps_it;
 	AppPtr_t papp = am.GetFirst(ApplicationStatusIF::RUNNING, apps_it);
@@ -217,6 +509,17 @@ void SchedulerManager::CommitRunningApplications() {
 	}
 }
 
+void SchedulerManager::CommitResizedApplications() {
+	AppsUidMapIt apps_it;
+	AppPtr_t papp = am.GetFirst(ApplicationStatusIF::RUNNING, apps_it);
+	for (; papp; papp = am.GetNext(ApplicationStatusIF::RUNNING, apps_it)) {
+		if (!papp->Resizing())
+			continue;
+		if (am.ResizeCommit(papp) == ApplicationManager::AM_SUCCESS)
+			SM_COUNT_EVENT(metrics, SM_SCHED_RESIZE);
+	}
+}
+
 void SchedulerManager::SetState(State_t _s) {
 	std::unique_lock<std::mutex> ul(mux);
 	state = _s;
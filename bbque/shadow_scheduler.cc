@@ -0,0 +1,389 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bbque/shadow_scheduler.h"
+
+#include "bbque/configuration_manager.h"
+#include "bbque/modules_factory.h"
+#include "bbque/resource_accounter.h"
+#include "bbque/system.h"
+#include "bbque/app/working_mode.h"
+#include "bbque/res/binder.h"
+
+#include "bbque/utils/timer.h"
+#include "bbque/utils/utility.h"
+
+#include <fstream>
+
+#define MODULE_CONFIG "ShadowScheduler"
+
+/** Metrics (class COUNTER) declaration */
+#define SS_COUNTER_METRIC(NAME, DESC)\
+ {SHADOW_SCHEDULER_NAMESPACE "." NAME, DESC, \
+	 MetricsCollector::COUNTER, 0, NULL, 0}
+/** Increase counter for the specified metric */
+#define SS_COUNT_EVENT(METRICS, INDEX) \
+	mc.Count(METRICS[INDEX].mh);
+
+/** Metrics (class SAMPLE) declaration */
+#define SS_SAMPLE_METRIC(NAME, DESC)\
+ {SHADOW_SCHEDULER_NAMESPACE "." NAME, DESC, \
+	 MetricsCollector::SAMPLE, 0, NULL, 0}
+/** Acquire a new sample */
+#define SS_ADD_SAMPLE(METRICS, INDEX, SAMPLE) \
+	mc.AddSample(METRICS[INDEX].mh, SAMPLE);
+
+namespace bp = bbque::plugins;
+namespace br = bbque::res;
+namespace po = boost::program_options;
+
+namespace bbque {
+
+/* Definition of metrics used by this module */
+MetricsCollector::MetricsCollection_t
+ShadowScheduler::metrics[SS_METRICS_COUNT] = {
+	//----- Event counting metrics
+	SS_COUNTER_METRIC("runs",	"Shadow policy executions count"),
+	SS_COUNTER_METRIC("skipped",	"Shadow runs dropped by a reconfiguration"),
+	SS_COUNTER_METRIC("failed",	"Shadow policy failures count"),
+	//----- Sample statistics
+	SS_SAMPLE_METRIC("time",	"Shadow policy execution t[ms]"),
+	SS_SAMPLE_METRIC("value.gap",	"Shadow - scheduled: AWM value"),
+	SS_SAMPLE_METRIC("fness.gap",	"Shadow - scheduled: fairness index"),
+	SS_SAMPLE_METRIC("reconf.gap",	"Shadow - scheduled: reconfigurations"),
+	SS_SAMPLE_METRIC("power.gap",	"Shadow - scheduled: power estimate [mW]"),
+};
+
+
+ShadowScheduler & ShadowScheduler::GetInstance() {
+	static ShadowScheduler instance;
+	return instance;
+}
+
+ShadowScheduler::ShadowScheduler() :
+	am(ApplicationManager::GetInstance()),
+	mc(bu::MetricsCollector::GetInstance()) {
+	std::string opt_namespace(SCHEDULER_POLICY_NAMESPACE ".");
+
+	//---------- Setup the worker (and the logger module)
+	Worker::Setup(BBQUE_MODULE_NAME("ss"), SHADOW_SCHEDULER_NAMESPACE);
+
+	//---------- Loading module configuration
+	ConfigurationManager & cm(ConfigurationManager::GetInstance());
+	po::options_description opts_desc("Shadow Scheduler Options");
+	opts_desc.add_options()
+		(MODULE_CONFIG ".policy",
+		 po::value<std::string>(&policy_name)->default_value(""),
+		 "The policy to evaluate in shadow mode (empty: disabled)")
+		(MODULE_CONFIG ".file",
+		 po::value<std::string>(&file_path)->default_value(BBQUE_SS_FILE),
+		 "The file of the comparisons (empty: disabled)")
+		(MODULE_CONFIG ".pe_power_mw",
+		 po::value<uint32_t>(&pe_power_mw)->default_value(BBQUE_SS_PE_POWER_MW),
+		 "The power [mW] of a fully used processing element");
+	po::variables_map opts_vm;
+	cm.ParseConfigurationFile(opts_desc, opts_vm);
+	if (policy_name.empty())
+		return;
+
+	//---------- Load the shadow policy
+	logger->Info("Loading shadow policy [%s%s]...",
+			opt_namespace.c_str(), policy_name.c_str());
+	policy = ModulesFactory::GetModule<bp::SchedulerPolicyIF>(
+			opt_namespace + policy_name);
+	if (!policy) {
+		logger->Error("Shadow policy load FAILED "
+			"(Error: missing plugin for [%s%s])",
+			opt_namespace.c_str(), policy_name.c_str());
+		return;
+	}
+
+	//---------- Setup all the module metrics
+	mc.Register(metrics, SS_METRICS_COUNT);
+
+	// Start the shadow runs thread
+	Worker::Start();
+}
+
+ShadowScheduler::~ShadowScheduler() {
+}
+
+void ShadowScheduler::Prepare() {
+	std::unique_lock<std::mutex> worker_status_ul(worker_status_mtx);
+	busy = true;
+
+	// Not started yet: the system state is going to change
+	if (pending_job) {
+		logger->Debug("Prepare: shadow run [%d] dropped",
+			pending_job->sched_count);
+		pending_job.reset();
+		SS_COUNT_EVENT(metrics, SS_SKIPPED);
+	}
+
+	// In progress: no more bookings, and wait for it to end, since the
+	// resource state views cannot be accessed concurrently
+	if (running_job) {
+		std::unique_lock<std::mutex> shadow_ul(running_job->ctx.mtx);
+		running_job->ctx.dropped = true;
+		shadow_ul.unlock();
+		logger->Debug("Prepare: waiting for shadow run [%d] to end...",
+			running_job->sched_count);
+		while (running_job)
+			worker_status_cv.wait(worker_status_ul);
+	}
+	worker_status_ul.unlock();
+
+	next_job = std::unique_ptr<Job_t>(new Job_t);
+	am.GetShadowContext(next_job->ctx);
+}
+
+void ShadowScheduler::Evaluate(
+		char const * sched_policy,
+		uint32_t sched_count,
+		double time_ms,
+		uint32_t budget_ms) {
+	if (!next_job)
+		return;
+
+	// The outcome of the scheduling
+	for (AppPtr_t const & papp: *(next_job->ctx.all)) {
+		ba::AwmPtr_t const & next_awm(papp->NextAWM());
+		if (!next_awm || !next_awm->GetResourceBinding() ||
+				next_awm->GetResourceBinding()->empty())
+			continue;
+		next_job->outcome[papp->Uid()] =
+			{ next_awm, next_awm->GetResourceBinding() };
+	}
+	next_job->sched_policy = sched_policy;
+	next_job->sched_count  = sched_count;
+	next_job->time_ms      = time_ms;
+	next_job->budget_ms    = budget_ms;
+
+	std::unique_lock<std::mutex> worker_status_ul(worker_status_mtx);
+	pending_job = std::move(next_job);
+}
+
+void ShadowScheduler::Resume() {
+	std::unique_lock<std::mutex> worker_status_ul(worker_status_mtx);
+	busy = false;
+	worker_status_cv.notify_all();
+}
+
+void ShadowScheduler::Task() {
+	std::unique_ptr<Job_t> job;
+
+	while (!done) {
+		std::unique_lock<std::mutex> worker_status_ul(worker_status_mtx);
+		while ((!pending_job || busy) && !done)
+			worker_status_cv.wait(worker_status_ul);
+		if (done)
+			break;
+		job = std::move(pending_job);
+		running_job = job.get();
+		worker_status_ul.unlock();
+
+		Run(*job);
+
+		worker_status_ul.lock();
+		running_job = nullptr;
+		worker_status_cv.notify_all();
+		worker_status_ul.unlock();
+		job.reset();
+	}
+}
+
+void ShadowScheduler::Run(Job_t & job) {
+	System & sv(System::GetInstance());
+	ResourceAccounter & ra(ResourceAccounter::GetInstance());
+	br::RViewToken_t shadow_view = 0;
+	bu::Timer shadow_tmr;
+
+	// The accounting is not serialized: no shadow run while the system is
+	// being reconfigured
+	if (!ra.IsReady()) {
+		logger->Debug("Run: shadow [%d] skipped, accounting not ready",
+			job.sched_count);
+		SS_COUNT_EVENT(metrics, SS_SKIPPED);
+		return;
+	}
+
+	// Dropped before starting
+	std::unique_lock<std::mutex> shadow_ul(job.ctx.mtx);
+	bool dropped = job.ctx.dropped;
+	shadow_ul.unlock();
+	if (dropped) {
+		logger->Debug("Run: shadow [%d] dropped", job.sched_count);
+		SS_COUNT_EVENT(metrics, SS_SKIPPED);
+		return;
+	}
+
+	logger->Debug("Run: shadow [%d], policy [%s]...",
+		job.sched_count, policy->Name());
+
+	// From now on, this thread sees the status captured
+	ShadowContext_t::current = &(job.ctx);
+	shadow_tmr.start();
+	SchedulerPolicyIF::ExitCode_t result =
+		policy->Schedule(sv, shadow_view, job.budget_ms);
+	double time_ms = shadow_tmr.getElapsedTimeMs();
+	ShadowContext_t::current = nullptr;
+
+	// Dropped by a new scheduling, or the accounting was not ready: the
+	// outcome is not comparable
+	shadow_ul.lock();
+	dropped = job.ctx.dropped;
+	shadow_ul.unlock();
+	if (dropped) {
+		logger->Debug("Run: shadow [%d] dropped", job.sched_count);
+		SS_COUNT_EVENT(metrics, SS_SKIPPED);
+		if (shadow_view != 0)
+			ra.PutView(shadow_view);
+		return;
+	}
+
+	SS_COUNT_EVENT(metrics, SS_RUNS);
+	if (result != SchedulerPolicyIF::SCHED_DONE) {
+		logger->Warn("Run: shadow [%d], policy [%s] FAILED",
+			job.sched_count, policy->Name());
+		SS_COUNT_EVENT(metrics, SS_FAILED);
+		return;
+	}
+
+	Score_t real(GetScore(job.ctx, job.outcome));
+	real.time_ms = job.time_ms;
+	Score_t shadow(GetScore(job.ctx, job.ctx.requests));
+	shadow.time_ms = time_ms;
+
+	// Nothing to commit
+	ra.PutView(shadow_view);
+
+	Report(job, real, shadow);
+}
+
+ShadowScheduler::Score_t ShadowScheduler::GetScore(
+		ShadowContext_t const & ctx,
+		ShadowContext_t::Requests_t const & outcome) const {
+	ResourceAccounter & ra(ResourceAccounter::GetInstance());
+	Score_t score;
+	double value_sum  = 0;
+	double value_sum2 = 0;
+	uint16_t count = 0;
+
+	for (AppPtr_t const & papp: *(ctx.all)) {
+		auto state_it = ctx.apps.find(papp->Uid());
+		if (state_it == ctx.apps.end())
+			continue;
+		ShadowContext_t::AppState_t const & app_state(state_it->second);
+		if ((app_state.state != ApplicationStatusIF::READY) &&
+				(app_state.state != ApplicationStatusIF::RUNNING))
+			continue;
+		++count;
+
+		// Not scheduled: a running EXC is going to be blocked
+		auto request_it = outcome.find(papp->Uid());
+		if (request_it == outcome.end()) {
+			if (app_state.awm)
+				++score.reconfs;
+			continue;
+		}
+		ShadowContext_t::Request_t const & request(request_it->second);
+		++score.scheduled;
+
+		// AWM value, normalized to the highest one
+		double value = 0;
+		if (!papp->WorkingModes().empty() &&
+				(papp->HighValueAWM()->Value() > 0))
+			value = request.awm->Value() / papp->HighValueAWM()->Value();
+		value_sum  += value;
+		value_sum2 += value * value;
+
+		// Reconfiguration or migration
+		if (!app_state.awm || (app_state.awm->Id() != request.awm->Id()))
+			++score.reconfs;
+		else if (app_state.binding &&
+				(br::ResourceBinder::GetMask(
+					app_state.binding, br::ResourceType::CPU) !=
+				 br::ResourceBinder::GetMask(
+					request.binding, br::ResourceType::CPU)))
+			++score.migrations;
+
+		// Processing quota [%], linear power model
+		score.power_mw += static_cast<double>(pe_power_mw) *
+			ra.GetAssignedAmount(
+				request.binding, br::ResourceType::PROC_ELEMENT) / 100.0;
+	}
+
+	if (count > 0)
+		score.value = value_sum / count;
+	if (value_sum2 > 0)
+		score.fairness = (value_sum * value_sum) / (count * value_sum2);
+	return score;
+}
+
+void ShadowScheduler::Report(
+		Job_t const & job,
+		Score_t const & real,
+		Score_t const & shadow) {
+
+	SS_ADD_SAMPLE(metrics, SS_TIME, shadow.time_ms);
+	SS_ADD_SAMPLE(metrics, SS_VALUE_GAP, shadow.value - real.value);
+	SS_ADD_SAMPLE(metrics, SS_FAIRNESS_GAP, shadow.fairness - real.fairness);
+	SS_ADD_SAMPLE(metrics, SS_RECONF_GAP,
+		static_cast<double>(shadow.reconfs) - real.reconfs);
+	SS_ADD_SAMPLE(metrics, SS_POWER_GAP, shadow.power_mw - real.power_mw);
+
+	logger->Notice(
+		"| %5d | %-12s | Value | Fness | Recnf | Migr | Sched | Power[mW] | t[ms] |",
+		job.sched_count, "Policy");
+	logger->Notice(
+		"| %5s | %-12s | %5.3f | %5.3f | %5d | %4d | %5d | %9.0f | %5.1f |",
+		"sched", job.sched_policy.c_str(), real.value, real.fairness,
+		real.reconfs, real.migrations, real.scheduled, real.power_mw,
+		real.time_ms);
+	logger->Notice(
+		"| %5s | %-12s | %5.3f | %5.3f | %5d | %4d | %5d | %9.0f | %5.1f |",
+		"shdw", policy_name.c_str(), shadow.value, shadow.fairness,
+		shadow.reconfs, shadow.migrations, shadow.scheduled, shadow.power_mw,
+		shadow.time_ms);
+
+	if (file_path.empty())
+		return;
+
+	// A line for each outcome, appended
+	bool header = (std::ifstream(file_path).peek() ==
+		std::ifstream::traits_type::eof());
+	std::ofstream ofs(file_path, std::ios::app);
+	if (!ofs.is_open()) {
+		logger->Error("Report: cannot write [%s]", file_path.c_str());
+		return;
+	}
+	if (header)
+		ofs << "# <sched> <role> <policy> <value> <fairness> <reconfs> "
+			"<migrations> <scheduled> <power[mW]> <time[ms]>\n";
+	for (auto const & entry: {
+			std::make_tuple("sched", job.sched_policy.c_str(), &real),
+			std::make_tuple("shadow", policy_name.c_str(), &shadow) }) {
+		Score_t const & score(*std::get<2>(entry));
+		ofs << job.sched_count << " " << std::get<0>(entry) << " "
+			<< std::get<1>(entry) << " " << score.value << " "
+			<< score.fairness << " " << score.reconfs << " "
+			<< score.migrations << " " << score.scheduled << " "
+			<< score.power_mw << " " << score.time_ms << "\n";
+	}
+}
+
+} // namespace bbque
@@ -21,6 +21,7 @@
 #include "bbque/configuration_manager.h"
 #include "bbque/modules_factory.h"
 #include "bbque/plugin_manager.h"
+#include "bbque/reconfig_cost_model.h"
 #include "bbque/resource_accounter.h"
 #include "bbque/system.h"
 
@@ -161,7 +162,7 @@ SynchronizationManager::Reshuffling(AppPtr_t papp) {
 SynchronizationManager::ExitCode_t
 SynchronizationManager::Sync_PreChange(ApplicationStatusIF::SyncState_t syncState) {
 	ExitCode_t syncInProgress = NO_EXC_IN_SYNC;
-	AppsUidMapIt apps_it;
+	std::vector<AppPtr_t>::const_iterator apps_it;
 
 	typedef std::map<AppPtr_t, ApplicationProxy::pPreChangeRsp_t> RspMap_t;
 	typedef std::pair<AppPtr_t, ApplicationProxy::pPreChangeRsp_t> RspMapEntry_t;
@@ -175,11 +176,8 @@ SynchronizationManager::Sync_PreChange(ApplicationStatusIF::SyncState_t syncStat
 	logger->Debug("STEP 1: preChange() START");
 	SM_RESET_TIMING(sm_tmr);
 
-	papp = am.GetFirst(syncState, apps_it);
-	for ( ; papp; papp = am.GetNext(syncState, apps_it)) {
-
-		if (!policy->DoSync(papp))
-			continue;
+	for (apps_it = sync_apps.begin(); apps_it != sync_apps.end(); ++apps_it) {
+		papp = *apps_it;
 
 		if (Reshuffling(papp) ||
 			papp->IsContainer()) {
@@ -199,7 +197,9 @@ SynchronizationManager::Sync_PreChange(ApplicationStatusIF::SyncState_t syncStat
 		// Pre-Change (just starting it if asynchronous)
 		presp = ApplicationProxy::pPreChangeRsp_t(
 				new ApplicationProxy::preChangeRsp_t());
+		sync_tmr.start();
 		result = ap.SyncP_PreChange(papp, presp);
+		sync_times[papp->Uid()] = sync_tmr.getElapsedTimeMs();
 		if (result != RTLIB_OK)
 			continue;
 
@@ -223,7 +223,9 @@ SynchronizationManager::Sync_PreChange(ApplicationStatusIF::SyncState_t syncStat
 		presp = (*resp_it).second;
 #endif
 
+		sync_tmr.start();
 Sync_PreChange_Check_EXC_Response(papp, presp);
+		sync_times[papp->Uid()] += sync_tmr.getElapsedTimeMs();
 
 // Pre-Change completion (just if asynchronous)
 #ifdef CONFIG_BBQUE_YP_SASB_ASYNC
@@ -304,7 +306,7 @@ void SynchronizationManager::Sync_PreChange_Check_EXC_Response(AppPtr_t papp,
 SynchronizationManager::ExitCode_t
 SynchronizationManager::Sync_SyncChange(
 		ApplicationStatusIF::SyncState_t syncState) {
-	AppsUidMapIt apps_it;
+	std::vector<AppPtr_t>::const_iterator apps_it;
 
 	typedef std::map<AppPtr_t, ApplicationProxy::pSyncChangeRsp_t> RspMap_t;
 	typedef std::pair<AppPtr_t, ApplicationProxy::pSyncChangeRsp_t> RspMapEntry_t;
@@ -318,11 +320,8 @@ SynchronizationManager::Sync_SyncChange(
 	logger->Debug("STEP 2: syncChange() START");
 	SM_RESET_TIMING(sm_tmr);
 
-	papp = am.GetFirst(syncState, apps_it);
-	for ( ; papp; papp = am.GetNext(syncState, apps_it)) {
-
-		if (!policy->DoSync(papp))
-			continue;
+	for (apps_it = sync_apps.begin(); apps_it != sync_apps.end(); ++apps_it) {
+		papp = *apps_it;
 
 		if (Reshuffling(papp) ||
 			papp->IsContainer())
@@ -340,9 +339,13 @@ SynchronizationManager::Sync_SyncChange(
 		// Sync-Change (just starting it if asynchronous)
 		presp = ApplicationProxy::pSyncChangeRsp_t(
 				new ApplicationProxy::syncChangeRsp_t());
+		sync_tmr.start();
 		result = ap.SyncP_SyncChange(papp, presp);
-		if (result != RTLIB_OK)
+		if (result != RTLIB_OK) {
+			sync_times.erase(papp->Uid());
 			continue;
+		}
+		sync_times[papp->Uid()] += sync_tmr.getElapsedTimeMs();
 
 // Sync-Change completion (just if asynchronous)
 #ifdef CONFIG_BBQUE_YP_SASB_ASYNC
@@ -358,8 +361,17 @@ SynchronizationManager::Sync_SyncChange(
 		presp = (*resp_it).second;
 #endif
 
+		sync_tmr.start();
 	Sync_SyncChange_Check_EXC_Response(papp, presp);
 
+		// Synchronization point reached: the time of the calls (and of
+		// the responses) of this EXC only, not the ones of the others
+		auto time_it = sync_times.find(papp->Uid());
+		if (papp->Disabled())
+			sync_times.erase(papp->Uid());
+		else if (time_it != sync_times.end())
+			time_it->second += sync_tmr.getElapsedTimeMs();
+
 // Sync-Change completion (just if asynchronous)
 #ifdef CONFIG_BBQUE_YP_SASB_ASYNC
 		// Remove the respose future
@@ -439,7 +451,7 @@ void SynchronizationManager::Sync_SyncChange_Check_EXC_Response(AppPtr_t papp,
 
 SynchronizationManager::ExitCode_t
 SynchronizationManager::Sync_DoChange(ApplicationStatusIF::SyncState_t syncState) {
-	AppsUidMapIt apps_it;
+	std::vector<AppPtr_t>::const_iterator apps_it;
 
 	RTLIB_ExitCode_t result;
 	AppPtr_t papp;
@@ -447,11 +459,8 @@ SynchronizationManager::Sync_DoChange(ApplicationStatusIF::SyncState_t syncState
 	logger->Debug("STEP 3: doChange() START");
 	SM_RESET_TIMING(sm_tmr);
 
-	papp = am.GetFirst(syncState, apps_it);
-	for ( ; papp; papp = am.GetNext(syncState, apps_it)) {
-
-		if (!policy->DoSync(papp))
-			continue;
+	for (apps_it = sync_apps.begin(); apps_it != sync_apps.end(); ++apps_it) {
+		papp = *apps_it;
 
 		if (Reshuffling(papp) ||
 			papp->IsContainer())
@@ -485,18 +494,15 @@ SynchronizationManager::Sync_DoChange(ApplicationStatusIF::SyncState_t syncState
 SynchronizationManager::ExitCode_t
 SynchronizationManager::Sync_PostChange(ApplicationStatusIF::SyncState_t syncState) {
 	ApplicationProxy::pPostChangeRsp_t presp;
-	AppsUidMapIt apps_it;
+	std::vector<AppPtr_t>::const_iterator apps_it;
 	AppPtr_t papp;
 	uint8_t excs = 0;
 
 	logger->Debug("STEP 4: postChange() START");
 	SM_RESET_TIMING(sm_tmr);
 
-	papp = am.GetFirst(syncState, apps_it);
-	for ( ; papp; papp = am.GetNext(syncState, apps_it)) {
-
-		if (!policy->DoSync(papp))
-			continue;
+	for (apps_it = sync_apps.begin(); apps_it != sync_apps.end(); ++apps_it) {
+		papp = *apps_it;
 
 		if (! (Reshuffling(papp) || papp->IsContainer()) ) {
 
@@ -516,9 +522,21 @@ SynchronizationManager::Sync_PostChange(ApplicationStatusIF::SyncState_t syncSta
 		if (papp->Disabled())
 			continue;
 
+		// Measured transition cost, before committing the next AWM
+		if (!(Reshuffling(papp) || papp->IsContainer()))
+			CollectTransitionCost(papp);
+
 		// Perform resource acquisition for RUNNING App/ExC
-		DoAcquireResources(papp);
+		bool acquired = DoAcquireResources(papp);
 		excs++;
+
+#ifdef CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+		// The assignment received at PreChange is now committed
+		if (acquired)
+			ap.SyncP_PostChangePublish(papp);
+#else
+		UNUSED(acquired);
+#endif
 	}
 
 	// Collecing execution metrics
@@ -535,10 +553,11 @@ SynchronizationManager::Sync_PostChange(ApplicationStatusIF::SyncState_t syncSta
 	return OK;
 }
 
-void SynchronizationManager::DoAcquireResources(AppPtr_t papp) {
+bool SynchronizationManager::DoAcquireResources(AppPtr_t papp) {
 	ApplicationManager &am(ApplicationManager::GetInstance());
 	ResourceAccounter &ra(ResourceAccounter::GetInstance());
 	ResourceAccounter::ExitCode_t raResult;
+	bool acquired = true;
 
 	// Acquiring the resources for RUNNING Applications
 	if (!papp->Blocking()) {
@@ -555,6 +574,7 @@ void SynchronizationManager::DoAcquireResources(AppPtr_t papp) {
 			logger->Error("SyncAcquire: failed for [%s]. Returned %d",
 					papp->StrId(), raResult);
 			am.SyncAbort(papp);
+			acquired = false;
 		}
 	}
 
@@ -562,23 +582,47 @@ void SynchronizationManager::DoAcquireResources(AppPtr_t papp) {
 	// NOTE: this should remove the current app from the queue,
 	// otherwise we enter an endless loop
 	am.SyncCommit(papp);
+	return acquired;
 }
 
+void SynchronizationManager::CollectTransitionCost(AppPtr_t papp) {
+	ReconfigCostModel & rcm(ReconfigCostModel::GetInstance());
+
+	// Only the transitions between two AWMs (starting EXCs excluded)
+	switch (papp->SyncState()) {
+	case ApplicationStatusIF::RECONF:
+	case ApplicationStatusIF::MIGREC:
+	case ApplicationStatusIF::MIGRATE:
+		break;
+	default:
+		return;
+	}
+	app::AwmPtr_t const & curr_awm(papp->CurrentAWM());
+	app::AwmPtr_t const & next_awm(papp->NextAWM());
+	if (!curr_awm || !next_awm)
+		return;
+
+	auto time_it = sync_times.find(papp->Uid());
+	if (time_it == sync_times.end())
+		return;
+	double cost_ms = time_it->second +
+		curr_awm->GetProfilingData().sync_time;
+	logger->Debug("SyncCost: [%s] AWM %d->%d cost %.3f[ms]",
+		papp->StrId(), curr_awm->Id(), next_awm->Id(), cost_ms);
+	rcm.AddSample(papp, curr_awm->Id(), next_awm->Id(), cost_ms);
+}
 
 SynchronizationManager::ExitCode_t
 SynchronizationManager::Sync_Platform(ApplicationStatusIF::SyncState_t syncState) {
     PlatformManager::ExitCode_t result = PlatformManager::PLATFORM_OK;
-	AppsUidMapIt apps_it;
+	std::vector<AppPtr_t>::const_iterator apps_it;
 	AppPtr_t papp;
 
 	logger->Debug("STEP M: SyncPlatform() START");
 	SM_RESET_TIMING(sm_tmr);
 
-	papp = am.GetFirst(syncState, apps_it);
-	for ( ; papp; papp = am.GetNext(syncState, apps_it)) {
-
-		if (!policy->DoSync(papp))
-			continue;
+	for (apps_it = sync_apps.begin(); apps_it != sync_apps.end(); ++apps_it) {
+		papp = *apps_it;
 
 		logger->Info("STEP M: SyncPlatform() ===> [%s]", papp->StrId());
 
@@ -590,7 +634,7 @@ SynchronizationManager::Sync_Platform(ApplicationStatusIF::SyncState_t syncState
 		}
 
 		// TODO: reconfigure resources
-		switch (syncState) {
+		switch (papp->SyncState()) {
 		case ApplicationStatusIF::STARTING:
             result = plm.MapResources(papp,
 					papp->NextAWM()->GetResourceBinding());
@@ -628,6 +672,34 @@ SynchronizationManager::Sync_Platform(ApplicationStatusIF::SyncState_t syncState
 	return PLATFORM_SYNC_FAILED;
 }
 
+void SynchronizationManager::SelectSyncApps(
+		ApplicationStatusIF::SyncState_t syncState) {
+	AppsUidMapIt apps_it;
+	AppPtr_t papp;
+	uint8_t first = syncState;
+	uint8_t last  = syncState;
+
+	// Multi-state rounds: scan all the synchronization queues
+	if (policy->MultiStateRounds()) {
+		first = ApplicationStatusIF::STARTING;
+		last  = ApplicationStatusIF::SYNC_STATE_COUNT - 1;
+	}
+
+	sync_apps.clear();
+	for (uint8_t state = first; state <= last; ++state) {
+		auto sync_state = static_cast<ApplicationStatusIF::SyncState_t>(state);
+		papp = am.GetFirst(sync_state, apps_it);
+		for ( ; papp; papp = am.GetNext(sync_state, apps_it)) {
+			if (!policy->DoSync(papp))
+				continue;
+			sync_apps.push_back(papp);
+		}
+	}
+
+	logger->Debug("SelectSyncApps: %lu EXCs selected for synchronization",
+			sync_apps.size());
+}
+
 SynchronizationManager::ExitCode_t
 SynchronizationManager::SyncApps(ApplicationStatusIF::SyncState_t syncState) {
 	ExitCode_t result;
@@ -638,6 +710,10 @@ SynchronizationManager::SyncApps(ApplicationStatusIF::SyncState_t syncState) {
 		return OK;
 	}
 
+	// Select the EXCs to be served by all the protocol steps
+	SelectSyncApps(syncState);
+	sync_times.clear();
+
 #ifdef CONFIG_BBQUE_YM_SYNC_FORCE
 	SynchronizationPolicyIF::SyncLatency_t syncLatency;
 
@@ -26,11 +26,26 @@
 #include <unistd.h>
 #include <string.h>
 #include <stdarg.h>
+#include <errno.h>
 
 #define MODULE_NAMESPACE "bq.rtlib.perf"
 
+// User-space counters reads are supported on x86 only
+#if (defined(__x86_64__) || defined(__i386__)) && \
+	LINUX_VERSION_CODE >= KERNEL_VERSION(3,12,0)
+# define BBQUE_PERF_RDPMC
+#endif
+
 namespace bbque { namespace utils {
 
+#ifdef BBQUE_PERF_RDPMC
+static inline uint64_t rdpmc(uint32_t counter) {
+	uint32_t low, high;
+	asm volatile("rdpmc" : "=a" (low), "=d" (high) : "c" (counter));
+	return low | ((uint64_t)high) << 32;
+}
+#endif
+
 Perf::Perf() :
 	opened(false) {
 
@@ -62,6 +77,17 @@ int Perf::EventOpen(struct perf_event_attr *attr,
 	attr->size = sizeof(*attr);
 	result = syscall(__NR_perf_event_open, attr, pid, cpu,
 			group_fd, flags);
+	if ((result == -1) && (errno == EINVAL) &&
+			(attr->read_format & PERF_FORMAT_GROUP)) {
+		// Group reads of inherited counters are not supported by older
+		// kernels: fall back to per-counter reads
+		fprintf(stderr, FW("PERF group reads not supported, "
+					"using per-counter reads\n"));
+		grouped = false;
+		attr->read_format &= ~PERF_FORMAT_GROUP;
+		result = syscall(__NR_perf_event_open, attr, pid, cpu,
+				-1, flags);
+	}
 	if (result == -1) {
 		fprintf(stderr, FE("Opening PERF counters FAILED "
 					"(Error: %s)\n"), strerror(errno));
@@ -78,7 +104,7 @@ int Perf::AddCounter(perf_type_id type,
 	pRegisteredCounter_t prc(new RegisteredCounter());
 
 	// Set default counter options
-	prc->attr.inherit = 1;
+	prc->attr.inherit = self_monitoring ? 0 : 1;
 	prc->attr.disabled = 1;
 	//prc->attr.exclude_idle = 1;
 
@@ -91,14 +117,32 @@ int Perf::AddCounter(perf_type_id type,
 	// Define read format
 	prc->attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | \
 							PERF_FORMAT_TOTAL_TIME_RUNNING;
+	if (grouped)
+		prc->attr.read_format |= PERF_FORMAT_GROUP;
 
 	// Define the event to read
 	prc->attr.type = type;
 	prc->attr.config = config;
 
-	// Add a new event counter
-	prc->fd = EventOpen(&(prc->attr), gettid(), -1, -1, 0);
-	//prc->fd = EventOpen(&(prc->attr), gettid(), -1, GroupLeader(), 0);
+	// Add a new event counter to its group
+	int group_fd = SelectGroup(prc);
+	prc->fd = EventOpen(&(prc->attr), gettid(), -1,
+			grouped ? group_fd : -1, 0);
+
+	CountersGroup_t & group(groups[prc->group_id]);
+	if (group.leader_fd == -1)
+		group.leader_fd = prc->fd;
+	group.members.push_back(prc);
+	group.buffer.resize(3 + group.members.size());
+	group.samples.resize(group.members.size());
+
+	// Map the counter in user-space for syscall-free reads
+	if (self_monitoring) {
+		void * addr = mmap(NULL, sysconf(_SC_PAGESIZE), PROT_READ,
+				MAP_SHARED, prc->fd, 0);
+		if (addr != MAP_FAILED)
+			prc->mpage = (struct perf_event_mmap_page *) addr;
+	}
 
 	// Keep track of GroupLeader
 	if (!IsGroupLeaderDefined()) {
@@ -107,12 +151,32 @@ int Perf::AddCounter(perf_type_id type,
 
 	counters[prc->fd] = prc;
 
-	fprintf(stderr, FI("Added new PERF counter [%02d:%d:%02lu]\n"),
-			prc->fd, type, config);
+	fprintf(stderr, FI("Added new PERF counter [%02d:%d:%02lu] group %d\n"),
+			prc->fd, type, config, prc->group_id);
 
 	return prc->fd;
 }
 
+int Perf::SelectGroup(pRegisteredCounter_t prc) {
+	bool hardware = (prc->attr.type != PERF_TYPE_SOFTWARE);
+
+	// Look for the last group of the same kind with a free slot
+	for (int g = groups.size() - 1; g >= 0; --g) {
+		if (groups[g].hardware != hardware)
+			continue;
+		if (hardware && (groups[g].members.size() >= MaxGroupHWCounters))
+			break;
+		prc->group_id = g;
+		return groups[g].leader_fd;
+	}
+
+	// Start a new group, lead by this counter
+	groups.emplace_back();
+	groups.back().hardware = hardware;
+	prc->group_id = groups.size() - 1;
+	return -1;
+}
+
 int Perf::Enable() {
 	if (!IsGroupLeaderDefined()) {
 		fprintf(stderr, FE("Enabling PERF counters FAILED "
@@ -153,27 +217,121 @@ int Perf::ReadCounter(int fd, void *buf, size_t n) {
 #define UPDATE_DELTA(COUNTER)\
 	prc->delta.COUNTER = prc->count.COUNTER - old_count.COUNTER
 
-uint64_t Perf::Update(int id, bool delta) {
-	pRegisteredCounter_t prc = counters[id];
+void Perf::UpdateCounter(pRegisteredCounter_t prc,
+		ReadFormat_t const & sample) {
 	ReadFormat_t old_count = prc->count;
-	ssize_t bytes;
+	prc->count = sample;
 
-	if (!opened || !prc) {
+	// Update deltas since last update
+	UPDATE_DELTA(value);
+	UPDATE_DELTA(time_enabled);
+	UPDATE_DELTA(time_running);
+}
+
+bool Perf::ReadGroupUser(CountersGroup_t & group) {
+#ifdef BBQUE_PERF_RDPMC
+	ReadFormat_t * samples = group.samples.data();
+
+	for (size_t i = 0; i < group.members.size(); ++i) {
+		struct perf_event_mmap_page * pc = group.members[i]->mpage;
+		uint32_t seq, idx;
+		int64_t pmc;
+
+		if (pc == nullptr)
+			return false;
+
+		// Retry if the kernel updated the page while reading
+		do {
+			seq = pc->lock;
+			__sync_synchronize();
+			idx = pc->index;
+			if (!pc->cap_user_rdpmc || (idx == 0))
+				return false;
+			pmc = rdpmc(idx - 1);
+			// Sign extend to the counter width
+			pmc <<= 64 - pc->pmc_width;
+			pmc >>= 64 - pc->pmc_width;
+			samples[i].value = pc->offset + pmc;
+			samples[i].time_enabled = pc->time_enabled;
+			samples[i].time_running = pc->time_running;
+			__sync_synchronize();
+		} while (pc->lock != seq);
+	}
+	return true;
+#else
+	(void) group;
+	return false;
+#endif
+}
+
+int Perf::UpdateGroup(CountersGroup_t & group) {
+	size_t nr = group.members.size();
+	ReadFormat_t * samples = group.samples.data();
+
+	// Syscall-free update, if all the counters are active in user-space
+	if (self_monitoring && ReadGroupUser(group)) {
+		for (size_t i = 0; i < nr; ++i)
+			UpdateCounter(group.members[i], samples[i]);
+		return 0;
+	}
+
+	// Per-counter reads
+	if (!grouped) {
+		for (auto & prc : group.members) {
+			if (ReadCounter(prc->fd, &samples[0], sizeof(ReadFormat_t))
+					!= sizeof(ReadFormat_t))
+				return -1;
+			UpdateCounter(prc, samples[0]);
+		}
+		return 0;
+	}
+
+	// Single group read: nr, time_enabled, time_running, values[nr]
+	int bytes = group.buffer.size() * sizeof(uint64_t);
+	if (ReadCounter(group.leader_fd, group.buffer.data(), bytes) != bytes)
+		return -1;
+	assert(group.buffer[0] == nr);
+
+	for (size_t i = 0; i < nr; ++i) {
+		samples[i].value = group.buffer[3 + i];
+		samples[i].time_enabled = group.buffer[1];
+		samples[i].time_running = group.buffer[2];
+		UpdateCounter(group.members[i], samples[i]);
+	}
+	return 0;
+}
+
+int Perf::UpdateAll() {
+	int result = 0;
+
+	if (!opened) {
+		fprintf(stderr, FE("Reading PERF counters FAILED "
+					"(Error: Counters not opened)\n"));
+		return -1;
+	}
+
+	for (auto & group : groups) {
+		if (UpdateGroup(group) != 0)
+			result = -1;
+	}
+	return result;
+}
+
+uint64_t Perf::Update(int id, bool delta) {
+	auto it = counters.find(id);
+
+	if (!opened || (it == counters.end())) {
 		fprintf(stderr, FE("Reading PERF counter FAILED "
 					"(Error: Counters not opened or invalid counter [%d])\n"),
 				id);
 		return 0;
 	}
 
-	// Reading counters
-	bytes = ReadCounter(id, &(prc->count), sizeof(prc->count));
-	assert(bytes == sizeof(prc->count));
-	(void)bytes; // quite compilation warning on RELEASE build
-
-	// Update deltas since last update
-	UPDATE_DELTA(value);
-	UPDATE_DELTA(time_enabled);
-	UPDATE_DELTA(time_running);
+	// Reading counters (the whole group is updated)
+	pRegisteredCounter_t prc = it->second;
+	int result = UpdateGroup(groups[prc->group_id]);
+	assert(result == 0);
+	(void)result; // quite compilation warning on RELEASE build
 
 	if (delta)
 		return (prc->delta).value;
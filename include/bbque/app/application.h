@@ -100,6 +100,11 @@ struct RuntimeProfiling_t {
 	/** Cycle time */
 	int ctime_ms = 0;
 
+	/** LLC misses per kilo-cycle (0 if not measured) */
+	float llc_mpkc = 0.0;
+	/** Memory bandwidth [MB/s] estimated from the LLC misses */
+	uint32_t mem_bw_mbps = 0;
+
 	/** The maximum CPU Usage allocated to an application. It should be
 	 * set by the scheduling policy and optionally compared with the variable
 	 * `cpu_usage` */
@@ -107,6 +112,35 @@ struct RuntimeProfiling_t {
 	int cpu_usage_prediction_old = 0;
 };
 
+/**
+ * @brief The resource usage of an application, measured by the platform
+ * (e.g., from the statistics of its Linux control group)
+ */
+struct ResourceUsage_t {
+	bool is_valid = false;
+
+	/** Total CPU time consumed [us] */
+	uint64_t cpu_time_us = 0;
+	/** CPU usage in the last sampling period [% of a single CPU] */
+	uint32_t cpu_usage = 0;
+	/** CPU bandwidth quota [% of a single CPU], 0 if not enforced */
+	uint32_t cpu_quota = 0;
+	/** Total time spent throttled by the CPU bandwidth control [us] */
+	uint64_t cpu_throttled_us = 0;
+
+	/** Current memory usage, including the page cache [bytes] */
+	uint64_t mem_current = 0;
+	/** Anonymous (resident) memory [bytes] */
+	uint64_t mem_anon = 0;
+
+	/** Total bytes read from/written to block devices */
+	uint64_t io_read_bytes  = 0;
+	uint64_t io_write_bytes = 0;
+	/** Block devices bandwidth in the last sampling period [bytes/s] */
+	uint64_t io_read_bps  = 0;
+	uint64_t io_write_bps = 0;
+};
+
 /**
  * @class ApplicationConfIF
  *
@@ -190,7 +224,7 @@ public:
 	/**
 	 * @see ApplicationConfIF
 	 */
-	inline void SetValue(float sched_metrics) noexcept { schedule.value = sched_metrics; }
+	void SetValue(float sched_metrics) noexcept;
 
 	/**
 	 * @see ApplicationStatusIF
@@ -219,6 +253,14 @@ public:
 	 */
 	inline RecipePtr_t GetRecipe() noexcept { return recipe; }
 
+	/**
+	 * @see ApplicationStatusIF
+	 */
+	inline std::string const & RecipeName() const noexcept {
+		static std::string const no_recipe;
+		return recipe ? recipe->Path() : no_recipe;
+	}
+
 	/**
 	 * @brief Set the current recipe used by the application.
 	 *
@@ -373,17 +415,17 @@ public:
 	/**
 	 * @see ApplicationStatusIF
 	 */
-	inline AwmPtrList_t const & WorkingModes() noexcept { return awms.enabled_list; }
+	AwmPtrList_t const & WorkingModes() noexcept;
 
 	/**
 	 * @see ApplicationStatusIF
 	 */
-	inline AwmPtr_t const & LowValueAWM() noexcept { return awms.enabled_list.front(); }
+	AwmPtr_t const & LowValueAWM() noexcept;
 
 	/**
 	 * @see ApplicationStatusIF
 	 */
-	inline AwmPtr_t const & HighValueAWM() noexcept { return awms.enabled_list.back(); }
+	AwmPtr_t const & HighValueAWM() noexcept;
 
 	/**
 	 * @see ApplicationStatusIF
@@ -420,6 +462,29 @@ public:
 	 */
 	void ScheduleAbort();
 
+	/**
+	 * @brief Check if the resources of the application have been resized
+	 *
+	 * The application continues to run in the same AWM, and using the same
+	 * binding, but the amounts of resources assigned have been changed by
+	 * the last scheduling. The new amounts must be enforced without a
+	 * synchronization (@see ApplicationManager::ResizeCommit()).
+	 */
+	bool Resizing();
+
+	/**
+	 * @brief Clear the resizing of the resources
+	 */
+	void ClearResizing();
+
+	/**
+	 * @brief Synchronize the resizing of the resources as a reconfiguration
+	 * into the current AWM, since it cannot be enforced in place
+	 *
+	 * This must be called only if the application is RUNNING.
+	 */
+	ExitCode_t ResizeReconf();
+
 	/**
 	 * @brief The application can continue to run
 	 *
@@ -548,6 +613,26 @@ public:
 		rt_prof.ggap_percent_prediction  = goal_gap_prediction;
 	}
 
+	/**
+	 * @brief Get the resource usage measured by the platform
+	 *
+	 * @return A data structure of type ResourceUsage_t
+	 */
+	inline ResourceUsage_t GetResourceUsage() {
+		std::unique_lock<std::mutex> usage_lock(rsrc_usage_mtx);
+		return rsrc_usage;
+	}
+
+	/**
+	 * @brief Save the resource usage measured by the platform
+	 *
+	 * @param usage The structure containing the usage data
+	 */
+	inline void SetResourceUsage(ResourceUsage_t const & usage) {
+		std::unique_lock<std::mutex> usage_lock(rsrc_usage_mtx);
+		rsrc_usage = usage;
+	}
+
 	// -------------------------- Task-graph management ------------------------------------- //
 
 #ifdef CONFIG_BBQUE_TG_PROG_MODEL
@@ -651,6 +736,13 @@ private:
 
 	std::mutex rt_prof_mtx;
 
+	/**
+	 * @brief Resource usage measured by the platform
+	 */
+	ResourceUsage_t rsrc_usage;
+
+	std::mutex rsrc_usage_mtx;
+
 	/**
 	 * Task-graph serialization file path
 	 */
@@ -914,9 +1006,13 @@ private:
 
 	/**
 	 * @brief Configure this application to switch to the specified AWM
+	 *
+	 * @param awm the target working mode
+	 * @param status_view the resource state view of the scheduling
+	 *
 	 * @return @see ExitCode_t
 	 */
-	ExitCode_t Reschedule(AwmPtr_t const & awm);
+	ExitCode_t Reschedule(AwmPtr_t const & awm, br::RViewToken_t status_view);
 
 	/**
 	 * @brief Configure this application to release resources.
@@ -936,6 +1032,7 @@ private:
 	 * clusters used in the previous execution step.
 	 *
 	 * @param awm the target working mode
+	 * @param status_view the resource state view of the scheduling
  	 *
 	 * @return One of the following values:
 	 * - RECONF: Application is being scheduled for using PEs from the same
@@ -945,10 +1042,12 @@ private:
 	 * - MIGREC: Application changes completely its execution profile. Both
 	 *   WorkingMode and clusters set are different from the previous run.
 	 * - SYNC_NONE: Nothing changes. Application is going to run in the same
-	 *   operating point.
-	 *
+	 *   operating point. Only the amounts of the resources bound can change,
+	 *   if they fit the current system status: in such a case the
+	 *   application is marked as resizing (@see Resizing()).
 	 */
-	SyncState_t SyncRequired(AwmPtr_t const & awm);
+	SyncState_t SyncRequired(AwmPtr_t const & awm,
+			br::RViewToken_t status_view);
 
 	/**
 	 * @brief Check if this is a reshuffling
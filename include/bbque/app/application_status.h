@@ -152,6 +152,11 @@ public:
 		float value;
 		/** How many times the application has been scheduled */
 		uint64_t count = 0;
+		/**
+		 * The amounts of resources assigned have been changed, in the same
+		 * AWM and binding, without requiring a synchronization
+		 */
+		bool resize = false;
 
 		/** Overloading of operator != for structure comparisons */
 		inline bool operator!=(SchedulingInfo_t const &other) const {
@@ -185,6 +190,12 @@ public:
 	 */
 	virtual std::string const & Name() const = 0;
 
+	/**
+	 * @brief Get the name of the recipe
+	 * @return The recipe name string (empty if no recipe is set)
+	 */
+	virtual std::string const & RecipeName() const = 0;
+
 	/**
 	 * @brief Get the process ID of the application
 	 * @return PID value
@@ -375,6 +386,13 @@ public:
 	virtual struct RuntimeProfiling_t GetRuntimeProfile(
 			bool mark_outdated = false) = 0;
 
+	/**
+	 * @brief Get the resource usage of this app, measured by the platform
+	 *
+	 * @return the usage data, valid only if the platform supports it
+	 */
+	virtual struct ResourceUsage_t GetResourceUsage() = 0;
+
 	/**
 	 * @brief SetRuntime Profile information for this app
 	 */
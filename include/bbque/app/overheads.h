@@ -51,6 +51,24 @@ public:
 		last_switch_time = time;
 		max_switch_time = time;
 		min_switch_time = time;
+		sum_switch_time = time;
+	}
+
+	/**
+	 * @brief Constructor, restoring previously collected statistics
+	 * @param count Number of transitions
+	 * @param avg_time The average transition time
+	 * @param min_time The minimum transition time
+	 * @param max_time The maximum transition time
+	 * @param last_time The last transition time
+	 */
+	TransitionOverheads(uint16_t count, double avg_time,
+			double min_time, double max_time, double last_time):
+		min_switch_time(min_time),
+		max_switch_time(max_time),
+		last_switch_time(last_time),
+		sum_switch_time(avg_time * count),
+		switch_count(count) {
 	}
 
 	/**
@@ -64,6 +82,7 @@ public:
 	inline void SetSwitchTime(double time) {
 		// Set last switch time
 		last_switch_time = time;
+		sum_switch_time += time;
 
 		// Update max and min values
 		if ((min_switch_time == 0) && (max_switch_time == 0)) {
@@ -97,6 +116,7 @@ public:
 	 */
 	inline void ResetCount() {
 		switch_count = 0;
+		sum_switch_time = 0;
 	}
 
 	/**
@@ -107,6 +127,15 @@ public:
 		return last_switch_time;
 	}
 
+	/**
+	 * @brief Average time measured for this transition over all the
+	 * reconfigurations
+	 * @return Average time registered
+	 */
+	inline double AvgTime() const {
+		return (switch_count > 0) ? sum_switch_time / switch_count : 0;
+	}
+
 	/**
 	 * @brief Minimum time measured for this transition over all the
 	 * reconfigurations
@@ -136,6 +165,9 @@ private:
 	/** The time spent in transition from last to current working mode */
 	double last_switch_time;
 
+	/** The overall time spent in the transitions counted */
+	double sum_switch_time;
+
 	/** A counter of switches */
 	uint16_t switch_count;
 
@@ -27,6 +27,9 @@
 
 #define AWM_NAMESPACE "bq.awm"
 
+/** The maximum number of resource bindings cached per working mode */
+#define BBQUE_AWM_BINDING_CACHE_SIZE 64
+
 namespace br = bbque::res;
 namespace bu = bbque::utils;
 
@@ -68,6 +71,12 @@ public:
 	 */
 	~WorkingMode();
 
+	/**
+	 * @brief A copy of the working mode, including its own copy of the
+	 * resource requests, to be modified without affecting this one
+	 */
+	std::shared_ptr<WorkingMode> Clone() const;
+
 	/**
 	 * @see WorkingModeStatusIF
 	 */
@@ -276,6 +285,7 @@ public:
 
 	inline void ClearResourceRequests() {
 		resources.requested.clear();
+		binding_cache.maps.clear();
 	}
 
 /******************************************************************************
@@ -335,13 +345,34 @@ public:
 			int32_t prev_refn = -1);
 
 
-	br::ResourceAssignmentMap_t const * GetSourceAndOutBindingMaps(
-			br::ResourceAssignmentMapPtr_t & out_map,
+	/**
+	 * @brief Get the source map of a binding
+	 *
+	 * @param source_ptr Set to the binding map to resume, if any. Since
+	 * binding maps are shared with the binding cache, they are never
+	 * modified: the further binding fills a copy.
+	 * @param prev_refn Reference number of an already started binding
+	 *
+	 * @return The map to bind (the one from the recipe if prev_refn < 0)
+	 */
+	br::ResourceAssignmentMap_t const * GetSourceBindingMap(
+			br::ResourceAssignmentMapPtr_t & source_ptr,
 			int32_t prev_refn);
 
 
 	int32_t StoreBinding(br::ResourceAssignmentMapPtr_t, int32_t prev_refn);
 
+	/**
+	 * @brief Restore a binding map already built, e.g., by a previous
+	 * scheduling run under the same platform generation
+	 *
+	 * @param binding The binding map (shared, not modified)
+	 *
+	 * @return The reference number of the scheduling binding, or -1 if the
+	 * map is empty
+	 */
+	int32_t RestoreBinding(br::ResourceAssignmentMapPtr_t binding);
+
 
 	/**
 	 * @see WorkingModeStatusIF
@@ -621,6 +652,61 @@ private:
 	 */
 	uint32_t sched_count = 0;
 
+	/**
+	 * @struct BindingKey_t
+	 *
+	 * The inputs of a resource binding
+	 */
+	struct BindingKey_t {
+		/** The map to bind (recipe requests or previous binding) */
+		br::ResourceAssignmentMap_t const * source_map;
+		/** The resource path to bind (path-based binding only) */
+		std::string resource_path;
+		br::ResourceType r_type        = br::ResourceType::UNDEFINED;
+		BBQUE_RID_TYPE source_id       = R_ID_NONE;
+		BBQUE_RID_TYPE out_id          = R_ID_NONE;
+		br::ResourceType filter_rtype  = br::ResourceType::UNDEFINED;
+		br::ResourceBitset filter_mask;
+
+		bool operator< (BindingKey_t const & other) const;
+	};
+
+	/**
+	 * @struct BindingCache_t
+	 *
+	 * Binding maps already built, valid until the next change of the
+	 * platform resources or of the resource requests. The maps are
+	 * immutable, thus shared with the scheduling bindings instead of being
+	 * copied.
+	 */
+	struct BindingCache_t {
+		/** The platform generation the maps have been built for */
+		uint32_t generation = 0;
+		/** The source maps of further bindings, kept alive with the keys */
+		std::map<BindingKey_t,
+			std::pair<br::ResourceAssignmentMapPtr_t,
+				br::ResourceAssignmentMapPtr_t>> maps;
+	} binding_cache;
+
+	/**
+	 * @brief Look for an already built binding map
+	 *
+	 * @return The binding map, or nullptr if not cached
+	 */
+	br::ResourceAssignmentMapPtr_t LookupBinding(BindingKey_t const & key);
+
+	/**
+	 * @brief Add a binding map to the cache
+	 *
+	 * @param key The inputs of the binding
+	 * @param source_ptr The source map, if not the recipe one
+	 * @param out_map The binding map built
+	 */
+	void CacheBinding(
+			BindingKey_t const & key,
+			br::ResourceAssignmentMapPtr_t source_ptr,
+			br::ResourceAssignmentMapPtr_t out_map);
+
 	/**
 	 * @struct ResourceUsagesInfo
 	 *
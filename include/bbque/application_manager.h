@@ -319,6 +319,41 @@ public:
 	 */
 	ExitCode_t NotifyNewState(AppPtr_t papp, ApplicationStatusIF::State_t next);
 
+	/**
+	 * @brief Scheduling statistics of a priority level
+	 *
+	 * Running aggregates, updated at each state transition and AWM commit,
+	 * thus not requiring to scan the applications.
+	 */
+	struct SchedStats_t {
+		/** Number of ACTIVE (READY or RUNNING) applications */
+		uint32_t active_count  = 0;
+		/** Number of RUNNING applications */
+		uint32_t running_count = 0;
+		/** Sum and sum of squares of the RUNNING applications value */
+		double app_value_sum  = 0;
+		double app_value_sum2 = 0;
+		/** Sum and sum of squares of the RUNNING applications AWM value */
+		double awm_value_sum  = 0;
+		double awm_value_sum2 = 0;
+	};
+
+	/**
+	 * @brief Get the scheduling statistics of a priority level
+	 *
+	 * @param prio the priority level
+	 * @return a copy of the current running aggregates
+	 */
+	SchedStats_t GetSchedStats(AppPrio_t prio);
+
+	/**
+	 * @brief Capture the applications status for a shadow scheduling run
+	 *
+	 * @param ctx the context to fill, with the indexes and the scheduling
+	 * status of all the applications/EXCs
+	 */
+	void GetShadowContext(ShadowContext_t & ctx);
+
 	/**
 	 * @brief Commit the "continue to run" for the specified application
 	 *
@@ -327,6 +362,24 @@ public:
 	 */
 	ExitCode_t RunningCommit(AppPtr_t papp);
 
+	/**
+	 * @brief Commit the resize of the resources of the specified application
+	 *
+	 * The application continues to run in the same AWM and binding, but
+	 * with different amounts of resources. These are accounted in the
+	 * system view and enforced by the platform proxy, without the
+	 * synchronization protocol. The RTLib is then notified, without
+	 * waiting for a response. If the amounts cannot be accounted or
+	 * enforced, the application is reconfigured into the same AWM instead.
+	 *
+	 * This must be called once the scheduled view has been set.
+	 *
+	 * @param papp a pointer to the interested application
+	 * @return AM_SUCCESS on success, AM_PLAT_PROXY_ERROR if the platform
+	 * proxy failed, AM_ABORT on other failures
+	 */
+	ExitCode_t ResizeCommit(AppPtr_t papp);
+
 	/**
 	 * @brief Update runtime profiling information of each active
 	 * application/EXC
@@ -395,7 +448,8 @@ public:
 			uint8_t exc_id, struct app::RuntimeProfiling_t profile);
 
 	ExitCode_t SetRuntimeProfile(AppPid_t pid, uint8_t exc_id,
-			int gap, int cusage, int ctime);
+			int gap, int cusage, int ctime,
+			float llc_mpkc = 0.0, uint32_t mem_bw_mbps = 0);
 
 	/**
 	 * @see ApplicationManagerConfIF
@@ -406,6 +460,25 @@ public:
 		return AM_SUCCESS;
 	}
 
+	/**
+	 * @brief Get the resource usage of an EXC, measured by the platform
+	 */
+	ExitCode_t GetResourceUsage(
+		AppPid_t pid, uint8_t exc_id, struct app::ResourceUsage_t &usage);
+
+	inline ExitCode_t GetResourceUsage(AppPtr_t papp,
+			struct app::ResourceUsage_t &usage) {
+		usage = papp->GetResourceUsage();
+		return AM_SUCCESS;
+	}
+
+	/**
+	 * @brief Publish the resource usage of an EXC, measured by the platform,
+	 * and feed the usage-based admission of the CPU bandwidth
+	 */
+	ExitCode_t SetResourceUsage(AppPtr_t papp,
+			struct app::ResourceUsage_t const & usage);
+
 #ifdef CONFIG_BBQUE_TG_PROG_MODEL
 
 	/**
@@ -460,22 +533,10 @@ private:
 
 
 	/**
-	 * Map of all the applications instances which entered the
-	 * resource manager starting from its boot. The map key is the UID of the
-	 * application instance. The value is the application descriptor of the
-	 * instance.
+	 * Index of all the applications instances which entered the
+	 * resource manager starting from its boot, by UID.
 	 */
-	AppsUidMap_t uids;
-
-	/**
-	 * Mutex to protect concurrent access to the map of applications UIDs.
-	 */
-	std::recursive_mutex uids_mtx;
-
-	/**
-	 * Array of iterator retainers for "in loop erase" support on UID map
-	 */
-	AppsUidMapItRetainer_t uids_ret;
+	AppsIndex uids;
 
 
 	/**
@@ -502,54 +563,53 @@ private:
 	 * ones. Each position in the vector points to a set of maps grouping active
 	 * applications by priority.
 	 */
-	AppsUidMap_t prio_vec[BBQUE_APP_PRIO_LEVELS];
+	AppsIndex prio_vec[BBQUE_APP_PRIO_LEVELS];
 
-	/**
-	 * Array of mutexes protecting the priority queues
-	 */
-	std::mutex prio_mtx[BBQUE_APP_PRIO_LEVELS];
 
 	/**
-	 * Array of iterator retainers for "in loop erase" support on priority
-	 * queues
+	 * @brief The contribution of an application to the scheduling
+	 * statistics of its priority level
 	 */
-	AppsUidMapItRetainer_t prio_ret[BBQUE_APP_PRIO_LEVELS];
-
+	struct SchedStatsContrib_t {
+		AppPrio_t prio;
+		bool active;
+		bool running;
+		double app_value;
+		double awm_value;
+	};
 
 	/**
-	 * Array grouping the applications by status (@see ScheduleFlag).
-	 * Each position points to a set of maps pointing applications
+	 * Per-priority scheduling statistics
 	 */
-	AppsUidMap_t status_vec[ApplicationStatusIF::STATE_COUNT];
+	SchedStats_t sched_stats[BBQUE_APP_PRIO_LEVELS];
 
 	/**
-	 * Array of mutexes protecting the status queues.
+	 * The last contribution of each application to the statistics
 	 */
-	std::mutex status_mtx[ApplicationStatusIF::STATE_COUNT];
+	std::map<AppUid_t, SchedStatsContrib_t> sched_stats_contrib;
 
 	/**
-	 * Array of iterator retainers for "in loop erase" support on STATUS
-	 * queues
+	 * Mutex protecting the scheduling statistics
 	 */
-	AppsUidMapItRetainer_t status_ret[ApplicationStatusIF::STATE_COUNT];
+	std::mutex sched_stats_mtx;
 
 	/**
-	 * Array grouping the applications by programming language (@see
-	 * RTLIB_ProgrammingLanguage_t). Each position points to a set of maps
-	 * pointing applications
+	 * Array grouping the applications by status (@see ScheduleFlag).
+	 * Each position points to a set of maps pointing applications
 	 */
-	AppsUidMap_t lang_vec[RTLIB_LANG_COUNT];
+	AppsIndex status_vec[ApplicationStatusIF::STATE_COUNT];
 
 	/**
-	 * Array of mutexes protecting the programming language queue
+	 * Array of mutexes serializing the moves between status queues.
 	 */
-	std::mutex lang_mtx[RTLIB_LANG_COUNT];
+	std::mutex status_mtx[ApplicationStatusIF::STATE_COUNT];
 
 	/**
-	 * Array of iterator retainers for "in loop erase" support on STATUS
-	 * queues
+	 * Array grouping the applications by programming language (@see
+	 * RTLIB_ProgrammingLanguage_t). Each position points to a set of maps
+	 * pointing applications
 	 */
-	AppsUidMapItRetainer_t lang_ret[RTLIB_LANG_COUNT];
+	AppsIndex lang_vec[RTLIB_LANG_COUNT];
 
 	/**
 	 * @brief Applications grouping based on next state to be scheduled.
@@ -559,18 +619,7 @@ private:
 	 * correposnding scheduled status. This view on applicaitons could be
 	 * exploited by the synchronization module to update applications.
 	 */
-	AppsUidMap_t sync_vec[ApplicationStatusIF::SYNC_STATE_COUNT];
-
-	/**
-	 * Array of mutexes protecting the synchronization queues.
-	 */
-	std::mutex sync_mtx[ApplicationStatusIF::SYNC_STATE_COUNT];
-
-	/**
-	 * Array of iterator retainers for "in loop erase" support on SYNC
-	 * queues
-	 */
-	AppsUidMapItRetainer_t sync_ret[ApplicationStatusIF::SYNC_STATE_COUNT];
+	AppsIndex sync_vec[ApplicationStatusIF::SYNC_STATE_COUNT];
 
 	/**
 	 * @brief EXC cleaner deferrable
@@ -608,12 +657,6 @@ private:
 	 */
 	ExitCode_t AppsRemove(AppPtr_t papp);
 
-	/**
-	 * @brief In-Loop-Erase-Safe update of iterators on applications
-	 * containers
-	 */
-	void UpdateIterators(AppsUidMapItRetainer_t & ret, AppPtr_t papp);
-
 	/**
 	 * @brief Move the application from state vectors
 	 *
@@ -624,6 +667,21 @@ private:
 	ExitCode_t UpdateStatusMaps(AppPtr_t papp,
 			ApplicationStatusIF::State_t prev, ApplicationStatusIF::State_t next);
 
+	/**
+	 * @brief Update the scheduling statistics with the current contribution
+	 * of an application
+	 *
+	 * @param papp a pointer to an application
+	 * @param state the (new) state of the application
+	 */
+	void UpdateSchedStats(AppPtr_t papp, ApplicationStatusIF::State_t state);
+
+	/**
+	 * @brief Remove the contribution of an application from the scheduling
+	 * statistics
+	 */
+	void RemoveSchedStats(AppPtr_t papp);
+
 	/**
 	 * @brief Release a synchronization request for the specified application
 	 *
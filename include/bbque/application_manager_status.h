@@ -19,6 +19,14 @@
 #define BBQUE_APPLICATION_MANAGER_STATUS_IF_H_
 
 #include "bbque/app/application.h"
+#include "bbque/res/resource_assignment.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 using bbque::app::ApplicationStatusIF;
 using bbque::app::AppPid_t;
@@ -56,25 +64,174 @@ typedef std::pair<AppUid_t, AppPtr_t> UidsMapEntry_t;
  *     In-Loop Erase Safe Iterator support
  ******************************************************************************/
 
-// Forward declaration
-class AppsUidMapIt;
+/**
+ * @typedef AppsVector_t
+ * @brief A dense array of Application descriptors, sorted by UID
+ */
+typedef std::vector<AppPtr_t> AppsVector_t;
 
 /**
- * @typedef AppsUidMapItRetainer_t
- * @brief Retainer list of ILES iterators
- * @see AppsUidMapIt
+ * @typedef AppsSnapshotPtr_t
+ * @brief An immutable (published) version of an applications index
  */
-typedef std::list<struct AppsUidMapIt*> AppsUidMapItRetainer_t;
+typedef std::shared_ptr<AppsVector_t const> AppsSnapshotPtr_t;
+
+/**
+ * @class AppsIndex
+ * @brief An index of applications supporting lock-free readers
+ *
+ * Writers update a UIDs map, serialized by an internal mutex, and just mark
+ * the index as stale. Readers get an immutable snapshot of the index, i.e., a
+ * dense array of applications sorted by UID, which is shared among all the
+ * readers and released once the last one has done with it (RCU-like).
+ * The snapshot is re-built, once, by the first reader finding the index
+ * stale. Thus a burst of updates (e.g., many EXCs registering while a
+ * schedule is running) costs a single copy, and readers never wait for
+ * writers when the index has not been modified.
+ */
+class AppsIndex {
+
+public:
+
+	AppsIndex() :
+		stale(false),
+		count(0),
+		version(0),
+		snapshot(std::make_shared<AppsVector_t>()) {
+	}
+
+	/**
+	 * @brief Add an application to the index
+	 */
+	void Insert(AppPtr_t const & papp) {
+		std::unique_lock<std::mutex> index_ul(mtx);
+		if (!map.insert(UidsMapEntry_t(papp->Uid(), papp)).second)
+			return;
+		count.store(map.size(), std::memory_order_relaxed);
+		stale.store(true, std::memory_order_release);
+		version.fetch_add(1, std::memory_order_release);
+	}
+
+	/**
+	 * @brief Remove an application from the index
+	 *
+	 * @return true if the application was in the index
+	 */
+	bool Erase(AppUid_t uid) {
+		std::unique_lock<std::mutex> index_ul(mtx);
+		if (map.erase(uid) == 0)
+			return false;
+		count.store(map.size(), std::memory_order_relaxed);
+		stale.store(true, std::memory_order_release);
+		version.fetch_add(1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * @brief Remove all the applications from the index
+	 */
+	void Clear() {
+		std::unique_lock<std::mutex> index_ul(mtx);
+		map.clear();
+		count.store(0, std::memory_order_relaxed);
+		stale.store(true, std::memory_order_release);
+		version.fetch_add(1, std::memory_order_release);
+	}
+
+	/**
+	 * @brief Look-up an application by UID
+	 */
+	AppPtr_t Find(AppUid_t uid) {
+		// Index modified: look-up the map, instead of re-building now
+		if (stale.load(std::memory_order_acquire)) {
+			std::unique_lock<std::mutex> index_ul(mtx);
+			auto it = map.find(uid);
+			return (it != map.end()) ? it->second : AppPtr_t();
+		}
+
+		// Binary search on the (UID sorted) snapshot
+		AppsSnapshotPtr_t apps(std::atomic_load(&snapshot));
+		auto it = std::lower_bound(apps->begin(), apps->end(), uid,
+			[](AppPtr_t const & papp, AppUid_t _uid) {
+				return papp->Uid() < _uid;
+			});
+		if ((it == apps->end()) || ((*it)->Uid() != uid))
+			return AppPtr_t();
+		return *it;
+	}
+
+	/**
+	 * @brief Check if an application is (still) in the index
+	 */
+	inline bool Contains(AppPtr_t const & papp) {
+		return (Find(papp->Uid()) == papp);
+	}
+
+	/**
+	 * @brief The number of updates of the index so far
+	 */
+	inline uint64_t Version() const {
+		return version.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * @brief Get the current snapshot of the index
+	 */
+	AppsSnapshotPtr_t Snapshot() {
+		if (!stale.load(std::memory_order_acquire))
+			return std::atomic_load(&snapshot);
+
+		std::unique_lock<std::mutex> index_ul(mtx);
+		if (stale.load(std::memory_order_relaxed)) {
+			std::shared_ptr<AppsVector_t> apps(std::make_shared<AppsVector_t>());
+			apps->reserve(map.size());
+			for (auto const & entry: map)
+				apps->push_back(entry.second);
+			std::atomic_store(&snapshot, AppsSnapshotPtr_t(apps));
+			stale.store(false, std::memory_order_release);
+		}
+		return snapshot;
+	}
+
+	inline bool Empty() const {
+		return (count.load(std::memory_order_relaxed) == 0);
+	}
+
+	inline size_t Size() const {
+		return count.load(std::memory_order_relaxed);
+	}
+
+private:
+
+	/** The applications indexed (writers side) */
+	AppsUidMap_t map;
+
+	/** Serialize the writers and the snapshot re-building */
+	std::mutex mtx;
+
+	/** The snapshot does not reflect the map */
+	std::atomic<bool> stale;
+
+	/** The number of applications indexed */
+	std::atomic<size_t> count;
+
+	/** Incremented at each update of the index */
+	std::atomic<uint64_t> version;
+
+	/** The last snapshot published */
+	AppsSnapshotPtr_t snapshot;
+};
 
 /**
  * @class AppsUidMapIt
- * @brief "In Loop Erase Safe" ILES iterator on an AppsUidMap_t maps
+ * @brief Iterator on an applications index (@see AppsIndex)
  *
- * This is an iterator wrapper object which is used to implement safe iterations on
- * mutable maps, where an erase could occours on a thread while another thread
- * is visiting the elements of the same container container.
- * A proper usage of such an ILES interator requires to visit the container
- * elements using a pair of provided functions "GetFirst" and "GetNext".
+ * The iterator visits an immutable snapshot of the index, taken by
+ * "GetFirst". Thus, it is safe with respect to concurrent insertion and
+ * removal of applications, and it does not require any lock. The
+ * applications inserted after the snapshot are not visited, while the ones
+ * removed from the index after the snapshot are skipped once reached. This
+ * check is paid only if the index has been updated meanwhile.
  * @see @ref GetFirst, @ref GetNext
  */
 class AppsUidMapIt {
@@ -87,44 +244,110 @@ public:
 
 private:
 
-	/** The map to visit */
-	AppsUidMap_t *map = NULL;
-	/** An interator on a UIDs map */
-	AppsUidMap_t::iterator it;
-	/** A flag to track iterator validity */
-	bool updated = false;
-	/** The retantion list on which this has been inserted */
-	AppsUidMapItRetainer_t *ret = NULL;
-
-	void Init(AppsUidMap_t & m, AppsUidMapItRetainer_t & rl) {
-		map = &m;
-		ret = &rl;
-		it = map->begin();
+	/** The snapshot of the index to visit */
+	AppsSnapshotPtr_t apps;
+	/** The position of the current application in the snapshot */
+	size_t pos = 0;
+	/** The index visited (nullptr for a frozen snapshot) */
+	AppsIndex * index = nullptr;
+	/** The version of the index when the snapshot was taken */
+	uint64_t version = 0;
+
+	void Init(AppsIndex & _index) {
+		index   = &_index;
+		version = _index.Version();
+		apps    = _index.Snapshot();
+		pos     = 0;
+		SkipRemoved();
+	}
+	void Init(AppsSnapshotPtr_t const & snapshot) {
+		index = nullptr;
+		apps  = snapshot;
+		pos   = 0;
 	}
-	void Retain() {
-		ret->push_front(this);
-	};
 	void Release() {
-		if (ret) ret->remove(this);
-		ret = NULL;
-	};
-	void Update() {
-		++it; updated = true;
+		apps.reset();
 	};
 	void operator++(int) {
-		if (!updated) ++it;
-		updated = false;
+		++pos;
+		SkipRemoved();
+	};
+	/** Move beyond the applications removed from the index meanwhile */
+	void SkipRemoved() {
+		if ((index == nullptr) || (index->Version() == version))
+			return;
+		while (!End() && !index->Contains((*apps)[pos]))
+			++pos;
 	};
 	bool End() {
-		return (it == map->end());
+		return (!apps || (pos >= apps->size()));
 	};
 	AppPtr_t Get() {
-		return (*it).second;
+		return (*apps)[pos];
 	};
 
 	friend class ApplicationManager;
 };
 
+/**
+ * @struct ShadowContext_t
+ * @brief The applications status seen by a shadow scheduling run
+ *
+ * A shadow run executes a secondary policy on the same system state of a
+ * scheduling run, without committing anything. While the context is bound
+ * to the thread running the policy (@see current), the application
+ * descriptors and the indexes return the status captured before the
+ * scheduling run, and the scheduling requests just book the resources into
+ * the (private) view of the policy, recording the AWMs chosen.
+ *
+ * The AWMs are copies of the ones of the applications, thus the policy can
+ * update their resource requests and bindings.
+ */
+struct ShadowContext_t {
+
+	/** The scheduling status of an application/EXC */
+	struct AppState_t {
+		ApplicationStatusIF::State_t state;
+		ApplicationStatusIF::SyncState_t sync_state;
+		/** The copies of the enabled AWMs, sorted by value */
+		bbque::app::AwmPtrList_t awms;
+		bbque::app::AwmPtr_t awm;
+		bbque::app::AwmPtr_t next_awm;
+		/** The resource binding of the current AWM */
+		bbque::res::ResourceAssignmentMapPtr_t binding;
+	};
+
+	/** A scheduling request: the AWM and its resource binding */
+	struct Request_t {
+		bbque::app::AwmPtr_t awm;
+		bbque::res::ResourceAssignmentMapPtr_t binding;
+	};
+
+	/** The AWM chosen for each application/EXC */
+	typedef std::map<AppUid_t, Request_t> Requests_t;
+
+	/** The status of each application/EXC */
+	std::map<AppUid_t, AppState_t> apps;
+
+	/** The indexes of the applications */
+	AppsSnapshotPtr_t all;
+	AppsSnapshotPtr_t prio[BBQUE_APP_PRIO_LEVELS];
+	AppsSnapshotPtr_t status[ApplicationStatusIF::STATE_COUNT];
+	AppsSnapshotPtr_t sync[ApplicationStatusIF::SYNC_STATE_COUNT];
+
+	/** The scheduling requests of the shadow run */
+	Requests_t requests;
+
+	/** Serialize the bookings with the dropping of the shadow run */
+	std::mutex mtx;
+
+	/** The shadow run has been dropped: no more bookings allowed */
+	bool dropped = false;
+
+	/** The context of the calling thread (nullptr if not a shadow run) */
+	static thread_local ShadowContext_t * current;
+};
+
 
 /*******************************************************************************
  *     Application Manager Status Interface
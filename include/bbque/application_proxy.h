@@ -23,6 +23,9 @@
 #include "bbque/utils/logging/logger.h"
 #include "bbque/plugins/rpc_channel.h"
 #include "bbque/rtlib/rpc_messages.h"
+#ifdef CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+#include "bbque/rtlib/rpc_shm.h"
+#endif
 #include "bbque/cpp11/thread.h"
 #include "bbque/cpp11/future.h"
 
@@ -97,6 +100,15 @@ public:
 
 	RTLIB_ExitCode StopExecutionSync(ba::AppPtr_t papp);
 
+	/**
+	 * @brief Notify an EXC about its resources resized in place
+	 *
+	 * The amounts assigned in the current AWM are sent to the RTLib, which
+	 * can ignore them, since the platform limits are already enforced.
+	 * Thus, no response is waited for.
+	 */
+	RTLIB_ExitCode_t ResizeNotify(ba::AppPtr_t papp);
+
 /*******************************************************************************
  * Runtime profiling
  ******************************************************************************/
@@ -171,6 +183,23 @@ public:
 	 */
 	RTLIB_ExitCode SyncP_PostChange(ba::AppPtr_t papp, pPostChangeRsp_t presp);
 
+#ifdef CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+	/**
+	 * @brief Publish the resource assignment of an EXC into the shared
+	 * memory page of its application, once the synchronization has been
+	 * committed
+	 */
+	void SyncP_PostChangePublish(ba::AppPtr_t papp);
+
+	/**
+	 * @brief Remove an EXC from the shared memory page of its application
+	 *
+	 * @param dead The application is dead: the whole page is removed, since
+	 * the exit message will never be received
+	 */
+	void ShmAllocCleanup(ba::AppPtr_t papp, bool dead);
+#endif
+
 
 private:
 
@@ -189,6 +218,14 @@ private:
 		char app_name[RTLIB_APP_NAME_LENGTH];
 		/** The communication channel data to connect the applicaton */
 		bp::RPCChannelIF::plugin_data_t pd;
+#ifdef CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+		/** The shared memory page publishing the resource assignments */
+		bl::rpc_shm_alloc_t * shm_alloc = nullptr;
+		/** The assignments sent at PreChange, published at PostChange */
+		std::map<uint8_t, bl::rpc_shm_alloc_exc_t> shm_pending;
+		/** Serialize the updates of the shared memory page */
+		std::mutex shm_mtx;
+#endif
 	} conCtx_t;
 
 	typedef std::shared_ptr<conCtx_t> pconCtx_t;
@@ -285,6 +322,16 @@ private:
 
 	RTLIB_ExitCode SyncP_PreChange(pcmdSn_t pcs, pPreChangeRsp_t presp);
 
+#ifdef CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+	/**
+	 * @brief Keep the resource assignment of the PreChange command, to be
+	 * published once committed (@see SyncP_PostChangePublish)
+	 */
+	void SyncP_PreChangeStage(pconCtx_t pcon, ba::AppPtr_t papp,
+			bl::rpc_msg_BBQ_SYNCP_PRECHANGE_t const & msg,
+			bl::rpc_msg_BBQ_SYNCP_PRECHANGE_SYSTEM_t const & sys_msg);
+#endif
+
 	void SyncP_PreChangeTrd(pPreChangeRsp_t presp);
 
 //----- SyncChange
@@ -314,6 +361,14 @@ private:
 
 	RTLIB_ExitCode SyncP_PostChangeSend(pcmdSn_t pcs);
 
+#ifdef CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+	/**
+	 * @brief Publish the resource assignment committed into the shared
+	 * memory page of the application
+	 */
+	void SyncP_PostChangePublish(pconCtx_t pcon, ba::AppPtr_t papp);
+#endif
+
 	RTLIB_ExitCode SyncP_PostChangeRecv(pcmdSn_t pcs, pPostChangeRsp_t preps);
 
 	RTLIB_ExitCode SyncP_PostChange(pcmdSn_t pcs, pPostChangeRsp_t presp);
@@ -346,6 +401,23 @@ private:
 
 	void RpcAppExit(prqsSn_t prqs);
 
+#ifdef CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+	/**
+	 * @brief Create the shared memory page of a paired application
+	 */
+	void ShmAllocSetup(pconCtx_t pcon);
+
+	/**
+	 * @brief Remove the shared memory page of an exited application
+	 */
+	void ShmAllocRelease(pconCtx_t pcon);
+
+	/**
+	 * @brief Release the slot of an EXC in the shared memory page
+	 */
+	void ShmAllocClear(pconCtx_t pcon, uint8_t exc_id);
+#endif
+
 
 	pconCtx_t GetConnectionContext(rpc_msg_header_t *pmsg_hdr);
 
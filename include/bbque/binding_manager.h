@@ -24,6 +24,7 @@
 #include <set>
 
 #include "bbque/resource_accounter.h"
+#include "bbque/pp/platform_description.h"
 #include "bbque/utils/logging/logger.h"
 
 
@@ -92,6 +93,48 @@ public:
 		return binding_options;
 	}
 
+	/**
+	 * @brief Whether the distances among the resources are known, i.e.,
+	 * the topology of the local system has been discovered
+	 */
+	inline bool HasTopology() const {
+		return !pe_distances.Empty();
+	}
+
+	/**
+	 * @brief The distance between two resources of the same type
+	 *
+	 * The processing elements distances reflect the sharing of cores and
+	 * caches (@see pp::PlatformDescription::PEDistance_t), while the
+	 * distances of CPUs and memories are the ones of their NUMA nodes.
+	 *
+	 * @return BBQUE_PP_DISTANCE_UNKNOWN if not available
+	 */
+	uint16_t GetDistance(
+		br::ResourceType r_type,
+		BBQUE_RID_TYPE id_a,
+		BBQUE_RID_TYPE id_b) const;
+
+	/**
+	 * @brief Select the resources closest to a reference one
+	 *
+	 * This supports the packing of the resources assigned to an
+	 * application, e.g., onto processing elements sharing the caches.
+	 *
+	 * @param r_type The resource type
+	 * @param ref_id The ID of the reference resource
+	 * @param candidates The IDs of the resources to select from
+	 * @param count The number of resources to select
+	 *
+	 * @return The IDs of the selected resources, by increasing distance
+	 * and ID
+	 */
+	br::ResourceBitset GetClosest(
+		br::ResourceType r_type,
+		BBQUE_RID_TYPE ref_id,
+		br::ResourceBitset const & candidates,
+		size_t count) const;
+
 private:
 
 	std::unique_ptr<bu::Logger> logger;
@@ -104,6 +147,12 @@ private:
 	 */
 	BindingMap_t binding_options;
 
+	/** The distances among the processing elements */
+	pp::PlatformDescription::DistanceMatrix pe_distances;
+
+	/** The distances among the memory (NUMA) nodes */
+	pp::PlatformDescription::DistanceMatrix mem_distances;
+
 
 	BindingManager();
 
@@ -112,6 +161,11 @@ private:
 	 */
 	void InitBindingOptions();
 
+	/**
+	 * @brief Load the distances among the resources of the local system
+	 */
+	void LoadDistances();
+
 };
 
 }
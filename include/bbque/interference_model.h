@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_INTERFERENCE_MODEL_H_
+#define BBQUE_INTERFERENCE_MODEL_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "bbque/config.h"
+#include "bbque/app/application_status.h"
+#include "bbque/utils/logging/logger.h"
+
+#define INTERFERENCE_MODEL_NAMESPACE "bq.im"
+
+/** Default LLC misses per kilo-cycle of a memory-bound AWM */
+#define BBQUE_IM_LLC_MPKC_HIGH      20
+/** Default memory bandwidth [MB/s] of a memory-bound AWM */
+#define BBQUE_IM_MEM_BW_HIGH_MBPS   8000
+/** Default number of samples before a profile is trusted */
+#define BBQUE_IM_MIN_SAMPLES        3
+/** Weight of a new sample in the moving average */
+#define BBQUE_IM_EWMA_WEIGHT        0.25
+
+namespace ba = bbque::app;
+namespace bu = bbque::utils;
+
+namespace bbque {
+
+/**
+ * @class InterferenceModel
+ *
+ * @brief Pressure of the AWMs on the shared cache and memory, per recipe
+ *
+ * The RTLib reports the LLC misses per kilo-cycle and the estimated memory
+ * bandwidth of each EXC, along with the runtime profile. The samples are
+ * averaged for each recipe and AWM, thus the profile outlives the EXC and
+ * is available when a new instance of the same recipe has to be scheduled.
+ *
+ * The scheduling policies query the pressure of an AWM, to avoid placing
+ * more memory-bound EXCs into the same LLC/NUMA domain.
+ */
+class InterferenceModel {
+
+public:
+
+	/**
+	 * @brief The interference profile of an AWM
+	 */
+	struct Profile_t {
+		/** LLC misses per kilo-cycle */
+		float llc_mpkc = 0.0;
+		/** Memory bandwidth [MB/s] */
+		float mem_bw_mbps = 0.0;
+		/** Number of samples */
+		uint32_t count = 0;
+	};
+
+	/**
+	 * @brief Get a reference to the model (singleton)
+	 */
+	static InterferenceModel & GetInstance();
+
+	/**
+	 * @brief Add the counters measured on an application/EXC
+	 *
+	 * @param papp The application/EXC
+	 * @param awm_id The AWM in use during the measurement
+	 * @param llc_mpkc LLC misses per kilo-cycle
+	 * @param mem_bw_mbps Memory bandwidth [MB/s]
+	 */
+	void AddSample(ba::AppSPtr_t papp, int8_t awm_id,
+			float llc_mpkc, uint32_t mem_bw_mbps);
+
+	/**
+	 * @brief The interference profile of an AWM
+	 *
+	 * @return false if not enough samples have been collected
+	 */
+	bool GetProfile(ba::AppSPtr_t papp, int8_t awm_id, Profile_t & profile);
+
+	/**
+	 * @brief The pressure of an AWM on the shared cache and memory
+	 *
+	 * The highest of the two counters, normalized to the level of a
+	 * memory-bound AWM.
+	 *
+	 * @return A value in [0..1], or a negative value if not enough samples
+	 * have been collected
+	 */
+	float GetPressure(ba::AppSPtr_t papp, int8_t awm_id);
+
+private:
+
+	/** Recipe and AWM */
+	typedef std::pair<std::string, int8_t> ProfileKey_t;
+
+	std::unique_ptr<bu::Logger> logger;
+
+	/** The profiles of the AWMs */
+	std::map<ProfileKey_t, Profile_t> profiles;
+
+	/** Serialize the updates with the policy queries */
+	std::mutex profiles_mtx;
+
+	/** LLC misses per kilo-cycle of a memory-bound AWM */
+	float llc_mpkc_high = BBQUE_IM_LLC_MPKC_HIGH;
+
+	/** Memory bandwidth [MB/s] of a memory-bound AWM */
+	uint32_t mem_bw_high_mbps = BBQUE_IM_MEM_BW_HIGH_MBPS;
+
+	/** The number of samples before a profile is trusted */
+	uint16_t min_samples = BBQUE_IM_MIN_SAMPLES;
+
+
+	InterferenceModel();
+};
+
+} // namespace bbque
+
+#endif // BBQUE_INTERFERENCE_MODEL_H_
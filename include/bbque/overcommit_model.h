@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_OVERCOMMIT_MODEL_H_
+#define BBQUE_OVERCOMMIT_MODEL_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "bbque/config.h"
+#include "bbque/app/application_status.h"
+#include "bbque/res/resources.h"
+#include "bbque/utils/logging/logger.h"
+#include "bbque/utils/timer.h"
+
+#define OVERCOMMIT_MODEL_NAMESPACE "bq.om"
+
+/** Default margin [%] added to the measured usage */
+#define BBQUE_OM_USAGE_MARGIN_PCT      10
+/** Default measured load [%] of a processing element triggering a reclaim */
+#define BBQUE_OM_RECLAIM_THRESHOLD_PCT 90
+/** Default minimum time [ms] between two reclaims */
+#define BBQUE_OM_RECLAIM_PERIOD_MS     2000
+/** Weight of a new (lower) sample in the moving average */
+#define BBQUE_OM_EWMA_WEIGHT           0.25
+
+namespace ba = bbque::app;
+namespace br = bbque::res;
+namespace bu = bbque::utils;
+
+namespace bbque {
+
+/**
+ * @class OvercommitModel
+ *
+ * @brief Usage-based admission of CPU bandwidth bookings
+ *
+ * In the default (strict) mode, the CPU bandwidth booked on a processing
+ * element can not exceed its total amount. If an overcommit ratio greater
+ * than one is configured for a priority class, the processing elements can
+ * be oversubscribed by the EXCs of that class. Each booking is then charged
+ * for the amount it is expected to use, i.e., the amount booked scaled by
+ * the highest of:
+ * - the inverse of the overcommit ratio, i.e., the share guaranteed to the
+ *   EXC under contention;
+ * - the measured usage of the EXC (from the RTLib runtime profile and the
+ *   control group statistics), as a fraction of its booking, plus a margin.
+ * The admission is performed on the amounts charged, which can not exceed
+ * the total amount. EXCs not measured yet are charged the amount booked.
+ *
+ * The platform proxy keeps limiting each EXC to the amount booked, and
+ * weights the EXCs by the guaranteed shares. When the measured load of an
+ * oversubscribed processing element approaches its capacity, a new
+ * scheduling is triggered, to charge the updated usage.
+ */
+class OvercommitModel {
+
+public:
+
+	/**
+	 * @brief Get a reference to the model (singleton)
+	 */
+	static OvercommitModel & GetInstance();
+
+	/**
+	 * @brief Whether the oversubscription is enabled for some class
+	 */
+	inline bool Enabled() const {
+		return enabled;
+	}
+
+	/**
+	 * @brief The overcommit ratio of a priority class
+	 */
+	float GetRatio(ba::AppPrio_t prio) const;
+
+	/**
+	 * @brief The amount charged for a booking
+	 *
+	 * @param rsrc The resource to book
+	 * @param papp The application/EXC
+	 * @param amount The amount to book
+	 * @param status_view The token referencing the resource view
+	 *
+	 * @return The amount itself, if the resource can not be oversubscribed
+	 */
+	uint64_t GetCharge(br::ResourcePtr_t const & rsrc,
+			ba::AppSPtr_t const & papp, uint64_t amount,
+			br::RViewToken_t status_view);
+
+	/**
+	 * @brief The amount of a resource that can be booked
+	 *
+	 * @param rsrc The resource to book
+	 * @param papp The application/EXC (the amount it holds is included)
+	 * @param status_view The token referencing the resource view
+	 *
+	 * @return The amount, not greater than the unreserved one
+	 */
+	uint64_t Available(br::ResourcePtr_t const & rsrc,
+			ba::AppSPtr_t const & papp, br::RViewToken_t status_view);
+
+	/**
+	 * @brief The amount guaranteed to a booking under contention
+	 *
+	 * @param papp The application/EXC
+	 * @param amount The amount booked
+	 */
+	uint64_t GetGuaranteed(ba::AppSPtr_t const & papp, uint64_t amount) const;
+
+	/**
+	 * @brief Add a measurement of the CPU usage of an application/EXC
+	 *
+	 * @param papp The application/EXC
+	 * @param cpu_usage The CPU usage [% of a single processing element]
+	 */
+	void AddSample(ba::AppSPtr_t papp, uint32_t cpu_usage);
+
+	/**
+	 * @brief Forget the usage of an application/EXC
+	 */
+	void Remove(ba::AppSPtr_t papp);
+
+private:
+
+	std::unique_ptr<bu::Logger> logger;
+
+	/** Whether any ratio is greater than one */
+	bool enabled = false;
+
+	/** The overcommit ratio of each priority class */
+	std::vector<float> ratios;
+
+	/** Margin [%] added to the measured usage */
+	uint16_t usage_margin_pct = BBQUE_OM_USAGE_MARGIN_PCT;
+
+	/** Measured load [%] triggering a reclaim */
+	uint16_t reclaim_threshold_pct = BBQUE_OM_RECLAIM_THRESHOLD_PCT;
+
+	/** Minimum time [ms] between two reclaims */
+	uint32_t reclaim_period_ms = BBQUE_OM_RECLAIM_PERIOD_MS;
+
+	/** The used fraction of the booking of each EXC */
+	std::map<AppUid_t, float> usage_ratios;
+
+	/** Serialize the updates with the bookings */
+	std::mutex usage_mtx;
+
+	/** Time since the last reclaim */
+	bu::Timer reclaim_tmr;
+
+
+	OvercommitModel();
+
+	/**
+	 * @brief The used fraction of the booking of an EXC (1 if unknown)
+	 */
+	float GetUsageRatio(AppUid_t app_uid);
+
+	/**
+	 * @brief The amount charged for each unit booked by an EXC
+	 */
+	float GetChargeRatio(ba::AppSPtr_t const & papp);
+
+	/**
+	 * @brief Trigger a new scheduling if the measured load of the
+	 * processing elements assigned to an EXC approaches their capacity
+	 */
+	void CheckReclaim(ba::AppSPtr_t const & papp);
+};
+
+} // namespace bbque
+
+#endif // BBQUE_OVERCOMMIT_MODEL_H_
@@ -123,6 +123,26 @@ public:
 	virtual ExitCode_t SendDisjoinRequest(int system_id) = 0;
 
 
+	// ------------- Hierarchical management functions -----------------
+
+	/**
+	 * @brief Send the capacity summary of the local node to another one
+	 * (i.e., the master instance)
+	 * @param system_id The destination system
+	 * @param status The local node status
+	 * @return
+	 */
+	virtual ExitCode_t SendNodeStatus(
+		int system_id, agent::NodeStatus const & status) = 0;
+
+	/**
+	 * @brief The latest capacity summaries received from the agents
+	 * @param nodes A map to fill with the node status, per system id
+	 */
+	virtual void GetNodesStatus(
+		std::map<int16_t, agent::NodeStatus> & nodes) = 0;
+
+
 	// ----------- Scheduling / Resource allocation functions ----------
 
 	/**
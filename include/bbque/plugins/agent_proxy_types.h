@@ -69,11 +69,42 @@ struct ChannelStatus {
 	double latency_ms;
 };
 
+/**
+ * @struct NodeStatus
+ *
+ * Capacity summary periodically sent by each agent to the master instance
+ * (hierarchical configuration)
+ */
+struct NodeStatus {
+	int16_t  system_id;
+	uint64_t cpu_total;
+	uint64_t cpu_used;
+	uint64_t mem_total;
+	uint64_t mem_used;
+	uint32_t nr_ready;
+	uint32_t nr_running;
+	/** Time of the last update [ms] */
+	double   timestamp_ms;
+
+	/** Fraction of processing capacity in use */
+	inline float CpuLoad() const {
+		return cpu_total > 0 ? float(cpu_used) / cpu_total : 1.0;
+	}
+
+	inline uint64_t CpuAvailable() const {
+		return cpu_total > cpu_used ? cpu_total - cpu_used : 0;
+	}
+
+	inline uint64_t MemAvailable() const {
+		return mem_total > mem_used ? mem_total - mem_used : 0;
+	}
+};
+
 /**
  * @struct ApplicationScheduleRequest
  */
 struct ApplicationScheduleRequest {
-	int16_t app_id;
+	uint32_t app_id;
 	std::string app_name;
 	int16_t awm_id;
 	struct {
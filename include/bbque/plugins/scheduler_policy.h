@@ -236,6 +236,48 @@ public:
 	virtual ExitCode_t Schedule(bbque::System & system,
 			bbque::res::RViewToken_t &rvt) = 0;
 
+	/**
+	 * @brief Schedule within a time budget
+	 *
+	 * The policies supporting the budget compute a cheap greedy baseline
+	 * assignment first, then check the budget by means of BudgetExpired(),
+	 * and once expired complete the schedule with the best feasible
+	 * choices found so far, or the baseline for the applications not
+	 * evaluated yet.
+	 *
+	 * @param system a reference to the system interfaces
+	 * @param rvt a token representing the view on resource allocation
+	 * @param budget_ms the time budget [ms], 0 for an unbounded run
+	 */
+	inline ExitCode_t Schedule(bbque::System & system,
+			bbque::res::RViewToken_t &rvt,
+			uint32_t budget_ms) {
+		this->budget_ms = budget_ms;
+		budget_expired  = false;
+		budget_tmr.start();
+		return Schedule(system, rvt);
+	}
+
+	/**
+	 * @brief Check whether the time budget of the current (or last)
+	 * scheduling run has expired
+	 */
+	inline bool BudgetExpired() {
+		if (!budget_expired && (budget_ms > 0))
+			budget_expired = (budget_tmr.getElapsedTimeMs() >= budget_ms);
+		return budget_expired;
+	}
+
+	/**
+	 * @brief Check whether the last scheduling run has been truncated,
+	 * i.e., the policy found its time budget expired
+	 *
+	 * Differently from BudgetExpired(), the timer is not evaluated again.
+	 */
+	inline bool BudgetTruncated() const {
+		return budget_expired;
+	}
+
 
 protected:
 
@@ -258,6 +300,15 @@ protected:
 	/** An High-Resolution timer */
 	Timer timer;
 
+	/** The time budget of the current scheduling run [ms] (0: unbounded) */
+	uint32_t budget_ms = 0;
+
+	/** The timer of the current scheduling run, for the time budget */
+	Timer budget_tmr;
+
+	/** Set once the time budget of the current run has expired */
+	bool budget_expired = false;
+
 	/**
 	 * @brief The number of slots, where a slot is defined as "resource
 	 * amount divider". The idea is to provide a mechanism to assign
@@ -141,6 +141,20 @@ public:
 	 */
 	virtual SyncLatency_t EstimatedSyncTime() = 0;
 
+	/**
+	 * @brief Check if a synchronization round spans multiple queues
+	 *
+	 * By default, each round returned by GetApplicationsQueue() includes only
+	 * the applications of the returned synchronization state. A policy
+	 * returning true here gets instead all the applications requiring a
+	 * synchronization offered to DoSync(), whatever their state, thus
+	 * synchronizing EXCs with different state changes within the same round.
+	 * In this case the returned state is used just for statistics purposes.
+	 */
+	virtual bool MultiStateRounds() {
+		return false;
+	}
+
 };
 
 } // namespace plugins
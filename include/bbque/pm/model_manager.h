@@ -106,6 +106,12 @@ private:
 
 	/***  The system power-thermal model */
 	SystemModelPtr_t system_model;
+
+	/**
+	 * @brief Register the table models listed in the configuration file,
+	 * and set the default model
+	 */
+	void LoadTableModels();
 };
 
 } // namespace pm
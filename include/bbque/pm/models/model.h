@@ -142,6 +142,23 @@ public:
 			std::string const & freq_governor
 				= BBQUE_PM_DEFAULT_CPUFREQ_GOVERNOR);
 
+	/**
+	 * @brief Calibrate the model with a sample of the resource status
+	 *
+	 * The default implementation does not support calibration, thus the
+	 * sample is ignored.
+	 *
+	 * @param freq_khz The operating frequency in KHz
+	 * @param load The resource utilization percentage
+	 * @param temp_mc Temperature in millidegree (Celsius)
+	 * @param power_mw The power consumption in milliwatts
+	 */
+	virtual void AddSample(
+			uint32_t freq_khz,
+			uint32_t load,
+			uint32_t temp_mc,
+			uint32_t power_mw);
+
 protected:
 
 	std::string id;
@@ -0,0 +1,287 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_MODEL_TABLE_H_
+#define BBQUE_MODEL_TABLE_H_
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "bbque/pm/models/model.h"
+
+/** Number of entries of the power lookup tables (load from 0 to 100%) */
+#define BBQUE_MODEL_TABLE_LOAD_STEPS   101
+/** Number of entries of the load lookup tables (inverse of the power ones) */
+#define BBQUE_MODEL_TABLE_POWER_STEPS  256
+/** Default forgetting factor of the online calibration */
+#define BBQUE_MODEL_TABLE_FORGETTING   0.98
+
+namespace bbque  { namespace pm {
+
+/**
+ * @class RLSEstimator
+ *
+ * @brief Recursive least squares estimation of the N parameters of a
+ * linear model y = theta' * x, with exponential forgetting
+ */
+template <size_t N>
+class RLSEstimator {
+
+public:
+
+	typedef std::array<double, N> Vector_t;
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param theta The initial (prior) parameters
+	 * @param lambda The forgetting factor, in (0..1]
+	 * @param delta The initial covariance, i.e., how much the prior can
+	 * be trusted (the smaller, the more)
+	 */
+	RLSEstimator(Vector_t const & theta, double lambda, double delta):
+		lambda(lambda), delta(delta), theta(theta) {
+		Reset(theta);
+	}
+
+	/**
+	 * @brief Restart the estimation from the given parameters
+	 */
+	void Reset(Vector_t const & _theta) {
+		theta = _theta;
+		for (size_t i = 0; i < N; ++i)
+			for (size_t j = 0; j < N; ++j)
+				cov[i][j] = (i == j) ? delta : 0.0;
+	}
+
+	/**
+	 * @brief Update the estimation with a new observation
+	 */
+	void Update(Vector_t const & x, double y) {
+		Vector_t px;
+		double den = lambda;
+		double err = y;
+		for (size_t i = 0; i < N; ++i) {
+			px[i] = 0.0;
+			for (size_t j = 0; j < N; ++j)
+				px[i] += cov[i][j] * x[j];
+			den += x[i] * px[i];
+			err -= theta[i] * x[i];
+		}
+
+		double trace = 0.0;
+		for (size_t i = 0; i < N; ++i) {
+			theta[i] += px[i] / den * err;
+			for (size_t j = 0; j < N; ++j)
+				cov[i][j] = (cov[i][j] - px[i] * px[j] / den) / lambda;
+			trace += cov[i][i];
+		}
+
+		// Without excitation the covariance grows unbounded (wind-up)
+		if (trace > N * delta)
+			for (size_t i = 0; i < N; ++i)
+				for (size_t j = 0; j < N; ++j)
+					cov[i][j] *= N * delta / trace;
+	}
+
+	inline Vector_t const & Parameters() const {
+		return theta;
+	}
+
+private:
+
+	double lambda;
+
+	double delta;
+
+	Vector_t theta;
+
+	std::array<std::array<double, N>, N> cov;
+};
+
+
+/**
+ * @class TableModel
+ *
+ * @brief Data-driven power-thermal model
+ *
+ * The model is loaded from a per-platform table, reporting the power
+ * consumption and the steady-state temperature of the resource, measured at
+ * different frequency and load values. The table is a text file with the
+ * following lines ('#' starts a comment):
+ * - "id <name>": the model identifier (default: the file name)
+ * - "tpd <mW>": the thermal-power design (default: the maximum power)
+ * - "<freq_khz> <load_%> <temp_C> <power_mW>": a measurement
+ *
+ * At loading time, the power of each frequency is interpolated over the
+ * load range with monotone cubic splines, and stored into dense lookup
+ * tables, together with their inverse (load from power). The temperature is
+ * modeled as a linear function of the power (T = T_amb + R_th * P), fitted
+ * on the measurements.
+ *
+ * The model is calibrated online from the power monitor samples, by
+ * recursive least squares:
+ * - power: P = c0 + c1 * P_table(f, load) + c2 * T, with the last term
+ *   accounting for the leakage;
+ * - temperature: T = T_amb + R_th * P.
+ *
+ * Thus every query costs a constant amount of time, regardless the size of
+ * the table.
+ */
+class TableModel: public Model {
+
+public:
+
+	/**
+	 * @brief Load a model from a table file
+	 *
+	 * @param filepath The path of the table file
+	 * @param lambda The forgetting factor of the online calibration
+	 *
+	 * @return The model, or nullptr in case of errors in the file
+	 */
+	static std::shared_ptr<TableModel> Load(
+			std::string const & filepath,
+			double lambda = BBQUE_MODEL_TABLE_FORGETTING);
+
+	/**
+	 * @brief Destructor
+	 */
+	virtual ~TableModel() {};
+
+	/*** Member functions to override ***/
+
+	uint32_t GetPowerFromTemperature(
+			uint32_t temp_mc,
+			std::string const & freq_governor
+				= BBQUE_PM_DEFAULT_CPUFREQ_GOVERNOR);
+
+	uint32_t GetPowerFromSystemBudget(
+			uint32_t power_mw,
+			std::string const & freq_governor
+				= BBQUE_PM_DEFAULT_CPUFREQ_GOVERNOR);
+
+	uint32_t GetTemperatureFromPower(
+			uint32_t power_mw,
+			std::string const & freq_governor
+				= BBQUE_PM_DEFAULT_CPUFREQ_GOVERNOR);
+
+	float GetResourcePercentageFromPower(
+			uint32_t power_mw,
+			std::string const & freq_governor
+				= BBQUE_PM_DEFAULT_CPUFREQ_GOVERNOR);
+
+	uint32_t GetResourceFromPower(
+			uint32_t power_mw,
+			uint32_t total_amount,
+			std::string const & freq_governor
+				= BBQUE_PM_DEFAULT_CPUFREQ_GOVERNOR);
+
+	void AddSample(
+			uint32_t freq_khz,
+			uint32_t load,
+			uint32_t temp_mc,
+			uint32_t power_mw);
+
+	/**
+	 * @brief The number of samples used for the online calibration
+	 */
+	inline uint32_t GetSamplesCount() const {
+		return samples_count;
+	}
+
+private:
+
+	/**
+	 * @class FrequencyTable
+	 *
+	 * @brief The lookup tables of an operating frequency
+	 */
+	struct FrequencyTable {
+		/** The frequency in KHz */
+		uint32_t freq_khz;
+		/** Power (W) for each load step (1%) */
+		std::array<double, BBQUE_MODEL_TABLE_LOAD_STEPS> power;
+		/** Load (%) for each power step */
+		std::array<double, BBQUE_MODEL_TABLE_POWER_STEPS> load;
+		/** The power of the first power step */
+		double power_min;
+		/** The power increase of each power step */
+		double power_step;
+	};
+
+	/** The lookup tables, in increasing frequency order */
+	std::vector<FrequencyTable> tables;
+
+	/** Power model calibration: (c0, c1, c2) */
+	RLSEstimator<3> power_rls;
+
+	/** Thermal model calibration: (T_amb, R_th) */
+	RLSEstimator<2> thermal_rls;
+
+	/** Index of the table of the last frequency sampled */
+	size_t last_freq_idx;
+
+	/** Number of samples used for the calibration */
+	uint32_t samples_count = 0;
+
+	/** Serialize the calibration with the queries */
+	std::mutex calib_mtx;
+
+
+	TableModel(std::string const & id, uint32_t tpd, double lambda);
+
+	/**
+	 * @brief Build the lookup tables of a frequency
+	 *
+	 * @param loads The measured load values, in increasing order
+	 * @param powers The power (W) measured at each load value
+	 */
+	void AddFrequency(
+			uint32_t freq_khz,
+			std::vector<double> const & loads,
+			std::vector<double> const & powers);
+
+	/**
+	 * @brief The lookup tables to use for the given frequency governor
+	 */
+	FrequencyTable const & GetTable(std::string const & freq_governor);
+
+	/**
+	 * @brief The index of the table of the closest frequency
+	 */
+	size_t GetTableIndex(uint32_t freq_khz) const;
+
+	/**
+	 * @brief The power (W) from the table, at the given load (%)
+	 */
+	static double TablePower(FrequencyTable const & table, double load);
+
+	/**
+	 * @brief The load (%) from the table, at the given power (W)
+	 */
+	static double TableLoad(FrequencyTable const & table, double power);
+};
+
+} // namespace pm
+
+} // namespace bbque
+
+#endif // BBQUE_MODEL_TABLE_H_
@@ -27,6 +27,7 @@
 #include "bbque/configuration_manager.h"
 #include "bbque/resource_manager.h"
 #include "bbque/pm/battery_manager.h"
+#include "bbque/pm/model_manager.h"
 #include "bbque/pm/power_manager.h"
 #include "bbque/res/resources.h"
 #include "bbque/utils/deferrable.h"
@@ -167,6 +168,11 @@ private:
 	 */
 	PowerManager & pm;
 
+	/**
+	 * @brief Power-thermal models manager instance
+	 */
+	bbque::pm::ModelManager & mm;
+
 #ifdef CONFIG_BBQUE_PM_BATTERY
 	/**
 	 * @brief Battery manager instance
@@ -303,6 +309,14 @@ private:
 	 */
 	void SampleResourcesStatus(uint16_t first_resource_index, uint16_t last_resource_index);
 
+	/**
+	 * @brief Calibrate the power-thermal model of a resource with the
+	 * last samples collected
+	 *
+	 * @param rsrc The resource sampled
+	 */
+	void CalibrateModel(br::ResourcePtr_t rsrc);
+
 #ifdef CONFIG_BBQUE_PM_BATTERY
 	void SampleBatteryStatus();
 #endif
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_LINUX_CGROUP_STATS_COLLECTOR_H_
+#define BBQUE_LINUX_CGROUP_STATS_COLLECTOR_H_
+
+#include <array>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "bbque/config.h"
+#include "bbque/app/application.h"
+#include "bbque/utils/worker.h"
+
+/** Default sampling period of the control groups statistics */
+#define BBQUE_LINUX_CG_STATS_PERIOD_MS  1000
+
+namespace ba = bbque::app;
+
+namespace bbque {
+namespace pp {
+
+/**
+ * @class CGroupStatsCollector
+ *
+ * @brief Per-EXC resource usage accounting, from the statistics of the
+ * Linux control groups
+ *
+ * Each registered EXC is sampled periodically: the CPU, memory and block I/O
+ * statistics files of its control group are read all together, in a single
+ * pass, by means of file descriptors kept open for the whole EXC lifetime.
+ * The usage computed (totals and rates) is published into the
+ * ApplicationManager, to be queried by the scheduling policies.
+ *
+ * Both the legacy (v1) and the unified (v2) hierarchies are supported.
+ */
+class CGroupStatsCollector : public bu::Worker {
+
+public:
+
+	/**
+	 * @brief Constructor (Singleton)
+	 */
+	static CGroupStatsCollector & GetInstance();
+
+	/**
+	 * @brief Destructor
+	 */
+	~CGroupStatsCollector();
+
+	/**
+	 * @brief Set the sampling period
+	 */
+	void SetPeriod(uint32_t period_ms);
+
+	/**
+	 * @brief Start collecting the usage of an EXC
+	 *
+	 * @param papp The application/EXC
+	 * @param cgpath The path of its control group, relative to the mount
+	 * point of the controllers
+	 */
+	void Register(ba::AppPtr_t papp, std::string const & cgpath);
+
+	/**
+	 * @brief Stop collecting the usage of an EXC, closing its files
+	 */
+	void Unregister(ba::AppPtr_t papp);
+
+private:
+
+	/**
+	 * @brief The statistics files read for each EXC
+	 */
+	enum StatFile_t {
+		CPU_USAGE = 0,
+		CPU_STAT,
+		CPU_QUOTA,
+		CPU_PERIOD,
+		MEM_CURRENT,
+		MEM_STAT,
+		IO_STAT,
+		STAT_FILES_COUNT
+	};
+
+	/**
+	 * @brief The sampling status of an EXC
+	 */
+	struct ExcStats_t {
+		ba::AppPtr_t papp;
+		/** Control group path (relative) */
+		std::string cgpath;
+		/** The open statistics files (-1 if not available) */
+		std::array<int, STAT_FILES_COUNT> fds;
+		/** Whether the files have been opened yet */
+		bool opened = false;
+		/** The usage computed at the previous sampling */
+		ba::ResourceUsage_t usage;
+		/** The time of the previous sampling */
+		std::chrono::steady_clock::time_point last_sample;
+	};
+
+	/** The EXCs sampled, by UID */
+	std::map<AppUid_t, ExcStats_t> excs;
+
+	/** Serialize the sampling with the (un)registrations */
+	std::mutex excs_mtx;
+
+	/** The mount point of the controller of each statistics file */
+	std::array<std::string, STAT_FILES_COUNT> mount_points;
+
+	/** Unified (v2) control groups hierarchy */
+	bool cgroup_v2 = false;
+
+	/** Sampling period */
+	uint32_t period_ms = BBQUE_LINUX_CG_STATS_PERIOD_MS;
+
+	/** Buffer to read the statistics files */
+	char buff[4096];
+
+
+	CGroupStatsCollector();
+
+	/**
+	 * @brief Sample the statistics of all the registered EXCs
+	 */
+	void Task();
+
+	/**
+	 * @brief Look for the mount points of the controllers
+	 *
+	 * This must be done once the platform proxy has initialized the
+	 * control groups library.
+	 */
+	void InitMountPoints();
+
+	/**
+	 * @brief Open the statistics files of an EXC
+	 *
+	 * @return true if at least one file is available
+	 */
+	bool OpenFiles(ExcStats_t & exc_stats);
+
+	/**
+	 * @brief Close the statistics files of an EXC
+	 */
+	void CloseFiles(ExcStats_t & exc_stats);
+
+	/**
+	 * @brief Read the statistics of an EXC and update its usage
+	 */
+	void Sample(ExcStats_t & exc_stats,
+			std::chrono::steady_clock::time_point now);
+
+	/**
+	 * @brief Read the whole content of a (cached) statistics file
+	 *
+	 * @return The number of bytes read, or a negative value on error
+	 */
+	ssize_t ReadFile(int fd);
+
+	/**
+	 * @brief Parse the value of a key in a "<key> <value>" file content
+	 */
+	static bool ParseKey(char const * content, char const * key,
+			uint64_t & value);
+
+	/**
+	 * @brief Parse the bytes read and written from a block I/O file content,
+	 * summing up all the devices
+	 */
+	void ParseIO(char const * content, uint64_t & rbytes, uint64_t & wbytes);
+};
+
+} // namespace pp
+
+} // namespace bbque
+
+#endif // BBQUE_LINUX_CGROUP_STATS_COLLECTOR_H_
@@ -11,8 +11,15 @@
 // constants define
 #include "bbque/pp/linux_platform_proxy_types.h"
 #include "bbque/pp/proc_listener.h"
+#ifdef CONFIG_BBQUE_LINUX_CG_STATS
+#include "bbque/pp/cgroup_stats_collector.h"
+#endif
+#ifdef CONFIG_BBQUE_LINUX_RESCTRL
+#include "bbque/pp/resctrl.h"
+#endif
 
 #include <bitset>
+#include <map>
 
 namespace bbque {
 namespace pp {
@@ -98,6 +105,9 @@ private:
 
 	int cfs_margin_pct    = 0;  /**< CFS bandwidth enforcement safety margin (default: 0%) */
 	int cfs_threshold_pct = 100;/**< CFS bandwidth enforcement threshold (default: 100%)   */
+#ifdef CONFIG_BBQUE_LINUX_CG_STATS
+	int cg_stats_period_ms = BBQUE_LINUX_CG_STATS_PERIOD_MS; /**< Usage statistics sampling period */
+#endif
 
 	std::unique_ptr<bu::Logger> logger;
 
@@ -144,10 +154,33 @@ private:
 
 	std::string memory_ids_all;
 
+#ifdef CONFIG_BBQUE_PIL_TOPOLOGY_DISCOVERY
+	/**
+	 * The memory node local to each processing element, if the topology
+	 * has been discovered
+	 */
+	std::map<BBQUE_RID_TYPE, BBQUE_RID_TYPE> local_memory_ids;
+#endif
+
 #ifdef CONFIG_BBQUE_LINUX_PROC_LISTENER
 	ProcessListener & proc_listener;
 #endif
 
+#ifdef CONFIG_BBQUE_LINUX_CG_STATS
+	CGroupStatsCollector & cg_stats;
+#endif
+
+#ifdef CONFIG_BBQUE_LINUX_RESCTRL
+	/** The mount point of the resctrl filesystem */
+	std::string resctrl_root;
+
+	/** Cache and memory bandwidth partitioning, if supported */
+	std::unique_ptr<Resctrl> resctrl;
+
+	/** The CPU under which each cache/memory bandwidth domain is registered */
+	std::map<uint16_t, std::string> resctrl_domains;
+#endif
+
 //-------------------- METHODS
 
 	LinuxPlatformProxy();
@@ -176,6 +209,17 @@ private:
 	ExitCode_t RegisterMEM(const PlatformDescription::Memory &mem) noexcept;
 	ExitCode_t RegisterNET(const PlatformDescription::NetworkIF &net) noexcept;
 
+#ifdef CONFIG_BBQUE_LINUX_RESCTRL
+	// --- resctrl-related methods
+	void InitResctrl() noexcept;
+	/** Register the cache and memory bandwidth of the domain of a CPU */
+	ExitCode_t RegisterResctrl(const PlatformDescription::CPU &cpu) noexcept;
+	/** Assign the cache ways and memory bandwidth to the EXC group */
+	ExitCode_t SetResctrlGroup(AppPtr_t papp,
+	                           ResourceAssignmentMapPtr_t pres) noexcept;
+	static std::string ResctrlGroupName(AppPtr_t papp);
+#endif
+
 	// --- CGroup-releated methods
 	ExitCode_t InitCGroups() noexcept;                          /**< Load the libcgroup and initialize the internal representation */
 	ExitCode_t BuildSilosCG(CGroupDataPtr_t &pcgd) noexcept;    /**< Load the silos */
@@ -15,6 +15,9 @@
 #define BBQUE_PP_ARCH_SUPPORTS_INT64 0
 #endif
 
+/** Distance between resources whose relative position is unknown */
+#define BBQUE_PP_DISTANCE_UNKNOWN UINT16_MAX
+
 namespace bbque {
 namespace pp {
 
@@ -35,6 +38,63 @@ public:
 	        SHARED
 	} PartitionType_t;
 
+	/**
+	 * @brief Distance levels between processing elements, from the
+	 * closest (same PE) to the farthest (same NUMA node). The PEs of
+	 * different NUMA nodes are at distance PE_DIST_NODE plus the distance
+	 * of the nodes, as reported by the firmware (SLIT).
+	 */
+	enum PEDistance_t : uint16_t {
+		PE_DIST_SAME  = 0,
+		PE_DIST_SMT   = 1,
+		PE_DIST_CACHE = 2,
+		PE_DIST_LLC   = 3,
+		PE_DIST_NODE  = 4
+	};
+
+
+	/**
+	 * @class DistanceMatrix
+	 *
+	 * @brief The relative distances among the resources of the same type
+	 * (e.g., processing elements or memory nodes), indexed by ID
+	 */
+	class DistanceMatrix {
+	public:
+
+		inline void Resize(size_t size) {
+			this->size = size;
+			this->dist.assign(size * size, BBQUE_PP_DISTANCE_UNKNOWN);
+			for (size_t i = 0; i < size; ++i)
+				this->dist[i * size + i] = 0;
+		}
+
+		inline size_t Size() const {
+			return this->size;
+		}
+
+		inline bool Empty() const {
+			return this->size == 0;
+		}
+
+		inline uint16_t Get(uint16_t from, uint16_t to) const {
+			if (from == to)
+				return 0;
+			if ((from >= size) || (to >= size))
+				return BBQUE_PP_DISTANCE_UNKNOWN;
+			return this->dist[from * size + to];
+		}
+
+		inline void Set(uint16_t from, uint16_t to, uint16_t distance) {
+			assert((from < size) && (to < size));
+			this->dist[from * size + to] = distance;
+		}
+
+	private:
+		size_t size = 0;
+		std::vector<uint16_t> dist;
+	};
+
 
 	class Resource {
 	public:
@@ -431,6 +491,30 @@ public:
 			this->icns.push_back(icn);
 		}
 
+		/**
+		 * @brief The distances among the processing elements (empty if
+		 * the topology has not been discovered)
+		 */
+		inline const DistanceMatrix & GetPEDistances() const {
+			return this->pe_distances;
+		}
+
+		inline DistanceMatrix & GetPEDistances() {
+			return this->pe_distances;
+		}
+
+		/**
+		 * @brief The distances among the memory (NUMA) nodes (empty if
+		 * the topology has not been discovered)
+		 */
+		inline const DistanceMatrix & GetMemoryDistances() const {
+			return this->mem_distances;
+		}
+
+		inline DistanceMatrix & GetMemoryDistances() {
+			return this->mem_distances;
+		}
+
 		void SetType(res::ResourceType type) = delete;
 
 	private:
@@ -445,6 +529,9 @@ public:
 		std::vector <MemoryPtr_t> memories;
 		std::vector <NetworkIF_t> networkIFs;
 		std::vector <InterConnect_t> icns;
+
+		DistanceMatrix pe_distances;
+		DistanceMatrix mem_distances;
 	};
 
 	inline const System & GetLocalSystem() const {
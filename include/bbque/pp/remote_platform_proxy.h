@@ -105,6 +105,12 @@ public:
 		std::string const & system_path,
 		agent::ApplicationScheduleRequest const & request) ;
 
+
+	bbque::agent::ExitCode_t SendNodeStatus(
+		int system_id, agent::NodeStatus const & status);
+
+	void GetNodesStatus(std::map<int16_t, agent::NodeStatus> & nodes);
+
 private:
 	/**
 	 * @brief The logger used by the worker thread
@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_RESCTRL_H_
+#define BBQUE_RESCTRL_H_
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include <sys/types.h>
+
+/** Default mount point of the resctrl filesystem */
+#define BBQUE_RESCTRL_ROOT        "/sys/fs/resctrl"
+/** Root of the threads of a process */
+#define BBQUE_RESCTRL_PROC_ROOT   "/proc"
+
+namespace bbque {
+namespace pp {
+
+/**
+ * @class Resctrl
+ *
+ * @brief Last-level cache (CAT) and memory bandwidth (MBA) partitioning,
+ * through the Linux resctrl filesystem
+ *
+ * The capabilities are read from <root>/info (cbm_mask, min_cbm_bits,
+ * num_closids, min_bandwidth, bandwidth_gran), while the cache domains are
+ * read from the schemata of the default group. Each EXC is given a resource
+ * group, i.e., a sub-directory of the root, with a contiguous set of cache
+ * ways not overlapping the other groups, and a memory bandwidth throttling
+ * percentage. The ways are taken from the highest ones, while the default
+ * group is shrunk to the lowest ways left free (at least the minimum
+ * number allowed, always kept out of the groups). The cache domains not
+ * assigned to a group are shared with the default group, and updated with
+ * it.
+ *
+ * The root directory can be changed, thus the management can be performed
+ * on a fake directory tree, without CAT/MBA capable hardware.
+ */
+class Resctrl {
+
+public:
+
+	/**
+	 * @brief The cache ways and memory bandwidth of a group, per domain
+	 */
+	struct Allocation_t {
+		/** The number of cache ways */
+		std::map<uint16_t, uint16_t> cache_ways;
+		/** The memory bandwidth [%] */
+		std::map<uint16_t, uint16_t> mem_bw_pct;
+	};
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param root The mount point of the resctrl filesystem
+	 */
+	Resctrl(std::string const & root = BBQUE_RESCTRL_ROOT);
+
+	/**
+	 * @brief Read the capabilities and the domains
+	 *
+	 * @return false if neither cache nor memory bandwidth allocation is
+	 * supported, or no group can be created
+	 */
+	bool Scan();
+
+	/**
+	 * @brief Cache allocation support
+	 */
+	inline bool HasCacheAllocation() const {
+		return !cache_domains.empty();
+	}
+
+	/**
+	 * @brief Memory bandwidth allocation support
+	 */
+	inline bool HasMemBWAllocation() const {
+		return !mem_bw_domains.empty();
+	}
+
+	/**
+	 * @brief The IDs of the cache domains
+	 */
+	inline std::set<uint16_t> const & GetCacheDomains() const {
+		return cache_domains;
+	}
+
+	/**
+	 * @brief The IDs of the memory bandwidth domains
+	 */
+	inline std::set<uint16_t> const & GetMemBWDomains() const {
+		return mem_bw_domains;
+	}
+
+	/**
+	 * @brief The number of ways of each cache domain
+	 */
+	uint16_t GetCacheWays() const;
+
+	/**
+	 * @brief The maximum number of groups, beside the default one
+	 */
+	inline uint16_t GetMaxGroups() const {
+		return (num_closids > 0) ? num_closids - 1 : 0;
+	}
+
+	/**
+	 * @brief Create or update a group, and move the threads of a process
+	 * into it
+	 *
+	 * The cache ways previously assigned to the group are released before
+	 * the new ones are chosen. The number of ways is raised to the minimum
+	 * allowed, while the bandwidth to the minimum and the granularity.
+	 *
+	 * @return false if no more groups are available, the ways cannot be
+	 * assigned, or the filesystem cannot be updated
+	 */
+	bool SetupGroup(std::string const & name, Allocation_t const & alloc,
+			pid_t pid);
+
+	/**
+	 * @brief Remove a group, thus moving its threads into the default one
+	 */
+	bool RemoveGroup(std::string const & name);
+
+	/**
+	 * @brief The cache ways bitmask of a group in a domain (0 if none)
+	 */
+	uint64_t GetCacheMask(std::string const & name, uint16_t domain_id) const;
+
+private:
+
+	/** The mount point */
+	std::string root;
+
+	/** The bitmask of all the cache ways */
+	uint64_t cbm_mask = 0;
+
+	/** The minimum number of ways of a group */
+	uint16_t min_cbm_bits = 1;
+
+	/** The minimum memory bandwidth [%] */
+	uint16_t min_bandwidth = 10;
+
+	/** The memory bandwidth granularity [%] */
+	uint16_t bandwidth_gran = 10;
+
+	/** The number of classes of service, including the default group */
+	uint16_t num_closids = 0;
+
+	/** The cache domains */
+	std::set<uint16_t> cache_domains;
+
+	/** The memory bandwidth domains */
+	std::set<uint16_t> mem_bw_domains;
+
+	/** The cache ways assigned to the groups, for each domain */
+	std::map<uint16_t, uint64_t> domains_used;
+
+	/** The cache ways of each group, for each domain */
+	std::map<std::string, std::map<uint16_t, uint64_t>> groups_masks;
+
+	/** Serialize the updates of the groups */
+	mutable std::mutex groups_mtx;
+
+
+	/**
+	 * @brief Read the first line of a file
+	 */
+	bool ReadLine(std::string const & path, std::string & line) const;
+
+	/**
+	 * @brief Write a string into a file
+	 */
+	bool Write(std::string const & path, std::string const & value,
+			bool append = false) const;
+
+	/**
+	 * @brief Parse the domains of a schemata line (e.g., "L3:0=fff;1=fff")
+	 */
+	static void ParseDomains(std::string const & line,
+			std::set<uint16_t> & domain_ids);
+
+	/**
+	 * @brief Choose a contiguous set of free ways, from the highest ones,
+	 * leaving the minimum number of ways to the default group
+	 *
+	 * @return The bitmask, or 0 if no such set is available
+	 */
+	uint64_t FindWays(uint16_t domain_id, uint16_t ways) const;
+
+	/**
+	 * @brief Release the ways assigned to a group
+	 */
+	void ReleaseWays(std::string const & name);
+
+	/**
+	 * @brief The ways of the default group: the contiguous free ones,
+	 * from the lowest
+	 */
+	uint64_t DefaultWays(uint16_t domain_id) const;
+
+	/**
+	 * @brief Write the cache ways of the default group, also into the
+	 * domains the groups share with it
+	 */
+	bool UpdateDefaultGroup() const;
+
+	/**
+	 * @brief Move all the threads of a process into a group
+	 */
+	bool MoveTasks(std::string const & group_dir, pid_t pid) const;
+};
+
+} // namespace pp
+
+} // namespace bbque
+
+#endif // BBQUE_RESCTRL_H_
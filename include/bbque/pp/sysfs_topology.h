@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_SYSFS_TOPOLOGY_H_
+#define BBQUE_SYSFS_TOPOLOGY_H_
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "bbque/pp/platform_description.h"
+
+/** Default root of the CPUs and NUMA nodes description */
+#define BBQUE_SYSFS_TOPOLOGY_ROOT  "/sys/devices/system"
+/** NUMA distance of remote nodes, when not reported by the firmware */
+#define BBQUE_SYSFS_TOPOLOGY_REMOTE_DISTANCE  20
+
+namespace bbque {
+namespace pp {
+
+/**
+ * @class SysfsTopology
+ *
+ * @brief Discovery of the local system topology from the Linux sysfs
+ *
+ * The online CPUs, their SMT siblings and cache sharing sets are read from
+ * <root>/cpu, while the NUMA nodes (CPUs, memory size and distances) are
+ * read from <root>/node. A system without NUMA support is considered as a
+ * single node (0) including all the CPUs.
+ *
+ * The root directory can be changed, thus the discovery can be performed
+ * on a captured copy of the sysfs tree.
+ */
+class SysfsTopology {
+
+public:
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param root The directory including the "cpu" and "node" entries
+	 */
+	SysfsTopology(std::string const & root = BBQUE_SYSFS_TOPOLOGY_ROOT);
+
+	/**
+	 * @brief Read the topology
+	 *
+	 * @return false if no online CPU has been found
+	 */
+	bool Scan();
+
+	/**
+	 * @brief Replace the CPUs and memories of a system description with
+	 * the discovered ones
+	 *
+	 * Each NUMA node becomes a CPU, bound to the memory of the node. The
+	 * partition type and share of the processing elements already
+	 * described are kept, while the other ones are fully shared. The
+	 * distance matrices of the system are filled too.
+	 */
+	void BuildSystem(PlatformDescription::System & sys) const;
+
+	/**
+	 * @brief The IDs of the online processing elements
+	 */
+	std::set<uint16_t> GetProcessingElements() const;
+
+	/**
+	 * @brief The IDs of the NUMA nodes
+	 */
+	std::set<uint16_t> GetNodes() const;
+
+	/**
+	 * @brief The NUMA node of a processing element
+	 */
+	uint16_t GetNode(uint16_t pe_id) const;
+
+	/**
+	 * @brief The distance between two processing elements
+	 *
+	 * @see PlatformDescription::PEDistance_t
+	 */
+	uint16_t GetPEDistance(uint16_t pe_a, uint16_t pe_b) const;
+
+	/**
+	 * @brief The distance between two NUMA nodes
+	 */
+	uint16_t GetNodeDistance(uint16_t node_a, uint16_t node_b) const;
+
+	/**
+	 * @brief Parse a sysfs list of IDs (e.g., "0-3,8,10-11")
+	 */
+	static bool ParseList(std::string const & str, std::set<uint16_t> & ids);
+
+private:
+
+	/**
+	 * @brief The position of a processing element
+	 */
+	struct PEInfo_t {
+		uint16_t core_id    = 0;
+		uint16_t package_id = 0;
+		uint16_t node_id    = 0;
+	};
+
+	/** The root directory */
+	std::string root;
+
+	/** The online processing elements */
+	std::map<uint16_t, PEInfo_t> pes;
+
+	/** The memory size [bytes] of each NUMA node */
+	std::map<uint16_t, uint64_t> nodes_mem;
+
+	/** The distances among the processing elements */
+	PlatformDescription::DistanceMatrix pe_dist;
+
+	/** The distances among the NUMA nodes */
+	PlatformDescription::DistanceMatrix node_dist;
+
+
+	/**
+	 * @brief Read the first line of a file
+	 */
+	bool ReadLine(std::string const & path, std::string & line) const;
+
+	/**
+	 * @brief Read the CPUs, with their SMT siblings and caches
+	 */
+	bool ScanCPUs();
+
+	/**
+	 * @brief Read the NUMA nodes, with their CPUs and distances
+	 */
+	void ScanNodes();
+
+	/**
+	 * @brief Set the distance of each pair of processing elements in the
+	 * given set, if closer than the current one
+	 */
+	void SetCloser(std::set<uint16_t> const & pe_ids, uint16_t distance);
+};
+
+} // namespace pp
+
+} // namespace bbque
+
+#endif // BBQUE_SYSFS_TOPOLOGY_H_
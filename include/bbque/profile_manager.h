@@ -23,6 +23,7 @@
 #include "bbque/scheduler_manager.h"
 #include "bbque/utils/logging/logger.h"
 #include "bbque/utils/metrics_collector.h"
+#include "bbque/utils/worker.h"
 
 using bbque::utils::MetricsCollector;
 
@@ -34,8 +35,12 @@ namespace bbque {
  * @class ProfileManager
  * @ingroup sec07_pm
  * @brief A class providing profiling support for the BarbequeRTRM
+ *
+ * The statistics of each schedule are computed from the running aggregates
+ * maintained by the ApplicationManager, and then reported (metrics and log)
+ * by a dedicated worker, thus out of the scheduler critical path.
  */
-class ProfileManager {
+class ProfileManager : public bu::Worker {
 
 public:
 
@@ -61,16 +66,14 @@ public:
 
 	/**
 	 * @brief Porfile the last computed resource schedule
+	 *
+	 * The per-priority statistics are collected (at a cost proportional to
+	 * the number of priority levels) and handed to the profiling worker.
 	 */
 	ExitCode_t ProfileSchedule();
 
 private:
 
-	/**
-	 * @brief The logger used by the resource manager.
-	 */
-	std::unique_ptr<bu::Logger> logger;
-
 	/**
 	 * @brief The Resource Scheduler module
 	 */
@@ -109,9 +112,25 @@ private:
 	ProfileManager();
 
 	/**
-	 * @brief Collect profiling stats on the specified scheduling class
+	 * @brief The statistics of the last schedule, per priority level
+	 */
+	std::vector<ApplicationManager::SchedStats_t> sched_stats;
+
+	/**
+	 * @brief A new schedule has to be reported
+	 */
+	bool sched_stats_pending = false;
+
+	/**
+	 * @brief Report the statistics of the schedules profiled
+	 */
+	void Task();
+
+	/**
+	 * @brief Report the profiling stats of the specified scheduling class
 	 */
-	ExitCode_t ProfileScheduleClass(uint16_t prio);
+	ExitCode_t ProfileScheduleClass(uint16_t prio,
+			ApplicationManager::SchedStats_t const & stats);
 
 
 };
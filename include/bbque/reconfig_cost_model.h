@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_RECONFIG_COST_MODEL_H_
+#define BBQUE_RECONFIG_COST_MODEL_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+#include "bbque/config.h"
+#include "bbque/app/application.h"
+#include "bbque/app/overheads.h"
+#include "bbque/utils/logging/logger.h"
+
+#define RECONFIG_COST_MODEL_NAMESPACE "bq.rcm"
+
+/** Default file storing the transition costs across restarts */
+#define BBQUE_RCM_FILE         BBQUE_PATH_VAR "/transition_costs"
+/** Default time horizon [ms] the transition costs are normalized to */
+#define BBQUE_RCM_HORIZON_MS   1000
+/** Default number of samples before a transition cost is trusted */
+#define BBQUE_RCM_MIN_SAMPLES  3
+/** Number of new samples after which the costs are saved */
+#define BBQUE_RCM_SAVE_PERIOD  16
+
+namespace ba = bbque::app;
+namespace bu = bbque::utils;
+
+namespace bbque {
+
+/**
+ * @class ReconfigCostModel
+ *
+ * @brief Measured cost of the AWM transitions, per recipe
+ *
+ * The SynchronizationManager feeds the model with the cost of each
+ * transition actually performed, i.e., the time the application took to
+ * reach its synchronization point since its pre-change, plus the
+ * reconfiguration time profiled for its AWM. Samples are collected for each recipe and each
+ * (source AWM, destination AWM) pair, where a pair with the same AWM
+ * accounts for the migrations.
+ *
+ * The statistics are persisted into a file, thus the model survives to
+ * daemon restarts. The scheduling policies query the normalized cost of a
+ * transition, to be compared with the expected gain.
+ */
+class ReconfigCostModel {
+
+public:
+
+	/**
+	 * @brief Get a reference to the model (singleton)
+	 */
+	static ReconfigCostModel & GetInstance();
+
+	/**
+	 * @brief Destructor, saving the collected statistics
+	 */
+	~ReconfigCostModel();
+
+	/**
+	 * @brief Add the measured cost of a transition
+	 *
+	 * @param papp The application/EXC
+	 * @param src_awm_id The AWM before the transition
+	 * @param dst_awm_id The AWM after the transition
+	 * @param cost_ms The cost measured [ms]
+	 */
+	void AddSample(ba::AppSPtr_t papp,
+			int8_t src_awm_id, int8_t dst_awm_id, double cost_ms);
+
+	/**
+	 * @brief The average measured cost of a transition
+	 *
+	 * @param cost_ms Set to the average cost [ms]
+	 *
+	 * @return false if not enough samples have been collected
+	 */
+	bool GetCost(ba::AppSPtr_t papp,
+			int8_t src_awm_id, int8_t dst_awm_id, double & cost_ms);
+
+	/**
+	 * @brief The measured cost of a transition, normalized to the time
+	 * horizon
+	 *
+	 * @return A value in [0..1], or a negative value if not enough samples
+	 * have been collected
+	 */
+	float GetNormalCost(ba::AppSPtr_t papp,
+			int8_t src_awm_id, int8_t dst_awm_id);
+
+	/**
+	 * @brief Save the statistics into the file
+	 */
+	void Save();
+
+private:
+
+	/** Recipe, source AWM and destination AWM */
+	typedef std::tuple<std::string, int8_t, int8_t> TransitionKey_t;
+
+	std::unique_ptr<bu::Logger> logger;
+
+	/** The measured costs of the transitions */
+	std::map<TransitionKey_t, ba::TransitionOverheads> costs;
+
+	/** Serialize the updates with the policy queries */
+	std::mutex costs_mtx;
+
+	/** The file storing the statistics */
+	std::string file_path;
+
+	/** The time horizon [ms] the costs are normalized to */
+	uint32_t horizon_ms = BBQUE_RCM_HORIZON_MS;
+
+	/** The number of samples before a cost is trusted */
+	uint16_t min_samples = BBQUE_RCM_MIN_SAMPLES;
+
+	/** Samples added since the last saving */
+	uint16_t unsaved = 0;
+
+
+	ReconfigCostModel();
+
+	/**
+	 * @brief Load the statistics from the file
+	 */
+	void Load();
+
+	/**
+	 * @brief Save the statistics into the file (not thread-safe)
+	 */
+	void _Save();
+
+	/**
+	 * @brief The key of a transition of an application/EXC
+	 */
+	static TransitionKey_t GetKey(ba::AppSPtr_t papp,
+			int8_t src_awm_id, int8_t dst_awm_id);
+};
+
+} // namespace bbque
+
+#endif // BBQUE_RECONFIG_COST_MODEL_H_
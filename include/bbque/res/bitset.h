@@ -18,7 +18,9 @@
 #ifndef BBQUE_RESOURCE_BITSET_H_
 #define BBQUE_RESOURCE_BITSET_H_
 
-#include <bitset>
+#include <cstdint>
+#include <string>
+#include <vector>
 
 #include "bbque/res/identifier.h"
 
@@ -32,6 +34,12 @@ namespace bbque { namespace res {
  * the information.
  * This is commonly exploited to keep track of the IDs of a specific resource
  * type, from a set of resource assignments or resource descriptors.
+ *
+ * The set is stored in a vector of 64-bit words, which is grown at runtime
+ * according to the highest ID set, so that the size does not depend on the
+ * build-time configuration. The number of bits set and the boundaries of
+ * the set are maintained incrementally, while the cpuset-like string (e.g.,
+ * "0-7,16-23") is built lazily and cached until the next update.
  */
 class ResourceBitset {
 
@@ -42,8 +50,21 @@ public:
 		OUT_OF_RANGE
 	};
 
+	/** The type of the words storing the bits */
+	typedef uint64_t Word_t;
+
+	/** Number of bits per word */
+	static constexpr size_t WordBits = 64;
+
 	ResourceBitset();
 
+	/**
+	 * @brief Constructor
+	 *
+	 * @param nr_bits Number of bits to pre-allocate
+	 */
+	explicit ResourceBitset(size_t nr_bits);
+
 	~ResourceBitset();
 
 	ExitCode_t Set(BBQUE_RID_TYPE pos);
@@ -53,7 +74,9 @@ public:
 	ExitCode_t Reset(BBQUE_RID_TYPE pos);
 
 	inline bool Test(BBQUE_RID_TYPE pos) const {
-		return bit_set.test(pos);
+		if ((pos < 0) || (WordIndex(pos) >= words.size()))
+			return false;
+		return (words[WordIndex(pos)] & BitMask(pos)) != 0;
 	}
 
 	inline BBQUE_RID_TYPE Count() const {
@@ -68,41 +91,78 @@ public:
 		return last_set;
 	}
 
-	inline std::string ToString() const {
-		return bit_set.to_string();
+	/**
+	 * @brief The position of the next bit set
+	 *
+	 * This allows an iteration over the bits set only, e.g.:
+	 * for (id = bs.FirstSet(); id >= 0; id = bs.NextSet(id)) {...}
+	 *
+	 * @param pos The position to start from (excluded)
+	 *
+	 * @return The position of the next bit set, or R_ID_NONE if missing
+	 */
+	BBQUE_RID_TYPE NextSet(BBQUE_RID_TYPE pos) const;
+
+	/**
+	 * @brief Number of bits currently allocated
+	 */
+	inline size_t Size() const {
+		return words.size() * WordBits;
 	}
 
-	inline std::string const & ToStringCG() const {
-		return cg_str;
+	inline bool None() const {
+		return count == 0;
 	}
 
+	/**
+	 * @brief Check if at least one bit is set in both the bitsets
+	 */
+	bool Intersects(ResourceBitset const & rbs) const;
+
+	std::string ToString() const;
+
+	/**
+	 * @brief The set as a cpuset-like ranges string, e.g., "0-3,8,10-11"
+	 */
+	std::string const & ToStringCG() const;
+
 	inline unsigned long ToULong() const {
-		return bit_set.to_ulong();
+		return words.empty() ? 0 : static_cast<unsigned long>(words[0]);
 	}
 
 	/*****************************************************************
 	 *                        Operators                              *
 	 *****************************************************************/
 
-	bool operator== (ResourceBitset const & rbs) {
-		return bit_set == rbs.bit_set;
-	}
+	bool operator== (ResourceBitset const & rbs) const;
 
-	bool operator!= (ResourceBitset const & rbs) {
-		return bit_set != rbs.bit_set;
+	bool operator!= (ResourceBitset const & rbs) const {
+		return !(*this == rbs);
 	}
 
-	bool operator[] (BBQUE_RID_TYPE pos) {
-		return bit_set[pos];
+	/**
+	 * @brief A strict weak ordering of the sets, to use them as keys of the
+	 * sorted containers
+	 */
+	bool operator< (ResourceBitset const & rbs) const;
+
+	bool operator[] (BBQUE_RID_TYPE pos) const {
+		return Test(pos);
 	}
 
-	ResourceBitset operator|= (const ResourceBitset & rbs);
+	ResourceBitset & operator|= (const ResourceBitset & rbs);
+
+	ResourceBitset & operator&= (const ResourceBitset & rbs);
 
-	ResourceBitset operator&= (const ResourceBitset & rbs);
+	/**
+	 * @brief Clear all the bits set in the given bitset (and-not)
+	 */
+	ResourceBitset & operator-= (const ResourceBitset & rbs);
 
 private:
 
-	std::bitset<BBQUE_MAX_R_ID_NUM+1> bit_set;
+	/** The words storing the bits */
+	std::vector<Word_t> words;
 
 	BBQUE_RID_TYPE first_set;
 
@@ -110,9 +170,33 @@ private:
 
 	BBQUE_RID_TYPE count;
 
-	bool none;
+	/** Cached cpuset-like string */
+	mutable std::string cg_str;
+
+	/** True if the cached string matches the current set */
+	mutable bool cg_valid;
+
+
+	static inline size_t WordIndex(BBQUE_RID_TYPE pos) {
+		return static_cast<size_t>(pos) / WordBits;
+	}
+
+	static inline Word_t BitMask(BBQUE_RID_TYPE pos) {
+		return Word_t(1) << (static_cast<size_t>(pos) % WordBits);
+	}
+
+	/**
+	 * @brief Update count and boundaries from the content of the words
+	 *
+	 * This is required after whole-word operations only.
+	 */
+	void UpdateSummary();
+
+	/**
+	 * @brief The position of the highest bit set before the given one
+	 */
+	BBQUE_RID_TYPE PrevSet(BBQUE_RID_TYPE pos) const;
 
-	std::string cg_str;
 };
 
 } // namespace res
@@ -120,4 +204,3 @@ private:
 } // namespace bbque
 
 #endif // BBQUE_RESOURCE_BITSET_H_
-
@@ -18,7 +18,7 @@
 #define R_ID_ANY            -1
 #define R_ID_NONE           -2
 
-#define R_TYPE_COUNT        12
+#define R_TYPE_COUNT        14
 
 /** Data-type for the Resource IDs */
 typedef int16_t BBQUE_RID_TYPE;
@@ -46,6 +46,8 @@ enum class ResourceType
 	NETWORK_IF   ,
 	INTERCONNECT ,
 	IO           ,
+	CACHE        ,
+	MEMORY_BW    ,
 	CUSTOM       ,
 };
 
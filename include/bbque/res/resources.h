@@ -94,7 +94,8 @@ struct ResourceState {
 	 * @brief Constructor
 	 */
 	ResourceState():
-		used(0) {
+		used(0),
+		charged(0) {
 	}
 
 	/**
@@ -102,17 +103,28 @@ struct ResourceState {
 	 */
 	~ResourceState() {
 		apps.clear();
+		charges.clear();
 	}
 
 	/** The amount of resource used in the system   */
 	uint64_t used;
 
+	/**
+	 * The amount of resource accounted for the admission of new requests.
+	 * This is equal to the amount used, unless the resource is
+	 * oversubscribed (@see OvercommitModel).
+	 */
+	uint64_t charged;
+
 	/**
 	 * Amounts of resource used by each of the applications holding the
 	 * resource
 	 */
 	AppUsageQtyMap_t apps;
 
+	/** Amounts of resource charged to each of the applications */
+	AppUsageQtyMap_t charges;
+
 };
 
 
@@ -252,6 +264,9 @@ public:
 	 * If the Application is not specified the method returns the amount of
 	 * resource free, i.e. not allocated to any Application/EXC.
 	 *
+	 * The amounts considered are the ones charged, which exceed the ones
+	 * used only if the resource is oversubscribed.
+	 *
 	 * @param view_id The token referencing the resource view
 	 *
 	 * @return How much resource is still available including the amount of
@@ -280,6 +295,19 @@ public:
 	 */
 	uint64_t ApplicationUsage(AppSPtr_t const & papp, RViewToken_t view_id = 0);
 
+	/**
+	 * @brief Amount of resource charged to the application
+	 *
+	 * This differs from the amount used only if the resource is
+	 * oversubscribed.
+	 *
+	 * @param papp Application (shared pointer) using the resource
+	 * @param view_id The token referencing the resource view
+	 *
+	 * @return The amount of resource accounted for the admission
+	 */
+	uint64_t ApplicationCharge(AppSPtr_t const & papp, RViewToken_t view_id = 0);
+
 	/**
 	 * @brief Applications using the resource
 	 *
@@ -571,9 +599,12 @@ private:
 	 * @param papp The application requiring the resource
 	 * @param amount How much resource is required
 	 * @param view_id The token referencing the resource view
+	 * @param charge The amount accounted for the admission of further
+	 * requests (0 for the amount itself)
 	 * @return The amount of resource acquired if success, 0 otherwise.
 	 */
-	 uint64_t Acquire(AppSPtr_t const & papp, uint64_t amount, RViewToken_t view_id = 0);
+	 uint64_t Acquire(AppSPtr_t const & papp, uint64_t amount,
+			 RViewToken_t view_id = 0, uint64_t charge = 0);
 
 	/**
 	 * @brief Release the resource
@@ -18,6 +18,7 @@
 #ifndef BBQUE_RESOURCE_ACCOUNTER_H_
 #define BBQUE_RESOURCE_ACCOUNTER_H_
 
+#include <atomic>
 #include <set>
 
 #include "bbque/resource_accounter_conf.h"
@@ -108,6 +109,12 @@ public:
 
 	void WaitForPlatformReady();
 
+	/**
+	 * @brief Check if the accounting is ready, i.e. the platform is ready
+	 * and no synchronization is in progress
+	 */
+	bool IsReady();
+
 	/**
 	 * @brief Destructor
 	 */
@@ -395,6 +402,18 @@ public:
 	ExitCode_t  OnlineResources(std::string const & path);
 
 
+	/**
+	 * @brief The generation number of the platform resources
+	 *
+	 * The number is incremented each time a resource is registered, updated,
+	 * reserved or set offline/online, so that the results depending only on
+	 * the set of registered resources (e.g., the resource bindings) can be
+	 * cached until the next change.
+	 */
+	inline uint32_t GetPlatformGeneration() const {
+		return platform_generation.load();
+	}
+
 	/**
 	 * @brief Check if resources are being reshuffled
 	 *
@@ -410,6 +429,45 @@ public:
 	        br::ResourceAssignmentMapPtr_t const & current_map,
 	        br::ResourceAssignmentMapPtr_t const & next_map);
 
+	/**
+	 * @brief Check if the resources of an application are being resized
+	 *
+	 * A resize happens when the resources bound in the next assignment are
+	 * the same of the ones currently used (system view), but some amounts
+	 * differ, e.g., a different CPU quota on the same processing elements.
+	 * Since the resizes are enforced one by one, the growth of the ones
+	 * already admitted in the same view is accounted too.
+	 *
+	 * @param papp the application/EXC
+	 * @param next_map the "next" resources bindings
+	 * @param status_view the view of the scheduling
+	 *
+	 * @return RA_SUCCESS if the next amounts fit the system view,
+	 * RA_ERR_USAGE_EXC if they do not fit, RA_FAILED if this is not a
+	 * resize
+	 */
+	ExitCode_t CheckResize(
+	        ba::AppSPtr_t const & papp,
+	        br::ResourceAssignmentMapPtr_t const & next_map,
+	        br::RViewToken_t status_view);
+
+	/**
+	 * @brief Resize the resources of an application in the system view
+	 *
+	 * The amounts assigned in the current AWM, as scheduled, are accounted
+	 * in the system view without a synchronized mode session. This must be
+	 * called only if the current resources are being resized (@see
+	 * CheckResize()).
+	 *
+	 * @param papp the application/EXC
+	 * @param status_view the view of the scheduling
+	 *
+	 * @return RA_SUCCESS if the amounts have been updated
+	 */
+	ExitCode_t ResizeResources(
+	        ba::AppSPtr_t const & papp,
+	        br::RViewToken_t status_view);
+
 
 	/**
 	 * @see ResourceAccounterConfIF
@@ -591,6 +649,9 @@ private:
 	/** The tree of all the resources in the system.*/
 	br::ResourceTree resources;
 
+	/** Incremented at each change of the set of resources */
+	std::atomic<uint32_t> platform_generation;
+
 	/** The resource paths registered (strings and objects) */
 	std::map<std::string, br::ResourcePathPtr_t> r_paths;
 
@@ -650,6 +711,15 @@ private:
 	ResourceAccounter();
 
 
+	/** The growth of the amounts of a resize, for each resource */
+	typedef std::map<br::ResourcePtr_t, uint64_t> ResizeGrowth_t;
+
+	/** The view of the resizes admitted */
+	br::RViewToken_t resize_view = 0;
+
+	/** The growth of the resizes admitted, for each application */
+	std::map<AppUid_t, ResizeGrowth_t> resize_growth;
+
 	/**
 	 * @brief Set the status to READY
 	 */
@@ -676,6 +746,20 @@ private:
 	}
 
 
+	/**
+	 * @brief Check if the resources of an application are being resized
+	 *
+	 * @param growth if not null, the growth of the resizes admitted is
+	 * accounted, and the one of this resize returned
+	 *
+	 * @see CheckResize()
+	 */
+	ExitCode_t _CheckResize(
+	        ba::AppSPtr_t const & papp,
+	        br::ResourceAssignmentMapPtr_t const & next_map,
+	        br::RViewToken_t status_view,
+	        ResizeGrowth_t * growth);
+
 	/**
 	 * @brief Thread unsafe version of @ref GetView
 	 */
@@ -28,6 +28,7 @@
 #include "bbque/platform_services.h"
 #include "bbque/plugin_manager.h"
 #include "bbque/scheduler_manager.h"
+#include "bbque/shadow_scheduler.h"
 #include "bbque/synchronization_manager.h"
 #include "bbque/profile_manager.h"
 #include "bbque/resource_accounter.h"
@@ -193,6 +194,7 @@ private:
 
 	SynchronizationManager & ym;
 
+	ShadowScheduler & ss;
 
 #ifdef CONFIG_BBQUE_SCHED_PROFILING
 	ProfileManager & om;
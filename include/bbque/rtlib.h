@@ -40,7 +40,7 @@ extern "C" {
  * @brief The RTLib revision version
  * @ingroup rtlib_sec03_plain_services
  */
-#define RTLIB_VERSION_MINOR 4
+#define RTLIB_VERSION_MINOR 5
 
 /**
  * @brief The maximum length for an "application" name
@@ -336,6 +336,28 @@ struct RTLIB_WorkingModeParams {
 	RTLIB_SystemResources_t * systems;
 };
 
+/**
+ * @brief A snapshot of the resources currently assigned to an EXC
+ * @ingroup rtlib_sec03_plain_rtrm
+ *
+ * Read from the memory shared with the BarbequeRTRM, without any RPC round
+ * trip. The generation number changes at each new resource assignment.
+ */
+typedef struct RTLIB_Allocation {
+	/** Incremented at each new resource assignment */
+	uint32_t generation = 0;
+	/** The ID of the assigned AWM (-1 if blocked) */
+	int8_t awm_id = -1;
+	/** The resources assigned on the local system */
+	RTLIB_SystemResources_t local;
+	/** The processing elements assigned (bitmask of global IDs) */
+	uint64_t cpu_ids = 0;
+	/** The processing elements assigned in isolation */
+	uint64_t cpu_ids_isolation = 0;
+	/** The memory nodes assigned */
+	uint64_t mem_ids = 0;
+} RTLIB_Allocation_t;
+
 /**
  * @brief The parameters to register an execution context.
  * @ingroup rtlib_sec03_plain_exc
@@ -676,6 +698,21 @@ typedef RTLIB_ExitCode_t (*RTLIB_Utils_GetResourcesArray) (
 	int32_t * assignment_per_system,
 	uint16_t number_of_systems);
 
+/**
+ * @brief Get a snapshot of the resources currently assigned by the
+ *        BarbequeRTRM
+ * @ingroup rtlib_sec03_plain_rtrm
+ *
+ * The call does not involve any communication with the BarbequeRTRM, thus
+ * it can be used to poll the assignment at each processing cycle. It returns
+ * RTLIB_EXC_NOT_STARTED if no assignment has been published yet.
+ * The assignments are published once committed, i.e., at the end of each
+ * reconfiguration: meanwhile, the one received by the RTLib is returned.
+ */
+typedef RTLIB_ExitCode_t (*RTLIB_Utils_GetAllocation) (
+	RTLIB_EXCHandler_t exc_handler,
+	RTLIB_Allocation_t * allocation);
+
 typedef void (*RTLIB_Utils_StartPCountersMonitoring) (
 	RTLIB_EXCHandler_t exc_handler);
 
@@ -1024,6 +1061,7 @@ typedef struct RTLIB_Config {
 			bool overheads    = false;
 			bool no_kernel    = false;
 			bool big_num      = false;
+			bool self_monitoring = false;
 			int  detailed_run = 0;
 			int  raw          = 0;
 		} perf_counters;
@@ -1041,8 +1079,17 @@ typedef struct RTLIB_Config {
 		struct {
 			bool enabled = false;
 			int  level   = 0;
+			// Profile one command every 'sampling' (per command queue)
+			uint32_t sampling = 1;
 		} opencl;
 
+		// Sampled profiling: full accounting only every N cycles, or
+		// every T milliseconds if a time period is specified
+		struct {
+			uint32_t period_cycles = 1;
+			uint32_t period_ms     = 0;
+		} sampling;
+
 	} profile;
 
 	// Application-Specific RTM
@@ -1168,6 +1215,7 @@ struct RTLIB_Services {
                 RTLIB_Utils_GetAffinityMask GetAffinityMask;
 		RTLIB_Utils_GetResourcesArray GetResourcesArray;
 		RTLIB_Utils_StartPCountersMonitoring MonitorPerfCounters;
+		RTLIB_Utils_GetAllocation GetAllocation;
 	} Utils;
 
 	/* Cycles Time Control interface */
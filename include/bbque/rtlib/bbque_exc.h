@@ -388,6 +388,21 @@ public:
 		uint16_t number_of_systems
 	);
 
+	/**
+	 * @brief Get a snapshot of the resources currently assigned
+	 *
+	 * The snapshot is read from the memory shared with the BarbequeRTRM,
+	 * without any RPC round trip, thus it can be polled at each cycle. The
+	 * generation number changes at each new assignment.
+	 *
+	 * @param allocation The snapshot to fill
+	 *
+	 * @return RTLIB_OK in case of success. RTLIB_EXC_NOT_REGISTERED in case
+	 * of not registered application. RTLIB_EXC_NOT_STARTED in case of not
+	 * scheduled application.
+	 */
+	RTLIB_ExitCode_t GetAllocation(RTLIB_Allocation_t & allocation);
+
 
 	/**
 	 * @brief Set the cycle rate for this EXC
@@ -29,9 +29,13 @@
 
 #include "bbque/rtlib/bbque_rpc.h"
 
+/**
+ * The profiling requires an event per command: if the application does not
+ * request it, a local one is used, and then released by the RTLib.
+ */
 #define EVENT_RC_CONTROL(ev) \
-	cl_event local_event; \
-	if (ev == NULL) ev = &local_event;
+	cl_event local_event = nullptr; \
+	if ((ev == NULL) && rtlib_ocl_prof_enabled()) ev = &local_event;
 
 #define OCL_PROF_OUTDIR BBQUE_PATH_TEMP
 #define OCL_PROF_FMT    "%s/profOCL-%s-AWM%d-%s.dat"
@@ -301,7 +305,7 @@ struct RTLIB_OpenCL {
 
 using bbque::rtlib::BbqueRPC;
 
-void acc_command_event_info(QueueProfPtr_t, cl_event, cl_command_type &, void *,
+void acc_command_sample(QueueProfPtr_t, RTLIB_OCL_CmdSample_t const &,
 							int8_t, int);
 void acc_command_stats(QueueProfPtr_t, cl_command_type, double, double, double);
 void acc_address_stats(QueueProfPtr_t, void *, double, double, double);
@@ -312,8 +316,9 @@ void rtlib_ocl_init();
 void rtlib_init_devices();
 void rtlib_ocl_set_device(uint8_t device_id, RTLIB_ExitCode_t status);
 void rtlib_ocl_flush_events();
-void rtlib_ocl_coll_event(cl_command_queue, cl_event *, void *);
-void rtlib_ocl_prof_save(cl_command_queue, OclEventsStatsMap_t &);
+void rtlib_ocl_coll_event(cl_command_queue, cl_event *, bool, void *);
+void rtlib_ocl_prof_setup(uint32_t sampling_period);
+bool rtlib_ocl_prof_enabled();
 void rtlib_ocl_prof_clean();
 void rtlib_ocl_prof_run(int8_t, OclEventsStatsMap_t &, int);
 cl_command_type rtlib_ocl_get_command_type(void *);
@@ -18,7 +18,10 @@
 #ifndef BBQUE_OCL_STATS_H_
 #define BBQUE_OCL_STATS_H_
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <cstdint>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -36,6 +39,19 @@
 #define CL_CMD_EXEC_TIME   2
 #define CL_TAG "opencl"
 
+/** Number of slots of the events ring of a command queue (power of two) */
+#define RTLIB_OCL_RING_SIZE      1024
+/** Maximum number of profiled command queues */
+#define RTLIB_OCL_MAX_QUEUES     16
+/** Maximum number of drained samples pending for aggregation */
+#define RTLIB_OCL_MAX_SAMPLES    (16 * RTLIB_OCL_RING_SIZE)
+/** Events drain period [ms] */
+#define RTLIB_OCL_DRAIN_PERIOD_MS 10
+/** Number of events drained by a single wait */
+#define RTLIB_OCL_DRAIN_BATCH    64
+/** Number of buckets of the profiling histograms */
+#define RTLIB_OCL_HIST_BUCKETS   48
+
 namespace bac = boost::accumulators;
 
 typedef class RTLIB_OCL_QueueProf RTLIB_OCL_QueueProf_t;
@@ -49,11 +65,191 @@ typedef std::map<cl_command_queue, QueueProfPtr_t> OclEventsStatsMap_t;
 typedef std::pair<cl_command_type, std::string> CmdStrPair_t;
 typedef std::pair<cl_command_queue, QueueProfPtr_t> QueueProfPair_t;
 typedef std::pair<cl_command_type, AccArray_t> CmdProfPair_t;
-typedef std::pair<void *, cl_event> AddrEventPair_t;
 typedef std::pair<void *, AccArray_t> AddrProfPair_t;
 
 extern std::map<cl_command_type, std::string> ocl_cmd_str;
 
+/**
+ * @class RTLIB_OCL_Histogram
+ *
+ * @brief Fixed-buckets histogram of command times
+ *
+ * Buckets are powers of two of the time in [ns], i.e., the bucket b counts
+ * the samples in [2^(b-1), 2^b), thus the update cost is constant and no
+ * memory is allocated.
+ */
+class RTLIB_OCL_Histogram
+{
+public:
+
+	void Add(uint64_t time_ns)
+	{
+		++ buckets[Bucket(time_ns)];
+		++ count;
+		sum += time_ns;
+		if (time_ns < min) min = time_ns;
+		if (time_ns > max) max = time_ns;
+	}
+
+	/**
+	 * @brief Approximated percentile (upper bound of the bucket) [ns]
+	 */
+	uint64_t Percentile(double pct) const
+	{
+		uint64_t target = pct * count / 100.0;
+		uint64_t partial = 0;
+		for (int b = 0; b < RTLIB_OCL_HIST_BUCKETS; ++ b) {
+			partial += buckets[b];
+			if (partial > target)
+				return std::min<uint64_t>(max, (b == 0) ? 0 : (1ULL << b));
+		}
+		return max;
+	}
+
+	double Mean() const
+	{
+		return count ? (double) sum / count : 0.0;
+	}
+
+	static uint8_t Bucket(uint64_t time_ns)
+	{
+		if (time_ns == 0)
+			return 0;
+		uint8_t b = 64 - __builtin_clzll(time_ns);
+		return (b < RTLIB_OCL_HIST_BUCKETS) ? b : RTLIB_OCL_HIST_BUCKETS - 1;
+	}
+
+	std::array<uint64_t, RTLIB_OCL_HIST_BUCKETS> buckets = {};
+	uint64_t count = 0;
+	uint64_t sum   = 0;
+	uint64_t min   = UINT64_MAX;
+	uint64_t max   = 0;
+};
+
+typedef std::array<RTLIB_OCL_Histogram, 3> HistArray_t;
+
+/**
+ * @brief A command enqueued and selected for profiling
+ */
+typedef struct RTLIB_OCL_EventRecord {
+	cl_command_queue queue;
+	cl_command_type  cmd_type;
+	void *           addr;
+	cl_event         event;
+} RTLIB_OCL_EventRecord_t;
+
+/**
+ * @brief The profiling times [ns] of a completed command
+ */
+typedef struct RTLIB_OCL_CmdSample {
+	cl_command_queue queue;
+	cl_command_type  cmd_type;
+	void *           addr;
+	double           queued_time;
+	double           submit_time;
+	double           exec_time;
+} RTLIB_OCL_CmdSample_t;
+
+/**
+ * @class RTLIB_OCL_EventRing
+ *
+ * @brief Bounded lock-free ring of profiled commands
+ *
+ * Multiple producers (the enqueueing threads) push records without locks,
+ * by claiming a slot with a CAS on the head and publishing it through the
+ * per-slot sequence number. Records are popped by a single consumer at a
+ * time. A full ring drops the record, instead of blocking the application.
+ */
+class RTLIB_OCL_EventRing
+{
+public:
+
+	RTLIB_OCL_EventRing()
+	{
+		for (size_t i = 0; i < RTLIB_OCL_RING_SIZE; ++ i)
+			slots[i].seq.store(i, std::memory_order_relaxed);
+	}
+
+	bool Push(RTLIB_OCL_EventRecord_t const & record)
+	{
+		size_t pos = head.load(std::memory_order_relaxed);
+		Slot * slot;
+
+		for (;;) {
+			slot = &slots[pos & (RTLIB_OCL_RING_SIZE - 1)];
+			size_t seq = slot->seq.load(std::memory_order_acquire);
+			intptr_t diff = (intptr_t) seq - (intptr_t) pos;
+			if (diff == 0) {
+				if (head.compare_exchange_weak(pos, pos + 1,
+						std::memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0) {
+				dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			else {
+				pos = head.load(std::memory_order_relaxed);
+			}
+		}
+
+		slot->record = record;
+		slot->seq.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * @brief Pop up to max records (single consumer)
+	 *
+	 * @return The number of records popped
+	 */
+	size_t PopBatch(RTLIB_OCL_EventRecord_t * batch, size_t max)
+	{
+		size_t pos = tail.load(std::memory_order_relaxed);
+		size_t n = 0;
+
+		for (; n < max; ++ n, ++ pos) {
+			Slot & slot(slots[pos & (RTLIB_OCL_RING_SIZE - 1)]);
+			if (slot.seq.load(std::memory_order_acquire) != pos + 1)
+				break;
+			batch[n] = slot.record;
+			slot.seq.store(pos + RTLIB_OCL_RING_SIZE, std::memory_order_release);
+		}
+
+		tail.store(pos, std::memory_order_relaxed);
+		return n;
+	}
+
+	size_t Size() const
+	{
+		return head.load(std::memory_order_relaxed) -
+			tail.load(std::memory_order_relaxed);
+	}
+
+	uint64_t Dropped() const
+	{
+		return dropped.load(std::memory_order_relaxed);
+	}
+
+	/** Number of commands enqueued (for sampling) */
+	std::atomic<uint32_t> commands = {0};
+
+private:
+
+	struct Slot {
+		std::atomic<size_t> seq;
+		RTLIB_OCL_EventRecord_t record;
+	};
+
+	std::array<Slot, RTLIB_OCL_RING_SIZE> slots;
+
+	alignas(64) std::atomic<size_t> head = {0};
+
+	alignas(64) std::atomic<size_t> tail = {0};
+
+	std::atomic<uint64_t> dropped = {0};
+};
+
 /**
  * The set of commands related to memory transfer/copy operations, to include
  * in the runtime profile. This information will be make available to the
@@ -102,25 +298,10 @@ static const cl_command_type memory_trans_cmds[] = {
 class RTLIB_OCL_QueueProf
 {
 public:
-	~RTLIB_OCL_QueueProf()
-	{
-		std::map<void *, cl_event>::iterator it_ev;
-		cl_uint ref_count;
-
-		for (it_ev = events.begin(); it_ev != events.end(); it_ev++) {
-			clGetEventInfo(it_ev->second, CL_EVENT_REFERENCE_COUNT, sizeof(cl_uint),
-						   &ref_count, NULL);
-
-			if (ref_count > 0)
-				clReleaseEvent(it_ev->second);
-		}
-
-		cmd_prof.clear();
-	};
-
-	std::map<void *, cl_event> events;
 	std::map<void *, AccArray_t> addr_prof;
 	std::map<cl_command_type, AccArray_t> cmd_prof;
+	/** Fixed-buckets histograms of the command times */
+	std::map<cl_command_type, HistArray_t> cmd_hist;
 };
 
 #endif // BBQUE_OCL_STATS_H_
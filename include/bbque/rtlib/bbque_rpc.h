@@ -21,6 +21,9 @@
 #include "bbque/rtlib.h"
 #include "bbque/config.h"
 #include "bbque/rtlib/rpc_messages.h"
+#ifdef CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+#include "bbque/rtlib/rpc_shm.h"
+#endif
 #include "bbque/utils/stats.h"
 #include "bbque/utils/utility.h"
 #include "bbque/utils/timer.h"
@@ -192,6 +195,14 @@ public:
 
 	RTLIB_ExitCode_t GetRuntimeProfile(rpc_msg_BBQ_GET_PROFILE_t & msg);
 
+	/**
+	 * @brief Update the resources of an EXC resized in place
+	 *
+	 * The resource manager has already enforced the new amounts, thus the
+	 * EXC is not reconfigured.
+	 */
+	RTLIB_ExitCode_t ResizeNotify(rpc_msg_BBQ_RESIZE_t & msg);
+
 	/**
 	 * @brief Get a breakdown of the allocated resources
 	 */
@@ -217,6 +228,14 @@ public:
 		int32_t * sys_array,
 		uint16_t array_size);
 
+	/**
+	 * @brief Get a snapshot of the current resource assignment, from the
+	 * memory shared with the BarbequeRTRM (lock-free)
+	 */
+	RTLIB_ExitCode_t GetAllocation(
+		RTLIB_EXCHandler_t exc_handler,
+		RTLIB_Allocation_t * allocation);
+
 	/**
 	 * @brief Start monitoring performance counters for this EXC
 	 */
@@ -531,10 +550,24 @@ protected:
 		bu::Perf perf;
 		/** Map of registered Perf counter IDs */
 		PerfRegisteredEventsMap_t events_map;
+		/** Counters accumulated since the last runtime profile notification */
+		struct PerfWindow {
+			uint64_t cycles        = 0;
+			uint64_t llc_misses    = 0;
+			uint64_t task_clock_ns = 0;
+		} perf_window;
 #endif // CONFIG_BBQUE_RTLIB_PERF_SUPPORT
 
 		/** Overall cycles for this EXC */
 		uint64_t cycles_count = 0;
+		/** Overall cycles fully accounted (sampled profiling) */
+		uint64_t sampled_cycles_count = 0;
+		/** True if the current cycle is fully accounted */
+		bool     sampled_cycle = true;
+		/** Cycles since the last fully accounted one */
+		uint32_t cycles_since_sample = 0;
+		/** The time [ms] of the last fully accounted cycle */
+		double   last_sample_time_ms = 0.0;
 		/** Statistics on AWM's of this EXC */
 		AwmStatsMap_t awm_stats;
 		/** Statistics of currently selected AWM */
@@ -778,6 +811,7 @@ protected:
 	void OclPrintAddrStats(QueueProfPtr_t, cl_command_queue);
 	void OclDumpStats(pRegisteredEXC_t exc);
 	void OclDumpCmdStats(QueueProfPtr_t stPtr, cl_command_queue cmd_queue);
+	void OclDumpHistStats(QueueProfPtr_t stPtr, cl_command_queue cmd_queue);
 	void OclDumpAddrStats(QueueProfPtr_t stPtr, cl_command_queue cmd_queue);
 	void OclGetRuntimeProfile(
 		pRegisteredEXC_t exc, uint32_t & exec_time, uint32_t & mem_time);
@@ -826,7 +860,8 @@ protected:
 	virtual RTLIB_ExitCode_t _Clear(pRegisteredEXC_t exc) = 0;
 
 	virtual RTLIB_ExitCode_t _RTNotify(pRegisteredEXC_t exc, int percent,
-									   int cusage, int ctime_ms) = 0;
+									   int cusage, int ctime_ms,
+									   float llc_mpkc, uint32_t mem_bw_mbps) = 0;
 
 	virtual RTLIB_ExitCode_t _ScheduleRequest(pRegisteredEXC_t exc) = 0;
 
@@ -980,6 +1015,26 @@ private:
 	 */
 	std::string pathCGroup;
 
+#ifdef CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+	/**
+	 * @brief The (read-only) shared memory page published by the
+	 * BarbequeRTRM, with the resource assignment of each EXC
+	 */
+	rpc_shm_alloc_t const * shm_alloc = nullptr;
+
+	/**
+	 * @brief Map the shared memory page, once paired with the BarbequeRTRM
+	 */
+	void ShmAllocMap();
+
+	/**
+	 * @brief Read a consistent copy of the slot of an EXC
+	 *
+	 * @return false if no assignment has been published for the EXC
+	 */
+	bool ShmAllocRead(pRegisteredEXC_t exc, rpc_shm_alloc_exc_t & slot);
+#endif
+
 	/**
 	 * @brief Get the next available (and unique) Execution Context ID
 	 */
@@ -1162,6 +1217,17 @@ private:
 	 */
 	bool CheckDurationTimeout(pRegisteredEXC_t exc);
 
+	/**
+	 * Check if the starting cycle must be fully accounted.
+	 *
+	 * In sampled profiling mode (see the "S" flag of BBQUE_RTLIB_OPTS)
+	 * perf counters, CPU bandwidth and allocation updates are performed
+	 * only every N cycles, or every T milliseconds, to keep the RTLib
+	 * overhead low for applications with very short cycles. Cycle times
+	 * are still collected at each cycle.
+	 */
+	bool IsSampledCycle(pRegisteredEXC_t exc);
+
 	/******************************************************************************
 	 * Performance Counters
 	 ******************************************************************************/
@@ -1169,6 +1235,9 @@ private:
 
 # define BBQUE_RTLIB_PERF_ENABLE true
 
+/** Bytes transferred from memory for each LLC miss */
+# define BBQUE_RTLIB_PERF_LLC_LINE_SIZE 64
+
 	/** Default performance attributes to collect for each task */
 	static PerfEventAttr_t * raw_events;
 
@@ -1198,12 +1267,30 @@ private:
 
 	inline void PerfDisable(pRegisteredEXC_t exc)
 	{
+		// Self-monitoring counters are free running
+		if (exc->perf.SelfMonitoring())
+			return;
 		exc->perf.Disable();
 	}
 
 	inline void PerfEnable(pRegisteredEXC_t exc)
+	{
+		// Self-monitoring counters are free running: just take a snapshot
+		// to account the following interval only
+		if (exc->perf.SelfMonitoring()) {
+			exc->perf.UpdateAll();
+			return;
+		}
+		exc->perf.Enable();
+	}
+
+	/**
+	 * @brief Start the free running counters of the self-monitoring mode
+	 */
+	inline void PerfStart(pRegisteredEXC_t exc)
 	{
 		exc->perf.Enable();
+		exc->perf.UpdateAll();
 	}
 
 	void PerfSetupEvents(pRegisteredEXC_t exc);
@@ -1214,6 +1301,15 @@ private:
 
 	void PerfPrintStats(pRegisteredEXC_t exc, pAwmStats_t awm_stats);
 
+	/**
+	 * @brief The pressure on the shared cache and memory since the last
+	 * call, as LLC misses per kilo-cycle and estimated memory bandwidth
+	 *
+	 * Both are zero if the LLC misses are not counted (detailed run).
+	 */
+	void PerfInterference(pRegisteredEXC_t exc,
+						  float & llc_mpkc, uint32_t & mem_bw_mbps);
+
 	bool IsNsecCounter(pRegisteredEXC_t exc, int fd);
 
 	void PerfPrintNsec(pAwmStats_t awm_stats, pPerfEventStats_t perf_event_stats);
@@ -1234,8 +1330,10 @@ private:
 # define PerfSetupEvents(exc) {}
 # define PerfEnable(exc) {}
 # define PerfDisable(exc) {}
+# define PerfStart(exc) {}
 # define PerfCollectStats(exc) {}
 # define PerfPrintStats(exc, awm_stats) {}
+# define PerfInterference(exc, llc_mpkc, mem_bw_mbps) {}
 #endif // CONFIG_BBQUE_RTLIB_PERF_SUPPORT
 
 
@@ -18,27 +18,20 @@
 #ifndef BBQUE_GENERIC_WINDOW_H_
 #define BBQUE_GENERIC_WINDOW_H_
 
-#include <bbque/cpp11/mutex.h>
-
 #include <cmath>
+#include <atomic>
+#include <limits>
 #include <vector>
 #include <memory>
 #include <cstdint>
 #include <algorithm>
 #include <functional>
+#include <type_traits>
 #include <boost/circular_buffer.hpp>
-#include <boost/accumulators/accumulators.hpp>
-#include <boost/accumulators/statistics/stats.hpp>
-#include <boost/accumulators/statistics/mean.hpp>
-#include <boost/accumulators/statistics/max.hpp>
-#include <boost/accumulators/statistics/min.hpp>
-#include <boost/accumulators/statistics/variance.hpp>
 
 #include <iostream>
 #include <bbque/monitors/goal_info.h>
 
-namespace bac = boost::accumulators;
-
 namespace bbque
 {
 namespace rtlib
@@ -84,7 +77,9 @@ class GenericWindowIF
 
 public:
 
-	virtual ~GenericWindowIF();
+	virtual ~GenericWindowIF()
+	{
+	}
 
 	/**
 	 * @brief Checks whether the goal has been respected and returns a
@@ -113,6 +108,17 @@ public:
 	 */
 	virtual GoalInfoPtr fullCheckGoal() = 0;
 
+	/**
+	 * @brief Check if the goal has been achieved
+	 *
+	 * Same as fullCheckGoal(), but filling the given GoalInfo, whose
+	 * vectors are reused, thus not allocating memory once warmed up.
+	 *
+	 * @param goalInfo output parameter for the goal information
+	 * @return true if all the targets of the goal have been achieved
+	 */
+	virtual bool fullCheckGoal(GoalInfo & goalInfo) = 0;
+
 	/**
 	 * @brief Checks if the window of data is full (according to the
 	 * resultWindowSize variable)
@@ -140,6 +146,44 @@ public:
 };
 
 
+/**
+ * @brief Statistics of the samples in a window
+ */
+template <typename dataType>
+class WindowStats
+{
+public:
+	/**
+	 * @brief Number of samples the statistics refer to
+	 */
+	uint32_t count;
+
+	/**
+	 * @brief The last sample added to the window
+	 */
+	dataType last;
+
+	/**
+	 * @brief The minimum value
+	 */
+	dataType min;
+
+	/**
+	 * @brief The maximum value
+	 */
+	dataType max;
+
+	/**
+	 * @brief The average value
+	 */
+	double mean;
+
+	/**
+	 * @brief The variance of the values
+	 */
+	double variance;
+};
+
 /**
  * @brief A generic data window
  * @ingroup rtlib_sec04_mon
@@ -147,6 +191,15 @@ public:
  * @details
  * This class provides a general window able to contain different types of
  * values and manage them by provided utility functions.
+ *
+ * The window has a single writer and multiple readers. The sum, the sum of
+ * squares and the minimum and maximum values (through monotonic queues) are
+ * updated incrementally by the writer at each new sample, which then
+ * publishes the resulting statistics. Readers just load the published
+ * values, without locking the writer, and can get a consistent snapshot of
+ * all of them by getStats().
+ * The methods changing the samples (addElement, clear, setCapacity,
+ * setResultsWindow and resetResultsWindow) must not be called concurrently.
  */
 template <typename dataType>
 class GenericWindow: public GenericWindowIF
@@ -229,7 +282,8 @@ public:
 				  TargetsPtr targets,
 				  uint16_t windowSize = defaultWindowSize) :
 		metricName(metricName),
-		goalTargets(targets)
+		goalTargets(targets),
+		publishedSeq(0)
 	{
 		setCapacity(windowSize);
 	}
@@ -237,7 +291,8 @@ public:
 	/**
 	 * @brief Initializes internal variables
 	 */
-	GenericWindow(uint16_t windowSize = defaultWindowSize)
+	GenericWindow(uint16_t windowSize = defaultWindowSize) :
+		publishedSeq(0)
 	{
 		setCapacity(windowSize);
 	}
@@ -281,6 +336,12 @@ public:
 	 */
 	GoalInfoPtr fullCheckGoal();
 
+	/**
+	 * @brief Check if the goal has been achieved, filling the given
+	 * GoalInfo instead of allocating a new one
+	 */
+	bool fullCheckGoal(GoalInfo & goalInfo);
+
 	/**
 	 * @brief Checks whether the goal has been respected
 	 *
@@ -311,6 +372,11 @@ public:
 	 */
 	dataType getLastElement() const;
 
+	/**
+	 * @brief Returns a consistent snapshot of the window statistics
+	 */
+	WindowStats<dataType> getStats() const;
+
 	/**
 	 * @brief Sets a goal for the window of data
 	 *
@@ -345,20 +411,82 @@ public:
 	 */
 	bool isFull()
 	{
-		return windowBuffer.size() == resultsWindowSize;
+		return published.size.load(std::memory_order_relaxed) ==
+			resultsWindowSize;
 	}
 
 protected:
 
 	/**
-	 * @brief Mutex variable associated to the window buffer.
+	 * @brief Buffer for the window of values
 	 */
-	std::mutex windowMutex;
+	boost::circular_buffer<dataType> windowBuffer;
 
 	/**
-	 * @brief Buffer for the window of values
+	 * @brief Sequence number of the next sample
+	 *
+	 * The sample with sequence number seq is found in the buffer at
+	 * position (seq - (pushed - windowBuffer.size())).
 	 */
-	boost::circular_buffer<dataType> windowBuffer;
+	uint64_t pushed = 0;
+
+	/**
+	 * @brief Number of samples the statistics are computed on
+	 */
+	uint32_t statsCount = 0;
+
+	/**
+	 * @brief Samples added since the last full computation of the sums
+	 */
+	uint32_t statsUpdates = 0;
+
+	/**
+	 * @brief Sum of the samples the statistics are computed on
+	 */
+	double sum = 0;
+
+	/**
+	 * @brief Sum of squares of the samples the statistics are computed on
+	 */
+	double sumSquares = 0;
+
+	/**
+	 * @brief Sequence numbers of the candidate minimum values
+	 *
+	 * The corresponding values are increasing, thus the front is the
+	 * minimum of the samples the statistics are computed on.
+	 */
+	boost::circular_buffer<uint64_t> minQueue;
+
+	/**
+	 * @brief Sequence numbers of the candidate maximum values
+	 *
+	 * The corresponding values are decreasing, thus the front is the
+	 * maximum of the samples the statistics are computed on.
+	 */
+	boost::circular_buffer<uint64_t> maxQueue;
+
+	/**
+	 * @brief The statistics published to the readers
+	 */
+	class PublishedStats
+	{
+	public:
+		std::atomic<uint32_t> count;
+		std::atomic<uint32_t> size;
+		std::atomic<dataType> last;
+		std::atomic<dataType> min;
+		std::atomic<dataType> max;
+		std::atomic<double> mean;
+		std::atomic<double> variance;
+	} published;
+
+	/**
+	 * @brief Sequence counter of the published statistics
+	 *
+	 * It is odd while the writer is publishing new statistics.
+	 */
+	std::atomic<uint32_t> publishedSeq;
 
 	/**
 	 * Name of the metric associated to the goal
@@ -385,6 +513,36 @@ protected:
 	 * used to have the right comparison in the goal-checking phase
 	 */
 	static const ComparisonFunctor comparisonFunctions[4];
+
+	/**
+	 * @brief Returns the sample with the given sequence number
+	 */
+	dataType sampleAt(uint64_t seq) const
+	{
+		return windowBuffer[seq - (pushed - windowBuffer.size())];
+	}
+
+	/**
+	 * @brief Number of samples used to compute the statistics
+	 */
+	uint32_t statsWindowSize() const
+	{
+		return std::min<uint32_t>(resultsWindowSize,
+				windowBuffer.capacity());
+	}
+
+	/**
+	 * @brief Computes again all the statistics from the buffer
+	 *
+	 * This is required when the set of samples the statistics are
+	 * computed on changes as a whole.
+	 */
+	void updateStats();
+
+	/**
+	 * @brief Publishes the current statistics to the readers
+	 */
+	void publishStats();
 };
 
 template <typename dataType>
@@ -464,17 +622,27 @@ inline bool GenericWindow<dataType>::checkGoal(std::vector<float> &
 
 template <typename dataType>
 inline GoalInfoPtr GenericWindow<dataType>::fullCheckGoal()
+{
+	GoalInfoPtr goalInfo(new GoalInfo(goalTargets->size()));
+	fullCheckGoal(*goalInfo);
+	return goalInfo;
+}
+
+template <typename dataType>
+inline bool GenericWindow<dataType>::fullCheckGoal(GoalInfo & goalInfo)
 {
 	bool result;
-	uint8_t nap = 0;
+	bool achieved = true;
+	uint8_t nap;
 	double goalValue;
 	double dfResult;
 	double absoluteError;
 	double relativeError;
-	GoalInfoPtr goalInfo(new GoalInfo(goalTargets->size()));
-	goalInfo->metricName = metricName;
 	typename std::vector<Target>::iterator it;
 
+	goalInfo.reset(goalTargets->size());
+	goalInfo.metricName = metricName;
+
 	for (it = goalTargets->begin(); it != goalTargets->end(); ++it) {
 		/*
 		 * Forced promotion to double to avoid problems with unsigned
@@ -488,84 +656,206 @@ inline GoalInfoPtr GenericWindow<dataType>::fullCheckGoal()
 		absoluteError = dfResult - goalValue;
 		relativeError = absoluteError / goalValue;
 		result = it->comparisonFunction(dfResult, goalValue);
+		achieved = achieved && result;
 
+		nap = 0;
 		if (!result)
 			nap = 100 * fabs(absoluteError / (dfResult + goalValue));
 
-		goalInfo->achieved.push_back(result);
-		goalInfo->targetGoals.push_back(goalValue);
-		goalInfo->relativeErrors.push_back(relativeError);
-		goalInfo->observedValues.push_back(dfResult);
-		goalInfo->naps.push_back(nap);
+		goalInfo.achieved.push_back(result);
+		goalInfo.targetGoals.push_back(goalValue);
+		goalInfo.relativeErrors.push_back(relativeError);
+		goalInfo.observedValues.push_back(dfResult);
+		goalInfo.naps.push_back(nap);
 	}
 
-	return goalInfo;
+	return achieved;
 }
 
-#define GW_ACCUMULATE()\
-	uint16_t count = windowBuffer.size();\
-	if (count > resultsWindowSize)\
-		count = resultsWindowSize;\
-	acc = std::for_each(windowBuffer.end() - count,\
-			    windowBuffer.end(), acc);
-
 template <typename dataType>
 inline dataType GenericWindow<dataType>::getMax() const
 {
-	bac::accumulator_set<dataType, bac::features<bac::tag::max>> acc;
-	GW_ACCUMULATE();
-	return (bac::extract::max(acc));
+	return published.max.load(std::memory_order_relaxed);
 }
 
 template <typename dataType>
 inline dataType GenericWindow<dataType>::getMin() const
 {
-	bac::accumulator_set<dataType, bac::features<bac::tag::min>> acc;
-	GW_ACCUMULATE();
-	return (bac::extract::min(acc));
+	return published.min.load(std::memory_order_relaxed);
 }
 
 template <typename dataType>
 inline dataType GenericWindow<dataType>::getAverage() const
 {
-	bac::accumulator_set<dataType,
-		bac::features<bac::tag::mean(bac::immediate)>> acc;
-	GW_ACCUMULATE();
-	return (bac::extract::mean(acc));
+	return static_cast<dataType>(
+			published.mean.load(std::memory_order_relaxed));
 }
 
 template <typename dataType>
 inline dataType GenericWindow<dataType>::getVariance() const
 {
-	bac::accumulator_set<dataType, bac::features<bac::tag::variance>> acc;
-	GW_ACCUMULATE();
-	return (bac::extract::variance(acc));
+	return static_cast<dataType>(
+			published.variance.load(std::memory_order_relaxed));
 }
 
 template <typename dataType>
 inline dataType GenericWindow<dataType>::getLastElement() const
 {
-	return (windowBuffer.back());
+	return published.last.load(std::memory_order_relaxed);
+}
+
+template <typename dataType>
+WindowStats<dataType> GenericWindow<dataType>::getStats() const
+{
+	WindowStats<dataType> stats;
+	uint32_t seq;
+
+	// Read again if the writer has been publishing meanwhile
+	do {
+		seq = publishedSeq.load(std::memory_order_acquire);
+		stats.count    = published.count.load(std::memory_order_relaxed);
+		stats.last     = published.last.load(std::memory_order_relaxed);
+		stats.min      = published.min.load(std::memory_order_relaxed);
+		stats.max      = published.max.load(std::memory_order_relaxed);
+		stats.mean     = published.mean.load(std::memory_order_relaxed);
+		stats.variance = published.variance.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+	} while ((seq & 1) ||
+		 (seq != publishedSeq.load(std::memory_order_relaxed)));
+
+	return stats;
+}
+
+template <typename dataType>
+void GenericWindow<dataType>::publishStats()
+{
+	uint32_t seq = publishedSeq.load(std::memory_order_relaxed);
+	double mean = 0;
+	double variance = 0;
+
+	if (statsCount > 0) {
+		mean = sum / statsCount;
+		variance = std::max(0.0, sumSquares / statsCount - mean * mean);
+	}
+
+	publishedSeq.store(seq + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	published.count.store(statsCount, std::memory_order_relaxed);
+	published.size.store(windowBuffer.size(), std::memory_order_relaxed);
+	published.last.store(windowBuffer.empty() ? dataType() :
+			windowBuffer.back(), std::memory_order_relaxed);
+	published.mean.store(mean, std::memory_order_relaxed);
+	published.variance.store(variance, std::memory_order_relaxed);
+	if (statsCount > 0) {
+		published.min.store(sampleAt(minQueue.front()),
+				std::memory_order_relaxed);
+		published.max.store(sampleAt(maxQueue.front()),
+				std::memory_order_relaxed);
+	}
+	else {
+		published.min.store(std::numeric_limits<dataType>::max(),
+				std::memory_order_relaxed);
+		published.max.store(std::numeric_limits<dataType>::lowest(),
+				std::memory_order_relaxed);
+	}
+
+	publishedSeq.store(seq + 2, std::memory_order_release);
+}
+
+template <typename dataType>
+void GenericWindow<dataType>::updateStats()
+{
+	// Number again the samples in the buffer
+	pushed = windowBuffer.size();
+
+	statsCount = std::min<uint32_t>(windowBuffer.size(), statsWindowSize());
+	statsUpdates = 0;
+	sum = sumSquares = 0;
+	minQueue.clear();
+	maxQueue.clear();
+	minQueue.set_capacity(windowBuffer.capacity());
+	maxQueue.set_capacity(windowBuffer.capacity());
+
+	for (uint64_t seq = pushed - statsCount; seq < pushed; ++seq) {
+		dataType element = sampleAt(seq);
+		double value = element;
+		sum += value;
+		sumSquares += value * value;
+		while (!minQueue.empty() && sampleAt(minQueue.back()) >= element)
+			minQueue.pop_back();
+		minQueue.push_back(seq);
+		while (!maxQueue.empty() && sampleAt(maxQueue.back()) <= element)
+			maxQueue.pop_back();
+		maxQueue.push_back(seq);
+	}
+
+	publishStats();
 }
 
 template <typename dataType>
 inline void GenericWindow<dataType>::setResultsWindow(uint16_t resultSize)
 {
 	resultsWindowSize = resultSize;
+	updateStats();
 }
 
 template <typename dataType>
 void GenericWindow<dataType>::addElement(dataType element)
 {
-	std::lock_guard<std::mutex> lg(windowMutex);
+	uint32_t windowSize = statsWindowSize();
+	double value = element;
+
+	// No statistics to update
+	if (windowSize == 0) {
+		windowBuffer.push_back(element);
+		++pushed;
+		publishStats();
+		return;
+	}
+
+	// Drop the oldest sample out of the statistics
+	if (statsCount == windowSize) {
+		uint64_t oldest = pushed - statsCount;
+		double oldValue = sampleAt(oldest);
+		sum -= oldValue;
+		sumSquares -= oldValue * oldValue;
+		if (minQueue.front() == oldest)
+			minQueue.pop_front();
+		if (maxQueue.front() == oldest)
+			maxQueue.pop_front();
+		--statsCount;
+	}
+
+	// Add the new one, keeping the queues monotonic
+	uint64_t seq = pushed++;
 	windowBuffer.push_back(element);
+	sum += value;
+	sumSquares += value * value;
+	++statsCount;
+	while (!minQueue.empty() && sampleAt(minQueue.back()) >= element)
+		minQueue.pop_back();
+	minQueue.push_back(seq);
+	while (!maxQueue.empty() && sampleAt(maxQueue.back()) <= element)
+		maxQueue.pop_back();
+	maxQueue.push_back(seq);
+
+	// Rounding errors accumulate on floating point sums: compute them
+	// again once per window, which keeps the cost constant per sample
+	if (std::is_floating_point<dataType>::value &&
+			(++statsUpdates >= windowSize)) {
+		updateStats();
+		return;
+	}
+
+	publishStats();
 }
 
 template <typename dataType>
 void GenericWindow<dataType>::clear()
 {
-	std::lock_guard<std::mutex> lg(windowMutex);
 	windowBuffer.clear();
+	updateStats();
 }
 
 template <typename dataType>
@@ -577,15 +867,16 @@ void GenericWindow<dataType>::setGoal(TargetsPtr targets)
 template <typename dataType>
 void GenericWindow<dataType>::setCapacity(uint16_t windowSize)
 {
-	std::lock_guard<std::mutex> lg(windowMutex);
 	windowBuffer.set_capacity(windowSize);
 	resultsWindowSize = windowSize;
+	updateStats();
 }
 
 template <typename dataType>
 inline void GenericWindow <dataType>::resetResultsWindow()
 {
 	resultsWindowSize = windowBuffer.capacity();
+	updateStats();
 }
 
 } // namespace as
@@ -83,6 +83,12 @@ public:
 	 */
 	GoalInfo(uint8_t nTargets);
 
+	/**
+	 * @brief Removes the information of all the targets, keeping the
+	 * memory reserved for nTargets of them
+	 */
+	void reset(uint8_t nTargets);
+
 	/**
 	 * @brief Returns if all the targets of the goal have been achieved or
 	 * not
@@ -107,6 +113,23 @@ typedef std::vector<GoalInfoPtr> GoalInfoList;
 inline GoalInfo::GoalInfo(uint8_t nTargets)
 {
 	achieved.reserve(nTargets);
+	targetGoals.reserve(nTargets);
+	observedValues.reserve(nTargets);
+	relativeErrors.reserve(nTargets);
+	naps.reserve(nTargets);
+}
+
+inline void GoalInfo::reset(uint8_t nTargets)
+{
+	achieved.clear();
+	targetGoals.clear();
+	observedValues.clear();
+	relativeErrors.clear();
+	naps.clear();
+
+	achieved.reserve(nTargets);
+	targetGoals.reserve(nTargets);
+	observedValues.reserve(nTargets);
 	relativeErrors.reserve(nTargets);
 	naps.reserve(nTargets);
 }
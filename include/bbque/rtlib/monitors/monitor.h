@@ -112,6 +112,15 @@ public:
 	 */
 	virtual GoalInfoPtr fullCheckGoal(uint16_t id);
 
+	/**
+	 * @brief Checks the goal, filling the given GoalInfo
+	 *
+	 * @param id Identifies monitor and corresponding list
+	 * @param goalInfo output parameter for the goal information
+	 * @return true if the goal has been achieved
+	 */
+	virtual bool fullCheckGoal(uint16_t id, GoalInfo & goalInfo);
+
 	/**
 	 * @brief Resets current goal
 	 *
@@ -279,6 +288,13 @@ inline GoalInfoPtr Monitor <dataType>::fullCheckGoal(uint16_t id)
 	return (goalList[id]->fullCheckGoal());
 }
 
+template <typename dataType>
+inline bool Monitor <dataType>::fullCheckGoal(uint16_t id,
+		GoalInfo & goalInfo)
+{
+	return (goalList[id]->fullCheckGoal(goalInfo));
+}
+
 template <typename dataType>
 inline void Monitor <dataType>::deleteGoal(uint16_t id)
 {
@@ -27,6 +27,7 @@
 #include <bbque/monitors/operating_point.h>
 #include <bbque/monitors/metric_priority.h>
 #include <bbque/monitors/op_filter.h>
+#include <bbque/monitors/op_table.h>
 
 namespace bbque
 {
@@ -45,6 +46,8 @@ namespace as
  * according to different metrics. When such a structure is created, it is
  * possible to move between different operating points according to priorities
  * and filters given by the user.
+ * Sorting and filtering work on a compiled OPTable, thus the metric names are
+ * resolved once per call, instead of once per compared point.
  */
 class OPManager
 {
@@ -68,6 +71,7 @@ public:
 		: operatingPoints(opList)
 	{
 		vectorId = 0;
+		opTable.setPoints(operatingPoints);
 		setPolicy(metricsPriorities);
 	}
 
@@ -157,76 +161,53 @@ public:
 	void setPolicy(PrioritiesList & orderingStrategy);
 
 	/**
-	 * @brief Getter for the list of operating points
+	 * @brief Getter for the list of operating points, in priority order
 	 */
 	OperatingPointsList getOperatingPoints() const
 	{
-		return operatingPoints;
+		OperatingPointsList sortedPoints;
+		sortedPoints.reserve(opTable.size());
+		for (uint32_t id = 0; id < opTable.size(); ++id)
+			sortedPoints.push_back(operatingPoints[opTable.getPointIndex(id)]);
+		return sortedPoints;
 	}
 
 private:
 	/**
-	 * @brief Current index of the operating points list
+	 * @brief Current index (priority order) of the operating points list
 	 */
-	uint16_t vectorId;
+	uint32_t vectorId;
 
 	/**
-	 * @brief List of references to operating points
+	 * @brief List of operating points, in the order they were given
 	 */
 	OperatingPointsList operatingPoints;
 
 	/**
-	 * @brief Checks whether an operating point respects some constraints
-	 *
-	 * REMEMBER: if a name in the filter is not in the map, it won't be
-	 * considered
-	 *
-	 * @param op Pointer to the OperatingPoint to check
-	 * @param opFilters List of constraints to that OperatingPoint
-	 * @return True if the point is valid, False otherwise
+	 * @brief Compiled table of the operating points metrics
 	 */
-	bool isValidOP(const OperatingPoint & op,
-				   const OPFilterList & opFilters) const;
+	OPTable opTable;
 
 	/**
-	 * @class operatingPointsComparator
-	 * @brief Defines a functor used to sort operating points
+	 * @brief Copy the operating point at the given index (priority order)
 	 */
-	class operatingPointsComparator
+	void selectOP(uint32_t id, OperatingPoint & op)
 	{
+		vectorId = id;
+		op = operatingPoints[opTable.getPointIndex(id)];
+	}
+
+	/**
+	 * @brief Implementation of getLowerOP, with compiled filters
+	 */
+	bool getLowerOP(OperatingPoint & op,
+			const OPTable::CompiledFilterList & filters);
 
-	public:
-		/**
-		 * @brief Constructor of the class
-		 *
-		 * @param orderingStrategy PrioritiesList giving the sorting
-		 * order of the operating points
-		 */
-		operatingPointsComparator(PrioritiesList & orderingStrategy)
-			: metricsPriorities(orderingStrategy)
-		{
-		}
-
-		/**
-		 * @brief Overload of the function call operator, used to
-		 * influence the sorting process
-		 *
-		 * @param op1 Pointer to the first OperatingPoint to compare
-		 * @param op2 Pointer to the second OperatingPoint to compare
-		 *
-		 * @return  True if op1 goes before op2 in the specific strict
-		 * weak ordering defined, False otherwise.
-		 */
-		bool operator()(const OperatingPoint & op1,
-						const OperatingPoint & op2) const;
-
-	private:
-		/**
-		 * @brief PrioritiesList giving the sorting order of the
-		 * operating points
-		 */
-		PrioritiesList metricsPriorities;
-	};
+	/**
+	 * @brief Implementation of getHigherOP, with compiled filters
+	 */
+	bool getHigherOP(OperatingPoint & op,
+			 const OPTable::CompiledFilterList & filters);
 };
 
 } // namespace as
@@ -0,0 +1,263 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_OP_TABLE_H_
+#define BBQUE_OP_TABLE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+#include <bbque/monitors/operating_point.h>
+#include <bbque/monitors/metric_priority.h>
+#include <bbque/monitors/op_filter.h>
+
+namespace bbque
+{
+namespace rtlib
+{
+namespace as
+{
+
+/**
+ * @brief Compiled table of operating points
+ * @ingroup rtlib_sec04_op
+ *
+ * @details
+ * The metrics of a list of operating points are stored column-wise, with
+ * the metric names resolved just once into column indexes. The rows of the
+ * table follow the order defined by a priorities list, so that filtering
+ * the points is a scan over contiguous arrays of values. The sorted indexes
+ * computed for a priorities list are kept, thus switching back to an
+ * already used ordering policy does not require sorting again.
+ *
+ * A metric missing in an operating point is stored as NaN: such a point
+ * never passes a filter on that metric, and it is sorted after the points
+ * defining it.
+ */
+class OPTable
+{
+
+public:
+
+	/**
+	 * @brief Column index of a metric not defined by any point
+	 */
+	static const int NoColumn = -1;
+
+	/**
+	 * @brief Position returned by searches not finding a valid point
+	 */
+	static const uint32_t NoPoint = UINT32_MAX;
+
+	/**
+	 * @brief Filter whose metric has been resolved into a column
+	 */
+	class CompiledFilter
+	{
+	public:
+		/**
+		 * @brief The kind of comparison, to inline the common ones
+		 */
+		enum Kind {
+			LESS,
+			LESS_EQUAL,
+			GREATER,
+			GREATER_EQUAL,
+			CUSTOM
+		};
+
+		/**
+		 * @brief Column of the filtered metric
+		 */
+		int column;
+
+		/**
+		 * @brief Comparison to perform
+		 */
+		Kind kind;
+
+		/**
+		 * @brief Upper or Lower bound for the metric
+		 */
+		double value;
+
+		/**
+		 * @brief The comparison function, for CUSTOM filters
+		 */
+		const ComparisonFunctor * cFunction;
+	};
+
+	/**
+	 * @brief Defines a type for a vector of compiled filters
+	 */
+	typedef std::vector<CompiledFilter> CompiledFilterList;
+
+	OPTable() :
+		pointsCount(0),
+		sortColumn(NoColumn),
+		sortAscending(true)
+	{
+	}
+
+	/**
+	 * @brief Load the metrics of a list of operating points
+	 *
+	 * The rows are in the same order of the list, until a policy is set.
+	 *
+	 * @param opList List of operating points
+	 */
+	void setPoints(const OperatingPointsList & opList);
+
+	/**
+	 * @brief Order the rows according to a list of priorities
+	 *
+	 * @param orderingStrategy A list of priorities, in descending order
+	 */
+	void setPolicy(const PrioritiesList & orderingStrategy);
+
+	/**
+	 * @brief Number of operating points in the table
+	 */
+	uint32_t size() const
+	{
+		return pointsCount;
+	}
+
+	/**
+	 * @brief Index, in the loaded list, of the point at the given row
+	 */
+	uint32_t getPointIndex(uint32_t row) const
+	{
+		return order[row];
+	}
+
+	/**
+	 * @brief Column of a metric, or NoColumn if not defined by any point
+	 */
+	int getColumn(const std::string & metricName) const;
+
+	/**
+	 * @brief Resolve a list of filters into the table columns
+	 *
+	 * @param opFilters List of filters
+	 * @param filters Where to store the compiled filters
+	 */
+	void compileFilters(const OPFilterList & opFilters,
+			    CompiledFilterList & filters) const;
+
+	/**
+	 * @brief Checks whether the point at a row respects the filters
+	 */
+	bool isValid(uint32_t row, const CompiledFilterList & filters) const;
+
+	/**
+	 * @brief The first row in [from, to) respecting the filters
+	 *
+	 * @return The row found, or NoPoint if missing
+	 */
+	uint32_t findFirst(uint32_t from, uint32_t to,
+			   const CompiledFilterList & filters) const;
+
+	/**
+	 * @brief The last row in [from, to) respecting the filters
+	 *
+	 * @return The row found, or NoPoint if missing
+	 */
+	uint32_t findLast(uint32_t from, uint32_t to,
+			  const CompiledFilterList & filters) const;
+
+private:
+
+	/**
+	 * @brief Number of rows checked at once by the searches
+	 */
+	static const uint32_t BlockSize = 256;
+
+	/**
+	 * @brief Number of operating points
+	 */
+	uint32_t pointsCount;
+
+	/**
+	 * @brief Column index of each metric
+	 */
+	std::map<std::string, int> columnIds;
+
+	/**
+	 * @brief The metric values, in the order of the loaded list
+	 */
+	std::vector<std::vector<double>> pointsColumns;
+
+	/**
+	 * @brief The metric values, in the order of the current policy
+	 */
+	std::vector<std::vector<double>> columns;
+
+	/**
+	 * @brief True for the columns with some missing values
+	 */
+	std::vector<bool> columnMissing;
+
+	/**
+	 * @brief The point index at each row, for the current policy
+	 */
+	std::vector<uint32_t> order;
+
+	/**
+	 * @brief The sorted indexes computed so far, by policy signature
+	 */
+	std::map<std::string, std::vector<uint32_t>> sortedIndexes;
+
+	/**
+	 * @brief Column of the highest priority metric, if sorted with one of
+	 * the standard orderings
+	 */
+	int sortColumn;
+
+	/**
+	 * @brief True if the sort column is in increasing order
+	 */
+	bool sortAscending;
+
+	/**
+	 * @brief Restrict a range of rows using the filters on the sort column
+	 *
+	 * Since the sort column is monotonic, the rows passing a standard
+	 * comparison on it are a contiguous range, found by binary search.
+	 */
+	void boundRange(const CompiledFilterList & filters,
+			uint32_t & from, uint32_t & to) const;
+
+	/**
+	 * @brief Evaluate the filters on a block of rows
+	 *
+	 * @param mask Set to 1 for the rows respecting all the filters
+	 */
+	void checkBlock(uint32_t from, uint32_t count,
+			const CompiledFilterList & filters, uint8_t * mask) const;
+};
+
+} // namespace as
+
+} // namespace rtlib
+
+} // namespace bbque
+
+#endif /* BBQUE_OP_TABLE_H_ */
@@ -226,6 +226,12 @@ private:
 	 * List of goals to register for the use with ApplicationRTRM
 	 */
 	GoalsList goalsList;
+
+	/**
+	 * Information on the goals from the last check, reused by the
+	 * following ones
+	 */
+	GoalInfoList goalsInfo;
 };
 
 } // namespace as
@@ -76,7 +76,8 @@ protected:
 	RTLIB_ExitCode_t _Clear(pRegisteredEXC_t exc);
 
 	RTLIB_ExitCode_t _RTNotify(pRegisteredEXC_t exc, int gap,
-							   int cusage, int ctime_ms);
+							   int cusage, int ctime_ms,
+							   float llc_mpkc, uint32_t mem_bw_mbps);
 
 	void _Exit();
 
@@ -202,6 +203,11 @@ private:
 	 */
 	void RpcBbqGetRuntimeProfile();
 
+	/**
+	 * @brief Get from FIFO a resize notification RPC message
+	 */
+	void RpcBbqResize();
+
 };
 
 } // namespace rtlib
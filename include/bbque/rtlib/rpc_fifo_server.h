@@ -34,7 +34,7 @@
 #define BBQUE_FIFO_NAME_LENGTH 32
 
 #define BBQUE_RPC_FIFO_MAJOR_VERSION 1
-#define BBQUE_RPC_FIFO_MINOR_VERSION 0
+#define BBQUE_RPC_FIFO_MINOR_VERSION 1
 
 #define FIFO_PKT_SIZE(RPC_TYPE)\
 	sizeof(bbque::rtlib::rpc_fifo_ ## RPC_TYPE ## _t)
@@ -138,6 +138,8 @@ RPC_FIFO_DEFINE_MESSAGE(BBQ_STOP);
 RPC_FIFO_DEFINE_MESSAGE(BBQ_GET_PROFILE);
 RPC_FIFO_DEFINE_MESSAGE(BBQ_GET_PROFILE_RESP);
 
+RPC_FIFO_DEFINE_MESSAGE(BBQ_RESIZE);
+
 /******************************************************************************
  * Utility Commands
  ******************************************************************************/
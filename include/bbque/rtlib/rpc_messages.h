@@ -67,6 +67,10 @@ typedef enum rpc_msg_type {
 	RPC_BBQ_GET_PROFILE,
 
 	RPC_BBQ_RESP, ///< Response to a BBQ command
+
+	// Appended, not to change the identifiers of the previous messages
+	RPC_BBQ_RESIZE,
+
 	RPC_BBQ_MSGS_COUNT ///< The number of EXC originated messages
 
 } rpc_msg_type_t;
@@ -190,6 +194,10 @@ typedef struct rpc_msg_EXC_RTNOTIFY {
 	int gap;
 	int cusage;
 	int ctime_ms;
+	/** LLC misses per kilo-cycle (0 if not measured) */
+	float llc_mpkc;
+	/** Memory bandwidth [MB/s] estimated from the LLC misses */
+	uint32_t mem_bw_mbps;
 } rpc_msg_EXC_RTNOTIFY_t;
 
 /**
@@ -362,6 +370,24 @@ typedef struct rpc_msg_BBQ_GET_PROFILE {
 	bool is_ocl;
 } rpc_msg_BBQ_GET_PROFILE_t;
 
+/**
+ * @brief Notification of the resources of an EXC resized in place
+ *
+ * The amounts assigned in the current AWM have been changed, without
+ * changing the AWM nor the binding. The platform limits are already
+ * enforced, thus no response is expected.
+ */
+typedef struct rpc_msg_BBQ_RESIZE {
+	/** The RPC fifo command header */
+	rpc_msg_header_t hdr;
+	/** The current AWM */
+	int8_t awm;
+	/** Amount of processing quota assigned */
+	int32_t r_proc;
+	/** Amount of memory assigned */
+	int32_t r_mem;
+} rpc_msg_BBQ_RESIZE_t;
+
 
 /*******************************************************************************
  *    RPC Utils
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_RPC_SHM_H_
+#define BBQUE_RPC_SHM_H_
+
+#include <cstdint>
+#include <cstring>
+
+/** The name of the shared memory page of an application (by PID) */
+#define RPC_SHM_ALLOC_NAME_FMT     "/bbque_alloc_%05d"
+/** The maximum length of the shared memory page name */
+#define RPC_SHM_ALLOC_NAME_LENGTH  32
+/** Magic number identifying a valid shared memory page */
+#define RPC_SHM_ALLOC_MAGIC        0xB0A110C5
+/** The number of EXC slots (must be a power of two) */
+#define RPC_SHM_ALLOC_EXCS         32
+/** The number of systems described in each EXC slot */
+#define RPC_SHM_ALLOC_SYSTEMS      4
+/** Number of attempts of a reader racing with the writer */
+#define RPC_SHM_ALLOC_READ_RETRIES 64
+
+namespace bbque
+{
+namespace rtlib
+{
+
+/**
+ * @brief The resources assigned to an EXC on a system
+ */
+typedef struct rpc_shm_alloc_system {
+	/** The system number */
+	int16_t sys_id;
+	/** Number of CPU (processors) assigned */
+	int16_t nr_cpus;
+	/** Number of processing elements assigned */
+	int16_t nr_procs;
+	/** Amount of processing quota assigned */
+	int32_t r_proc;
+	/** Amount of memory assigned */
+	int32_t r_mem;
+} rpc_shm_alloc_system_t;
+
+/**
+ * @brief The resource assignment of an EXC
+ *
+ * The slot is updated by the BarbequeRTRM only, under a sequence lock: the
+ * sequence number is odd while the update is in progress, thus a reader
+ * copies the slot and retries if the sequence number has changed meanwhile.
+ */
+typedef struct rpc_shm_alloc_exc {
+	/** Sequence number of the updates */
+	uint32_t seq;
+	/** Incremented at each new resource assignment */
+	uint32_t generation;
+	/** The EXC owning the slot (-1 if none) */
+	int16_t exc_id;
+	/** The ID of the assigned AWM (-1 if blocked) */
+	int8_t awm_id;
+	/** The number of valid system entries */
+	uint8_t nr_sys;
+	/** The processing elements assigned (bitmask of global IDs) */
+	uint64_t cpu_ids;
+	/** The processing elements assigned in isolation */
+	uint64_t cpu_ids_isolation;
+	/** The memory nodes assigned */
+	uint64_t mem_ids;
+	/** The resources assigned on each system */
+	rpc_shm_alloc_system_t systems[RPC_SHM_ALLOC_SYSTEMS];
+} rpc_shm_alloc_exc_t;
+
+/**
+ * @brief The shared memory page of an application
+ *
+ * Created by the BarbequeRTRM at pairing time and mapped read-only by the
+ * RTLib, it publishes the current resource assignment of each EXC, so that
+ * the application can poll it without any RPC round trip.
+ */
+typedef struct rpc_shm_alloc {
+	/** Set once the page has been initialized */
+	uint32_t magic;
+	/** The EXC slots, indexed by EXC ID */
+	rpc_shm_alloc_exc_t excs[RPC_SHM_ALLOC_EXCS];
+} rpc_shm_alloc_t;
+
+
+/**
+ * @brief The slot of an EXC
+ */
+inline rpc_shm_alloc_exc_t * RpcShmAllocSlot(
+		rpc_shm_alloc_t * shm, uint8_t exc_id) {
+	return &shm->excs[exc_id & (RPC_SHM_ALLOC_EXCS - 1)];
+}
+
+inline rpc_shm_alloc_exc_t const * RpcShmAllocSlot(
+		rpc_shm_alloc_t const * shm, uint8_t exc_id) {
+	return &shm->excs[exc_id & (RPC_SHM_ALLOC_EXCS - 1)];
+}
+
+/**
+ * @brief Start the update of a slot (single writer)
+ */
+inline void RpcShmAllocWriteBegin(rpc_shm_alloc_exc_t * slot) {
+	uint32_t seq = __atomic_load_n(&slot->seq, __ATOMIC_RELAXED);
+	__atomic_store_n(&slot->seq, seq + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Complete the update of a slot, making it visible to the readers
+ */
+inline void RpcShmAllocWriteEnd(rpc_shm_alloc_exc_t * slot) {
+	uint32_t seq = __atomic_load_n(&slot->seq, __ATOMIC_RELAXED);
+	__atomic_store_n(&slot->seq, seq + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Copy a consistent snapshot of a slot, without locking
+ *
+ * @return false if the writer kept updating the slot for all the attempts
+ */
+inline bool RpcShmAllocRead(
+		rpc_shm_alloc_exc_t const * slot, rpc_shm_alloc_exc_t & snapshot) {
+	for (int i = 0; i < RPC_SHM_ALLOC_READ_RETRIES; ++i) {
+		uint32_t seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+		if (seq & 0x1)
+			continue;
+		memcpy(&snapshot, slot, sizeof(rpc_shm_alloc_exc_t));
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == seq)
+			return true;
+	}
+	return false;
+}
+
+} // namespace rtlib
+
+} // namespace bbque
+
+#endif // BBQUE_RPC_SHM_H_
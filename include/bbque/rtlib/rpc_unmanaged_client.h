@@ -109,13 +109,16 @@ protected:
 	}
 
 	RTLIB_ExitCode_t _RTNotify(pRegisteredEXC_t exc, int gap,
-							   int cusage, int ctime_ms)
+							   int cusage, int ctime_ms,
+							   float llc_mpkc, uint32_t mem_bw_mbps)
 	{
 		// Remove compilation warning
 		(void)exc;
 		(void)gap;
 		(void)cusage;
 		(void)ctime_ms;
+		(void)llc_mpkc;
+		(void)mem_bw_mbps;
 		return RTLIB_OK;
 	}
 
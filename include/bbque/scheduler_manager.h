@@ -20,6 +20,10 @@
 
 #include <mutex>
 #include <condition_variable>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "bbque/config.h"
 #include "bbque/plugin_manager.h"
@@ -40,6 +44,9 @@ using bbque::utils::MetricsCollector;
 
 #define SCHEDULER_MANAGER_NAMESPACE "bq.sm"
 
+/** Default number of scheduling outcomes memoized (0 to disable) */
+#define BBQUE_SCHED_MEMO_SIZE 0
+
 namespace bbque {
 
 /**
@@ -140,6 +147,72 @@ private:
 	std::mutex mux;
 	std::condition_variable status_cv;
 
+	/**
+	 * @brief The time budget [ms] of the scheduling runs, for each
+	 * priority class (the last one applies to the lower classes too).
+	 * A null budget means unbounded runs.
+	 */
+	std::vector<uint32_t> budgets_ms;
+
+	/**
+	 * @brief The sum of the quality of the runs completed within the time
+	 * budget, i.e., equivalent to unbounded ones
+	 */
+	double unbounded_quality_sum = 0;
+
+	/**
+	 * @brief The number of runs completed within the time budget
+	 */
+	uint32_t unbounded_runs = 0;
+
+	/**
+	 * @struct MemoOutcome_t
+	 *
+	 * The scheduling outcome of an application/EXC
+	 */
+	struct MemoOutcome_t {
+		/** The schedulable state of the application/EXC */
+		std::string key;
+		/** The AWM assigned (-1 if not scheduled) */
+		int awm_id = -1;
+		/** The resource binding of the AWM */
+		br::ResourceAssignmentMapPtr_t binding;
+	};
+
+	/**
+	 * @struct MemoEntry_t
+	 *
+	 * The outcome of a scheduling run, for each application/EXC, in the
+	 * order of their schedulable state keys
+	 */
+	struct MemoEntry_t {
+		size_t fingerprint;
+		std::vector<MemoOutcome_t> outcomes;
+	};
+
+	/** The schedulable applications/EXCs, with their state keys */
+	typedef std::vector<std::pair<std::string, AppPtr_t>> SchedApps_t;
+
+	/**
+	 * @brief The maximum number of scheduling outcomes memoized
+	 */
+	uint32_t memo_size = BBQUE_SCHED_MEMO_SIZE;
+
+	/**
+	 * @brief The scheduling outcomes memoized, most recently used first
+	 */
+	std::list<MemoEntry_t> memo_lru;
+
+	/**
+	 * @brief The memoized outcomes, by fingerprint
+	 */
+	std::unordered_map<size_t, std::list<MemoEntry_t>::iterator> memo_index;
+
+	/**
+	 * @brief A counter used for getting always a new clean resources view
+	 */
+	uint32_t memo_view_count = 0;
+
 	/**
 	 * @brief The collection of metrics generated by this module
 	 */
@@ -152,6 +225,12 @@ private:
 		SM_SCHED_MIGREC,
 		SM_SCHED_MIGRATE,
 		SM_SCHED_BLOCKED,
+		SM_SCHED_RESIZE,
+		SM_SCHED_BUDGET_EXPIRED,
+		SM_SCHED_BUDGET_OVERRUN,
+		SM_SCHED_MEMO_HIT,
+		SM_SCHED_MEMO_MISS,
+		SM_SCHED_MEMO_INVALID,
 		//----- Timing metrics
 		SM_SCHED_TIME,
 		SM_SCHED_PERIOD,
@@ -161,6 +240,9 @@ private:
 		SM_SCHED_AVG_MIGREC,
 		SM_SCHED_AVG_MIGRATE,
 		SM_SCHED_AVG_BLOCKED,
+		//----- Quality statistics
+		SM_SCHED_QUALITY,
+		SM_SCHED_QUALITY_GAP,
 
 		SM_METRICS_COUNT
 	} SchedMgrMetrics_t;
@@ -180,11 +262,99 @@ private:
 	 */
 	void CollectStats();
 
+	/**
+	 * @brief The time budget of the next scheduling run
+	 *
+	 * This is the budget of the highest priority class among the
+	 * applications waiting to start, or among all the applications if no
+	 * one is waiting.
+	 */
+	uint32_t GetTimeBudget();
+
+	/**
+	 * @brief The quality of the schedule just computed
+	 *
+	 * This is the average value of the AWMs assigned, normalized to the
+	 * highest value AWM of each application (0 if not scheduled).
+	 */
+	double GetScheduleQuality();
+
+	/**
+	 * @brief Collect statistics on the time budget of the last run
+	 *
+	 * The quality gap of the runs truncated by the time budget is
+	 * estimated with respect to the average quality of the completed
+	 * ones.
+	 */
+	void CollectBudgetStats(uint32_t budget_ms);
+
+	/**
+	 * @brief Fingerprint of the schedulable state
+	 *
+	 * The state of each application/EXC to schedule is described by a key
+	 * including recipe, priority and enabled AWMs (thus the effects of the
+	 * constraints). The fingerprint hashes the sorted keys, together with
+	 * the generation of the platform resources (totals, reservations and
+	 * offline state).
+	 *
+	 * @param apps Filled with the applications/EXCs, sorted by key
+	 *
+	 * @return The fingerprint
+	 */
+	size_t GetSchedulableState(SchedApps_t & apps);
+
+	/**
+	 * @brief Apply the memoized outcome of the same schedulable state
+	 *
+	 * The outcome is validated first, by booking all the bindings into a
+	 * scratch resource state view. Only if everything still fits, the
+	 * scheduling requests are performed into a new view.
+	 *
+	 * The schedulable state does not include the runtime profiles of the
+	 * applications (e.g., the goal gaps), which are then not taken into
+	 * account by the outcomes reused.
+	 *
+	 * @param fingerprint The current schedulable state fingerprint
+	 * @param apps The applications/EXCs to schedule, sorted by key
+	 * @param sched_view_id Set to the view of the scheduling
+	 *
+	 * @return true if the memoized outcome has been applied, false if
+	 * missing or no longer valid
+	 */
+	bool ApplyMemoizedSchedule(
+			size_t fingerprint,
+			SchedApps_t const & apps,
+			br::RViewToken_t & sched_view_id);
+
+	/**
+	 * @brief Get a new resource state view for the memoization
+	 *
+	 * @return false if the view cannot be got
+	 */
+	bool GetMemoView(br::RViewToken_t & view_id);
+
+	/**
+	 * @brief Memoize the outcome of the scheduling policy
+	 *
+	 * This must be called before committing the running applications,
+	 * which clears their next AWM.
+	 */
+	void MemoizeSchedule(size_t fingerprint, SchedApps_t const & apps);
+
 	/**
 	 * @brief Clear next AWM in RUNNING Applications/EXC
 	 */
 	void CommitRunningApplications();
 
+	/**
+	 * @brief Enforce the resources resized of RUNNING Applications/EXC
+	 *
+	 * The applications keeping the same AWM and binding, but with different
+	 * amounts of resources, do not require a synchronization: the new
+	 * amounts are committed immediately.
+	 */
+	void CommitResizedApplications();
+
 	/**
 	 * @brief Set the current scheduling state
 	 * @param _s The new state
@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_SHADOW_SCHEDULER_H_
+#define BBQUE_SHADOW_SCHEDULER_H_
+
+#include <memory>
+#include <string>
+
+#include "bbque/application_manager.h"
+#include "bbque/plugins/scheduler_policy.h"
+#include "bbque/utils/logging/logger.h"
+#include "bbque/utils/metrics_collector.h"
+#include "bbque/utils/worker.h"
+
+#define SHADOW_SCHEDULER_NAMESPACE "bq.ss"
+
+/** Default file of the comparisons */
+#define BBQUE_SS_FILE          BBQUE_PATH_VAR "/shadow_schedules"
+/** Default power [mW] of a fully used processing element */
+#define BBQUE_SS_PE_POWER_MW   1000
+
+using bbque::plugins::SchedulerPolicyIF;
+using bbque::utils::MetricsCollector;
+
+namespace bu = bbque::utils;
+
+namespace bbque {
+
+/**
+ * @class ShadowScheduler
+ * @ingroup sec05_sm
+ * @brief Evaluation of a secondary scheduling policy on live workloads
+ *
+ * After each scheduling run, a secondary ("shadow") policy is executed on
+ * the same system state, by a dedicated worker. The shadow policy books
+ * the resources into a private view, which is then released, while the
+ * applications see the status captured before the scheduling run, and
+ * copies of their AWMs (@see ShadowContext_t). Thus, its decisions are
+ * never committed.
+ *
+ * Since the resource accounting is not serialized, the shadow run starts
+ * once the system has been synchronized, and the next scheduling run
+ * drops it, i.e., it rejects its further bookings, and waits for it to
+ * end.
+ *
+ * Both the outcomes are scored (value, fairness, reconfigurations implied,
+ * power estimate and scheduling time) and the comparison is exported to
+ * the metrics collector, the log and a file.
+ */
+class ShadowScheduler : public bu::Worker {
+
+public:
+
+	/**
+	 * @brief The score of a scheduling outcome
+	 */
+	struct Score_t {
+		/** Average AWM value, normalized to the highest one [0..1] */
+		double value = 0;
+		/** Jain's fairness index of the normalized AWM values */
+		double fairness = 1;
+		/** EXCs starting, changing AWM or blocked */
+		uint16_t reconfs = 0;
+		/** EXCs keeping the AWM on a different set of processing elements */
+		uint16_t migrations = 0;
+		/** EXCs scheduled */
+		uint16_t scheduled = 0;
+		/** Power estimate [mW] of the processing quota assigned */
+		double power_mw = 0;
+		/** Scheduling time [ms] */
+		double time_ms = 0;
+	};
+
+	/**
+	 * @brief Get a reference to the shadow scheduler
+	 */
+	static ShadowScheduler & GetInstance();
+
+	~ShadowScheduler();
+
+	/**
+	 * @brief Whether a shadow policy has been loaded
+	 */
+	inline bool Enabled() const {
+		return (policy != nullptr);
+	}
+
+	/**
+	 * @brief Prepare the shadow run of the next scheduling
+	 *
+	 * This drops the shadow run pending, or in progress, which cannot
+	 * book resources anymore, and waits for the latter to end. Then the
+	 * applications status is captured.
+	 *
+	 * This must be called before running the scheduling policy.
+	 */
+	void Prepare();
+
+	/**
+	 * @brief Queue the shadow run of the scheduling just performed
+	 *
+	 * The outcome of the scheduling (the next AWMs) is recorded, and the
+	 * shadow run handed to the worker, which starts it on Resume().
+	 *
+	 * This must be called before committing the running applications,
+	 * which clears their next AWM.
+	 *
+	 * @param sched_policy the name of the scheduling policy
+	 * @param sched_count the scheduling run number
+	 * @param time_ms the scheduling time [ms]
+	 * @param budget_ms the time budget [ms] of the scheduling run
+	 */
+	void Evaluate(char const * sched_policy, uint32_t sched_count,
+			double time_ms, uint32_t budget_ms);
+
+	/**
+	 * @brief Let the shadow run start
+	 *
+	 * This must be called once the scheduling has been synchronized, or
+	 * aborted.
+	 */
+	void Resume();
+
+private:
+
+	/**
+	 * @brief A shadow run to perform
+	 */
+	struct Job_t {
+		/** The status of the applications, and the shadow requests */
+		ShadowContext_t ctx;
+		/** The outcome of the scheduling */
+		ShadowContext_t::Requests_t outcome;
+		/** The name of the scheduling policy */
+		std::string sched_policy;
+		/** The scheduling run number */
+		uint32_t sched_count = 0;
+		/** The scheduling time [ms] */
+		double time_ms = 0;
+		/** The time budget [ms] */
+		uint32_t budget_ms = 0;
+	};
+
+	ApplicationManager & am;
+
+	MetricsCollector & mc;
+
+	/** The shadow policy */
+	SchedulerPolicyIF * policy = nullptr;
+
+	/** The name of the shadow policy */
+	std::string policy_name;
+
+	/** The file of the comparisons (empty: disabled) */
+	std::string file_path;
+
+	/** Power [mW] of a fully used processing element */
+	uint32_t pe_power_mw;
+
+	/** The shadow run being prepared */
+	std::unique_ptr<Job_t> next_job;
+
+	/** The shadow run ready to be performed */
+	std::unique_ptr<Job_t> pending_job;
+
+	/** The shadow run in progress, if any */
+	Job_t * running_job = nullptr;
+
+	/** The system is being scheduled or synchronized */
+	bool busy = false;
+
+	/**
+	 * @brief The collection of metrics generated by this module
+	 */
+	typedef enum ShadowSchedMetrics {
+		//----- Event counting metrics
+		SS_RUNS = 0,
+		SS_SKIPPED,
+		SS_FAILED,
+		//----- Sample statistics
+		SS_TIME,
+		SS_VALUE_GAP,
+		SS_FAIRNESS_GAP,
+		SS_RECONF_GAP,
+		SS_POWER_GAP,
+
+		SS_METRICS_COUNT
+	} ShadowSchedMetrics_t;
+
+	static MetricsCollector::MetricsCollection_t metrics[SS_METRICS_COUNT];
+
+	ShadowScheduler();
+
+	/**
+	 * @brief Perform the shadow runs
+	 */
+	void Task();
+
+	/**
+	 * @brief Run the shadow policy, and compare the outcomes
+	 */
+	void Run(Job_t & job);
+
+	/**
+	 * @brief Score an outcome, with respect to the status captured
+	 */
+	Score_t GetScore(ShadowContext_t const & ctx,
+			ShadowContext_t::Requests_t const & outcome) const;
+
+	/**
+	 * @brief Export the comparison of the outcomes
+	 */
+	void Report(Job_t const & job, Score_t const & real,
+			Score_t const & shadow);
+};
+
+} // namespace bbque
+
+#endif // BBQUE_SHADOW_SCHEDULER_H_
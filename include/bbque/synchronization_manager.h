@@ -18,6 +18,9 @@
 #ifndef BBQUE_SYNCHRONIZATION_MANAGER_H_
 #define BBQUE_SYNCHRONIZATION_MANAGER_H_
 
+#include <map>
+#include <vector>
+
 #include "bbque/config.h"
 #include "bbque/plugin_manager.h"
 #include "bbque/application_proxy.h"
@@ -117,6 +120,11 @@ private:
 	 */
 	uint32_t sync_count;
 
+	/**
+	 * @brief The EXCs selected for the current synchronization round
+	 */
+	std::vector<AppPtr_t> sync_apps;
+
 	typedef enum SyncMgrMetrics {
 		//----- Event counting metrics
 		SM_SYNCP_RUNS = 0,
@@ -142,6 +150,16 @@ private:
 	/** The High-Resolution timer used for profiling */
 	Timer sm_tmr;
 
+	/** The timer of each EXC synchronization call (and response) */
+	Timer sync_tmr;
+
+	/**
+	 * The time [ms] each EXC took to reach its synchronization point: the
+	 * sum of its own PreChange and SyncChange calls and responses, thus not
+	 * depending on its position in the synchronization queue
+	 */
+	std::map<AppUid_t, double> sync_times;
+
 	static MetricsCollector::MetricsCollection_t metrics[SM_METRICS_COUNT];
 
 	/**
@@ -149,6 +167,16 @@ private:
 	 */
 	SynchronizationManager();
 
+	/**
+	 * @brief Select the EXCs to synchronize in the current round
+	 *
+	 * The EXCs in the specified synchronization state (or in any state, if
+	 * the policy supports multi-state rounds) which are accepted by the
+	 * policy DoSync() are collected once, and then served by all the steps
+	 * of the synchronization protocol.
+	 */
+	void SelectSyncApps(ApplicationStatusIF::SyncState_t syncState);
+
 	/**
 	 * @brief Synchronize the specified EXCs
 	 */
@@ -183,8 +211,21 @@ private:
 	 * @brief Perform the synchronized resource acquisition
 	 *
 	 * @param The App/ExC that have to acquire resources
+	 *
+	 * @return false if the acquisition failed, and the synchronization
+	 * has then been aborted
+	 */
+	bool DoAcquireResources(AppPtr_t);
+
+	/**
+	 * @brief Account for the cost of the AWM transition of an EXC
+	 *
+	 * The cost is the time elapsed from the PreChange sent to the EXC to
+	 * its SyncChange response, plus the reconfiguration time profiled for
+	 * the current AWM. This must be called before committing the
+	 * synchronization.
 	 */
-	void DoAcquireResources(AppPtr_t);
+	void CollectTransitionCost(AppPtr_t papp);
 
 	/**
 	 * @brief Check fo reshuffling reconfigurations
@@ -100,6 +100,21 @@ public:
 		return am.GetNext(ba::ApplicationStatusIF::BLOCKED, ait);
 	}
 
+	/**
+	 * @brief Map of applications in a given synchronization state
+	 */
+	inline ba::AppCPtr_t GetFirstInSync(
+			ba::ApplicationStatusIF::SyncState_t sync_state,
+			AppsUidMapIt & ait) {
+		return am.GetFirst(sync_state, ait);
+	}
+
+	inline ba::AppCPtr_t GetNextInSync(
+			ba::ApplicationStatusIF::SyncState_t sync_state,
+			AppsUidMapIt & ait) {
+		return am.GetNext(sync_state, ait);
+	}
+
 	/**
 	 * @see ApplicationManagerStatusIF
 	 */
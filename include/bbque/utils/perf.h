@@ -20,12 +20,14 @@
 
 #include <stdint.h>
 #include <string.h>
+#include <sys/mman.h>
 
 #include <linux/version.h>
 #include <linux/perf_event.h>
 
 #include <map>
 #include <memory>
+#include <vector>
 
 #include "bbque/utils/utility.h"
 
@@ -122,6 +124,14 @@ namespace bbque { namespace utils {
  *  Thomas Gleixner and Ingo Molnar
  * and all the other guys which contributed to the Linux Performance events
  * framework.
+ *
+ * Counters are organized in groups (PERF_FORMAT_GROUP), thus all the
+ * counters of a group are updated by a single read. Hardware counters are
+ * kept apart from software ones, and at most MaxGroupHWCounters are
+ * co-scheduled in the same group, to fit the available PMU slots.
+ * In self-monitoring mode the counters are mapped in user-space and, where
+ * the kernel allows it, read by means of the rdpmc instruction, i.e.,
+ * without system calls.
  */
 class Perf {
 
@@ -137,6 +147,29 @@ public:
 	 */
 	~Perf();
 
+	/**
+	 * @brief Maximum number of hardware counters in the same group
+	 */
+	static constexpr uint8_t MaxGroupHWCounters = 4;
+
+	/**
+	 * @brief Count the calling thread only, enabling user-space reads
+	 *
+	 * Self-monitoring counters are not inherited by child threads, and they
+	 * are expected to be free running, i.e., enabled once and then sampled
+	 * by means of UpdateAll(). This must be set before adding counters.
+	 */
+	void SetSelfMonitoring(bool enable) {
+		self_monitoring = enable;
+	}
+
+	/**
+	 * @brief True if the counters are in self-monitoring mode
+	 */
+	bool SelfMonitoring() const {
+		return self_monitoring;
+	}
+
 	/**
 	 * @brief Add performance counter
 	 *
@@ -225,6 +258,16 @@ public:
 	 */
 	uint64_t Update(int id, bool delta = true);
 
+	/**
+	 * @brief Update all the registered counters
+	 *
+	 * This requires a single read for each group of counters, or no system
+	 * calls at all, if the counters can be read from user-space.
+	 *
+	 * @return 0 on success, -1 on error
+	 */
+	int UpdateAll();
+
 	/**
 	 * @brief Read the performance counter value
 	 */
@@ -257,6 +300,16 @@ private:
 	 */
 	int fd_group = 0;
 
+	/**
+	 * @brief Group reads (PERF_FORMAT_GROUP) supported
+	 */
+	bool grouped = true;
+
+	/**
+	 * @brief Count the calling thread only (see SetSelfMonitoring)
+	 */
+	bool self_monitoring = false;
+
 	/**
 	 * @brief The format of bytes readed from kernel space
 	 */
@@ -276,6 +329,10 @@ private:
 		pid_t pid = -1;
 		/** The attributed of this counter */
 		struct perf_event_attr attr;
+		/** The group this counter belongs to */
+		uint8_t group_id = 0;
+		/** The user-space mapped page (self-monitoring mode) */
+		struct perf_event_mmap_page * mpage = nullptr;
 
 		/** Counters values as of last last update */
 		ReadFormat_t count;
@@ -290,6 +347,8 @@ private:
 		};
 
 		~RegisteredCounter() {
+			if (mpage != nullptr)
+				munmap(mpage, sysconf(_SC_PAGESIZE));
 			if (fd != -1)
 				close(fd);
 		}
@@ -311,6 +370,27 @@ private:
 	 */
 	typedef std::pair<int, pRegisteredCounter_t> RegisteredCountersMapEntry_t;
 
+	/**
+	 * @brief A group of counters updated by a single read
+	 */
+	typedef struct CountersGroup {
+		/** The FD of the group leader */
+		int leader_fd = -1;
+		/** True if the group collects hardware counters */
+		bool hardware = false;
+		/** The counters of the group, in opening order */
+		std::vector<pRegisteredCounter_t> members;
+		/** The buffer for group reads: nr, enabled, running, values */
+		std::vector<uint64_t> buffer;
+		/** The last samples of the members */
+		std::vector<ReadFormat_t> samples;
+	} CountersGroup_t;
+
+	/**
+	 * @brief The groups of counters
+	 */
+	std::vector<CountersGroup_t> groups;
+
 	/**
 	 * @brief True if counters has been successfully opened
 	 */
@@ -361,6 +441,31 @@ private:
 	 */
 	int ReadCounter(int fd, void *buf, size_t n);
 
+	/**
+	 * @brief Select (or create) the group for a new counter
+	 *
+	 * @return The group leader FD, or -1 if the counter is a new leader
+	 */
+	int SelectGroup(pRegisteredCounter_t prc);
+
+	/**
+	 * @brief Update all the counters of a group
+	 */
+	int UpdateGroup(CountersGroup_t & group);
+
+	/**
+	 * @brief Read all the counters of a group from user-space
+	 *
+	 * @return false if at least one counter is not readable from
+	 * user-space, e.g., software events or counters not currently active
+	 */
+	bool ReadGroupUser(CountersGroup_t & group);
+
+	/**
+	 * @brief Update the counter values given a new sample
+	 */
+	void UpdateCounter(pRegisteredCounter_t prc, ReadFormat_t const & sample);
+
 	/**
 	 * @brief Check if the specified event is a valid CACHE event
 	 */
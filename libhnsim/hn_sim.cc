@@ -0,0 +1,449 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "libhn/hn.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bbque/config.h"
+
+namespace {
+
+/**
+ * @brief A memory bank, with its allocated address ranges
+ */
+struct MemoryBank {
+	uint32_t size = 0;
+	/** The allocated ranges: starting address => size */
+	std::map<uint32_t, uint32_t> ranges;
+};
+
+/**
+ * @brief A buffer placed in a memory bank
+ */
+struct BufferPlacement {
+	uint32_t tile;
+	uint32_t addr;
+	uint32_t size;
+};
+
+/**
+ * @brief A partition found by hn_find_partitions
+ */
+struct PartitionInfo {
+	std::vector<uint32_t> tiles;
+	std::vector<BufferPlacement> buffers;
+	bool allocated = false;
+};
+
+/**
+ * @brief The state of the simulated platform
+ */
+struct Platform {
+	std::mutex mtx;
+	bool initialized = false;
+	uint32_t tiles_x = 0;
+	uint32_t tiles_y = 0;
+	std::vector<uint32_t> tile_types;
+	std::vector<bool> tile_busy;
+	/** The memory banks, by hosting tile */
+	std::map<uint32_t, MemoryBank> banks;
+	std::map<uint32_t, PartitionInfo> partitions;
+	uint32_t next_partition_id = 0;
+} platform;
+
+uint32_t GetEnv(const char * name, uint32_t default_value) {
+	const char * value = getenv(name);
+	if (value == nullptr)
+		return default_value;
+	return strtoul(value, nullptr, 10);
+}
+
+std::vector<uint32_t> GetEnvList(const char * name, const char * default_value) {
+	std::vector<uint32_t> list;
+	const char * value = getenv(name);
+	std::stringstream ss(value ? value : default_value);
+	std::string item;
+	while (std::getline(ss, item, ','))
+		list.push_back(strtoul(item.c_str(), nullptr, 10));
+	return list;
+}
+
+uint32_t Distance(uint32_t tile1, uint32_t tile2) {
+	int dx = (tile1 % platform.tiles_x) - (tile2 % platform.tiles_x);
+	int dy = (tile1 / platform.tiles_x) - (tile2 / platform.tiles_x);
+	return std::abs(dx) + std::abs(dy);
+}
+
+/**
+ * @brief First fit of a range of memory in a bank
+ *
+ * @param extra Further ranges to consider allocated
+ * @return true if found
+ */
+bool FindRange(MemoryBank const & bank, uint32_t tile, uint32_t size,
+		std::vector<BufferPlacement> const & extra, uint32_t & addr) {
+	std::map<uint32_t, uint32_t> ranges(bank.ranges);
+	for (auto const & buffer: extra) {
+		if (buffer.tile == tile)
+			ranges.emplace(buffer.addr, buffer.size);
+	}
+
+	uint64_t start = 0;
+	for (auto const & range: ranges) {
+		if ((range.first >= start) && (range.first - start >= size))
+			break;
+		start = std::max<uint64_t>(start, uint64_t(range.first) + range.second);
+	}
+	if (start + size > bank.size)
+		return false;
+	addr = start;
+	return true;
+}
+
+/**
+ * @brief Place a buffer in the bank closest to a set of tiles
+ */
+bool PlaceBuffer(std::vector<uint32_t> const & tiles, uint32_t size,
+		std::vector<BufferPlacement> & buffers) {
+	uint32_t best_dist = UINT32_MAX;
+	BufferPlacement placement;
+
+	for (auto const & bank: platform.banks) {
+		uint32_t dist = 0;
+		uint32_t addr;
+		for (uint32_t tile: tiles)
+			dist += Distance(tile, bank.first);
+		if ((dist >= best_dist) ||
+				!FindRange(bank.second, bank.first, size, buffers, addr))
+			continue;
+		best_dist = dist;
+		placement = { bank.first, addr, size };
+	}
+
+	if (best_dist == UINT32_MAX)
+		return false;
+	buffers.push_back(placement);
+	return true;
+}
+
+/**
+ * @brief Place the computing resources around a seed tile
+ */
+bool PlaceResources(hn_st_req const & req, uint32_t seed,
+		std::vector<uint32_t> & tiles) {
+	std::vector<bool> used(platform.tile_busy);
+
+	for (uint32_t i = 0; i < req.num_comp_rsc; ++i) {
+		uint32_t best_dist = UINT32_MAX;
+		uint32_t best_tile = 0;
+		for (uint32_t tile = 0; tile < platform.tile_types.size(); ++tile) {
+			if (used[tile] || (platform.tile_types[tile] != req.comp_rsc_types[i]))
+				continue;
+			uint32_t dist = Distance(seed, tile);
+			if (dist < best_dist) {
+				best_dist = dist;
+				best_tile = tile;
+			}
+		}
+		if (best_dist == UINT32_MAX)
+			return false;
+		used[best_tile] = true;
+		tiles.push_back(best_tile);
+	}
+	return true;
+}
+
+/**
+ * @brief Place the buffers close to the resources accessing them
+ *
+ * Buffers not accessed by any resource are placed close to the seed tile.
+ */
+bool PlaceBuffers(hn_st_req const & req, uint32_t seed,
+		std::vector<uint32_t> const & tiles,
+		std::vector<BufferPlacement> & buffers) {
+	for (uint32_t b = 0; b < req.num_mem_buffers; ++b) {
+		std::vector<uint32_t> users;
+		for (uint32_t i = 0; i < req.num_comp_rsc; ++i) {
+			if (req.bw_read_req[i][b] || req.bw_write_req[i][b])
+				users.push_back(tiles[i]);
+		}
+		if (users.empty())
+			users.push_back(seed);
+		if (!PlaceBuffer(users, req.mem_buffers_size[b], buffers))
+			return false;
+	}
+	return true;
+}
+
+} // namespace
+
+
+uint32_t hn_initialize(hn_daemon_socket_filter filter,
+		uint32_t partition_strategy, uint32_t socket_connection,
+		uint32_t reset) {
+	std::unique_lock<std::mutex> lck(platform.mtx);
+	(void)filter;
+	(void)partition_strategy;
+	(void)socket_connection;
+	(void)reset;
+
+	platform.tiles_x = GetEnv("HN_SIM_TILES_X", BBQUE_HN_SIM_TILES_X);
+	platform.tiles_y = GetEnv("HN_SIM_TILES_Y", BBQUE_HN_SIM_TILES_Y);
+	if ((platform.tiles_x == 0) || (platform.tiles_y == 0))
+		return HN_WRONG_PARAMETERS;
+	uint32_t num_tiles = platform.tiles_x * platform.tiles_y;
+
+	// Tile types: the last one specified is repeated
+	std::vector<uint32_t> types(GetEnvList("HN_SIM_TILE_TYPES", "1"));
+	if (types.empty())
+		types.push_back(HN_PEAK_TYPE_1);
+	platform.tile_types.clear();
+	for (uint32_t tile = 0; tile < num_tiles; ++tile)
+		platform.tile_types.push_back(
+			types.at(std::min<size_t>(tile, types.size() - 1)));
+	platform.tile_busy.assign(num_tiles, false);
+
+	// Memory banks: by default, on the first and last column of the mesh
+	uint64_t mem_size = GetEnv("HN_SIM_MEM_SIZE_MB", BBQUE_HN_SIM_MEM_SIZE_MB);
+	mem_size = std::min<uint64_t>(mem_size << 20, UINT32_MAX);
+	std::vector<uint32_t> mem_tiles(GetEnvList("HN_SIM_MEM_TILES", ""));
+	if (mem_tiles.empty()) {
+		for (uint32_t y = 0; y < platform.tiles_y; ++y) {
+			mem_tiles.push_back(y * platform.tiles_x);
+			mem_tiles.push_back(y * platform.tiles_x + platform.tiles_x - 1);
+		}
+	}
+	platform.banks.clear();
+	for (uint32_t tile: mem_tiles) {
+		if (tile < num_tiles)
+			platform.banks[tile].size = mem_size;
+	}
+
+	platform.partitions.clear();
+	platform.initialized = true;
+	return HN_SUCCEEDED;
+}
+
+uint32_t hn_reset(uint32_t tile) {
+	std::unique_lock<std::mutex> lck(platform.mtx);
+	(void)tile;
+	if (!platform.initialized)
+		return HN_NOT_INITIALIZED;
+
+	platform.tile_busy.assign(platform.tile_types.size(), false);
+	for (auto & bank: platform.banks)
+		bank.second.ranges.clear();
+	platform.partitions.clear();
+	return HN_SUCCEEDED;
+}
+
+uint32_t hn_end() {
+	std::unique_lock<std::mutex> lck(platform.mtx);
+	platform.initialized = false;
+	return HN_SUCCEEDED;
+}
+
+uint32_t hn_get_num_tiles(uint32_t *num_tiles, uint32_t *num_tiles_x,
+		uint32_t *num_tiles_y) {
+	std::unique_lock<std::mutex> lck(platform.mtx);
+	if (!platform.initialized)
+		return HN_NOT_INITIALIZED;
+
+	*num_tiles   = platform.tile_types.size();
+	*num_tiles_x = platform.tiles_x;
+	*num_tiles_y = platform.tiles_y;
+	return HN_SUCCEEDED;
+}
+
+uint32_t hn_get_num_vns(uint32_t *num_vns) {
+	*num_vns = 3;
+	return HN_SUCCEEDED;
+}
+
+uint32_t hn_get_tile_info(uint32_t tile, hn_st_tile_info *info) {
+	std::unique_lock<std::mutex> lck(platform.mtx);
+	if (!platform.initialized)
+		return HN_NOT_INITIALIZED;
+	if (tile >= platform.tile_types.size())
+		return HN_WRONG_PARAMETERS;
+
+	info->tile_type = platform.tile_types[tile];
+	info->memory_attached = platform.banks.count(tile);
+	return HN_SUCCEEDED;
+}
+
+uint32_t hn_get_memory_size(uint32_t tile, uint32_t *size) {
+	std::unique_lock<std::mutex> lck(platform.mtx);
+	if (!platform.initialized)
+		return HN_NOT_INITIALIZED;
+	if (tile >= platform.tile_types.size())
+		return HN_WRONG_PARAMETERS;
+
+	std::vector<BufferPlacement> placed;
+	if (!PlaceBuffer({ tile }, 0, placed))
+		return HN_NO_RESOURCES;
+	*size = platform.banks[placed[0].tile].size;
+	return HN_SUCCEEDED;
+}
+
+uint32_t hn_find_memory(uint32_t tile, uint32_t size, uint32_t *tile_mem,
+		uint32_t *starting_addr) {
+	std::unique_lock<std::mutex> lck(platform.mtx);
+	if (!platform.initialized)
+		return HN_NOT_INITIALIZED;
+	if (tile >= platform.tile_types.size())
+		return HN_WRONG_PARAMETERS;
+
+	std::vector<BufferPlacement> placed;
+	if (!PlaceBuffer({ tile }, size, placed))
+		return HN_NO_RESOURCES;
+
+	// Memory for the unit images is never released
+	platform.banks[placed[0].tile].ranges.emplace(placed[0].addr, size);
+	*tile_mem = placed[0].tile;
+	*starting_addr = placed[0].addr;
+	return HN_SUCCEEDED;
+}
+
+uint32_t hn_boot_unit(uint32_t tile, uint32_t tile_memory, uint32_t addr) {
+	std::unique_lock<std::mutex> lck(platform.mtx);
+	(void)tile_memory;
+	(void)addr;
+	if (!platform.initialized)
+		return HN_NOT_INITIALIZED;
+	if (tile >= platform.tile_types.size())
+		return HN_WRONG_PARAMETERS;
+	return HN_SUCCEEDED;
+}
+
+uint32_t hn_find_partitions(hn_st_req req, hn_st_response *res, uint32_t *ids,
+		uint32_t max_parts, uint32_t *num_parts) {
+	std::unique_lock<std::mutex> lck(platform.mtx);
+	std::vector<std::vector<uint32_t>> found;
+
+	*num_parts = 0;
+	if (!platform.initialized)
+		return HN_NOT_INITIALIZED;
+	if ((req.num_comp_rsc > HN_MAX_RSCS) ||
+			(req.num_mem_buffers > HN_MAX_MEM_BUFFERS))
+		return HN_WRONG_PARAMETERS;
+
+	// The partitions found by the previous call are no longer valid
+	for (auto it = platform.partitions.begin();
+			it != platform.partitions.end(); ) {
+		if (it->second.allocated)
+			++it;
+		else
+			it = platform.partitions.erase(it);
+	}
+
+	// A different placement around each seed tile
+	for (uint32_t seed = 0; (seed < platform.tile_types.size()) &&
+			(*num_parts < max_parts); ++seed) {
+		PartitionInfo part;
+		if (!PlaceResources(req, seed, part.tiles))
+			continue;
+		if (std::find(found.begin(), found.end(), part.tiles) != found.end())
+			continue;
+		if (!PlaceBuffers(req, seed, part.tiles, part.buffers))
+			continue;
+		found.push_back(part.tiles);
+
+		hn_st_response & r(res[*num_parts]);
+		for (uint32_t i = 0; i < req.num_comp_rsc; ++i)
+			r.comp_rsc_tiles[i] = part.tiles[i];
+		for (uint32_t b = 0; b < req.num_mem_buffers; ++b) {
+			r.mem_buffers_tiles[b] = part.buffers[b].tile;
+			r.mem_buffers_addr[b]  = part.buffers[b].addr;
+		}
+		ids[*num_parts] = platform.next_partition_id;
+		platform.partitions.emplace(platform.next_partition_id++, part);
+		++(*num_parts);
+	}
+
+	return HN_SUCCEEDED;
+}
+
+uint32_t hn_allocate_partition(uint32_t id) {
+	std::unique_lock<std::mutex> lck(platform.mtx);
+	auto part_it = platform.partitions.find(id);
+	if (part_it == platform.partitions.end())
+		return HN_WRONG_PARAMETERS;
+	PartitionInfo & part(part_it->second);
+	if (part.allocated)
+		return HN_SUCCEEDED;
+
+	// Another partition may have taken the resources meanwhile
+	for (uint32_t tile: part.tiles) {
+		if (platform.tile_busy[tile])
+			return HN_NO_RESOURCES;
+	}
+	for (auto const & buffer: part.buffers) {
+		auto const & ranges(platform.banks[buffer.tile].ranges);
+		auto next = ranges.lower_bound(buffer.addr);
+		if ((next != ranges.end()) && (next->first < buffer.addr + buffer.size))
+			return HN_NO_RESOURCES;
+		if ((next != ranges.begin()) &&
+				(std::prev(next)->first + std::prev(next)->second > buffer.addr))
+			return HN_NO_RESOURCES;
+	}
+
+	for (uint32_t tile: part.tiles)
+		platform.tile_busy[tile] = true;
+	for (auto const & buffer: part.buffers) {
+		if (buffer.size > 0)
+			platform.banks[buffer.tile].ranges.emplace(
+				buffer.addr, buffer.size);
+	}
+	part.allocated = true;
+	return HN_SUCCEEDED;
+}
+
+uint32_t hn_delete_partition(uint32_t id) {
+	std::unique_lock<std::mutex> lck(platform.mtx);
+	auto part_it = platform.partitions.find(id);
+	if (part_it == platform.partitions.end())
+		return HN_WRONG_PARAMETERS;
+
+	PartitionInfo & part(part_it->second);
+	if (part.allocated) {
+		for (uint32_t tile: part.tiles)
+			platform.tile_busy[tile] = false;
+		for (auto const & buffer: part.buffers) {
+			if (buffer.size > 0)
+				platform.banks[buffer.tile].ranges.erase(buffer.addr);
+		}
+	}
+	platform.partitions.erase(part_it);
+	return HN_SUCCEEDED;
+}
+
+uint32_t hn_receive_item(uint32_t *item) {
+	(void)item;
+	std::this_thread::sleep_for(std::chrono::seconds(1));
+	return HN_NO_RESOURCES;
+}
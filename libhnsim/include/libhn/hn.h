@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_HN_SIM_H_
+#define BBQUE_HN_SIM_H_
+
+/**
+ * @file hn.h
+ * @brief Simulated HN library
+ *
+ * This header provides the subset of the MANGO HN library interface used
+ * by the BarbequeRTRM, implemented on top of a software model of the
+ * platform: a 2D mesh of tiles, some of them hosting a memory bank.
+ * It allows to build and benchmark the MangA policy and the partition
+ * skimmers without the MANGO hardware.
+ *
+ * The simulated platform geometry is set at build time (see Kconfig) and
+ * can be overridden at run-time by the following environment variables:
+ * - HN_SIM_TILES_X, HN_SIM_TILES_Y: the size of the mesh
+ * - HN_SIM_TILE_TYPES: comma separated list of the tile types (the last
+ *   one is repeated for the remaining tiles)
+ * - HN_SIM_MEM_TILES: comma separated list of the tiles hosting a memory
+ * - HN_SIM_MEM_SIZE_MB: size of each memory bank
+ */
+
+#include <cstdint>
+
+/** Return code of the successful calls */
+#define HN_SUCCEEDED                  0
+/** Generic error */
+#define HN_NOT_INITIALIZED            1
+/** Wrong parameters */
+#define HN_WRONG_PARAMETERS           2
+/** Not enough resources */
+#define HN_NO_RESOURCES               3
+
+/** Maximum number of computing resources of a request */
+#define HN_MAX_RSCS                   32
+/** Maximum number of memory buffers of a request */
+#define HN_MAX_MEM_BUFFERS            64
+
+/** Connection filter parameters */
+#define TARGET_MANGO                  0
+#define APPL_MODE_SYNC_READS          1
+
+/** Partitioning strategy */
+#define UPV_PARTITION_STRATEGY        0
+
+/**
+ * @brief The types of tile (and computing resource requested)
+ */
+enum hn_tile_type {
+	HN_PEAK_TYPE_0 = 0,
+	HN_PEAK_TYPE_1,
+	HN_PEAK_TYPE_2,
+	HN_NUPLUS_TYPE_0,
+	HN_NUPLUS_TYPE_1,
+	HN_ARM_TYPE,
+	HN_DCT_TYPE
+};
+
+/**
+ * @brief Filter of the connection to the HN daemon
+ */
+typedef struct hn_daemon_socket_filter {
+	uint32_t target;
+	uint32_t mode;
+	uint32_t tile;
+	uint32_t core;
+} hn_daemon_socket_filter;
+
+/**
+ * @brief Information about a tile
+ */
+typedef struct hn_st_tile_info {
+	uint32_t tile_type;
+	uint32_t memory_attached;
+} hn_st_tile_info;
+
+/**
+ * @brief Request of a partition
+ *
+ * The bandwidth requirements are indexed by [computing resource][buffer].
+ * A non-zero value means that the resource accesses the buffer.
+ */
+typedef struct hn_st_req {
+	uint32_t num_comp_rsc;
+	uint32_t comp_rsc_types[HN_MAX_RSCS];
+	uint32_t num_mem_buffers;
+	uint32_t mem_buffers_size[HN_MAX_MEM_BUFFERS];
+	uint32_t bw_read_req[HN_MAX_MEM_BUFFERS][HN_MAX_MEM_BUFFERS];
+	uint32_t bw_write_req[HN_MAX_MEM_BUFFERS][HN_MAX_MEM_BUFFERS];
+} hn_st_req;
+
+/**
+ * @brief A partition found for a request
+ */
+typedef struct hn_st_response {
+	uint32_t comp_rsc_tiles[HN_MAX_RSCS];
+	uint32_t mem_buffers_tiles[HN_MAX_MEM_BUFFERS];
+	uint32_t mem_buffers_addr[HN_MAX_MEM_BUFFERS];
+} hn_st_response;
+
+/**
+ * @brief Initialize the (simulated) platform
+ */
+uint32_t hn_initialize(hn_daemon_socket_filter filter,
+		uint32_t partition_strategy, uint32_t socket_connection,
+		uint32_t reset);
+
+/**
+ * @brief Release all the partitions and the booted units
+ */
+uint32_t hn_reset(uint32_t tile);
+
+/**
+ * @brief Close the (simulated) platform
+ */
+uint32_t hn_end();
+
+/**
+ * @brief Get the number of tiles and the mesh geometry
+ */
+uint32_t hn_get_num_tiles(uint32_t *num_tiles, uint32_t *num_tiles_x,
+		uint32_t *num_tiles_y);
+
+/**
+ * @brief Get the number of virtual networks
+ */
+uint32_t hn_get_num_vns(uint32_t *num_vns);
+
+/**
+ * @brief Get the information about a tile
+ */
+uint32_t hn_get_tile_info(uint32_t tile, hn_st_tile_info *info);
+
+/**
+ * @brief Get the size of the memory closest to a tile
+ */
+uint32_t hn_get_memory_size(uint32_t tile, uint32_t *size);
+
+/**
+ * @brief Find some free memory, in the memory bank closest to a tile
+ */
+uint32_t hn_find_memory(uint32_t tile, uint32_t size, uint32_t *tile_mem,
+		uint32_t *starting_addr);
+
+/**
+ * @brief Boot a unit, with the image loaded in memory
+ */
+uint32_t hn_boot_unit(uint32_t tile, uint32_t tile_memory, uint32_t addr);
+
+/**
+ * @brief Find up to max_parts partitions satisfying a request
+ *
+ * The partitions found are different placements of the computing
+ * resources, each one around a different tile, with the buffers placed in
+ * the memory banks closest to the resources accessing them. They are not
+ * reserved and remain valid until the next call.
+ *
+ * @param req The request
+ * @param res Array of max_parts responses, filled with the partitions
+ * @param ids Array of max_parts identifiers of the partitions found
+ * @param max_parts The maximum number of partitions to find
+ * @param num_parts The number of partitions found
+ */
+uint32_t hn_find_partitions(hn_st_req req, hn_st_response *res, uint32_t *ids,
+		uint32_t max_parts, uint32_t *num_parts);
+
+/**
+ * @brief Reserve the resources of a partition found
+ */
+uint32_t hn_allocate_partition(uint32_t id);
+
+/**
+ * @brief Release the resources of a partition
+ */
+uint32_t hn_delete_partition(uint32_t id);
+
+/**
+ * @brief Receive an item from the platform
+ *
+ * No item is ever generated by the simulated platform, thus this call just
+ * blocks the caller for a while.
+ */
+uint32_t hn_receive_item(uint32_t *item);
+
+#endif // BBQUE_HN_SIM_H_
@@ -24,7 +24,6 @@
 
 // Network
 #include <sys/socket.h>
-#include <fcntl.h>
 
 // BBQ
 #include <bbque/utils/utility.h>
@@ -62,27 +61,15 @@ void CommandsManager::request_migration(const std::string &src, const std::strin
 bool CommandsManager::get_and_manage_commands() noexcept {
 	local_bbq_cmd_t cmd;
 
-	// Now set the socket as non-blocking
-	::fcntl(this->socket_client,
-			F_SETFL, ::fcntl(this->socket_client,F_GETFL, 0) | O_NONBLOCK);
-
-	// First of all, receive a command from the shell
-	int bytes = recv(this->socket_client, &cmd, sizeof(local_bbq_cmd_t), 0);
-	if (bytes==-1 && errno == EWOULDBLOCK) {
-		// No requests (remember, recv is non-blocking!)
-		return true;
-	}
-
+	// The socket is readable: wait for the whole command
+	int bytes = recv(this->socket_client, &cmd, sizeof(local_bbq_cmd_t),
+			MSG_WAITALL);
 	if(bytes != sizeof(local_bbq_cmd_t)) {
 		this->error = true;
         mpirun_logger->Crit("Error receiving data from `mpirun` (maybe dirty close?)");
 		return false;
     }
 
-	// Now reset the socket as blocking
-	::fcntl(this->socket_client,
-			F_SETFL, ::fcntl(this->socket_client,F_GETFL, 0) & ~O_NONBLOCK);
-
 	switch(cmd.cmd_type) {
     case BBQ_CMD_NODES_REQUEST:
         if ( cmd.flags & BBQ_OPT_MIG_AVAILABLE ) {
@@ -127,7 +114,8 @@ bool CommandsManager::get_and_manage_commands() noexcept {
 bool CommandsManager::manage_nodes_request() noexcept {
 	local_bbq_job_t job;
 
-	int bytes  = recv(this->socket_client, &job, sizeof(local_bbq_job_t), 0);
+	int bytes  = recv(this->socket_client, &job, sizeof(local_bbq_job_t),
+			MSG_WAITALL);
 	if (bytes != sizeof(local_bbq_job_t)) {
 		// Something bad happened here
         mpirun_logger->Crit("Error receiving data from `mpirun`");
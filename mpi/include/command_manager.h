@@ -43,9 +43,9 @@ public:
 
 
 	/**
-	 * @brief The core method. It checks if new messages are on socket and in
-	 *        in case it manages them. If there is no new messages, it simply
-	 *        return successfully. (Note that this call is non-blocking)
+	 * @brief The core method. It receives a message from the socket and
+	 *        manages it. It has to be called when the socket is readable
+	 *        (e.g., as notified by epoll), since the receive is blocking.
 	 *
 	 * @note  You MUST call set_available_resources() before any call to this
 	 *        method!
@@ -53,8 +53,7 @@ public:
 	 * @return it returns false if wants to terminate
 	 * 	       the execution. Termination due to error or due to
 	 *         normal closing is defined by get_in_error method.
-	 *         It returns true if messages are elaborated successfully
-	 *         or no new messages are present.
+	 *         It returns true if the message is elaborated successfully.
 	 */
 	bool get_and_manage_commands() noexcept;
 
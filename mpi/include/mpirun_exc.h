@@ -20,6 +20,7 @@
 
 #include <bbque/bbque_exc.h>
 #include <netinet/in.h>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -31,6 +32,15 @@ using bbque::rtlib::BbqueEXC;
 
 extern std::unique_ptr<bbque::utils::Logger> mpirun_logger;
 
+/** The period of the cycles, if not configured, in milliseconds */
+#define MPIRUN_DEFAULT_UPDATETIME_MS 100
+
+/** The time given to mpirun to terminate, before killing it, in milliseconds */
+#define MPIRUN_TERM_TIMEOUT_MS 3000
+
+/** The maximum number of events managed at each wait */
+#define MPIRUN_MAX_EVENTS 4
+
 namespace mpirun {
 
 class MpiRun: public BbqueEXC {
@@ -56,6 +66,17 @@ private:
 	int pid_child        = -1;
 	int socket_listening = -1;
 	int socket_client    = -1;
+
+	/** The epoll instance waiting for socket, child and timer events */
+	int epoll_fd         = -1;
+	/** The timer of the periodic work */
+	int timer_fd         = -1;
+	/** The period of the timer in milliseconds */
+	int update_period_ms = 0;
+	/** Time elapsed since the first run, in milliseconds */
+	uint64_t elapsed_ms  = 0;
+	/** The test migration has been requested */
+	bool mig_requested   = false;
 	struct sockaddr_in serv_addr;
 	struct sockaddr_in client_addr;
 
@@ -73,6 +94,28 @@ private:
 	bool accept_socket();
 	void clean_sockets();
 
+	// Event loop section
+	bool open_events();
+	bool watch_fd(int fd);
+	void unwatch_fd(int fd);
+	void clean_events();
+
+	/**
+	 * @brief Wait for the events of the current cycle
+	 *
+	 * Commands from `mpirun` are managed as soon as they arrive, until the
+	 * timer expires.
+	 *
+	 * @return false if the execution has to be terminated
+	 */
+	bool wait_events();
+
+	/**
+	 * @brief Update the resources offered to `mpirun` according to the
+	 *        resources assigned to the current AWM
+	 */
+	void update_available_resources();
+
 	// Node section
 	bool parse_commands();
 	bool manage_nodes_requests();
@@ -1,7 +1,7 @@
 /**
  *      @file   ProcessChecker.h
- *      @brief  This class checks for a process termination, then it closes the
- *              socket.
+ *      @brief  This class notifies a process termination through a file
+ *              descriptor, to be watched by an event loop.
  *
  *     @author  Federico Reghenzani (federeghe), federico1.reghenzani@mail.polimi.it
  *     @author  Gianmario Pozzi (kom-broda), gianmario.pozzi@mail.polimi.it
@@ -18,35 +18,60 @@
 #define MPIRUN_PROCESSCHECKER_H_
 
 #include <thread>
-#include <atomic>
 
 namespace mpirun {
 	class ProcessChecker {
 	public:
 		/**
-		 * @brief Starts a thread to check for the process termination.
+		 * @brief Starts monitoring the termination of a (child) process.
+		 *
+		 * The termination is notified through a pidfd, if supported by the
+		 * kernel. Otherwise, a thread blocks until the process terminates
+		 * and then signals an eventfd.
+		 *
 		 * @param pid     the pid of the process to monitor
-		 * @param socket  the socket to shutdown (RW) when the process terminates
 		 */
-		ProcessChecker(int pid, int socket) noexcept;
+		ProcessChecker(int pid) noexcept;
 
 		/**
-		 * @brief Stops the thread that checks for temrniation.
+		 * @brief Stops the monitoring.
+		 *
+		 * @note The process should have been terminated, since the
+		 *       destructor waits for the fallback thread (see wait_for()).
 		 */
 		~ProcessChecker() noexcept;
 
 		/**
-		 * @brief Stops the thread that checks for temrniation.
+		 * @brief The file descriptor becoming readable when the process
+		 *        terminates, or -1 in case of error.
 		 */
-		void stop() noexcept;
+		inline int get_fd() const noexcept {
+			return this->fd;
+		}
+
+		/**
+		 * @brief Reaps the process, if terminated.
+		 *
+		 * @return true if the process has terminated
+		 */
+		bool terminated() noexcept;
+
+		/**
+		 * @brief Waits for the process termination, without reaping it.
+		 *
+		 * @param timeout_ms the maximum time to wait, in milliseconds
+		 *
+		 * @return true if the process has terminated
+		 */
+		bool wait_for(unsigned int timeout_ms) noexcept;
 
 	private:
-		std::atomic<bool> stopped;
 		int pid;
-		int socket;
-		std::thread my_thread;
+		int fd = -1;
+		bool reaped = false;
+		std::thread waiter;
 
-		void checker() noexcept;
+		void wait_termination() noexcept;
 	};
 }
 #endif /* MPIRUN_PROCESSCHECKER_H_ */
@@ -24,6 +24,9 @@
 #include <string>
 #include <sstream>
 #include <utility>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/epoll.h>
 
 #define MODULE_CONFIG "ompi"
 
@@ -39,7 +42,9 @@ MpiRun::MpiRun(
 
 MpiRun::~MpiRun() {
     this->clean_mpirun();
+    this->pc.reset();
 	this->clean_sockets();
+	this->clean_events();
 }
 
 RTLIB_ExitCode_t MpiRun::onSetup() {
@@ -68,6 +73,9 @@ RTLIB_ExitCode_t MpiRun::onSetup() {
 	}
     mpirun_logger->Debug("Configuration loaded");
 
+	if (!this->open_events())
+		return RTLIB_ERROR;
+
 	if (!this->open_socket())	// Open the socket for MPI communication.
 		return RTLIB_ERROR;		// if the socket fails to bind/listen/etc.
 								// stops execution here.
@@ -90,17 +98,9 @@ RTLIB_ExitCode_t MpiRun::onSetup() {
 RTLIB_ExitCode_t MpiRun::onConfigure(int8_t awm_id) {
 
     mpirun_logger->Info("MpiRun::onConfigure(): AWM [%02d]", awm_id);
-	// TODO: Get the bit map from BBQ
-
-	// Avail resources is the minimum between awm_id+1 and the
-	// resources list size
-	avail_res_n = (size_t)awm_id+1 < all_res->size() ? (size_t)awm_id+1 : all_res->size();
-	avail_res_n = all_res->size();	// Test TODO remove
-
-	// Recreate the subvector of resource available, and update the amount of
-	// available resources
-    avail_res.reset();
-    avail_res = std::make_shared<res_list>( all_res->begin(), all_res->begin()+avail_res_n );
+	// Offer to mpirun the nodes assigned to this AWM: the next nodes
+	// request is served with them, as soon as it arrives
+	this->update_available_resources();
 
     if (this->cm != NULL) {
         // Update available resources to CommandManager
@@ -114,20 +114,20 @@ RTLIB_ExitCode_t MpiRun::onConfigure(int8_t awm_id) {
 
 RTLIB_ExitCode_t MpiRun::onRun() {
     Config &config = Config::get();
-    static int n=0;
 
-    // Do nothing: this application as no particular workload
-    usleep(config.get_updatetime_res()*1000);    // milliseconds -> microseconds
+    // Manage the commands from mpirun until the end of the period
+    if (!this->wait_events())
+        return RTLIB_EXC_WORKLOAD_NONE;
 
-    mpirun_logger->Info("MpiRun::onRun() %d %d",
-        config.get_mig_time(), config.get_updatetime_res()*(n));
+    mpirun_logger->Info("MpiRun::onRun() %d %llu",
+        config.get_mig_time(), (unsigned long long) this->elapsed_ms);
 
     // Mig time for testing purposes
-    if (config.get_mig_time() != 0) {
-        int time_elapsed = config.get_updatetime_res()*(++n)*1000; // In seconds
-        if (time_elapsed == config.get_mig_time() * 1000 ) {
+    if (config.get_mig_time() != 0 && !this->mig_requested) {
+        if (this->elapsed_ms >= (uint64_t) config.get_mig_time()) {
             mpirun_logger->Info("Sending migrate command");
             this->cm->request_migration(config.get_mig_source(), config.get_mig_destination());
+            this->mig_requested = true;
         }
     }
     return RTLIB_OK;
@@ -140,16 +140,79 @@ RTLIB_ExitCode_t MpiRun::onMonitor() {
     mpirun_logger->Info("MpiRun::onMonitor(): AWM [%02d], Cycle [%4d]",
 		wmp.awm_id, Cycles());
 
-	// Now check for MPI requests
-	// If a 'true' is returned the execution should continue, 'false'
-	// otherwise.
-	bool status = this->cm->get_and_manage_commands();
-	if (!status) {
-		// Error or clean shutdown
-		return RTLIB_EXC_WORKLOAD_NONE;
+	return RTLIB_OK;
+}
+
+bool MpiRun::wait_events() {
+	struct epoll_event events[MPIRUN_MAX_EVENTS];
+	uint64_t expirations;
+	bool expired = false;
+
+	while (!expired) {
+		int n = ::epoll_wait(this->epoll_fd, events, MPIRUN_MAX_EVENTS, -1);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n < 0) {
+			mpirun_logger->Crit("Error waiting for events");
+			return false;
+		}
+
+		for (int i = 0; i < n; ++i) {
+			int fd = events[i].data.fd;
+			if (fd == this->timer_fd) {
+				if (::read(this->timer_fd, &expirations,
+						sizeof(expirations)) == sizeof(expirations))
+					this->elapsed_ms += expirations * this->update_period_ms;
+				expired = true;
+			}
+			else if (fd == this->socket_client) {
+				// Nodes requests and migration commands are served
+				// immediately. 'false' means error or clean shutdown.
+				if (!this->cm->get_and_manage_commands())
+					return false;
+			}
+			else if (this->pc && fd == this->pc->get_fd()) {
+				this->pc->terminated();
+				mpirun_logger->Notice("`mpirun` terminated");
+				return false;
+			}
+		}
 	}
 
-	return RTLIB_OK;
+	return true;
+}
+
+void MpiRun::update_available_resources() {
+	int32_t nr_sys = 0;
+
+	avail_res = std::make_shared<res_list>();
+
+	// The nodes of the systems assigned, with at most the number of
+	// processing elements assigned on each one
+	if (GetAssignedResources(SYSTEM, nr_sys) == RTLIB_OK && nr_sys > 0) {
+		std::vector<int32_t> sys_ids(nr_sys);
+		std::vector<int32_t> sys_pes(nr_sys);
+		GetAssignedResources(SYSTEM, sys_ids.data(), nr_sys);
+		GetAssignedResources(PROC_NR, sys_pes.data(), nr_sys);
+
+		for (int32_t i = 0; i < nr_sys; ++i) {
+			if (sys_ids[i] < 0 || (size_t) sys_ids[i] >= all_res->size())
+				continue;
+			auto node = (*all_res)[sys_ids[i]];
+			if (sys_pes[i] > 0 && sys_pes[i] < node.second)
+				node.second = sys_pes[i];
+			avail_res->push_back(node);
+		}
+	}
+
+	// Not managed or no node matching: offer all the configured nodes
+	if (avail_res->empty())
+		avail_res->assign(all_res->begin(), all_res->end());
+	avail_res_n = avail_res->size();
+
+	for (auto const & node : *avail_res)
+		mpirun_logger->Debug("Available node: %s, slots: %d",
+			node.first.c_str(), node.second);
 }
 
 RTLIB_ExitCode_t MpiRun::onRelease() {
@@ -20,6 +20,11 @@
 #include <vector>
 #include <signal.h>
 #include <utility>
+#include <unistd.h>
+
+// Event loop related
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
 
 // Network related
 #include <netdb.h>
@@ -29,6 +34,7 @@
 
 #include "ompi_types.h"
 #include "mpirun_exc.h"
+#include "config.h"
 #include <bbque/utils/utility.h>
 
 #include <iostream>
@@ -66,7 +72,7 @@ bool MpiRun::call_mpirun() {
 		// Parent
         mpirun_logger->Notice("Forked %i", pid);
 		this->pid_child = pid;
-        pc =  std::unique_ptr<ProcessChecker>(new ProcessChecker(this->pid_child, this->socket_listening));
+        pc =  std::unique_ptr<ProcessChecker>(new ProcessChecker(this->pid_child));
 
 	}
 
@@ -74,8 +80,17 @@ bool MpiRun::call_mpirun() {
 }
 
 void MpiRun::clean_mpirun() const noexcept {
+	if (this->pid_child <= 0)
+		return;
     mpirun_logger->Info("Sending SIGTERM to `mpirun`...");
     kill(this->pid_child, SIGTERM);
+
+	// The process checker waits for the termination on destruction
+	if (!this->pc || this->pc->wait_for(MPIRUN_TERM_TIMEOUT_MS))
+		return;
+    mpirun_logger->Warn("`mpirun` still running after %d ms, sending SIGKILL...",
+		MPIRUN_TERM_TIMEOUT_MS);
+    kill(this->pid_child, SIGKILL);
 }
 
 bool MpiRun::open_socket() {
@@ -113,20 +128,36 @@ bool MpiRun::open_socket() {
 
 
 bool MpiRun::accept_socket() {
+	struct epoll_event event;
 
-	::socklen_t clilen  = sizeof(this->client_addr);
-	this->socket_client = ::accept(
-			this->socket_listening, (struct sockaddr *) &this->client_addr,	&clilen);
+	// Wait for the connection, or for the termination of mpirun
+	if (!this->watch_fd(this->socket_listening))
+		return false;
+	if (this->pc->get_fd() >= 0 && !this->watch_fd(this->pc->get_fd()))
+		return false;
 
-	// Just to check, should not be happens. Let's stop the checker (doesn't
-	// matter what happens)
-    this->pc.reset();
+	int ret;
+	do {
+		ret = ::epoll_wait(this->epoll_fd, &event, 1, -1);
+	} while (ret < 0 && errno == EINTR);
+	this->unwatch_fd(this->socket_listening);
 
-	if (this->socket_client < 0 && errno == EINVAL) {
+	if (ret < 0) {
+        mpirun_logger->Fatal("Unable to wait for a connection on socket "
+				"for MPI communication.");
+		return false;
+	}
+
+	if (event.data.fd != this->socket_listening) {
         mpirun_logger->Warn("`mpirun` terminates before opening a socket.");
+		this->pc->terminated();
 		return false;
 	}
 
+	::socklen_t clilen  = sizeof(this->client_addr);
+	this->socket_client = ::accept(
+			this->socket_listening, (struct sockaddr *) &this->client_addr,	&clilen);
+
 	if (this->socket_client < 0) {
         mpirun_logger->Fatal("Unable to accept a connection on socket "
 				"for MPI communication.");
@@ -134,7 +165,8 @@ bool MpiRun::accept_socket() {
 	}
     mpirun_logger->Info("`mpirun` (RAS) connected.");
 
-	return true;
+	// From now on, the commands are notified by the event loop
+	return this->watch_fd(this->socket_client);
 }
 
 void MpiRun::clean_sockets() {
@@ -149,4 +181,63 @@ void MpiRun::clean_sockets() {
 	}
 }
 
+bool MpiRun::open_events() {
+	Config &config = Config::get();
+	struct itimerspec period;
+
+	this->epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+	if (this->epoll_fd < 0) {
+        mpirun_logger->Fatal("Unable to create the epoll instance.");
+		return false;
+	}
+
+	// The timer paces the cycles, so that reconfigurations are not delayed
+	// more than a period while waiting for commands
+	this->timer_fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+	if (this->timer_fd < 0) {
+        mpirun_logger->Fatal("Unable to create the update timer.");
+		return false;
+	}
+
+	this->update_period_ms = config.get_updatetime_res();
+	if (this->update_period_ms <= 0)
+		this->update_period_ms = MPIRUN_DEFAULT_UPDATETIME_MS;
+	period.it_interval.tv_sec  = this->update_period_ms / 1000;
+	period.it_interval.tv_nsec = (this->update_period_ms % 1000) * 1000000L;
+	period.it_value = period.it_interval;
+	if (::timerfd_settime(this->timer_fd, 0, &period, NULL) < 0) {
+        mpirun_logger->Fatal("Unable to start the update timer.");
+		return false;
+	}
+
+	return this->watch_fd(this->timer_fd);
+}
+
+bool MpiRun::watch_fd(int fd) {
+	struct epoll_event event;
+
+	event.events  = EPOLLIN;
+	event.data.fd = fd;
+	if (::epoll_ctl(this->epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0) {
+        mpirun_logger->Fatal("Unable to watch the file descriptor %d.", fd);
+		return false;
+	}
+	return true;
+}
+
+void MpiRun::unwatch_fd(int fd) {
+	::epoll_ctl(this->epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+}
+
+void MpiRun::clean_events() {
+	if (this->timer_fd != -1) {
+		::close(this->timer_fd);
+		this->timer_fd = -1;
+	}
+	if (this->epoll_fd != -1) {
+		::close(this->epoll_fd);
+		this->epoll_fd = -1;
+	}
+}
+
 } // End namespace
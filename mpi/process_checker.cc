@@ -15,46 +15,88 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
 #include <csignal>
-#include <iostream>
 #include <sys/types.h>
 #include <sys/wait.h>
-#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
 #include <thread>
-#include <chrono>
 
 #include "process_checker.h"
 
 
 namespace mpirun {
 
-ProcessChecker::ProcessChecker(int pid, int socket) noexcept
-			: pid(pid), socket(socket) {
-	// Set the PID and start the thread
-	this->stopped   = false;
-	this->my_thread = std::thread(&ProcessChecker::checker, this);
+ProcessChecker::ProcessChecker(int pid) noexcept
+			: pid(pid) {
+#ifdef SYS_pidfd_open
+	// The pidfd becomes readable as soon as the process terminates
+	this->fd = ::syscall(SYS_pidfd_open, this->pid, 0);
+	if (this->fd >= 0)
+		return;
+#endif
+	// Fallback: a thread waiting for the termination signals an eventfd
+	this->fd = ::eventfd(0, EFD_CLOEXEC);
+	if (this->fd < 0)
+		return;
+	this->waiter = std::thread(&ProcessChecker::wait_termination, this);
 }
 
-void ProcessChecker::stop() noexcept {
-	this->stopped = true;
+ProcessChecker::~ProcessChecker() noexcept {
+	if (this->waiter.joinable())
+		this->waiter.join();
+	if (this->fd >= 0)
+		::close(this->fd);
 }
 
-ProcessChecker::~ProcessChecker() noexcept {
-	this->stop();
-	this->my_thread.join();
+void ProcessChecker::wait_termination() noexcept {
+	siginfo_t info;
+	uint64_t value = 1;
+
+	// Do not reap the process: it is up to terminated()
+	while (::waitid(P_PID, this->pid, &info, WEXITED | WNOWAIT) < 0 &&
+			errno == EINTR);
+	if (::write(this->fd, &value, sizeof(value)) < 0) {
+		// Nothing to do: the event loop will detect the closed socket
+	}
+}
+
+bool ProcessChecker::terminated() noexcept {
+	if (this->reaped)
+		return true;
+
+	pid_t result = ::waitpid(this->pid, NULL, WNOHANG);
+	if (result == 0)
+		return false;
+	this->reaped = true;
+	return true;
 }
 
-void ProcessChecker::checker() noexcept {
+bool ProcessChecker::wait_for(unsigned int timeout_ms) noexcept {
+	auto deadline = std::chrono::steady_clock::now() +
+		std::chrono::milliseconds(timeout_ms);
 
-	while (!this->stopped) {
-		pid_t result = ::waitpid(this->pid, NULL, WNOHANG);
-		if (result != 0) {
-			// Child terminated: close the socket so the accept() can return
-			::shutdown(this->socket, SHUT_RDWR	);
-			this->stopped = true;
+	while (!this->reaped) {
+		siginfo_t info;
+		info.si_pid = 0;
+		if (::waitid(P_PID, this->pid, &info, WEXITED | WNOHANG | WNOWAIT) < 0) {
+			if (errno == EINTR)
+				continue;
+			// Already reaped by someone else
+			return true;
 		}
-		std::this_thread::sleep_for(std::chrono::milliseconds(500));
+		if (info.si_pid == this->pid)
+			return true;
+		if (std::chrono::steady_clock::now() >= deadline)
+			return false;
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
 	}
+	return true;
 }
 
 } // namespace mpirun
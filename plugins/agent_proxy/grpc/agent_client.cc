@@ -174,23 +174,116 @@ ExitCode_t AgentClient::GetChannelStatus(
 
 ExitCode_t AgentClient::SendJoinRequest()
 {
-
-	return ExitCode_t::OK;
+	return SendNodeManagementRequest(bbque::NodeManagementRequest::JOIN);
 }
 
 ExitCode_t AgentClient::SendDisjoinRequest()
 {
+	return SendNodeManagementRequest(bbque::NodeManagementRequest::DISJOIN);
+}
 
-	return ExitCode_t::OK;
+ExitCode_t AgentClient::SendNodeManagementRequest(
+		bbque::NodeManagementRequest::Action action) {
+
+	ExitCode_t exit_code = Connect();
+	if (exit_code != ExitCode_t::OK) {
+		logger->Error("NodeManagement: Connection failed");
+		return exit_code;
+	}
+
+	bbque::NodeManagementRequest request;
+	request.set_sender_id(local_system_id);
+	request.set_value(action);
+	grpc::Status status;
+	grpc::ClientContext context;
+	bbque::GenericReply reply;
+
+	logger->Debug("NodeManagement: Calling implementation...");
+	status = service_stub->SetNodeManagementAction(&context, request, &reply);
+	if (!status.ok()) {
+		logger->Error("NodeManagement: Returned code %d", status.error_code());
+		return ExitCode_t::AGENT_DISCONNECTED;
+	}
+
+	return ReplyToExitCode(reply);
+}
+
+ExitCode_t AgentClient::SendNodeStatus(
+		agent::NodeStatus const & node_status) {
+
+	ExitCode_t exit_code = Connect();
+	if (exit_code != ExitCode_t::OK) {
+		logger->Error("NodeStatus: Connection failed");
+		return exit_code;
+	}
+
+	bbque::NodeStatusRequest request;
+	request.set_sender_id(local_system_id);
+	request.set_cpu_total(node_status.cpu_total);
+	request.set_cpu_used(node_status.cpu_used);
+	request.set_mem_total(node_status.mem_total);
+	request.set_mem_used(node_status.mem_used);
+	request.set_nr_ready(node_status.nr_ready);
+	request.set_nr_running(node_status.nr_running);
+	grpc::Status status;
+	grpc::ClientContext context;
+	bbque::GenericReply reply;
+
+	logger->Debug("NodeStatus: Calling implementation...");
+	status = service_stub->SetNodeStatus(&context, request, &reply);
+	if (!status.ok()) {
+		logger->Error("NodeStatus: Returned code %d", status.error_code());
+		return ExitCode_t::AGENT_DISCONNECTED;
+	}
+
+	return ReplyToExitCode(reply);
 }
 
 // ----------- Scheduling / Resource allocation
 
 ExitCode_t AgentClient::SendScheduleRequest(
-        agent::ApplicationScheduleRequest const & request)
+        agent::ApplicationScheduleRequest const & sched_request)
 {
+	ExitCode_t exit_code = Connect();
+	if (exit_code != ExitCode_t::OK) {
+		logger->Error("ScheduleRequest: Connection failed");
+		return exit_code;
+	}
 
-	return ExitCode_t::OK;
+	bbque::ApplicationSchedulingRequest request;
+	request.set_sender_id(local_system_id);
+	request.set_app_id(sched_request.app_id);
+	request.set_app_name(sched_request.app_name);
+	request.set_awm_id(sched_request.awm_id);
+	for (auto const & amount_entry: sched_request.resources.amount)
+		(*request.mutable_amount())[
+			static_cast<uint32_t>(amount_entry.first)] = amount_entry.second;
+	grpc::Status status;
+	grpc::ClientContext context;
+	bbque::GenericReply reply;
+
+	logger->Debug("ScheduleRequest: Calling implementation...");
+	status = service_stub->SetApplicationSchedule(&context, request, &reply);
+	if (!status.ok()) {
+		logger->Error("ScheduleRequest: Returned code %d", status.error_code());
+		return ExitCode_t::AGENT_DISCONNECTED;
+	}
+
+	return ReplyToExitCode(reply);
+}
+
+
+ExitCode_t AgentClient::ReplyToExitCode(bbque::GenericReply const & reply) const {
+	switch (reply.value()) {
+	case bbque::GenericReply::OK:
+		return ExitCode_t::OK;
+	case bbque::GenericReply::AGENT_UNREACHABLE:
+		return ExitCode_t::AGENT_UNREACHABLE;
+	case bbque::GenericReply::AGENT_DISCONNECTED:
+		return ExitCode_t::AGENT_DISCONNECTED;
+	default:
+		return ExitCode_t::REQUEST_REJECTED;
+	}
 }
 
 } // namespace plugins
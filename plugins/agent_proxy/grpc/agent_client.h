@@ -65,6 +65,8 @@ public:
 
 	ExitCode_t SendDisjoinRequest();
 
+	ExitCode_t SendNodeStatus(agent::NodeStatus const & node_status);
+
 	// ----------- Scheduling / Resource allocation
 
 	ExitCode_t SendScheduleRequest(
@@ -86,6 +88,11 @@ private:
 
 
 	ExitCode_t Connect();
+
+	ExitCode_t SendNodeManagementRequest(
+		bbque::NodeManagementRequest::Action action);
+
+	ExitCode_t ReplyToExitCode(bbque::GenericReply const & reply) const;
 };
 
 } // namespace plugins
@@ -17,6 +17,8 @@
 
 #include "agent_impl.h"
 
+#include <cinttypes>
+
 #include "bbque/config.h"
 
 #ifdef CONFIG_BBQUE_PM
@@ -106,12 +108,113 @@ grpc::Status AgentImpl::SetNodeManagementAction(
 		bbque::GenericReply * error) {
 
 	logger->Debug(" === SetNodeManagementAction ===");
-	logger->Info("Management action: %d ", action->value());
+	logger->Info("Management action: %d from system %d",
+		action->value(), action->sender_id());
+
+	// A joining node is accounted since its first status update, while a
+	// leaving node is dropped
+	if (action->value() == bbque::NodeManagementRequest::DISJOIN) {
+		std::unique_lock<std::mutex> status_ul(status_mtx);
+		nodes_status.erase(action->sender_id());
+	}
+	error->set_value(bbque::GenericReply::OK);
+
+	return grpc::Status::OK;
+}
+
+
+grpc::Status AgentImpl::SetNodeStatus(
+		grpc::ServerContext * context,
+		const bbque::NodeStatusRequest * request,
+		bbque::GenericReply * error) {
+
+	logger->Debug("NodeStatus: Update from system %d", request->sender_id());
+	agent::NodeStatus status;
+	status.system_id  = request->sender_id();
+	status.cpu_total  = request->cpu_total();
+	status.cpu_used   = request->cpu_used();
+	status.mem_total  = request->mem_total();
+	status.mem_used   = request->mem_used();
+	status.nr_ready   = request->nr_ready();
+	status.nr_running = request->nr_running();
+	status.timestamp_ms = timer.getElapsedTimeMs();
+
+	std::unique_lock<std::mutex> status_ul(status_mtx);
+	if (nodes_status.find(status.system_id) == nodes_status.end())
+		logger->Info("NodeStatus: first update from system %d",
+			status.system_id);
+	nodes_status[status.system_id] = status;
+	logger->Debug("NodeStatus: sys%d CPU: %" PRIu64 "/%" PRIu64 ", RUN: %d",
+		status.system_id, status.cpu_used, status.cpu_total,
+		status.nr_running);
+	error->set_value(bbque::GenericReply::OK);
+
+	return grpc::Status::OK;
+}
+
+
+grpc::Status AgentImpl::SetApplicationSchedule(
+		grpc::ServerContext * context,
+		const bbque::ApplicationSchedulingRequest * request,
+		bbque::GenericReply * error) {
+
+	logger->Debug("ApplicationSchedule: Request from system %d for [%s]",
+		request->sender_id(), request->app_name().c_str());
+
+	auto amount_it = request->amount().find(
+		static_cast<uint32_t>(bbque::res::ResourceType::PROC_ELEMENT));
+	uint64_t cpu_req = (amount_it != request->amount().end()) ?
+		amount_it->second : 0;
+	amount_it = request->amount().find(
+		static_cast<uint32_t>(bbque::res::ResourceType::MEMORY));
+	uint64_t mem_req = (amount_it != request->amount().end()) ?
+		amount_it->second : 0;
+
+	// Admission: the amount requested must be currently available on the
+	// local node. Nothing is reserved: the EXCs are executed, and scheduled,
+	// on the node where they have been started.
+	agent::NodeStatus local_status;
+	GetLocalNodeStatus(local_status);
+
+	if ((cpu_req > local_status.CpuAvailable()) ||
+			(mem_req > local_status.MemAvailable())) {
+		logger->Warn("ApplicationSchedule: [%s] rejected "
+			"(CPU: %" PRIu64 "/%" PRIu64 ", MEM: %" PRIu64 "/%" PRIu64 ")",
+			request->app_name().c_str(),
+			cpu_req, local_status.CpuAvailable(),
+			mem_req, local_status.MemAvailable());
+		error->set_value(bbque::GenericReply::REQUEST_REJECTED);
+		return grpc::Status::OK;
+	}
+
+	logger->Info("ApplicationSchedule: [%s] AWM %d accepted",
+		request->app_name().c_str(), request->awm_id());
 	error->set_value(bbque::GenericReply::OK);
 
 	return grpc::Status::OK;
 }
 
+
+void AgentImpl::GetLocalNodeStatus(agent::NodeStatus & status) {
+	std::string sys_prefix("sys" + std::to_string(local_sys_id));
+	status.system_id  = local_sys_id;
+	status.cpu_total  = system.ResourceTotal(sys_prefix + ".cpu.pe");
+	status.cpu_used   = system.ResourceUsed(sys_prefix + ".cpu.pe");
+	status.mem_total  = system.ResourceTotal(sys_prefix + ".mem");
+	status.mem_used   = system.ResourceUsed(sys_prefix + ".mem");
+	status.nr_ready   = system.ApplicationsCount(
+		bbque::app::ApplicationStatusIF::READY);
+	status.nr_running = system.ApplicationsCount(
+		bbque::app::ApplicationStatusIF::RUNNING);
+	status.timestamp_ms = timer.getElapsedTimeMs();
+}
+
+
+void AgentImpl::GetNodesStatus(std::map<int16_t, agent::NodeStatus> & nodes) {
+	std::unique_lock<std::mutex> status_ul(status_mtx);
+	nodes = nodes_status;
+}
+
 } // namespace plugins
 
 } // namespace bbque
@@ -18,9 +18,13 @@
 #ifndef BBQUE_AGENT_PROXY_GRPC_IMPL_H_
 #define BBQUE_AGENT_PROXY_GRPC_IMPL_H_
 
+#include <map>
+#include <mutex>
+
 #include "bbque/plugins/agent_proxy_if.h"
 #include "bbque/system.h"
 #include "bbque/utils/logging/logger.h"
+#include "bbque/utils/timer.h"
 
 #include <grpc/grpc.h>
 #include "agent_com.grpc.pb.h"
@@ -37,6 +41,7 @@ public:
 	explicit AgentImpl():
 		system(bbque::System::GetInstance()),
 		logger(bbque::utils::Logger::GetLogger(AGENT_PROXY_NAMESPACE".grpc.imp")) {
+		timer.start();
 	}
 
 	virtual ~AgentImpl() {}
@@ -60,12 +65,50 @@ public:
 	        grpc::ServerContext * context,
 	        const bbque::NodeManagementRequest * action,
 	        bbque::GenericReply * error) override;
+
+	grpc::Status SetNodeStatus(
+	        grpc::ServerContext * context,
+	        const bbque::NodeStatusRequest * request,
+	        bbque::GenericReply * error) override;
+
+	grpc::Status SetApplicationSchedule(
+	        grpc::ServerContext * context,
+	        const bbque::ApplicationSchedulingRequest * request,
+	        bbque::GenericReply * error) override;
+
+	/**
+	 * @brief Set the identifier of the local system
+	 */
+	inline void SetLocalSystemId(int16_t sys_id) {
+		local_sys_id = sys_id;
+	}
+
+	/**
+	 * @brief Fill the summary of the local node status
+	 */
+	void GetLocalNodeStatus(agent::NodeStatus & status);
+
+	/**
+	 * @brief The latest capacity summaries received from the agents
+	 */
+	void GetNodesStatus(std::map<int16_t, agent::NodeStatus> & nodes);
+
 private:
 
 	bbque::System & system;
 
 	std::unique_ptr<bbque::utils::Logger> logger;
 
+	int16_t local_sys_id = 0;
+
+	/** Time reference for the node status updates */
+	bbque::utils::Timer timer;
+
+	/** Capacity summaries from the joined agents, per system id */
+	std::map<int16_t, agent::NodeStatus> nodes_status;
+
+	std::mutex status_mtx;
+
 };
 
 } // namespace plugins
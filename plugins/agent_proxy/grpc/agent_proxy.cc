@@ -40,6 +40,10 @@ boost::program_options::variables_map agent_proxy_opts_value;
 
 uint32_t AgentProxyGRPC::port_num = BBQUE_AGENT_PROXY_PORT_DEFAULT;
 
+uint32_t AgentProxyGRPC::master_id = 0;
+
+uint32_t AgentProxyGRPC::status_period_ms = 1000;
+
 // =======================[ Static plugin interface ]=========================
 
 bool AgentProxyGRPC::configured = false;
@@ -68,7 +72,13 @@ bool AgentProxyGRPC::Configure(PF_ObjectParams * params) {
 	agent_proxy_opts_desc.add_options()
 		(MODULE_CONFIG".port", boost::program_options::value<uint32_t>
 		 (&port_num)->default_value(BBQUE_AGENT_PROXY_PORT_DEFAULT),
-		 "Server port number");
+		 "Server port number")
+		(MODULE_CONFIG".master_id", boost::program_options::value<uint32_t>
+		 (&master_id)->default_value(0),
+		 "System id of the master instance (hierarchical mode)")
+		(MODULE_CONFIG".status_period_ms", boost::program_options::value<uint32_t>
+		 (&status_period_ms)->default_value(1000),
+		 "Period of the node status updates to the master [ms]");
 
 	// Get configuration params
 	PF_Service_ConfDataIn data_in;
@@ -102,6 +112,13 @@ AgentProxyGRPC::AgentProxyGRPC() {
 
 AgentProxyGRPC::~AgentProxyGRPC() {
 	logger->Info("Destroying the AgentProxy module...");
+	if (status_thd.joinable()) {
+		std::unique_lock<std::mutex> status_ul(status_mtx);
+		status_done = true;
+		status_cv.notify_all();
+		status_ul.unlock();
+		status_thd.join();
+	}
 	clients.clear();
 	systems.clear();
 }
@@ -119,6 +136,7 @@ void AgentProxyGRPC::SetPlatformDescription(
 
 	local_sys_id = platform->GetLocalSystem().GetId();
 	logger->Debug("Local system id: %d", local_sys_id);
+	service.SetLocalSystemId(local_sys_id);
 }
 
 void AgentProxyGRPC::StartServer() {
@@ -128,6 +146,42 @@ void AgentProxyGRPC::StartServer() {
 	}
 	logger->Info("Starting the server task...");
 	Start();
+
+#ifdef CONFIG_BBQUE_DIST_HIERARCHICAL
+	// The agents periodically send a status summary to the master
+	if (local_sys_id != master_id) {
+		logger->Info("Node status updates to system %d every %d ms",
+			master_id, status_period_ms);
+		status_thd = std::thread(&AgentProxyGRPC::StatusUpdateTask, this);
+	}
+#endif
+}
+
+void AgentProxyGRPC::StatusUpdateTask() {
+	agent::NodeStatus status;
+	ExitCode_t result;
+	logger->Debug("Status update task launched");
+
+	result = SendJoinRequest(master_id);
+	if (result != ExitCode_t::OK)
+		logger->Warn("Join request to system %d failed", master_id);
+
+	std::unique_lock<std::mutex> status_ul(status_mtx);
+	while (!status_done) {
+		status_ul.unlock();
+		service.GetLocalNodeStatus(status);
+		result = SendNodeStatus(master_id, status);
+		if (result != ExitCode_t::OK)
+			logger->Debug("Status update to system %d failed", master_id);
+		status_ul.lock();
+
+		status_cv.wait_for(status_ul,
+			std::chrono::milliseconds(status_period_ms));
+	}
+	status_ul.unlock();
+
+	SendDisjoinRequest(master_id);
+	logger->Debug("Status update task terminated");
 }
 
 void AgentProxyGRPC::Task() {
@@ -149,6 +203,14 @@ void AgentProxyGRPC::RunServer() {
 
 void AgentProxyGRPC::StopServer() {
 	logger->Info("Stopping the server task...");
+	if (status_thd.joinable()) {
+		std::unique_lock<std::mutex> status_ul(status_mtx);
+		status_done = true;
+		status_cv.notify_all();
+		status_ul.unlock();
+		status_thd.join();
+	}
+
 	if (server == nullptr) {
 		logger->Warn("Server already stopped");
 		return;
@@ -177,21 +239,26 @@ std::shared_ptr<AgentClient> AgentProxyGRPC::GetAgentClient(uint16_t system_id)
 		return nullptr;
 	}
 
-	if(clients.size() <= system_id) {
+	std::unique_lock<std::mutex> clients_ul(clients_mtx);
+	auto client_it = clients.find(system_id);
+	if (client_it == clients.end()) {
 		logger->Debug("Creating a client for system %d", system_id);
+		// A port number in the address (e.g. "127.0.0.1:8851") overrides
+		// the default one. This allows several instances on the same host.
 		std::string server_address_port(
 			systems.at(system_id).GetNetAddress());
-		server_address_port.append(":" + std::to_string(port_num));
+		if (server_address_port.find(':') == std::string::npos)
+			server_address_port.append(":" + std::to_string(port_num));
 		logger->Debug("Allocating a client to connect %s",
 			server_address_port.c_str());
 
 		std::shared_ptr<AgentClient> client =
 		        std::make_shared<AgentClient>(
 				local_sys_id, server_address_port);
-		clients.push_back(client);
+		client_it = clients.emplace(system_id, client).first;
 	}
 	logger->Debug("Client instances: %d", clients.size());
-	return clients.at(system_id);
+	return client_it->second;
 }
 
 
@@ -240,33 +307,54 @@ ExitCode_t AgentProxyGRPC::GetChannelStatus(
 // ------------- Multi-agent management functions ------------------
 
 ExitCode_t AgentProxyGRPC::SendJoinRequest(std::string const & path) {
-
-	return agent::ExitCode_t::AGENT_UNREACHABLE;
+	return SendJoinRequest(GetSystemId(path));
 }
 
 ExitCode_t AgentProxyGRPC::SendJoinRequest(int system_id) {
-
+	std::shared_ptr<AgentClient> client(GetAgentClient(system_id));
+	if (client)
+		return client->SendJoinRequest();
 	return agent::ExitCode_t::AGENT_UNREACHABLE;
 }
 
 
 ExitCode_t AgentProxyGRPC::SendDisjoinRequest(std::string const & path) {
+	return SendDisjoinRequest(GetSystemId(path));
+}
 
+ExitCode_t AgentProxyGRPC::SendDisjoinRequest(int system_id) {
+	std::shared_ptr<AgentClient> client(GetAgentClient(system_id));
+	if (client)
+		return client->SendDisjoinRequest();
 	return agent::ExitCode_t::AGENT_UNREACHABLE;
 }
 
-ExitCode_t AgentProxyGRPC::SendDisjoinRequest(int system_id) {
 
+// ------------- Hierarchical management functions -----------------
+
+ExitCode_t AgentProxyGRPC::SendNodeStatus(
+		int system_id,
+		agent::NodeStatus const & status) {
+	std::shared_ptr<AgentClient> client(GetAgentClient(system_id));
+	if (client)
+		return client->SendNodeStatus(status);
 	return agent::ExitCode_t::AGENT_UNREACHABLE;
 }
 
+void AgentProxyGRPC::GetNodesStatus(
+		std::map<int16_t, agent::NodeStatus> & nodes) {
+	service.GetNodesStatus(nodes);
+}
+
 
 // ----------- Scheduling / Resource allocation functions ----------
 
 ExitCode_t AgentProxyGRPC::SendScheduleRequest(
 		std::string const & path,
 		agent::ApplicationScheduleRequest const & request) {
-
+	std::shared_ptr<AgentClient> client(GetAgentClient(GetSystemId(path)));
+	if (client)
+		return client->SendScheduleRequest(request);
 	return agent::ExitCode_t::AGENT_UNREACHABLE;
 }
 
@@ -19,8 +19,11 @@
 #define BBQUE_AGENT_PROXY_GRPC_H_
 
 #include <chrono>
+#include <condition_variable>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -111,6 +114,15 @@ public:
 	ExitCode_t SendDisjoinRequest(int system_id) override;
 
 
+	// ------------- Hierarchical management functions -----------------
+
+	ExitCode_t SendNodeStatus(
+	        int system_id, agent::NodeStatus const & status) override;
+
+	void GetNodesStatus(
+	        std::map<int16_t, agent::NodeStatus> & nodes) override;
+
+
 	// ----------- Scheduling / Resource allocation functions ----------
 
 	ExitCode_t SendScheduleRequest(
@@ -123,6 +135,12 @@ private:
 
 	static uint32_t port_num;
 
+	/** The system id of the master instance (hierarchical mode) */
+	static uint32_t master_id;
+
+	/** Period of the node status updates to the master [ms] */
+	static uint32_t status_period_ms;
+
 	std::unique_ptr<bu::Logger> logger;
 
 
@@ -136,10 +154,21 @@ private:
 
 	std::unique_ptr<grpc::Server> server;
 
-	std::vector<std::shared_ptr<AgentClient>> clients;
+	std::map<uint16_t, std::shared_ptr<AgentClient>> clients;
+
+	std::mutex clients_mtx;
 
 	bool server_started = false;
 
+	/** Thread sending the node status updates to the master */
+	std::thread status_thd;
+
+	bool status_done = false;
+
+	std::mutex status_mtx;
+
+	std::condition_variable status_cv;
+
 	// Plugin required
 	static bool configured;
 
@@ -150,6 +179,11 @@ private:
 
 	void RunServer();
 
+	/**
+	 * @brief Periodically send the local node status to the master
+	 */
+	void StatusUpdateTask();
+
 
 	uint16_t GetSystemId(std::string const & path) const;
 
@@ -4,6 +4,10 @@
 #include "bbque/utils/utility.h"
 #include "bbque/config.h"
 
+#ifdef CONFIG_BBQUE_PIL_TOPOLOGY_DISCOVERY
+#include "bbque/pp/sysfs_topology.h"
+#endif
+
 #include <boost/program_options.hpp>
 #include <fstream>
 #include <string>
@@ -22,6 +26,14 @@ bool RXMLPlatformLoader::configured = false;
 /** Recipes directory */
 std::string RXMLPlatformLoader::platforms_dir = "";
 
+#ifdef CONFIG_BBQUE_PIL_TOPOLOGY_DISCOVERY
+/** Topology discovery from sysfs */
+bool RXMLPlatformLoader::topology_discovery = false;
+
+/** Topology discovery root directory */
+std::string RXMLPlatformLoader::sysfs_root = BBQUE_SYSFS_TOPOLOGY_ROOT;
+#endif
+
 /** Map of options (in the Barbeque config file) for the plugin */
 po::variables_map xmlploader_opts_value;
 
@@ -148,6 +160,14 @@ bool RXMLPlatformLoader::Configure(PF_ObjectParams * params) {
 		(MODULE_CONFIG".platform_dir", po::value<std::string>
 		 (&platforms_dir)->default_value(BBQUE_PATH_PREFIX "/" BBQUE_PATH_PILS),
 		 "platform folder")
+#ifdef CONFIG_BBQUE_PIL_TOPOLOGY_DISCOVERY
+		(MODULE_CONFIG".topology_discovery", po::value<bool>
+		 (&topology_discovery)->default_value(false),
+		 "local system topology discovery from sysfs")
+		(MODULE_CONFIG".sysfs_root", po::value<std::string>
+		 (&sysfs_root)->default_value(BBQUE_SYSFS_TOPOLOGY_ROOT),
+		 "sysfs directory for the topology discovery")
+#endif
 	;
 
 	// Get configuration params
@@ -341,12 +361,37 @@ RXMLPlatformLoader::ExitCode_t RXMLPlatformLoader::ParseSystemDocument(
 	if (ec != PL_SUCCESS)
 		return ec;
 
+#ifdef CONFIG_BBQUE_PIL_TOPOLOGY_DISCOVERY
+	if (is_local && topology_discovery)
+		DiscoverTopology(sys);
+#endif
+
 	pd.AddSystem(sys);
 	return is_local ? PL_SUCCESS : PL_SUCCESS_NO_LOCAL;
 }
 
 
 
+#ifdef CONFIG_BBQUE_PIL_TOPOLOGY_DISCOVERY
+
+void RXMLPlatformLoader::DiscoverTopology(pp::PlatformDescription::System & sys) {
+	pp::SysfsTopology topology(sysfs_root);
+	if (!topology.Scan()) {
+		logger->Warn("Topology discovery from '%s' failed: keeping the "
+				"XML description", sysfs_root.c_str());
+		return;
+	}
+
+	topology.BuildSystem(sys);
+	logger->Info("Topology discovered from '%s': %d PEs, %d NUMA nodes",
+			sysfs_root.c_str(),
+			topology.GetProcessingElements().size(),
+			topology.GetNodes().size());
+}
+
+#endif // CONFIG_BBQUE_PIL_TOPOLOGY_DISCOVERY
+
+
 RXMLPlatformLoader::ExitCode_t RXMLPlatformLoader::ParseMemories(
 		node_ptr root,
 		pp::PlatformDescription::System & sys) {
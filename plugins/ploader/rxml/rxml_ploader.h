@@ -99,6 +99,19 @@ private:
 	 */
 	static std::string platforms_dir;
 
+#ifdef CONFIG_BBQUE_PIL_TOPOLOGY_DISCOVERY
+	/**
+	 * Build the CPUs and memories of the local system from the sysfs
+	 * topology, rather than from the XML file
+	 */
+	static bool topology_discovery;
+
+	/**
+	 * The sysfs directory to discover the topology from
+	 */
+	static std::string sysfs_root;
+#endif
+
 	/**
 	 * @brief Load RecipeLoader configuration
 	 *
@@ -134,6 +147,14 @@ private:
 
 	ExitCode_t ParseSystemDocument(const char* name, bool is_local);
 
+#ifdef CONFIG_BBQUE_PIL_TOPOLOGY_DISCOVERY
+	/**
+	 * @brief Replace the CPUs and memories of the local system with the
+	 * ones discovered from the sysfs topology
+	 */
+	void DiscoverTopology(pp::PlatformDescription::System & sys);
+#endif
+
 
 	ExitCode_t ParseMemories(node_ptr root, pp::PlatformDescription::System & sys);
 
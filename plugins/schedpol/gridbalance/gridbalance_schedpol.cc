@@ -27,6 +27,7 @@
 #include "bbque/utils/logging/logger.h"
 
 #include "bbque/app/working_mode.h"
+#include "bbque/binding_manager.h"
 #include "bbque/res/binder.h"
 #include "bbque/res/resource_utils.h"
 
@@ -184,6 +185,11 @@ SchedulerPolicyIF::ExitCode_t GridBalanceSchedPol::BindWorkingModesAndSched() {
 	bbque::res::ResourcePtrList_t::const_iterator iter = proc_elements.begin();
 	auto proc_path = ra.GetPath("sys.cpu.pe");
 
+	BindingManager & bdm(BindingManager::GetInstance());
+	bbque::res::ResourceBitset all_procs_mask;
+	for (auto & proc: proc_elements)
+		all_procs_mask.Set(proc->ID());
+
 	for (auto & sched_entity: entities) {
 		logger->Info("Bind: [%s] binding and scheduling...",
 			sched_entity->papp->StrId());
@@ -195,6 +201,14 @@ SchedulerPolicyIF::ExitCode_t GridBalanceSchedPol::BindWorkingModesAndSched() {
 		auto proc_mask =
 			bbque::res::ResourceBinder::GetMaskInRange(
 				proc_elements, iter, num_procs);
+
+		// Pack the processing elements onto the ones closest to the
+		// first selected (e.g., sharing the caches)
+		if (bdm.HasTopology() && (num_procs > 1)) {
+			proc_mask = bdm.GetClosest(
+				bbque::res::ResourceType::PROC_ELEMENT,
+				proc_mask.FirstSet(), all_procs_mask, num_procs);
+		}
 		logger->Debug("Bind: [%s] <sys.cpu.pe> mask = %s",
 			sched_entity->papp->StrId(), proc_mask.ToString().c_str());
 
@@ -17,11 +17,14 @@
 
 #include "manga_schedpol.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <cstdint>
 #include <iostream>
 
 #include "bbque/modules_factory.h"
+#include "bbque/platform_proxy.h"
 #include "bbque/utils/logging/logger.h"
 #include "bbque/utils/assert.h"
 #include "bbque/app/working_mode.h"
@@ -69,6 +72,42 @@ MangASchedPol::MangASchedPol():
 	else
 		fprintf(stderr,
 			FI("manga: Built new dynamic object [%p]\n"), (void *)this);
+
+	// Partitions scoring parameters
+	float weight_locality, weight_noc, weight_memory;
+	uint32_t noc_columns;
+	po::options_description opts_desc("MangA scheduling policy parameters");
+	opts_desc.add_options()
+		(MODULE_CONFIG ".weight.locality",
+		 po::value<float>(&weight_locality)->default_value(1.0),
+		 "Weight of the tasks/buffers locality in partitions scoring")
+		(MODULE_CONFIG ".weight.noc",
+		 po::value<float>(&weight_noc)->default_value(1.0),
+		 "Weight of the NoC bandwidth in partitions scoring")
+		(MODULE_CONFIG ".weight.memory",
+		 po::value<float>(&weight_memory)->default_value(1.0),
+		 "Weight of the memory banks contention in partitions scoring")
+		(MODULE_CONFIG ".noc_columns",
+		 po::value<uint32_t>(&noc_columns)->default_value(0),
+		 "Number of columns of the tiles mesh (0 = square mesh)")
+	;
+	po::variables_map opts_vm;
+	cm.ParseConfigurationFile(opts_desc, opts_vm);
+
+	// Assume a square mesh of the accelerators, if not specified
+	if (noc_columns == 0) {
+		size_t nr_tiles = 1;
+#ifndef CONFIG_BBQUE_PIL_LEGACY
+		auto const & sys(PlatformProxy::GetPlatformDescription().GetLocalSystem());
+		nr_tiles = sys.GetAcceleratorsAll().size();
+#endif
+		noc_columns = std::max<uint32_t>(1, std::ceil(std::sqrt(nr_tiles)));
+	}
+	logger->Info("manga: scoring weights [locality=%.2f, noc=%.2f, memory=%.2f], "
+		"mesh columns=%d", weight_locality, weight_noc, weight_memory,
+		noc_columns);
+	scorer.SetWeights(weight_locality, weight_noc, weight_memory);
+	scorer.SetColumns(noc_columns);
 }
 
 
@@ -111,6 +150,9 @@ MangASchedPol::Schedule(
 	sys = &system;
 	Init();
 
+	// The memory banks load is accounted by the partitions selected now
+	scorer.ClearBanksLoad();
+
 	fut_tg.get();
 
 	for (AppPrio_t priority = 0; priority <= sys->ApplicationLowestPriority(); priority++) {
@@ -310,13 +352,39 @@ MangASchedPol::SelectTheBestPartition(ba::AppCPtr_t papp, const std::list<Partit
 
 	bbque_assert(partitions.size() > 0);
 
-	// TODO: Intelligent policy
+	auto tg = papp->GetTaskGraph();
+	std::vector<const Partition *> candidates;
+	std::vector<PartitionScorer::PartitionCost_t> costs;
+	std::vector<double> scores;
+	Timer eval_tmr(true);
+
+	for (auto const & partition : partitions)
+		candidates.push_back(&partition);
+	size_t best = scorer.SelectBest(*tg, candidates, costs, scores);
+
+	for (size_t i = 0; i < candidates.size(); ++i) {
+		if (std::isinf(costs[i].locality)) {
+			logger->Warn("Partition [id=%d] not mapping the whole task graph",
+				candidates[i]->GetId());
+			continue;
+		}
+		logger->Debug("Partition [id=%d]: locality=%.0f noc=%.0f memory=%.0f "
+			"=> score=%.3f", candidates[i]->GetId(), costs[i].locality,
+			costs[i].noc, costs[i].memory, scores[i]);
+	}
 
-	// For the demo just select the first partition
-	logger->Warn("TODO: now selecting the first available partition");
+	if (best == candidates.size()) {
+		logger->Error("No valid partition for application %s [pid=%d]",
+			papp->Name().c_str(), papp->Pid());
+		return SCHED_SKIP_APP;
+	}
 
-	auto tg = papp->GetTaskGraph();
-	auto selected_partition = partitions.front();
+	logger->Info("Selected partition [id=%d] out of %lu [score=%.3f, t=%.3f ms]",
+		candidates[best]->GetId(), candidates.size(), scores[best],
+		eval_tmr.getElapsedTimeMs());
+
+	auto selected_partition = *candidates[best];
+	scorer.UpdateBanksLoad(*tg, selected_partition);
 
 	papp->SetPartition(std::make_shared<Partition>(selected_partition));		// For cleanup and similar
 	rmv.PropagatePartition(*tg, selected_partition);
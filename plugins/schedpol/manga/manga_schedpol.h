@@ -29,6 +29,8 @@
 #include "bbque/scheduler_manager.h"
 #include "bbque/resource_partition_validator.h"
 
+#include "partition_scorer.h"
+
 #define SCHEDULER_POLICY_NAME "manga"
 
 #define MODULE_NAMESPACE SCHEDULER_POLICY_NAMESPACE "." SCHEDULER_POLICY_NAME
@@ -101,6 +103,9 @@ private:
 
 	std::future<void> fut_tg;
 
+	/** Scoring of the candidate partitions */
+	PartitionScorer scorer;
+
 	/**
 	 * @brief Constructor
 	 *
@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "partition_scorer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+/** Minimum number of candidate partitions evaluated by each worker */
+#define MANGA_PARTITIONS_PER_WORKER 4
+
+namespace bbque { namespace plugins {
+
+PartitionScorer::PartitionScorer(uint32_t noc_columns,
+		float weight_locality, float weight_noc, float weight_memory):
+	noc_columns(std::max<uint32_t>(1, noc_columns)),
+	weight_locality(weight_locality),
+	weight_noc(weight_noc),
+	weight_memory(weight_memory) {
+}
+
+void PartitionScorer::SetWeights(float weight_locality, float weight_noc,
+		float weight_memory) noexcept {
+	this->weight_locality = weight_locality;
+	this->weight_noc      = weight_noc;
+	this->weight_memory   = weight_memory;
+}
+
+void PartitionScorer::SetColumns(uint32_t noc_columns) noexcept {
+	this->noc_columns = std::max<uint32_t>(1, noc_columns);
+}
+
+uint32_t PartitionScorer::Hops(int tile1, int tile2) const noexcept {
+	int dx = (tile1 % noc_columns) - (tile2 % noc_columns);
+	int dy = (tile1 / noc_columns) - (tile2 / noc_columns);
+	return std::abs(dx) + std::abs(dy);
+}
+
+void PartitionScorer::EvaluatePartition(const TaskGraph & tg,
+		const Partition & partition, PartitionCost_t & cost) const noexcept {
+	// Memory bandwidth of this partition on each bank
+	std::map<int, uint64_t> own_load;
+
+	try {
+		for (auto const & task_pair : tg.Tasks()) {
+			auto const & task = task_pair.second;
+			int unit = partition.GetUnit(task);
+			Bandwidth_t bw = task->GetAssignedBandwidth();
+
+			// The bandwidth is split among the buffers accessed. A unit
+			// weight is given to the accesses without requirements.
+			size_t nr_in  = task->InputBuffers().size();
+			size_t nr_out = task->OutputBuffers().size();
+			uint64_t in_kbps  = nr_in  ? std::max<uint64_t>(1, bw.in_kbps / nr_in) : 0;
+			uint64_t out_kbps = nr_out ? std::max<uint64_t>(1, bw.out_kbps / nr_out) : 0;
+
+			auto account = [&](uint32_t buffer_id, uint64_t kbps) {
+				auto const & buffer = tg.Buffers().at(buffer_id);
+				int bank = partition.GetMemoryBank(buffer);
+				uint32_t hops = Hops(unit, bank);
+				cost.locality += hops;
+				cost.noc += kbps * hops;
+				own_load[bank] += kbps;
+			};
+			for (uint32_t buffer_id : task->InputBuffers())
+				account(buffer_id, in_kbps);
+			for (uint32_t buffer_id : task->OutputBuffers())
+				account(buffer_id, out_kbps);
+
+			// The kernel image is fetched by the unit too
+			cost.locality += Hops(unit, partition.GetKernelBank(task));
+		}
+	}
+	catch (const std::out_of_range &) {
+		// Not a complete mapping of the task graph
+		cost.locality = cost.noc = cost.memory =
+			std::numeric_limits<double>::infinity();
+		return;
+	}
+
+	// Contention: the bandwidth requested on a bank, times the bandwidth
+	// already assigned there (including the other accesses of this graph)
+	for (auto const & load : own_load) {
+		auto const bank_it = banks_load.find(load.first);
+		uint64_t others = (bank_it != banks_load.end()) ? bank_it->second : 0;
+		cost.memory += double(load.second) * (others + load.second);
+	}
+}
+
+void PartitionScorer::EvaluatePartitions(const TaskGraph & tg,
+		const std::vector<const Partition *> & candidates,
+		std::vector<PartitionCost_t> & costs) const noexcept {
+	size_t nr_workers = std::max<size_t>(1, std::thread::hardware_concurrency());
+	nr_workers = std::min(nr_workers,
+		(candidates.size() + MANGA_PARTITIONS_PER_WORKER - 1) /
+			MANGA_PARTITIONS_PER_WORKER);
+	nr_workers = std::max<size_t>(1, nr_workers);
+	costs.assign(candidates.size(), PartitionCost_t());
+
+	auto evaluate = [&](size_t first, size_t last) {
+		for (size_t i = first; i < last; ++i)
+			EvaluatePartition(tg, *candidates[i], costs[i]);
+	};
+
+	// Each worker scores a contiguous slice of the candidates, while the
+	// calling thread scores the first one
+	std::vector<std::future<void>> workers;
+	size_t slice = (candidates.size() + nr_workers - 1) / nr_workers;
+	for (size_t first = slice; first < candidates.size(); first += slice) {
+		size_t last = std::min(first + slice, candidates.size());
+		workers.push_back(std::async(std::launch::async, evaluate, first, last));
+	}
+	evaluate(0, std::min(slice, candidates.size()));
+	for (auto & worker : workers)
+		worker.get();
+}
+
+size_t PartitionScorer::SelectBest(const TaskGraph & tg,
+		const std::vector<const Partition *> & candidates,
+		std::vector<PartitionCost_t> & costs,
+		std::vector<double> & scores) const noexcept {
+	EvaluatePartitions(tg, candidates, costs);
+	scores.assign(candidates.size(), std::numeric_limits<double>::infinity());
+
+	// Each cost is normalized on the worst candidate, then weighted
+	PartitionCost_t max_cost;
+	for (auto const & cost : costs) {
+		if (std::isinf(cost.locality))
+			continue;
+		max_cost.locality = std::max(max_cost.locality, cost.locality);
+		max_cost.noc      = std::max(max_cost.noc, cost.noc);
+		max_cost.memory   = std::max(max_cost.memory, cost.memory);
+	}
+
+	size_t best = candidates.size();
+	for (size_t i = 0; i < candidates.size(); ++i) {
+		if (std::isinf(costs[i].locality))
+			continue;
+		double score = 0;
+		if (max_cost.locality > 0)
+			score += weight_locality * costs[i].locality / max_cost.locality;
+		if (max_cost.noc > 0)
+			score += weight_noc * costs[i].noc / max_cost.noc;
+		if (max_cost.memory > 0)
+			score += weight_memory * costs[i].memory / max_cost.memory;
+		scores[i] = score;
+		if ((best == candidates.size()) || (score < scores[best]))
+			best = i;
+	}
+
+	return best;
+}
+
+void PartitionScorer::UpdateBanksLoad(const TaskGraph & tg,
+		const Partition & partition) noexcept {
+	for (auto const & task_pair : tg.Tasks()) {
+		auto const & task = task_pair.second;
+		Bandwidth_t bw = task->GetAssignedBandwidth();
+		size_t nr_in  = task->InputBuffers().size();
+		size_t nr_out = task->OutputBuffers().size();
+		for (uint32_t buffer_id : task->InputBuffers()) {
+			int bank = partition.GetMemoryBank(tg.Buffers().at(buffer_id));
+			banks_load[bank] += std::max<uint64_t>(1, bw.in_kbps / nr_in);
+		}
+		for (uint32_t buffer_id : task->OutputBuffers()) {
+			int bank = partition.GetMemoryBank(tg.Buffers().at(buffer_id));
+			banks_load[bank] += std::max<uint64_t>(1, bw.out_kbps / nr_out);
+		}
+	}
+}
+
+} // namespace plugins
+
+} // namespace bbque
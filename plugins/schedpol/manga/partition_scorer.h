@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_MANGA_PARTITION_SCORER_H_
+#define BBQUE_MANGA_PARTITION_SCORER_H_
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "tg/partition.h"
+#include "tg/task_graph.h"
+
+namespace bbque { namespace plugins {
+
+/**
+ * @class PartitionScorer
+ *
+ * Scoring of the candidate partitions of a task graph, on a mesh of tiles.
+ * Each candidate is evaluated, in parallel, by:
+ * - locality: hops between each task and the memory banks it accesses,
+ *   including its kernel image;
+ * - NoC bandwidth: the task bandwidth requirements times the hops;
+ * - memory contention: the bandwidth on each bank, including the one of
+ *   the partitions already selected.
+ * The costs are normalized on the worst candidate and weighted.
+ */
+class PartitionScorer {
+
+public:
+
+	/**
+	 * @brief The costs of a candidate partition
+	 */
+	typedef struct PartitionCost {
+		/** Hops between the tasks and the memory banks they access */
+		double locality = 0;
+		/** NoC bandwidth (kbps) times the hops to cross */
+		double noc = 0;
+		/** Bandwidth (kbps) contending the memory banks */
+		double memory = 0;
+	} PartitionCost_t;
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param noc_columns Number of columns of the tiles mesh
+	 */
+	PartitionScorer(uint32_t noc_columns = 1,
+			float weight_locality = 1.0, float weight_noc = 1.0,
+			float weight_memory = 1.0);
+
+	/**
+	 * @brief Set the weights of the costs in the partitions scoring
+	 */
+	void SetWeights(float weight_locality, float weight_noc,
+			float weight_memory) noexcept;
+
+	/**
+	 * @brief Set the number of columns of the tiles mesh
+	 */
+	void SetColumns(uint32_t noc_columns) noexcept;
+
+	/**
+	 * @brief Select the best candidate partition
+	 *
+	 * @param costs The costs of each candidate
+	 * @param scores The score of each candidate (the lower the better),
+	 * infinite if the candidate does not map the whole task graph
+	 *
+	 * @return The index of the best candidate, or candidates.size() if
+	 * none is valid
+	 */
+	size_t SelectBest(const TaskGraph & tg,
+			const std::vector<const Partition *> & candidates,
+			std::vector<PartitionCost_t> & costs,
+			std::vector<double> & scores) const noexcept;
+
+	/**
+	 * @brief Evaluate the costs of the candidate partitions, in parallel
+	 */
+	void EvaluatePartitions(const TaskGraph & tg,
+			const std::vector<const Partition *> & candidates,
+			std::vector<PartitionCost_t> & costs) const noexcept;
+
+	/**
+	 * @brief Evaluate the costs of a candidate partition
+	 */
+	void EvaluatePartition(const TaskGraph & tg, const Partition & partition,
+			PartitionCost_t & cost) const noexcept;
+
+	/**
+	 * @brief Number of hops on the NoC between two tiles
+	 */
+	uint32_t Hops(int tile1, int tile2) const noexcept;
+
+	/**
+	 * @brief Account the memory bandwidth of the selected partition
+	 */
+	void UpdateBanksLoad(const TaskGraph & tg,
+			const Partition & partition) noexcept;
+
+	/**
+	 * @brief Forget the memory bandwidth of the partitions selected
+	 */
+	inline void ClearBanksLoad() noexcept {
+		banks_load.clear();
+	}
+
+private:
+
+	/** Number of columns of the tiles mesh */
+	uint32_t noc_columns;
+
+	/** Weight of the locality in the partitions scoring */
+	float weight_locality;
+
+	/** Weight of the NoC bandwidth in the partitions scoring */
+	float weight_noc;
+
+	/** Weight of the memory banks contention in the partitions scoring */
+	float weight_memory;
+
+	/** Bandwidth (kbps) already assigned on each memory bank */
+	std::map<int, uint64_t> banks_load;
+
+};
+
+} // namespace plugins
+
+} // namespace bbque
+
+#endif // BBQUE_MANGA_PARTITION_SCORER_H_
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sc_interference.h"
+
+#include <set>
+
+#include "bbque/application_manager.h"
+#include "bbque/interference_model.h"
+
+namespace po = boost::program_options;
+
+namespace bbque { namespace plugins {
+
+
+SCInterference::SCInterference(
+		const char * _name,
+		BindingInfo_t const & _bd_info,
+		uint16_t const cfg_params[]):
+	SchedContrib(_name, _bd_info, cfg_params) {
+	char conf_str[50];
+	memset(conf_str, '\0', sizeof(conf_str));
+
+	// Configuration parameters
+	po::options_description opts_desc("Interference contribute parameters");
+	snprintf(conf_str, sizeof(conf_str)-1, SC_CONF_BASE_STR"%s.penalty", name);
+	opts_desc.add_options()
+		(conf_str,
+		 po::value<uint16_t>(&penalty_int)->default_value(SC_INTF_DEFAULT_PENALTY),
+		 "Interference penalty");
+		;
+	po::variables_map opts_vm;
+	cm.ParseConfigurationFile(opts_desc, opts_vm);
+
+	// Boundaries enforcement (0 <= penalty <= 100)
+	if (penalty_int > 100) {
+		logger->Warn("penalty out of range [0,100]: found %d. Setting to %d",
+				penalty_int, SC_INTF_DEFAULT_PENALTY);
+		penalty_int = SC_INTF_DEFAULT_PENALTY;
+	}
+	penalty = static_cast<float>(penalty_int) / 100.0;
+	logger->Debug("penalty: %.2f", penalty);
+}
+
+SCInterference::~SCInterference() {
+}
+
+SchedContrib::ExitCode_t
+SCInterference::Init(void * params) {
+	(void) params;
+	return SC_SUCCESS;
+}
+
+SchedContrib::ExitCode_t
+SCInterference::_Compute(
+		SchedulerPolicyIF::EvalEntity_t const & evl_ent,
+		float & ctrib) {
+	InterferenceModel & im(InterferenceModel::GetInstance());
+	ApplicationManager & am(ApplicationManager::GetInstance());
+	br::AppUsageQtyMap_t apps_map;
+	std::set<AppUid_t> co_apps;
+	ctrib = 1.0;
+
+	// No profile, or no pressure, for the candidate AWM
+	float pressure = im.GetPressure(evl_ent.papp, evl_ent.pawm->Id());
+	if (pressure <= 0)
+		return SC_SUCCESS;
+
+	// The EXCs already scheduled into the processing elements of the domain
+	for (auto const & ru_entry:
+			*((evl_ent.pawm->GetSchedResourceBinding(evl_ent.bind_refn)).get())) {
+		ResourcePathPtr_t const & r_path(ru_entry.first);
+		if (r_path->Type() != br::ResourceType::PROC_ELEMENT)
+			continue;
+		for (auto & rsrc: sv->GetResources(r_path)) {
+			rsrc->Applications(apps_map, status_view);
+			for (auto const & app_entry: apps_map)
+				co_apps.insert(app_entry.first);
+		}
+	}
+	co_apps.erase(evl_ent.papp->Uid());
+
+	// Sum of the pressures of the co-located EXCs
+	float co_pressure = 0.0;
+	for (AppUid_t app_uid: co_apps) {
+		AppPtr_t const co_papp(am.GetApplication(app_uid));
+		if (!co_papp)
+			continue;
+		ba::AwmPtr_t co_awm(co_papp->NextAWM());
+		if (!co_awm)
+			co_awm = co_papp->CurrentAWM();
+		if (!co_awm)
+			continue;
+		float co_app_pressure = im.GetPressure(co_papp, co_awm->Id());
+		if (co_app_pressure > 0)
+			co_pressure += co_app_pressure;
+	}
+
+	ctrib = 1.0 - penalty * std::min<float>(pressure * co_pressure, 1.0);
+	logger->Debug("%s: pressure=%.2f co-located=%d (pressure=%.2f) index=%.4f",
+			evl_ent.StrId(), pressure, co_apps.size(), co_pressure, ctrib);
+	return SC_SUCCESS;
+}
+
+} // namespace plugins
+
+} // namespace bbque
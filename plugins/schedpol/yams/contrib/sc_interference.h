@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_SC_INTERFERENCE_
+#define BBQUE_SC_INTERFERENCE_
+
+#include "sched_contrib.h"
+
+#define SC_INTF_DEFAULT_PENALTY     50
+
+namespace bbque { namespace plugins {
+
+
+class SCInterference: public SchedContrib {
+
+public:
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @see SchedContrib
+	 */
+	SCInterference(
+		const char * _name,
+		BindingInfo_t const & _bd_info,
+		uint16_t const cfg_params[]);
+
+	~SCInterference();
+
+	ExitCode_t Init(void * params);
+
+private:
+
+	/**
+	 * Penalty of placing two memory-bound AWMs into the same binding domain.
+	 * This stores the value parsed from the configuration file.
+	 */
+	uint16_t penalty_int;
+
+	/** Penalty index */
+	float penalty;
+
+	/**
+	 * @brief Compute the "Interference" contribution
+	 *
+	 * The pressure of the candidate AWM on the shared cache and memory
+	 * (@see InterferenceModel) is multiplied by the sum of the pressures of
+	 * the EXCs already scheduled into the same binding domain, i.e., the
+	 * same LLC and NUMA node. The index decreases with the expected
+	 * contention, while it is 1 if no profile is available.
+	 *
+	 * @param evl_ent The scheduling entity to evaluate
+	 * @ctrib ctrib The contribute index to return
+	 *
+	 * @return SC_SUCCESS. No error conditions expected.
+	 */
+	ExitCode_t _Compute(
+			SchedulerPolicyIF::EvalEntity_t const & evl_ent,
+			float & ctrib);
+
+};
+
+} // plugins
+
+} // bbque
+
+#endif // BBQUE_SC_INTERFERENCE_
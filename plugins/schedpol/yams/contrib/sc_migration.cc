@@ -17,6 +17,8 @@
 
 #include "sc_migration.h"
 
+#include "bbque/reconfig_cost_model.h"
+
 namespace bbque { namespace plugins {
 
 
@@ -43,14 +45,34 @@ SCMigration::_Compute(
 	br::ResourceBitset r_mask;
 	br::ResourceType r_type = bd_info.base_path->Type();
 
-	// Migraton => index := 0
+	// Migraton => index := 0, or the complement of the measured cost, if
+	// worth the expected gain
 	if (evl_ent.IsMigrating(r_type)) {
-		r_mask = evl_ent.papp->CurrentAWM()->BindingSet(r_type);
+		ba::AwmPtr_t const & curr_awm(evl_ent.papp->CurrentAWM());
+		r_mask = curr_awm->BindingSet(r_type);
 		logger->Debug("%s: is migrating to %s{%s}",
 				evl_ent.StrId(),
 				br::GetResourceTypeString(r_type),
 				r_mask.ToStringCG().c_str());
-		ctrib = 0.0;
+		float cost = ReconfigCostModel::GetInstance().GetNormalCost(
+			evl_ent.papp, curr_awm->Id(), evl_ent.pawm->Id());
+		if (cost < 0) {
+			ctrib = 0.0;
+			return SC_SUCCESS;
+		}
+
+		// Gain: the destination less loaded than the current domains
+		float curr_share = 0.0;
+		for (BBQUE_RID_TYPE bd_id = r_mask.FirstSet(); bd_id >= 0;
+				bd_id = r_mask.NextSet(bd_id))
+			curr_share += AvailableShare(bd_id);
+		if (r_mask.Count() > 0)
+			curr_share /= r_mask.Count();
+		float gain = AvailableShare(evl_ent.bind_id) - curr_share;
+
+		ctrib = (gain > cost) ? 1.0 - cost : 0.0;
+		logger->Debug("%s: measured cost=%.3f gain=%.3f",
+				evl_ent.StrId(), cost, gain);
 		return SC_SUCCESS;
 	}
 
@@ -59,6 +81,16 @@ SCMigration::_Compute(
 	return SC_SUCCESS;
 }
 
+float SCMigration::AvailableShare(BBQUE_RID_TYPE bd_id) const {
+	std::string pe_path(
+		bd_info.base_path->ToString() + std::to_string(bd_id) + ".pe");
+	uint64_t total = sv->ResourceTotal(pe_path);
+	if (total == 0)
+		return 0.0;
+	return static_cast<float>(sv->ResourceAvailable(pe_path, status_view)) /
+		total;
+}
+
 } // namespace plugins
 
 } // namespace bbque
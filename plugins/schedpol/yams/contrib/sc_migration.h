@@ -48,7 +48,10 @@ private:
 	 *
 	 * Current implementation simply returns 1 if the binding specified in the
 	 * evaluation entity does not lead to a migration of the application.
-	 * Conversely, an index value equal to 0 is returned.
+	 * Conversely, the measured cost of the transition is weighed against
+	 * the expected gain, i.e., how much the destination binding domain is
+	 * less loaded than the current one: the index is the complement of the
+	 * cost if the gain exceeds it, 0 otherwise (or if the cost is unknown).
 	 *
 	 * @param evl_ent The scheduling entity to evaluate
 	 * @ctrib ctrib The contribute index to return
@@ -59,6 +62,12 @@ private:
 			SchedulerPolicyIF::EvalEntity_t const & evl_ent,
 			float & ctrib);
 
+	/**
+	 * @brief The share of processing elements available in a binding
+	 * domain, in the scheduling resource state view
+	 */
+	float AvailableShare(BBQUE_RID_TYPE bd_id) const;
+
 };
 
 } // plugins
@@ -17,6 +17,8 @@
 
 #include "sc_reconfig.h"
 
+#include "bbque/reconfig_cost_model.h"
+
 namespace br = bbque::res;
 namespace po = boost::program_options;
 
@@ -49,6 +51,20 @@ SCReconfig::_Compute(
 		return SC_SUCCESS;
 	}
 
+	// Measured cost of the transition: not worth if exceeding the gain
+	ba::AwmPtr_t const & curr_awm(evl_ent.papp->CurrentAWM());
+	if (curr_awm) {
+		float cost = ReconfigCostModel::GetInstance().GetNormalCost(
+			evl_ent.papp, curr_awm->Id(), evl_ent.pawm->Id());
+		if (cost >= 0) {
+			float gain = evl_ent.pawm->Value() - curr_awm->Value();
+			ctrib = ((gain > 0) && (cost > gain)) ? 0.0 : 1.0 - cost;
+			logger->Debug("%s: measured cost=%.3f gain=%.3f",
+				evl_ent.StrId(), cost, gain);
+			return SC_SUCCESS;
+		}
+	}
+
 	// Configuration time available
 	if (evl_ent.pawm->ConfigTime() >= 0) {
 		ctrib = 1.0 - evl_ent.pawm->ConfigTime();
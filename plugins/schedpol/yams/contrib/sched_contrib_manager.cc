@@ -29,6 +29,7 @@
 // Binding dependent
 #include "sc_congestion.h"
 #include "sc_migration.h"
+#include "sc_interference.h"
 // ...:: ADD_SC ::...
 
 namespace bu = bbque::utils;
@@ -49,6 +50,7 @@ char const * SchedContribManager::sc_str[SC_COUNT] = {
 	"fairness",
 	"migration",
 	"congestio",
+	"interfer",
 	//"power",
 	//"thermal",
 	//"stability",
@@ -111,6 +113,10 @@ SchedContribManager::SchedContribManager(
 			sc_objs_reqs[MIGRATION] =
 				SchedContribManager::sc_objs[MIGRATION];
 			break;
+		case INTERFERENCE:
+			sc_objs_reqs[INTERFERENCE] =
+				SchedContribManager::sc_objs[INTERFERENCE];
+			break;
 		default:
 			logger->Error("Scheduling contribution unknown: %d", sc_types[i]);
 		}
@@ -302,6 +308,8 @@ void SchedContribManager::AllocateContribs() {
 			new SCFairness(sc_str[FAIRNESS], bd_info, sc_cfg_params));
 	sc_objs[MIGRATION] = SchedContribPtr_t(
 			new SCMigration(sc_str[MIGRATION], bd_info, sc_cfg_params));
+	sc_objs[INTERFERENCE] = SchedContribPtr_t(
+			new SCInterference(sc_str[INTERFERENCE], bd_info, sc_cfg_params));
 	// ...:: ADD_SC ::...
 }
 
@@ -64,6 +64,7 @@ public:
 		FAIRNESS,
 		MIGRATION,
 		CONGESTION,
+		INTERFERENCE,
 		//POWER,
 		//THERMAL,
 		//STABILITY,
@@ -17,14 +17,17 @@
 
 #include "yams_schedpol.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <cstdint>
 #include <iostream>
+#include <iterator>
 #include <functional>
 #include "bbque/cpp11/thread.h"
 #include "bbque/modules_factory.h"
 #include "bbque/app/working_mode.h"
+#include "bbque/res/binder.h"
 #include "bbque/utils/logging/logger.h"
 #include "contrib/sched_contrib_manager.h"
 #include "bbque/utils/extra_data_container.h"
@@ -40,7 +43,8 @@ SchedContribManager::Type_t YamsSchedPol::sc_types[] = {
 	SchedContribManager::FAIRNESS,
 	SchedContribManager::MIGRATION,
 #ifndef CONFIG_BBQUE_SP_COWS_BINDING
-	SchedContribManager::CONGESTION
+	SchedContribManager::CONGESTION,
+	SchedContribManager::INTERFERENCE
 #endif
 };
 
@@ -89,6 +93,8 @@ YamsSchedPol::coll_mct_metrics[YAMS_SC_COUNT] = {
 #ifndef CONFIG_BBQUE_SP_COWS_BINDING
 	YAMS_SAMPLE_METRIC("cgst.comp",
 			"Congestion contribution computing time [ms]"),
+	YAMS_SAMPLE_METRIC("intf.comp",
+			"Interference contribution computing time [ms]"),
 #endif
 	// ...:: ADD_MCT ::...
 };
@@ -263,11 +269,17 @@ YamsSchedPol::Schedule(System & sys_if, br::RViewToken_t & rav) {
 	if (result != YAMS_SUCCESS)
 		goto error;
 
-	// Schedule per priority
+	// The greedy baseline first (only needed for a bounded run), then the
+	// schedule per priority, completing greedily once out of time budget
+	if (budget_ms > 0)
+		ComputeBaseline();
 	for (AppPrio_t prio = 0; prio <= sv->ApplicationLowestPriority(); ++prio) {
 		if (!sv->HasApplications(prio))
 			continue;
-		SchedulePrioQueue(prio);
+		if (!BudgetExpired())
+			SchedulePrioQueue(prio);
+		if (BudgetExpired())
+			ScheduleGreedy(prio);
 	}
 	// Set the new resource state view token
 	rav = status_view;
@@ -288,6 +300,7 @@ error:
 
 inline void YamsSchedPol::Clear() {
 	entities.clear();
+	baseline.clear();
 }
 
 void YamsSchedPol::SchedulePrioQueue(AppPrio_t prio) {
@@ -325,6 +338,144 @@ do_schedule:
 	YAMS_GET_TIMING(coll_metrics, YAMS_SELECTING_TIME, yams_tmr);
 }
 
+void YamsSchedPol::ComputeBaseline() {
+	char token_path[40];
+	br::RViewToken_t baseline_view;
+	baseline.clear();
+
+	// A private view, released once the baseline is known
+	snprintf(token_path, 40, "%s.baseline%d", MODULE_NAMESPACE,
+			status_view_count);
+	if (ra.GetView(token_path, baseline_view)
+			!= ResourceAccounterStatusIF::RA_SUCCESS) {
+		logger->Warn("Baseline: cannot get a resource state view");
+		return;
+	}
+
+	for (AppPrio_t prio = 0; prio <= sv->ApplicationLowestPriority(); ++prio) {
+		AppsUidMapIt app_it;
+		ba::AppCPtr_t papp = sv->GetFirstWithPrio(prio, app_it);
+		for (; papp; papp = sv->GetNextWithPrio(prio, app_it)) {
+			if (CheckSkipConditions(papp))
+				continue;
+			GreedyChoice_t choice;
+			bool found = FindGreedyChoice(papp,
+				[&](GreedyChoice_t const & candidate) {
+					return ra.BookResources(papp, candidate.binding,
+						baseline_view) == ResourceAccounterStatusIF::RA_SUCCESS;
+				}, choice);
+			if (found)
+				baseline.emplace(papp->Uid(), choice);
+		}
+	}
+
+	ra.PutView(baseline_view);
+	logger->Debug("Baseline: %d applications assigned", baseline.size());
+}
+
+void YamsSchedPol::ScheduleGreedy(AppPrio_t prio) {
+	AppsUidMapIt app_it;
+	ba::AppCPtr_t papp = sv->GetFirstWithPrio(prio, app_it);
+	for (; papp; papp = sv->GetNextWithPrio(prio, app_it)) {
+		if (CheckSkipConditions(papp))
+			continue;
+		if (!ScheduleGreedy(papp))
+			logger->Debug("Greedy: [%s] no feasible AWM", papp->StrId());
+	}
+}
+
+bool YamsSchedPol::ScheduleGreedy(ba::AppCPtr_t const & papp) {
+	// The baseline choice, unless the resources have been taken by the
+	// applications scheduled in the meanwhile
+	auto base_it = baseline.find(papp->Uid());
+	if ((base_it != baseline.end()) && ScheduleChoice(papp, base_it->second))
+		return true;
+
+	GreedyChoice_t choice;
+	return FindGreedyChoice(papp,
+		[&](GreedyChoice_t const & candidate) {
+			return ScheduleChoice(papp, candidate);
+		}, choice);
+}
+
+bool YamsSchedPol::ScheduleChoice(ba::AppCPtr_t const & papp,
+		GreedyChoice_t const & choice) {
+	int32_t b_refn = choice.pawm->RestoreBinding(choice.binding);
+	if ((b_refn < 0) ||
+			(papp->ScheduleRequest(choice.pawm, status_view, b_refn)
+			 != ApplicationStatusIF::APP_SUCCESS))
+		return false;
+	logger->Notice("Greedy: [%s] AWM{%d} SCHEDULED [%d]",
+			papp->StrId(), choice.pawm->Id(), b_refn);
+	return true;
+}
+
+bool YamsSchedPol::FindGreedyChoice(ba::AppCPtr_t const & papp,
+		std::function<bool(GreedyChoice_t const &)> accept,
+		GreedyChoice_t & choice) {
+	BindingMap_t & bindings(bdm.GetBindingOptions());
+
+	// The current AWM first (no reconfiguration), then the cheapest ones
+	ba::AwmPtrList_t awms(papp->WorkingModes());
+	awms.sort([](ba::AwmPtr_t const & a, ba::AwmPtr_t const & b) {
+			return a->Value() < b->Value();
+		});
+	if (papp->CurrentAWM()) {
+		awms.remove(papp->CurrentAWM());
+		awms.push_front(papp->CurrentAWM());
+	}
+
+	size_t attempts = 1;
+	for (auto const & bd_entry: bindings)
+		attempts = std::max(attempts, bd_entry.second->ids.size());
+
+	for (ba::AwmPtr_t const & pawm: awms) {
+		// The k-th binding option of each domain requested
+		for (size_t k = 0; k < attempts; ++k) {
+			choice.pawm    = pawm;
+			choice.binding = GreedyBinding(pawm, k);
+			if (choice.binding && accept(choice))
+				return true;
+		}
+	}
+
+	return false;
+}
+
+br::ResourceAssignmentMapPtr_t YamsSchedPol::GreedyBinding(
+		ba::AwmPtr_t const & pawm,
+		size_t k) {
+	BindingMap_t & bindings(bdm.GetBindingOptions());
+	br::ResourceAssignmentMapPtr_t binding;
+
+	for (auto const & bd_entry: bindings) {
+		BindingInfo_t const & bd_info(*(bd_entry.second));
+		if (bd_info.ids.empty() || (ra.GetAssignedAmount(
+				pawm->ResourceRequests(),
+				br::ResourceType::PROC_ELEMENT,
+				bd_entry.first) == 0))
+			continue;
+		auto id_it = bd_info.ids.begin();
+		std::advance(id_it, k % bd_info.ids.size());
+
+		// No processing elements left there
+		if (bd_info.full.Test(*id_it))
+			return nullptr;
+
+		auto out_map = binding ?
+			std::make_shared<br::ResourceAssignmentMap_t>(*binding):
+			std::make_shared<br::ResourceAssignmentMap_t>();
+		br::ResourceBinder::Bind(
+			binding ? *binding : pawm->ResourceRequests(),
+			bd_entry.first, R_ID_ANY, *id_it, out_map);
+		if (out_map->empty())
+			return nullptr;
+		binding = out_map;
+	}
+
+	return binding;
+}
+
 uint8_t YamsSchedPol::OrderSchedEntities(AppPrio_t prio) {
 	uint8_t naps_count = 0;
 	AppsUidMapIt app_it;
@@ -337,6 +488,13 @@ uint8_t YamsSchedPol::OrderSchedEntities(AppPrio_t prio) {
 		if (CheckSkipConditions(papp))
 			continue;
 
+		// Out of time: select among the entities evaluated so far
+		if (BudgetExpired()) {
+			logger->Warn("Ordering: time budget (%d ms) expired",
+					budget_ms);
+			break;
+		}
+
 		// Compute the metrics for each AWM [and binding option]
 		InsertWorkingModes(papp);
 
@@ -19,6 +19,7 @@
 #define BBQUE_YAMS_SCHEDPOL_H_
 
 #include <cstdint>
+#include <functional>
 
 #include "bbque/binding_manager.h"
 #include "bbque/configuration_manager.h"
@@ -55,7 +56,7 @@
 
 #define YAMS_AWM_SC_COUNT 3
 #ifndef CONFIG_BBQUE_SP_COWS_BINDING
-	#define YAMS_BD_SC_COUNT  2
+	#define YAMS_BD_SC_COUNT  3
 #else
 	#define YAMS_BD_SC_COUNT  1
 #endif
@@ -222,6 +223,17 @@ private:
 	/** List of entities to schedule */
 	SchedEntityList_t entities;
 
+	/**
+	 * @brief The greedy baseline assignment of an application
+	 */
+	struct GreedyChoice_t {
+		ba::AwmPtr_t pawm;
+		br::ResourceAssignmentMapPtr_t binding;
+	};
+
+	/** The greedy baseline, computed before the metrics-driven schedule */
+	std::map<AppUid_t, GreedyChoice_t> baseline;
+
 
 	/** Set of scheduling contributions type used for the metrics */
 	static SchedContribManager::Type_t sc_types[YAMS_SC_COUNT];
@@ -351,6 +363,67 @@ private:
 	 */
 	void SchedulePrioQueue(AppPrio_t prio);
 
+	/**
+	 * @brief Compute the greedy baseline assignment
+	 *
+	 * Before any metrics is computed, each application is assigned the
+	 * first feasible AWM, trying the current one first and then the
+	 * others by increasing value, into a private resource state view.
+	 * The baseline is then available whenever the time budget expires.
+	 * Unbounded runs (no time budget) skip it.
+	 */
+	void ComputeBaseline();
+
+	/**
+	 * @brief Greedy scheduling of the applications of a priority queue
+	 *
+	 * Once the time budget has expired, the applications not scheduled
+	 * yet are assigned their baseline choice or, if it does not fit
+	 * anymore, the first feasible AWM.
+	 *
+	 * @param prio The priority applications queue to schedule
+	 */
+	void ScheduleGreedy(AppPrio_t prio);
+
+	/**
+	 * @brief Greedy scheduling of an application
+	 *
+	 * @return true if an AWM has been assigned
+	 */
+	bool ScheduleGreedy(ba::AppCPtr_t const & papp);
+
+	/**
+	 * @brief The first feasible AWM of an application, in the greedy order
+	 *
+	 * @param papp The application
+	 * @param accept Whether a candidate choice is feasible (booking it)
+	 * @param choice The AWM and binding selected
+	 *
+	 * @return true if a feasible AWM has been found
+	 */
+	bool FindGreedyChoice(ba::AppCPtr_t const & papp,
+			std::function<bool(GreedyChoice_t const &)> accept,
+			GreedyChoice_t & choice);
+
+	/**
+	 * @brief Send the schedule request of a greedy choice
+	 *
+	 * @return true if the request has been accepted
+	 */
+	bool ScheduleChoice(ba::AppCPtr_t const & papp,
+			GreedyChoice_t const & choice);
+
+	/**
+	 * @brief Bind an AWM to the k-th option of each binding domain, skipping
+	 * the options already known to be full
+	 *
+	 * The AWM scheduling bindings are not modified.
+	 *
+	 * @return The binding, or nullptr if not feasible
+	 */
+	br::ResourceAssignmentMapPtr_t GreedyBinding(ba::AwmPtr_t const & pawm,
+			size_t k);
+
 	/**
 	 * @brief Order the scheduling entities per metrics value
 	 *
@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "deps_syncpol.h"
+
+#include "bbque/synchronization_manager.h"
+#include "bbque/modules_factory.h"
+#include "bbque/system.h"
+#include "bbque/app/working_mode.h"
+#include "bbque/utils/utility.h"
+
+/** Metrics (class COUNTER) declaration */
+#define SM_COUNTER_METRIC(NAME, DESC)\
+ {SYNCHRONIZATION_MANAGER_NAMESPACE "." SYNCHRONIZATION_POLICY_NAME "." NAME,\
+	 DESC, MetricsCollector::COUNTER, 0, NULL, 0}
+/** Increase counter for the specified metric */
+#define SM_COUNT_EVENT(METRICS, INDEX) \
+	mc.Count(METRICS[INDEX].mh);
+
+/** Metrics (class SAMPLE) declaration */
+#define SM_SAMPLE_METRIC(NAME, DESC)\
+ {SYNCHRONIZATION_MANAGER_NAMESPACE "." SYNCHRONIZATION_POLICY_NAME "." NAME,\
+	 DESC, MetricsCollector::SAMPLE, 0, NULL, 0}
+/** Acquire a new (generic) sample */
+#define SM_ADD_SAMPLE(METRICS, INDEX, VALUE) \
+	mc.AddSample(METRICS[INDEX].mh, VALUE);
+/** Reset the timer used to evaluate metrics */
+#define SM_START_TIMER(TIMER) \
+	TIMER.start();
+/** Acquire a new completion time sample */
+#define SM_GET_TIMING(METRICS, INDEX, TIMER) \
+	if (TIMER.Running()) {\
+		mc.AddSample(METRICS[INDEX].mh, TIMER.getElapsedTimeMs());\
+		TIMER.stop();\
+	}
+
+namespace bu = bbque::utils;
+
+namespace bbque { namespace plugins {
+
+/* Definition of metrics used by this module */
+MetricsCollector::MetricsCollection_t
+DepsSyncPol::metrics[SM_METRICS_COUNT] = {
+	//----- Event counting metrics
+	SM_COUNTER_METRIC("runs",   "DEPS SyncP executions count"),
+	SM_COUNTER_METRIC("cycles", "Circular dependencies count"),
+	//----- Sampling statistics
+	SM_SAMPLE_METRIC("rounds",  "Sync rounds per SyncP"),
+	SM_SAMPLE_METRIC("excs",    "EXCs synched per round"),
+	//----- Timing metrics
+	SM_SAMPLE_METRIC("graph",   "Dependency graph building t[ms]"),
+	SM_SAMPLE_METRIC("round",   "Sync round t[ms]"),
+	SM_SAMPLE_METRIC("span",    "Sync makespan t[ms]"),
+};
+
+DepsSyncPol::DepsSyncPol() :
+	mc(bu::MetricsCollector::GetInstance()) {
+
+	// Get a logger
+	logger = bu::Logger::GetLogger(MODULE_NAMESPACE);
+	assert(logger);
+
+	//---------- Setup all the module metrics
+	mc.Register(metrics, SM_METRICS_COUNT);
+
+	logger->Debug("Built DEPS SyncPol object @%p", (void*)this);
+}
+
+DepsSyncPol::~DepsSyncPol() {
+}
+
+//----- Synchronization policy module interface
+
+char const *DepsSyncPol::Name() {
+	return SYNCHRONIZATION_POLICY_NAME;
+}
+
+void DepsSyncPol::CollectDependencies(
+		bbque::System & sv, std::vector<ExcDeps_t> & excs) {
+	AppsUidMapIt apps_it;
+	ba::AppCPtr_t papp;
+
+	for (uint8_t state = ApplicationStatusIF::STARTING;
+			state < ApplicationStatusIF::SYNC_STATE_COUNT; ++state) {
+		auto sync_state = static_cast<ApplicationStatusIF::SyncState_t>(state);
+
+		papp = sv.GetFirstInSync(sync_state, apps_it);
+		for ( ; papp; papp = sv.GetNextInSync(sync_state, apps_it)) {
+			auto const & curr_awm(papp->CurrentAWM());
+			auto const & next_awm(papp->NextAWM());
+			br::ResourceBitset curr_pes;
+			br::ResourceBitset next_pes;
+
+			// A starting EXC has nothing to release, while a blocked one
+			// has nothing to acquire. If the AWM does not change, its
+			// binding has been updated and the previous one is the current.
+			if (curr_awm && (sync_state != ApplicationStatusIF::STARTING)) {
+				if (curr_awm == next_awm)
+					curr_pes = curr_awm->BindingSetPrev(
+						br::ResourceType::PROC_ELEMENT);
+				else
+					curr_pes = curr_awm->BindingSet(
+						br::ResourceType::PROC_ELEMENT);
+			}
+			if (next_awm && (sync_state != ApplicationStatusIF::BLOCKED))
+				next_pes = next_awm->BindingSet(
+					br::ResourceType::PROC_ELEMENT);
+
+			ExcDeps_t exc_deps;
+			exc_deps.uid        = papp->Uid();
+			exc_deps.sync_state = sync_state;
+			exc_deps.released   = curr_pes;
+			exc_deps.released  -= next_pes;
+			exc_deps.acquired   = next_pes;
+			exc_deps.acquired  -= curr_pes;
+
+			logger->Debug("Deps: [%s] %s, releasing {%s}, acquiring {%s}",
+				papp->StrId(),
+				ApplicationStatusIF::SyncStateStr(sync_state),
+				exc_deps.released.ToStringCG().c_str(),
+				exc_deps.acquired.ToStringCG().c_str());
+			excs.push_back(exc_deps);
+		}
+	}
+}
+
+void DepsSyncPol::BuildRounds(std::vector<ExcDeps_t> const & excs) {
+	size_t nr_excs = excs.size();
+	std::vector<std::vector<size_t>> dependants(nr_excs);
+	std::vector<uint16_t> nr_deps(nr_excs, 0);
+	std::vector<bool> served(nr_excs, false);
+	std::vector<size_t> ready;
+	size_t nr_served = 0;
+
+	// Build the graph: 'a' depends on 'b' if acquiring what 'b' releases
+	for (size_t a = 0; a < nr_excs; ++a) {
+		if (excs[a].acquired.None())
+			continue;
+		for (size_t b = 0; b < nr_excs; ++b) {
+			if ((a == b) || !excs[a].acquired.Intersects(excs[b].released))
+				continue;
+			dependants[b].push_back(a);
+			++nr_deps[a];
+		}
+	}
+
+	// Each round includes the EXCs whose dependencies are all served
+	while (nr_served < nr_excs) {
+		ready.clear();
+		for (size_t i = 0; i < nr_excs; ++i) {
+			if (!served[i] && (nr_deps[i] == 0))
+				ready.push_back(i);
+		}
+
+		// Circular dependencies: sync all the remaining EXCs together
+		if (ready.empty()) {
+			logger->Warn("Deps: circular dependencies among %lu EXCs",
+					nr_excs - nr_served);
+			SM_COUNT_EVENT(metrics, SM_DEPS_CYCLES);
+			for (size_t i = 0; i < nr_excs; ++i) {
+				if (!served[i])
+					ready.push_back(i);
+			}
+		}
+
+		for (size_t i: ready) {
+			apps_round[excs[i].uid] = rounds.size();
+			served[i] = true;
+			for (size_t d: dependants[i])
+				--nr_deps[d];
+		}
+		nr_served += ready.size();
+
+		logger->Debug("Deps: round [%lu] including %lu EXCs",
+				rounds.size(), ready.size());
+		SM_ADD_SAMPLE(metrics, SM_DEPS_EXCS, ready.size());
+		rounds.push_back(excs[ready.front()].sync_state);
+	}
+}
+
+ApplicationStatusIF::SyncState_t DepsSyncPol::GetApplicationsQueue(
+			bbque::System & sv, bool restart) {
+
+	// Get timings for previously synched round
+	SM_GET_TIMING(metrics, SM_DEPS_TIME_ROUND, sm_tmr);
+
+	// Resetting the maximum latency since a new round is going to be served,
+	// thus a new SyncP is going to start
+	max_latency = 0;
+
+	if (restart) {
+		std::vector<ExcDeps_t> excs;
+		logger->Debug("Resetting sync status");
+		// Account for Policy runs
+		SM_COUNT_EVENT(metrics, SM_DEPS_RUNS);
+		SM_START_TIMER(makespan_tmr);
+
+		// Split the EXCs to synchronize in dependency-ordered rounds
+		SM_START_TIMER(sm_tmr);
+		apps_round.clear();
+		rounds.clear();
+		curr_round = 0;
+		CollectDependencies(sv, excs);
+		BuildRounds(excs);
+		SM_GET_TIMING(metrics, SM_DEPS_TIME_GRAPH, sm_tmr);
+
+		logger->Info("Deps: %lu EXCs to synchronize in %lu rounds",
+				excs.size(), rounds.size());
+		SM_ADD_SAMPLE(metrics, SM_DEPS_ROUNDS, rounds.size());
+	}
+	else {
+		++curr_round;
+	}
+
+	if (curr_round >= rounds.size()) {
+		SM_GET_TIMING(metrics, SM_DEPS_TIME_MAKESPAN, makespan_tmr);
+		return ApplicationStatusIF::SYNC_NONE;
+	}
+
+	logger->Debug("Deps: serving round [%d/%lu]",
+			curr_round + 1, rounds.size());
+	SM_START_TIMER(sm_tmr);
+	return rounds[curr_round];
+}
+
+bool DepsSyncPol::DoSync(AppPtr_t papp) {
+	bool reconf;
+
+	// EXCs missing in the graph are synched in the last round
+	auto const round_it(apps_round.find(papp->Uid()));
+	if (round_it == apps_round.end())
+		reconf = (curr_round == rounds.size() - 1);
+	else
+		reconf = (round_it->second == curr_round);
+
+	logger->Debug("Checking [%s] @ round [%d]: sync_state [%d] => %s",
+			papp->StrId(),
+			curr_round,
+			papp->SyncState(),
+			reconf ? "SYNC" : "SKIP");
+
+	return reconf;
+}
+
+DepsSyncPol::ExitCode_t
+DepsSyncPol::CheckLatency(AppPtr_t papp, SyncLatency_t latency) {
+	UNUSED(papp);
+
+	// All the EXCs of a round are synched together, thus the worst case
+	// latency among them is the one to wait for
+	if (max_latency < latency)
+		max_latency = latency;
+
+	return SYNCP_OK;
+}
+
+DepsSyncPol::SyncLatency_t
+DepsSyncPol::EstimatedSyncTime() {
+	return max_latency;
+}
+
+
+//----- static plugin interface
+
+void * DepsSyncPol::Create(PF_ObjectParams *) {
+	return new DepsSyncPol();
+}
+
+int32_t DepsSyncPol::Destroy(void * plugin) {
+  if (!plugin)
+    return -1;
+  delete (DepsSyncPol *)plugin;
+  return 0;
+}
+
+} // namesapce plugins
+
+} // namespace bbque
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BBQUE_DEPS_SYNCPOL_H_
+#define BBQUE_DEPS_SYNCPOL_H_
+
+#include "bbque/plugins/synchronization_policy.h"
+#include "bbque/utils/logging/logger.h"
+#include "bbque/plugins/plugin.h"
+
+#include "bbque/res/bitset.h"
+#include "bbque/utils/timer.h"
+#include "bbque/utils/metrics_collector.h"
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#define SYNCHRONIZATION_POLICY_NAME "deps"
+#define MODULE_NAMESPACE \
+	SYNCHRONIZATION_POLICY_NAMESPACE "." SYNCHRONIZATION_POLICY_NAME
+
+namespace ba = bbque::app;
+namespace bu = bbque::utils;
+namespace br = bbque::res;
+
+using bbque::utils::Timer;
+using bbque::utils::MetricsCollector;
+
+// These are the parameters received by the PluginManager on create calls
+struct PF_ObjectParams;
+
+namespace bbque { namespace plugins {
+
+/**
+ * @class DepsSyncPol
+ * @brief A dynamic C++ plugin which synchronizes the EXCs according to the
+ * dependencies among the resources they release and acquire.
+ *
+ * At the beginning of each synchronization, the processing elements released
+ * and acquired by each EXC are derived from its current and next AWM
+ * bindings. An EXC acquiring a processing element depends on the EXCs
+ * releasing it, thus it must be synchronized in a later round. The
+ * dependency graph is then split in levels (rounds), where each round
+ * includes all the EXCs whose dependencies have been already synchronized,
+ * whatever their synchronization state.
+ * Independent EXCs are thus synchronized concurrently, in as few protocol
+ * rounds as the graph allows.
+ */
+class DepsSyncPol : public SynchronizationPolicyIF {
+
+public:
+
+//----- static plugin interface
+
+	/**
+	 *
+	 */
+	static void * Create(PF_ObjectParams *);
+
+	/**
+	 *
+	 */
+	static int32_t Destroy(void *);
+
+	virtual ~DepsSyncPol();
+
+//----- Synchronization Policy module interface
+
+	char const * Name();
+
+	ApplicationStatusIF::SyncState_t GetApplicationsQueue(
+			bbque::System & system, bool restart = false);
+
+	bool DoSync(AppPtr_t papp);
+
+	ExitCode_t CheckLatency(AppPtr_t papp, SyncLatency_t latency);
+
+	SyncLatency_t EstimatedSyncTime();
+
+	bool MultiStateRounds() {
+		return true;
+	}
+
+private:
+
+	/**
+	 * @brief The resources exchanged by an EXC in the synchronization
+	 */
+	typedef struct ExcDeps {
+		/** The EXC unique identifier */
+		AppUid_t uid;
+		/** The synchronization state of the EXC */
+		ApplicationStatusIF::SyncState_t sync_state;
+		/** The processing elements no longer assigned */
+		br::ResourceBitset released;
+		/** The processing elements newly assigned */
+		br::ResourceBitset acquired;
+	} ExcDeps_t;
+
+	/**
+	 * @brief System logger instance
+	 */
+	std::unique_ptr<bu::Logger> logger;
+
+	/**
+	 * @brief The synchronization round of each EXC
+	 */
+	std::map<AppUid_t, uint16_t> apps_round;
+
+	/**
+	 * @brief The (representative) synchronization state of each round
+	 */
+	std::vector<ApplicationStatusIF::SyncState_t> rounds;
+
+	/**
+	 * @brief The round currently served
+	 */
+	uint16_t curr_round = 0;
+
+	/**
+	 * @brief Keep track of the best estimation for the sync latency
+	 */
+	SyncLatency_t max_latency = 0;
+
+	/** The metrics collector */
+	MetricsCollector & mc;
+
+	/** The set of metrics collected by this plugin */
+	typedef enum SyncPolMetrics {
+		//----- Event counting metrics
+		SM_DEPS_RUNS = 0,
+		SM_DEPS_CYCLES,
+		//----- Sampling statistics
+		SM_DEPS_ROUNDS,
+		SM_DEPS_EXCS,
+		//----- Timing metrics
+		SM_DEPS_TIME_GRAPH,
+		SM_DEPS_TIME_ROUND,
+		SM_DEPS_TIME_MAKESPAN,
+
+		SM_METRICS_COUNT
+	} SyncMgrMetrics_t;
+
+	/** The High-Resolution timer used for profiling the rounds */
+	Timer sm_tmr;
+
+	/** The High-Resolution timer used for profiling the whole sync */
+	Timer makespan_tmr;
+
+	/** The collection of metrics used by this plugin */
+	static MetricsCollector::MetricsCollection_t metrics[SM_METRICS_COUNT];
+
+	/**
+	 * @brief   The plugins constructor
+	 * Plugins objects could be build only by using the "create" method.
+	 * Usually the PluginManager acts as object
+	 * @param
+	 * @return
+	 */
+	DepsSyncPol();
+
+	/**
+	 * @brief Collect the resources released and acquired by the EXCs
+	 * requiring a synchronization
+	 */
+	void CollectDependencies(bbque::System & sv, std::vector<ExcDeps_t> & excs);
+
+	/**
+	 * @brief Split the dependency graph in synchronization rounds
+	 *
+	 * Each round includes the EXCs not acquiring any resource released by
+	 * an EXC not yet synchronized. Circular dependencies, which cannot be
+	 * resolved, are broken by synchronizing the remaining EXCs all together
+	 * in a final round.
+	 */
+	void BuildRounds(std::vector<ExcDeps_t> const & excs);
+
+};
+
+} // namespace plugins
+
+} // namespace bbque
+
+#endif // BBQUE_DEPS_SYNCPOL_H_
@@ -309,6 +309,12 @@ RTLIB_ExitCode_t BbqueEXC::GetAssignedResources(
 										  array_size);
 }
 
+RTLIB_ExitCode_t BbqueEXC::GetAllocation(
+	RTLIB_Allocation_t & allocation)
+{
+	return rtlib->Utils.GetAllocation(exc_handler, &allocation);
+}
+
 /*******************************************************************************
  *    Cycles Per Second (CPS) and Jobs Per Second (JPS) Control Support
  ******************************************************************************/
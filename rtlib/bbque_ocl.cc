@@ -16,9 +16,13 @@
  */
 #include <dlfcn.h>
 
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <mutex>
+#include <thread>
 #include <unistd.h>
 
 #include "bbque/config.h"
@@ -46,9 +50,52 @@ static std::unique_ptr<bu::Logger> logger;
 extern const char * rtlib_app_name;
 extern RTLIB_OpenCL_t rtlib_ocl;
 extern RTLIB_Services_t rtlib_services;
-extern std::map<cl_command_queue, QueueProfPtr_t> ocl_queues_prof;
 extern std::map<void *, cl_command_type> ocl_addr_cmd;
 
+/**
+ * The ring of profiled commands of each command queue
+ */
+static struct RTLIB_OCL_QueueRing {
+	std::atomic<cl_command_queue> queue;
+	RTLIB_OCL_EventRing ring;
+} ocl_rings[RTLIB_OCL_MAX_QUEUES];
+
+/** Commands profiling enabled */
+static bool ocl_prof_enabled = false;
+
+/** Profile one command every ocl_sampling_period (per command queue) */
+static uint32_t ocl_sampling_period = 1;
+
+/** Serialize the consumers of the rings */
+static std::mutex ocl_drain_mtx;
+
+/** Drained samples, waiting for the aggregation into the AWM statistics */
+static std::vector<RTLIB_OCL_CmdSample_t> ocl_samples;
+static std::mutex ocl_samples_mtx;
+
+/**
+ * The background drainer of the events rings
+ */
+static struct RTLIB_OCL_Drainer {
+	std::thread thd;
+	std::mutex mtx;
+	std::condition_variable cv;
+	bool done = false;
+
+	~RTLIB_OCL_Drainer() {
+		if (!thd.joinable())
+			return;
+		{
+			std::unique_lock<std::mutex> lk(mtx);
+			done = true;
+		}
+		cv.notify_one();
+		thd.join();
+	}
+} ocl_drainer;
+
+static void rtlib_ocl_put_ring(cl_command_queue cmd_queue);
+
 /* Platform API */
 CL_API_ENTRY cl_int CL_API_CALL
 clGetPlatformIDs(
@@ -487,6 +534,8 @@ clReleaseCommandQueue(cl_command_queue command_queue)
 CL_API_SUFFIX__VERSION_1_0
 {
 	DB2(logger->Debug("Calling clReleaseCommandQueue()..."));
+	if (ocl_prof_enabled)
+		rtlib_ocl_put_ring(command_queue);
 	return rtlib_ocl.releaseCommandQueue(command_queue);
 }
 
@@ -937,7 +986,8 @@ CL_API_SUFFIX__VERSION_1_0
 		logger->Error("OCL: Error [%d] in clEnqueueReadBuffer()", status);
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, (event == &local_event),
+		__builtin_return_address(0));
 	return status;
 }
 
@@ -971,7 +1021,8 @@ CL_API_SUFFIX__VERSION_1_1
 		logger->Error("OCL: Error [%d] in clEnqueueReadBufferRect()", status);
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, (event == &local_event),
+		__builtin_return_address(0));
 	return status;
 }
 
@@ -998,7 +1049,8 @@ CL_API_SUFFIX__VERSION_1_0
 		logger->Error("OCL: Error [%d] in clEnqueueWriteBuffer()", status);
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, (event == &local_event),
+		__builtin_return_address(0));
 	return status;
 }
 
@@ -1032,7 +1084,8 @@ CL_API_SUFFIX__VERSION_1_1
 		logger->Error("OCL: Error [%d] in clEnqueueWriteBufferRect()", status);
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, (event == &local_event),
+		__builtin_return_address(0));
 	return status;
 }
 
@@ -1059,7 +1112,8 @@ CL_API_SUFFIX__VERSION_1_0
 		logger->Error("OCL: Error [%d] in clEnqueueCopyBuffer()", status);
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, (event == &local_event),
+		__builtin_return_address(0));
 	return status;
 }
 
@@ -1091,7 +1145,8 @@ CL_API_SUFFIX__VERSION_1_1
 		logger->Error("OCL: Error [%d] in clEnqueueCopyBufferRect()", status);
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, (event == &local_event),
+		__builtin_return_address(0));
 	return status;
 }
 
@@ -1121,7 +1176,8 @@ CL_API_SUFFIX__VERSION_1_0
 		logger->Error("OCL: Error [%d] in clEnqueueReadImage()", status);
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, (event == &local_event),
+		__builtin_return_address(0));
 	return status;
 }
 
@@ -1151,7 +1207,8 @@ CL_API_SUFFIX__VERSION_1_0
 		logger->Error("OCL: Error [%d] in clEnqueueWriteImage()", status);
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, (event == &local_event),
+		__builtin_return_address(0));
 	return status;
 }
 
@@ -1178,7 +1235,8 @@ CL_API_SUFFIX__VERSION_1_0
 		logger->Error("OCL: Error [%d] in clEnqueueCopyImage()", status);
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, (event == &local_event),
+		__builtin_return_address(0));
 	return status;
 }
 
@@ -1206,7 +1264,8 @@ CL_API_SUFFIX__VERSION_1_0
 		logger->Error("OCL: Error [%d] in clEnqueueCopyImageToBuffer()", status);
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, (event == &local_event),
+		__builtin_return_address(0));
 	return status;
 }
 
@@ -1234,7 +1293,8 @@ CL_API_SUFFIX__VERSION_1_0
 		logger->Error("OCL: Error [%d] in clEnqueueCopyBufferToImage()", status);
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, (event == &local_event),
+		__builtin_return_address(0));
 	return status;
 }
 
@@ -1263,7 +1323,8 @@ CL_API_SUFFIX__VERSION_1_0
 		logger->Error("OCL: Error [%d] in clEnqueueMapBuffer()", *errcode_ret);
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, (event == &local_event),
+		__builtin_return_address(0));
 	return buff_ptr;
 }
 
@@ -1294,7 +1355,8 @@ CL_API_SUFFIX__VERSION_1_0
 		logger->Error("OCL: Error [%d] in clEnqueueMapImage()", *errcode_ret);
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, (event == &local_event),
+		__builtin_return_address(0));
 	return buff_ptr;
 }
 
@@ -1319,7 +1381,8 @@ CL_API_SUFFIX__VERSION_1_0
 		logger->Error("OCL: Error [%d] in clEnqueueUnmapMemObject()", status);
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, (event == &local_event),
+		__builtin_return_address(0));
 	return status;
 }
 
@@ -1347,7 +1410,8 @@ CL_API_SUFFIX__VERSION_1_0
 		logger->Error("OCL: Error [%d] in clEnqueueNDRangeKernel()", status);
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, (event == &local_event),
+		__builtin_return_address(0));
 	return status;
 }
 
@@ -1370,7 +1434,8 @@ CL_API_SUFFIX__VERSION_1_0
 		logger->Error("OCL: Error [%d] in clEnqueueTask()", status);
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, (event == &local_event),
+		__builtin_return_address(0));
 	return status;
 }
 
@@ -1399,7 +1464,8 @@ CL_API_SUFFIX__VERSION_1_0
 		logger->Error("OCL: Error [%d] in clEnqueueNativeKernel()", status);
 	}
 
-	rtlib_ocl_coll_event(command_queue, event, __builtin_return_address(0));
+	rtlib_ocl_coll_event(command_queue, event, (event == &local_event),
+		__builtin_return_address(0));
 	return status;
 }
 
@@ -1643,93 +1709,248 @@ void rtlib_ocl_set_device(uint8_t device_id, RTLIB_ExitCode_t status)
 	rtlib_ocl.status    = status;
 }
 
+static RTLIB_OCL_EventRing * rtlib_ocl_get_ring(cl_command_queue cmd_queue)
+{
+	for (auto & qr : ocl_rings) {
+		cl_command_queue cq = qr.queue.load(std::memory_order_acquire);
+		if (cq == cmd_queue)
+			return &qr.ring;
+		if (cq != nullptr)
+			continue;
+		// Free slot: claim it for this command queue
+		if (qr.queue.compare_exchange_strong(cq, cmd_queue) ||
+				(cq == cmd_queue))
+			return &qr.ring;
+	}
+	return nullptr;
+}
+
 void rtlib_ocl_coll_event(cl_command_queue cmd_queue, cl_event * event,
-			  void * addr)
+			  bool owned, void * addr)
 {
-	std::map<cl_command_queue, QueueProfPtr_t>::iterator it;
-	clRetainEvent(*event);
-	// Collect events per command queue
-	it = ocl_queues_prof.find(cmd_queue);
+	if ((event == nullptr) || (*event == nullptr))
+		return;
 
-	if (it == ocl_queues_prof.end())
-		ocl_queues_prof.insert(QueueProfPair_t(
-						cmd_queue, QueueProfPtr_t(new RTLIB_OCL_QueueProf)));
+	// The events not requested by the application are released here, or
+	// by the drainer if pushed into the ring
+	if (!ocl_prof_enabled) {
+		if (owned)
+			clReleaseEvent(*event);
+		return;
+	}
 
-	ocl_queues_prof[cmd_queue]->events.insert(AddrEventPair_t(addr, *event));
-}
+	RTLIB_OCL_EventRing * ring = rtlib_ocl_get_ring(cmd_queue);
+	if (ring == nullptr) {
+		DB2(logger->Debug("OCL: Too many command queues to profile"));
+		if (owned)
+			clReleaseEvent(*event);
+		return;
+	}
 
-void rtlib_ocl_prof_clean()
-{
-	ocl_queues_prof.clear();
+	// Sampling
+	uint32_t cmd_id = ring->commands.fetch_add(1, std::memory_order_relaxed);
+	if ((cmd_id % ocl_sampling_period) != 0) {
+		if (owned)
+			clReleaseEvent(*event);
+		return;
+	}
+
+	// The command type is retrieved at drain time
+	if (!owned)
+		clRetainEvent(*event);
+	if (!ring->Push({cmd_queue, 0, addr, *event})) {
+		clReleaseEvent(*event);
+		return;
+	}
+
+	// Wake up the drainer on the ring half full
+	if (ring->Size() == (RTLIB_OCL_RING_SIZE / 2))
+		ocl_drainer.cv.notify_one();
 }
 
-void rtlib_ocl_flush_events()
+static bool get_command_event_times(RTLIB_OCL_EventRecord_t & record,
+				    RTLIB_OCL_CmdSample_t & sample)
 {
-	std::map<cl_command_queue, QueueProfPtr_t>::iterator it_cq;
-	cl_command_queue cq;
+	cl_int status;
+	cl_ulong ev_times[4];
+	static const cl_profiling_info ev_info[4] = {
+		CL_PROFILING_COMMAND_QUEUED,
+		CL_PROFILING_COMMAND_SUBMIT,
+		CL_PROFILING_COMMAND_START,
+		CL_PROFILING_COMMAND_END
+	};
+
+	clGetEventInfo(record.event, CL_EVENT_COMMAND_TYPE,
+		sizeof (cl_command_type), &record.cmd_type, NULL);
 
-	for (it_cq = ocl_queues_prof.begin(); it_cq != ocl_queues_prof.end(); it_cq ++) {
-		QueueProfPtr_t stPtr = it_cq->second;
-		cq = it_cq->first;
-		stPtr->events.clear();
+	for (int i = 0; i < 4; ++ i) {
+		status = clGetEventProfilingInfo(record.event, ev_info[i],
+				sizeof (cl_ulong), &ev_times[i], NULL);
+		if (status != CL_SUCCESS) {
+			logger->Error("OCL: Error [%d] in event profiling [%d]",
+				status, i);
+			return false;
+		}
 	}
 
-	ocl_queues_prof.erase(cq);
+	sample.queue       = record.queue;
+	sample.cmd_type    = record.cmd_type;
+	sample.addr        = record.addr;
+	sample.queued_time = (double) (ev_times[1] - ev_times[0]);
+	sample.submit_time = (double) (ev_times[2] - ev_times[1]);
+	sample.exec_time   = (double) (ev_times[3] - ev_times[2]);
+	return true;
 }
 
-void rtlib_ocl_prof_run(
-			int8_t awm_id,
-			OclEventsStatsMap_t & awm_ocl_events,
-			int prof_level)
+/**
+ * Drain an events ring in batches: wait for the completion of the commands,
+ * get their profiling times and release the events.
+ * The ocl_drain_mtx must be held.
+ */
+static void rtlib_ocl_drain_ring(RTLIB_OCL_QueueRing & qr, bool discard)
 {
-	cl_command_type cmd_type = 0;
-	cl_int status;
-	std::map<cl_command_queue, QueueProfPtr_t>::iterator it_cq;
-	std::map<void *, cl_event>::iterator it_ev;
-
-	for (it_cq = ocl_queues_prof.begin();
-			it_cq != ocl_queues_prof.end(); it_cq ++) {
-		cl_command_queue cq = it_cq->first;
-		clFinish(cq);
-		// Resume previously stored statistics
-		QueueProfPtr_t stPtr = it_cq->second;
-
-		if (awm_ocl_events[cq] != nullptr) {
-			stPtr->cmd_prof  = awm_ocl_events[cq]->cmd_prof;
-			stPtr->addr_prof = awm_ocl_events[cq]->addr_prof;
-		}
+	RTLIB_OCL_EventRecord_t batch[RTLIB_OCL_DRAIN_BATCH];
+	RTLIB_OCL_CmdSample_t samples[RTLIB_OCL_DRAIN_BATCH];
+	cl_event events[RTLIB_OCL_DRAIN_BATCH];
+	size_t n;
 
-		// Extract event profiling timings
-		for (it_ev = stPtr->events.begin(); it_ev != stPtr->events.end(); it_ev ++) {
-			cl_event & ev(it_ev->second);
-			status = clWaitForEvents(1, &ev);
+	while ((n = qr.ring.PopBatch(batch, RTLIB_OCL_DRAIN_BATCH)) > 0) {
+		size_t nr_samples = 0;
 
+		if (!discard) {
+			for (size_t i = 0; i < n; ++ i)
+				events[i] = batch[i].event;
+			cl_int status = clWaitForEvents(n, events);
 			if (status != CL_SUCCESS)
 				logger->Error("OCL: Error [%d] in clWaitForEvents", status);
+		}
 
-			acc_command_event_info(
-					stPtr, ev, cmd_type, it_ev->first, awm_id, prof_level);
+		for (size_t i = 0; i < n; ++ i) {
+			if (!discard &&
+					get_command_event_times(batch[i], samples[nr_samples]))
+				++ nr_samples;
+			clReleaseEvent(batch[i].event);
 		}
 
-		rtlib_ocl_prof_save(cq, awm_ocl_events);
+		if (nr_samples == 0)
+			continue;
+
+		std::unique_lock<std::mutex> samples_lk(ocl_samples_mtx);
+		if (ocl_samples.size() + nr_samples > RTLIB_OCL_MAX_SAMPLES) {
+			logger->Warn("OCL: Too many samples pending, dropping");
+			continue;
+		}
+		ocl_samples.insert(ocl_samples.end(), samples, samples + nr_samples);
 	}
+}
 
-	rtlib_ocl_prof_clean();
+/**
+ * Drain the events rings of all the command queues
+ */
+static void rtlib_ocl_drain(bool discard)
+{
+	std::unique_lock<std::mutex> drain_lk(ocl_drain_mtx);
+
+	for (auto & qr : ocl_rings) {
+		if (qr.queue.load(std::memory_order_acquire) == nullptr)
+			continue;
+		rtlib_ocl_drain_ring(qr, discard);
+	}
 }
 
-void rtlib_ocl_prof_save(
-			 cl_command_queue cmd_queue,
-			 OclEventsStatsMap_t & awm_ocl_events)
+/**
+ * Free the ring of a command queue being destroyed, after collecting the
+ * commands still pending, so that the slot can be claimed by a new queue
+ */
+static void rtlib_ocl_put_ring(cl_command_queue cmd_queue)
 {
-	OclEventsStatsMap_t::iterator it_cq;
-	it_cq = awm_ocl_events.find(cmd_queue);
+	cl_uint ref_count = 0;
+	cl_int status = rtlib_ocl.getCommandQueueInfo(cmd_queue,
+			CL_QUEUE_REFERENCE_COUNT, sizeof (cl_uint), &ref_count, NULL);
+	if ((status != CL_SUCCESS) || (ref_count > 1))
+		return;
 
-	if (it_cq == awm_ocl_events.end()) {
-		QueueProfPtr_t p(new RTLIB_OCL_QueueProf(*(ocl_queues_prof[cmd_queue].get())));
-		awm_ocl_events.insert(QueueProfPair_t(cmd_queue, p));
+	std::unique_lock<std::mutex> drain_lk(ocl_drain_mtx);
+	for (auto & qr : ocl_rings) {
+		if (qr.queue.load(std::memory_order_acquire) != cmd_queue)
+			continue;
+		rtlib_ocl_drain_ring(qr, false);
+		qr.ring.commands.store(0, std::memory_order_relaxed);
+		qr.queue.store(nullptr, std::memory_order_release);
+		DB2(logger->Debug("OCL: Ring of command queue %p released", cmd_queue));
+		return;
 	}
-	else {
-		awm_ocl_events[cmd_queue] = ocl_queues_prof[cmd_queue];
+}
+
+static void rtlib_ocl_drainer_task()
+{
+	std::unique_lock<std::mutex> lk(ocl_drainer.mtx);
+	logger->Debug("OCL: Events drainer started");
+
+	while (!ocl_drainer.done) {
+		ocl_drainer.cv.wait_for(lk,
+			std::chrono::milliseconds(RTLIB_OCL_DRAIN_PERIOD_MS));
+		if (ocl_drainer.done)
+			break;
+		lk.unlock();
+		rtlib_ocl_drain(false);
+		lk.lock();
+	}
+
+	logger->Debug("OCL: Events drainer terminated");
+}
+
+void rtlib_ocl_prof_setup(uint32_t sampling_period)
+{
+	if (ocl_prof_enabled)
+		return;
+
+	ocl_sampling_period = (sampling_period > 0) ? sampling_period : 1;
+	ocl_samples.reserve(RTLIB_OCL_MAX_SAMPLES);
+	ocl_prof_enabled = true;
+	ocl_drainer.thd = std::thread(rtlib_ocl_drainer_task);
+	logger->Notice("OCL: Commands profiling enabled [sampling: 1/%u]",
+		ocl_sampling_period);
+}
+
+bool rtlib_ocl_prof_enabled()
+{
+	return ocl_prof_enabled;
+}
+
+void rtlib_ocl_prof_clean()
+{
+	std::unique_lock<std::mutex> samples_lk(ocl_samples_mtx);
+	ocl_samples.clear();
+}
+
+void rtlib_ocl_flush_events()
+{
+	rtlib_ocl_drain(true);
+	rtlib_ocl_prof_clean();
+}
+
+void rtlib_ocl_prof_run(
+			int8_t awm_id,
+			OclEventsStatsMap_t & awm_ocl_events,
+			int prof_level)
+{
+	// Swap the pending samples with an empty buffer, to keep the drainer
+	// blocked for the minimum time
+	thread_local std::vector<RTLIB_OCL_CmdSample_t> samples;
+	samples.clear();
+	{
+		std::unique_lock<std::mutex> samples_lk(ocl_samples_mtx);
+		samples.swap(ocl_samples);
+		ocl_samples.reserve(RTLIB_OCL_MAX_SAMPLES);
+	}
+
+	// Aggregate into the AWM statistics
+	for (auto const & sample : samples) {
+		QueueProfPtr_t & stPtr(awm_ocl_events[sample.queue]);
+		if (!stPtr)
+			stPtr = std::make_shared<RTLIB_OCL_QueueProf>();
+		acc_command_sample(stPtr, sample, awm_id, prof_level);
 	}
 }
 
@@ -1810,88 +2031,34 @@ void dump_command_prof_info(
 	fclose(dump_file);
 }
 
-void acc_command_event_info(
-			    QueueProfPtr_t stPtr,
-			    cl_event event,
-			    cl_command_type & cmd_type,
-			    void * addr,
-			    int8_t awm_id,
-			    int prof_level)
+void acc_command_sample(
+			QueueProfPtr_t stPtr,
+			RTLIB_OCL_CmdSample_t const & sample,
+			int8_t awm_id,
+			int prof_level)
 {
-	size_t return_bytes;
-	cl_int status;
-	cl_ulong ev_queued_time = (cl_ulong) 0;
-	cl_ulong ev_submit_time = (cl_ulong) 0;
-	cl_ulong ev_start_time  = (cl_ulong) 0;
-	cl_ulong ev_end_time    = (cl_ulong) 0;
-	// Extract event times
-	clGetEventInfo(event, CL_EVENT_COMMAND_TYPE, sizeof (cl_command_type),
-		&cmd_type, NULL);
-	status = clGetEventProfilingInfo(
-					event,
-					CL_PROFILING_COMMAND_QUEUED,
-					sizeof (cl_ulong),
-					&ev_queued_time,
-					&return_bytes);
-
-	if (status != CL_SUCCESS) {
-		logger->Error("OCL: Error [%d] in queued event profiling", status);
-		return;
-	}
-
-	status = clGetEventProfilingInfo(
-					event,
-					CL_PROFILING_COMMAND_SUBMIT,
-					sizeof (cl_ulong),
-					&ev_submit_time,
-					&return_bytes);
-
-	if (status != CL_SUCCESS) {
-		logger->Error("OCL: Error [%d] in submit event profiling", status);
-		return;
-	}
-
-	status = clGetEventProfilingInfo(
-					event,
-					CL_PROFILING_COMMAND_START,
-					sizeof (cl_ulong),
-					&ev_start_time,
-					&return_bytes);
-
-	if (status != CL_SUCCESS) {
-		logger->Error("OCL: Error [%d] in start event profiling", status);
-		return;
-	}
-
-	status = clGetEventProfilingInfo(
-					event,
-					CL_PROFILING_COMMAND_END,
-					sizeof (cl_ulong),
-					&ev_end_time,
-					&return_bytes);
-
-	if (status != CL_SUCCESS) {
-		logger->Error("OCL: Error [%d] in end event profiling", status);
-		return;
-	}
+	void * addr = sample.addr;
 
 	// Accumulate event times for this command
-	double queued_time = (double) (ev_submit_time - ev_queued_time);
-	double submit_time = (double) (ev_start_time  - ev_submit_time);
-	double exec_time   = (double) (ev_end_time    - ev_start_time);
-	acc_command_stats(stPtr, cmd_type, queued_time, submit_time, exec_time);
+	acc_command_stats(stPtr, sample.cmd_type,
+		sample.queued_time, sample.submit_time, sample.exec_time);
+	HistArray_t & hist(stPtr->cmd_hist[sample.cmd_type]);
+	hist[CL_CMD_QUEUED_TIME].Add(sample.queued_time);
+	hist[CL_CMD_SUBMIT_TIME].Add(sample.submit_time);
+	hist[CL_CMD_EXEC_TIME].Add(sample.exec_time);
 
 	// Collects stats for command instances
 	if (prof_level > 0) {
-		acc_address_stats(stPtr, addr, queued_time, submit_time, exec_time);
-		ocl_addr_cmd[addr] = cmd_type;
+		acc_address_stats(stPtr, addr,
+			sample.queued_time, sample.submit_time, sample.exec_time);
+		ocl_addr_cmd[addr] = sample.cmd_type;
 	}
 	else
 		addr = 0;
 
 	// File dump
-	dump_command_prof_info(
-			awm_id, cmd_type, queued_time, submit_time, exec_time, addr);
+	dump_command_prof_info(awm_id, sample.cmd_type,
+		sample.queued_time, sample.submit_time, sample.exec_time, addr);
 }
 
 cl_command_type rtlib_ocl_get_command_type(void * addr)
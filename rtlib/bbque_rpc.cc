@@ -31,6 +31,12 @@
 #include <cstring>
 #include <sys/stat.h>
 
+#ifdef CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #ifdef CONFIG_BBQUE_OPENCL
 #include "bbque/rtlib/bbque_ocl.h"
 #endif
@@ -80,6 +86,13 @@ BbqueRPC * BbqueRPC::GetInstance()
 	logger = bu::Logger::GetLogger(BBQUE_LOG_MODULE);
 	// Parse environment configuration
 	ParseOptions();
+#ifdef CONFIG_BBQUE_OPENCL
+
+	// OpenCL commands profiling (events drained in background)
+	if (rtlib_configuration.profile.opencl.enabled)
+		rtlib_ocl_prof_setup(rtlib_configuration.profile.opencl.sampling);
+
+#endif // CONFIG_BBQUE_OPENCL
 	// Instantiating a communication client based on the current mode
 	// (currently, unmanaged or FIFO)
 #ifdef CONFIG_BBQUE_RTLIB_UNMANAGED_SUPPORT
@@ -101,7 +114,14 @@ BbqueRPC * BbqueRPC::GetInstance()
 	return instance;
 }
 
-BbqueRPC::~ BbqueRPC(void) { }
+BbqueRPC::~ BbqueRPC(void)
+{
+#ifdef CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+	if (shm_alloc)
+		::munmap(const_cast<rpc_shm_alloc_t *>(shm_alloc),
+				 sizeof (rpc_shm_alloc_t));
+#endif
+}
 
 RTLIB_ExitCode_t BbqueRPC::ParseOptions()
 {
@@ -170,6 +190,31 @@ RTLIB_ExitCode_t BbqueRPC::ParseOptions()
 			rtlib_configuration.profile.perf_counters.overheads = true;
 			break;
 
+		case 'S':
+			// Setup sampled profiling (cycles or milliseconds)
+			if (option[1] == 'm' || option[1] == 'M') {
+				rtlib_configuration.profile.sampling.period_ms = atoi(option + 2);
+				logger->Notice("Enabling SAMPLED profiling every %u [ms]",
+							   rtlib_configuration.profile.sampling.period_ms);
+				break;
+			}
+
+			if (option[1] == 'c' || option[1] == 'C') {
+				rtlib_configuration.profile.sampling.period_cycles =
+					std::max(1, atoi(option + 2));
+				logger->Notice("Enabling SAMPLED profiling every %u [cycles]",
+							   rtlib_configuration.profile.sampling.period_cycles);
+				break;
+			}
+
+			logger->Warn("Expected sampling period in cycles (Sc) or [ms] (Sm)");
+			break;
+
+		case 'T':
+			// Count the control thread only, reading counters from user-space
+			rtlib_configuration.profile.perf_counters.self_monitoring = true;
+			break;
+
 		case 'U':
 			// Enable "unmanaged" mode with the specified AWM
 			rtlib_configuration.unmanaged.enabled = true;
@@ -316,10 +361,13 @@ RTLIB_ExitCode_t BbqueRPC::ParseOptions()
 
 		case 'o':
 			// Enabling OpenCL Profiling Output on file
+			// Format: o<level>[,<sampling period>]
 			rtlib_configuration.profile.opencl.enabled = true;
-			sscanf(option + 1, "%d", &rtlib_configuration.profile.opencl.level);
-			logger->Notice("Enabling OpenCL profiling [verbosity: %d]",
-						   rtlib_configuration.profile.opencl.level);
+			sscanf(option + 1, "%d,%u", &rtlib_configuration.profile.opencl.level,
+				   &rtlib_configuration.profile.opencl.sampling);
+			logger->Notice("Enabling OpenCL profiling [verbosity: %d, sampling: 1/%u]",
+						   rtlib_configuration.profile.opencl.level,
+						   rtlib_configuration.profile.opencl.sampling);
 			break;
 #endif //CONFIG_BBQUE_OPENCL
 
@@ -354,6 +402,11 @@ RTLIB_ExitCode_t BbqueRPC::InitializeApplication(const char * name)
 		return exitCode;
 	}
 
+#ifdef CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+	// Resource assignments published by the BarbequeRTRM at pairing time
+	ShmAllocMap();
+#endif
+
 	// Initialize CGroup support. Note Per-APP cgroups will be mounted during
 	// Configuration phase
 	logger->Debug("Initializing libcgroup");
@@ -1019,6 +1072,7 @@ void BbqueRPC::DumpStats(pRegisteredEXC_t exc, bool verbose)
 		fprintf(output_file, "Cumulative execution stats for '%s':\n",
 				exc->name.c_str());
 		fprintf(output_file, "  TotCycles    : %7lu\n", exc->cycles_count);
+		fprintf(output_file, "  SampledCycles: %7lu\n", exc->sampled_cycles_count);
 		fprintf(output_file, "  StartLatency : %7u [ms]\n", exc->starting_time_ms);
 		fprintf(output_file, "  AwmWait      : %7u [ms]\n", exc->blocked_time_ms);
 		fprintf(output_file, "  Configure    : %7u [ms]\n", exc->config_time_ms);
@@ -1028,6 +1082,7 @@ void BbqueRPC::DumpStats(pRegisteredEXC_t exc, bool verbose)
 	else {
 		logger->Debug("Cumulative execution stats for '%s':", exc->name.c_str());
 		logger->Debug("  TotCycles    : %7lu", exc->cycles_count);
+		logger->Debug("  SampledCycles: %7lu", exc->sampled_cycles_count);
 		logger->Debug("  StartLatency : %7u [ms]", exc->starting_time_ms);
 		logger->Debug("  AwmWait      : %7u [ms]", exc->blocked_time_ms);
 		logger->Debug("  Configure    : %7u [ms]", exc->config_time_ms);
@@ -1068,6 +1123,32 @@ bool BbqueRPC::CheckDurationTimeout(pRegisteredEXC_t exc)
 	return false;
 }
 
+bool BbqueRPC::IsSampledCycle(pRegisteredEXC_t exc)
+{
+	auto const & sampling(rtlib_configuration.profile.sampling);
+	++exc->cycles_since_sample;
+
+	// The first cycle is always accounted, to initialize the statistics
+	if (likely(exc->sampled_cycles_count > 0)) {
+		if (sampling.period_ms > 0) {
+			double now_ms = bbque_tmr.getElapsedTimeMs();
+			if ((now_ms - exc->last_sample_time_ms) < sampling.period_ms)
+				return false;
+			exc->last_sample_time_ms = now_ms;
+		}
+		else if (exc->cycles_since_sample < sampling.period_cycles) {
+			return false;
+		}
+	}
+	else if (sampling.period_ms > 0) {
+		exc->last_sample_time_ms = bbque_tmr.getElapsedTimeMs();
+	}
+
+	exc->cycles_since_sample = 0;
+	++exc->sampled_cycles_count;
+	return true;
+}
+
 void BbqueRPC::_SyncTimeEstimation(pRegisteredEXC_t exc)
 {
 	pAwmStats_t awm_stats(exc->current_awm_stats);
@@ -1416,6 +1497,22 @@ RTLIB_ExitCode_t BbqueRPC::GetAffinityMask(
 
     for (int id = 0; id < ids_number; id ++)
 		ids_vector[id] = exc->cg_current_allocation.cpu_affinity_mask[id];
+#elif defined(CONFIG_BBQUE_RTLIB_SHM_ALLOCATION)
+	// The processing elements published by the BarbequeRTRM, once the
+	// current AWM has been committed
+	rpc_shm_alloc_exc_t slot;
+	if (! ShmAllocRead(exc, slot))
+		return RTLIB_OK;
+	std::unique_lock<std::mutex> exc_u_lock(exc->exc_mutex);
+	if (slot.awm_id != (isBlocked(exc) ? -1 : exc->current_awm_id))
+		return RTLIB_OK;
+	exc_u_lock.unlock();
+
+	int ids_number = 0;
+	for (int pe_id = 0; pe_id < 64 && ids_number < vector_size; pe_id ++) {
+		if (slot.cpu_ids & (1ull << pe_id))
+			ids_vector[ids_number ++] = pe_id;
+	}
 #endif
 
     return RTLIB_OK;
@@ -1500,6 +1597,129 @@ RTLIB_ExitCode_t BbqueRPC::GetAssignedResources(
 	return RTLIB_OK;
 }
 
+RTLIB_ExitCode_t BbqueRPC::GetAllocation(
+	RTLIB_EXCHandler_t exc_handler,
+	RTLIB_Allocation_t * allocation)
+{
+	pRegisteredEXC_t exc = getRegistered(exc_handler);
+
+	if (! exc) {
+		logger->Error("Getting allocation for EXC [%p] FAILED "
+					  "(Error: EXC not registered)", (void *) exc_handler);
+		return RTLIB_EXC_NOT_REGISTERED;
+	}
+
+	*allocation = RTLIB_Allocation_t();
+
+#ifdef CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+	rpc_shm_alloc_exc_t slot;
+	bool published = ShmAllocRead(exc, slot);
+#endif
+	std::unique_lock<std::mutex> exc_u_lock(exc->exc_mutex);
+
+#ifdef CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+	// The page is updated once the reconfiguration has been committed:
+	// meanwhile, the assignment just received is the most recent one
+	if (published &&
+			(slot.awm_id == (isBlocked(exc) ? -1 : exc->current_awm_id))) {
+		allocation->generation = slot.generation;
+		allocation->awm_id = slot.awm_id;
+		allocation->cpu_ids = slot.cpu_ids;
+		allocation->cpu_ids_isolation = slot.cpu_ids_isolation;
+		allocation->mem_ids = slot.mem_ids;
+
+		if (slot.nr_sys > 0) {
+			allocation->local.sys_id = slot.systems[0].sys_id;
+			allocation->local.number_cpus = slot.systems[0].nr_cpus;
+			allocation->local.number_proc_elements = slot.systems[0].nr_procs;
+			allocation->local.cpu_bandwidth = slot.systems[0].r_proc;
+			allocation->local.mem_bandwidth = slot.systems[0].r_mem;
+		}
+
+		return RTLIB_OK;
+	}
+#endif
+
+	// Fallback: the assignment received by the last PreChange message
+	auto sys_it = exc->resource_assignment.find(0);
+
+	if (sys_it == exc->resource_assignment.end())
+		return RTLIB_EXC_NOT_STARTED;
+
+	allocation->awm_id = isBlocked(exc) ? -1 : exc->current_awm_id;
+	allocation->local = *(sys_it->second);
+#ifdef CONFIG_BBQUE_CGROUPS_DISTRIBUTED_ACTUATION
+
+	for (int32_t pe_id : exc->cg_budget.cpu_global_ids)
+		allocation->cpu_ids |= (1ull << pe_id);
+
+	for (int32_t pe_id : exc->cg_budget.cpu_isolation_ids)
+		allocation->cpu_ids_isolation |= (1ull << pe_id);
+
+#endif
+	return RTLIB_OK;
+}
+
+#ifdef CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+
+void BbqueRPC::ShmAllocMap()
+{
+	char shm_name[RPC_SHM_ALLOC_NAME_LENGTH];
+	struct stat shm_stat;
+	snprintf(shm_name, RPC_SHM_ALLOC_NAME_LENGTH,
+			 RPC_SHM_ALLOC_NAME_FMT, channel_thread_pid);
+
+	int fd = ::shm_open(shm_name, O_RDONLY, 0);
+
+	if (fd < 0) {
+		logger->Debug("Shared memory [%s] not available", shm_name);
+		return;
+	}
+
+	// A smaller page would be published by a mismatching BarbequeRTRM
+	if ((::fstat(fd, &shm_stat) != 0) ||
+		(shm_stat.st_size < (off_t) sizeof (rpc_shm_alloc_t))) {
+		logger->Warn("Shared memory [%s] size mismatch", shm_name);
+		::close(fd);
+		return;
+	}
+
+	void * addr = ::mmap(nullptr, sizeof (rpc_shm_alloc_t),
+						 PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+
+	if (addr == MAP_FAILED) {
+		logger->Warn("Shared memory [%s] mapping FAILED", shm_name);
+		return;
+	}
+
+	shm_alloc = static_cast<rpc_shm_alloc_t const *>(addr);
+
+	if (__atomic_load_n(&shm_alloc->magic, __ATOMIC_ACQUIRE)
+			!= RPC_SHM_ALLOC_MAGIC) {
+		logger->Warn("Shared memory [%s] not initialized", shm_name);
+		::munmap(addr, sizeof (rpc_shm_alloc_t));
+		shm_alloc = nullptr;
+		return;
+	}
+
+	logger->Debug("Shared memory [%s] mapped", shm_name);
+}
+
+bool BbqueRPC::ShmAllocRead(pRegisteredEXC_t exc, rpc_shm_alloc_exc_t & slot)
+{
+	if (! shm_alloc)
+		return false;
+
+	if (! RpcShmAllocRead(RpcShmAllocSlot(shm_alloc, exc->id), slot))
+		return false;
+
+	// The slot could be owned by another EXC with a colliding ID
+	return (slot.exc_id == exc->id);
+}
+
+#endif // CONFIG_BBQUE_RTLIB_SHM_ALLOCATION
+
 void BbqueRPC::StartPCountersMonitoring(
 	RTLIB_EXCHandler_t exc_handler)
 {
@@ -1518,7 +1738,10 @@ void BbqueRPC::StartPCountersMonitoring(
 		logger->Notice("Starting performance counters monitoring");
 		PerfSetupEvents(exc);
 
-		if (rtlib_configuration.profile.perf_counters.global
+		if (rtlib_configuration.profile.perf_counters.self_monitoring
+			&& PerfRegisteredEvents(exc))
+			PerfStart(exc);
+		else if (rtlib_configuration.profile.perf_counters.global
 			&& PerfRegisteredEvents(exc))
 			PerfEnable(exc);
 	}
@@ -2317,17 +2540,25 @@ RTLIB_ExitCode_t BbqueRPC::ForwardRuntimeProfile(
 	float cycle_time_avg_ms = exc->cycletime_analyser_system.GetMean() +
 		exc->cycletime_analyser_system.GetConfidenceInterval99();
 
+	// Pressure on the shared cache and memory, if counted
+	float llc_mpkc = 0.0f;
+	uint32_t mem_bw_mbps = 0;
+	if (rtlib_configuration.profile.enabled &&
+		exc->current_awm_stats && (PerfRegisteredEvents(exc) > 0))
+		PerfInterference(exc, llc_mpkc, mem_bw_mbps);
+
 	exc->waiting_sync_timeout_ms =
 			rtlib_configuration.runtime_profiling.rt_profile_wait_for_sync_ms;
 	exc->is_waiting_for_sync = true;
 
 	logger->Debug("[%p:%s] Profile notification : {Gap: %.2f, CPU: "
-				 "%.2f, CTime: %.2f ms}", (void *) exc_handler, exc->name.c_str(),
-				 goal_gap, cpu_usage, cycle_time_avg_ms);
+				 "%.2f, CTime: %.2f ms, LLC: %.2f MPKC, BW: %u MB/s}",
+				 (void *) exc_handler, exc->name.c_str(),
+				 goal_gap, cpu_usage, cycle_time_avg_ms, llc_mpkc, mem_bw_mbps);
 	// Forward the RTP
 	RTLIB_ExitCode_t result =
 		_RTNotify(exc, std::round(goal_gap), std::round(cpu_usage),
-				  std::round(cycle_time_avg_ms));
+				  std::round(cycle_time_avg_ms), llc_mpkc, mem_bw_mbps);
 
 	if (result != RTLIB_OK) {
 		logger->Error("[%p:%s] Profile notification FAILED (Error %d: %s)",
@@ -2395,6 +2626,36 @@ RTLIB_ExitCode_t BbqueRPC::GetRuntimeProfile(
 	return RTLIB_OK;
 }
 
+RTLIB_ExitCode_t BbqueRPC::ResizeNotify(
+	rpc_msg_BBQ_RESIZE_t & msg)
+{
+	pRegisteredEXC_t exc = getRegistered(msg.hdr.exc_id);
+
+	if (! exc) {
+		logger->Error("Resize EXC [%d] FAILED "
+					  "(Error: Execution Context not registered)",
+					  msg.hdr.exc_id);
+		return RTLIB_EXC_NOT_REGISTERED;
+	}
+
+	std::unique_lock<std::mutex> exc_u_lock(exc->exc_mutex);
+
+	// A pending synchronization will provide the assignment anyway
+	if (isSyncMode(exc) || (exc->current_awm_id != msg.awm))
+		return RTLIB_OK;
+
+	// Update the resources assigned (no reconfiguration required)
+	auto sys_it = exc->resource_assignment.find(0);
+	if ((sys_it != exc->resource_assignment.end()) && sys_it->second) {
+		sys_it->second->cpu_bandwidth = msg.r_proc;
+		sys_it->second->mem_bandwidth = msg.r_mem;
+	}
+
+	logger->Info("Resize EXC [%d], AWM [%d], Assigned PROC=<%d>",
+				 msg.hdr.exc_id, msg.awm, msg.r_proc);
+	return RTLIB_OK;
+}
+
 /*******************************************************************************
  *    Performance Monitoring Support
  ******************************************************************************/
@@ -2522,6 +2783,10 @@ void BbqueRPC::PerfSetupEvents(pRegisteredEXC_t exc)
 	// to add eventually more detailed counters or to completely disable perf
 	// support
 
+	// Self-monitoring counters are enabled once, and then sampled
+	exc->perf.SetSelfMonitoring(
+		rtlib_configuration.profile.perf_counters.self_monitoring);
+
 	// Adding raw events
 	for (uint8_t e = 0; e < rtlib_configuration.profile.perf_counters.raw; e ++) {
 		fd = exc->perf.AddCounter(
@@ -2613,18 +2878,47 @@ void BbqueRPC::PerfCollectStats(pRegisteredEXC_t exc)
 	uint64_t          increase_from_last_sampling;
 	int               event_id;
 
+	// Update all the counters at once: a single read per group of counters,
+	// or none, if the counters can be read from user-space
+	if (exc->perf.UpdateAll() != 0)
+		logger->Warn("PerfCollectStats: counters update failed");
+
 	// Collect counters for registered events
 	for (auto & event_counter : awm_stats->events_map) {
 		event_stats = event_counter.second;
 		event_id = event_counter.first;
 		// Reading increase_from_last_sampling for this perf counter
-		increase_from_last_sampling = exc->perf.Update(event_id);
+		increase_from_last_sampling = exc->perf.Read(event_id);
 		// Computing stats for this counter
 		event_stats->value += increase_from_last_sampling;
 		event_stats->perf_samples(increase_from_last_sampling);
+		// Accounting the counters of the interference profile
+		if (PerfEventMatch(event_stats->pattr, PERF_HW(CPU_CYCLES)))
+			exc->perf_window.cycles += increase_from_last_sampling;
+		else if (PerfEventMatch(event_stats->pattr, PERF_HC(LLC_RM)))
+			exc->perf_window.llc_misses += increase_from_last_sampling;
+		else if (PerfEventMatch(event_stats->pattr, PERF_SW(TASK_CLOCK)))
+			exc->perf_window.task_clock_ns += increase_from_last_sampling;
 	}
 }
 
+void BbqueRPC::PerfInterference(pRegisteredEXC_t exc,
+								float & llc_mpkc, uint32_t & mem_bw_mbps)
+{
+	std::unique_lock<std::mutex> stats_lock(exc->current_awm_stats->stats_mutex);
+	auto & window(exc->perf_window);
+
+	if (window.cycles > 0)
+		llc_mpkc = 1e3 * window.llc_misses / window.cycles;
+
+	// Bytes over the time spent running, i.e. the pressure while co-running
+	if (window.task_clock_ns > 0)
+		mem_bw_mbps = 1e3 * window.llc_misses *
+			BBQUE_RTLIB_PERF_LLC_LINE_SIZE / window.task_clock_ns;
+
+	window = RegisteredExecutionContext_t::PerfWindow();
+}
+
 void BbqueRPC::PerfPrintNsec(pAwmStats_t awm_stats,
 							 pPerfEventStats_t event_stats)
 {
@@ -2953,6 +3247,7 @@ void BbqueRPC::OclDumpStats(pRegisteredEXC_t exc)
 			 it_cq != awm_stats->ocl_events_map.end(); it_cq ++) {
 			QueueProfPtr_t stPtr = it_cq->second;
 			OclDumpCmdStats(stPtr, it_cq->first);
+			OclDumpHistStats(stPtr, it_cq->first);
 
 			if (rtlib_configuration.profile.opencl.level == 0)
 				continue;
@@ -2995,6 +3290,23 @@ void BbqueRPC::OclDumpCmdStats(QueueProfPtr_t stPtr, cl_command_queue cmd_queue)
 	fprintf(output_file, OCL_STATS_BAR);
 }
 
+void BbqueRPC::OclDumpHistStats(QueueProfPtr_t stPtr, cl_command_queue cmd_queue)
+{
+	for (auto const & entry : stPtr->cmd_hist) {
+		RTLIB_OCL_Histogram const & exec_hist(entry.second[CL_CMD_EXEC_TIME]);
+		fprintf(output_file, "# %-32p || %-23s || exec[ms] "
+				"samples: %8lu | p50: %8.3f | p90: %8.3f | p99: %8.3f | max: %8.3f\n",
+				(void *) cmd_queue, ocl_cmd_str[entry.first].c_str(),
+				exec_hist.count,
+				exec_hist.Percentile(50) * 1e-06,
+				exec_hist.Percentile(90) * 1e-06,
+				exec_hist.Percentile(99) * 1e-06,
+				exec_hist.max * 1e-06);
+	}
+
+	fprintf(output_file, OCL_STATS_BAR);
+}
+
 void BbqueRPC::OclDumpAddrStats(QueueProfPtr_t stPtr, cl_command_queue cmd_queue)
 {
 	std::map<void *, AccArray_t>::iterator it_ct;
@@ -3363,6 +3675,8 @@ void BbqueRPC::NotifyPreRun(
 	}
 
 	assert(isRegistered(exc) == true);
+	exc->sampled_cycle = IsSampledCycle(exc);
+
 	logger->Debug("Pre-Run: Checking if perf counters are activated");
 	bool pcounters_collected_systemwide =
 		rtlib_configuration.profile.perf_counters.global;
@@ -3374,16 +3688,21 @@ void BbqueRPC::NotifyPreRun(
 			rtlib_configuration.profile.perf_counters.overheads;
 
 		if (unlikely(pcounters_monitor_rtlib_overheads)) {
+			// RTLIB overheads are accounted at each cycle
 			logger->Debug("Pre-Run: RTLIB overheads mode: disabling perf");
 			PerfDisable(exc);
 			PerfCollectStats(exc);
 		}
-		else {
+		else if (exc->sampled_cycle) {
 			logger->Debug("Pre-Run: standard profiling mode: enabling perf");
 			PerfEnable(exc);
 		}
 	}
 
+	// Sampled profiling: skip the accounting of this cycle
+	if (! exc->sampled_cycle)
+		return;
+
 	logger->Debug("Pre-Run: Starting computing CPU quota");
 	InitCPUBandwidthStats(exc);
 }
@@ -3416,13 +3735,17 @@ void BbqueRPC::NotifyPostRun(
 			logger->Debug("Post-Run: RTLIB overheads mode: enabling perf");
 			PerfEnable(exc);
 		}
-		else {
+		else if (exc->sampled_cycle) {
 			logger->Debug("Post-Run: standard profiling mode: disabling perf");
 			PerfDisable(exc);
 			PerfCollectStats(exc);
 		}
 	}
 
+	// Sampled profiling: skip the accounting of this cycle
+	if (! exc->sampled_cycle)
+		return;
+
 	logger->Debug("Post-Run: Stop computing CPU quota");
 
 	if (UpdateCPUBandwidthStats(exc) != RTLIB_OK)
@@ -3479,6 +3802,11 @@ void BbqueRPC::NotifyPostMonitor(RTLIB_EXCHandler_t exc_handler)
 	if (rtlib_configuration.unmanaged.enabled)
 		return;
 
+	// Sampled profiling: the allocation is updated on sampled cycles only,
+	// since CPU usage statistics are not collected otherwise
+	if (! exc->sampled_cycle)
+		return;
+
 	// Compute the ideal resource allocation for the application,
 	// given its history
 	UpdateAllocation(exc_handler);
@@ -3537,9 +3865,11 @@ void BbqueRPC::OclGetRuntimeProfile(
 		}
 	}
 
-	// Update
+	// Update (scaling the sampled commands times)
 	exec_time = (cum_exec_time - cum_exec_time_prev) / delta_cycles_count;
 	mem_time  = (cum_mem_time  - cum_mem_time_prev)  / delta_cycles_count;
+	exec_time *= rtlib_configuration.profile.opencl.sampling;
+	mem_time  *= rtlib_configuration.profile.opencl.sampling;
 	logger->Fatal("OCL: Runtime profile %d cycles {exec_time=%d [us], mem_time=%d [us]}",
 				  delta_cycles_count, exec_time, mem_time);
 	cum_exec_time_prev = cum_exec_time;
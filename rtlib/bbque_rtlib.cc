@@ -63,12 +63,6 @@ RTLIB_Services_t rtlib_services;
  */
 RTLIB_OpenCL_t rtlib_ocl;
 
-/**
- * The map contains OpenCL command queues and shared pointers to profiling
- * events data structures
- */
-std::map<cl_command_queue, QueueProfPtr_t> ocl_queues_prof;
-
 /**
  * The map contains OpenCL command types and their respective string values
  */
@@ -173,6 +167,12 @@ static RTLIB_ExitCode_t rtlib_utils_get_resources_array(
 					array_size);
 }
 
+static RTLIB_ExitCode_t rtlib_utils_get_allocation(
+		RTLIB_EXCHandler_t exc_handler,
+		RTLIB_Allocation_t * allocation) {
+	return rpc->GetAllocation(exc_handler, allocation);
+}
+
 static void rtlib_utils_start_pcounters_monitoring(RTLIB_EXCHandler_t exc_handler) {
 	rpc->StartPCountersMonitoring(exc_handler);
 }
@@ -288,6 +288,7 @@ RTLIB_ExitCode_t RTLIB_Init(const char * name, RTLIB_Services_t ** rtlib)
 	rtlib_services.Utils.GetResourcesArray = rtlib_utils_get_resources_array;
 	rtlib_services.Utils.MonitorPerfCounters =
 		rtlib_utils_start_pcounters_monitoring;
+	rtlib_services.Utils.GetAllocation = rtlib_utils_get_allocation;
 	// Cycles Time Control interface
 	rtlib_services.CPS.Set = rtlib_cps_set;
 	rtlib_services.CPS.Get = rtlib_cps_get;
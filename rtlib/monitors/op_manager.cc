@@ -27,33 +27,18 @@ using namespace std;
 
 namespace bbque { namespace rtlib { namespace as {
 
-bool OPManager::operatingPointsComparator::operator()(const OperatingPoint &op1,
-						       const OperatingPoint &op2) const{
-	double val1;
-	double val2;
-	std::string mName;
-	for (unsigned int i=0; i < metricsPriorities.size(); ++i){
-		mName = metricsPriorities[i].metricName;
-		val1 = op1.metrics.find(mName)->second;
-		val2 = op2.metrics.find(mName)->second;
-		if (val1 == val2)
-			continue;
-		return metricsPriorities[i].comparisonFunction(val1, val2);
-	}
-	return false;
-}
-
 bool OPManager::getCurrentOP(OperatingPoint &op) {
-	op = operatingPoints[vectorId];
+	if (opTable.size() == 0)
+		return false;
+	selectOP(vectorId, op);
 	return true;
 }
 
 bool OPManager::getLowerOP(OperatingPoint &op) {
-	if (vectorId >= (operatingPoints.size()-1))
+	if (vectorId + 1 >= opTable.size())
 		return false;
 
-	vectorId++;
-	op = operatingPoints[vectorId];
+	selectOP(vectorId + 1, op);
 	return true;
 }
 
@@ -61,78 +46,63 @@ bool OPManager::getHigherOP(OperatingPoint &op) {
 	if (vectorId == 0)
 		return false;
 
-	op = operatingPoints[vectorId];
+	selectOP(vectorId - 1, op);
 	return true;
 }
 
-bool OPManager::isValidOP(const OperatingPoint &op,
-			   const OPFilterList &opFilters) const {
-
-	bool result = true;
-	OPFilterList::const_iterator filter = opFilters.begin();
-	std::map<std::string, double>::const_iterator mappedValue;
-
-	while (result && filter!=opFilters.end()) {
-		mappedValue = op.metrics.find(filter->name);
-		if (mappedValue == op.metrics.end())
-			return false;
-		result = (filter->cFunction(mappedValue->second, filter->value));
-		++filter;
-	}
-	return result;
-}
+bool OPManager::getCurrentOP(OperatingPoint &op, const OPFilterList &opFilters) {
+	OPTable::CompiledFilterList filters;
 
+	if (opTable.size() == 0)
+		return false;
 
-bool OPManager::getCurrentOP(OperatingPoint &op, const OPFilterList &opFilters) {
-	if (isValidOP(operatingPoints[vectorId], opFilters)){
-		op = operatingPoints[vectorId];
+	opTable.compileFilters(opFilters, filters);
+	if (opTable.isValid(vectorId, filters)) {
+		selectOP(vectorId, op);
 		return true;
 	}
-	/*
-	 * TODO Find a better search strategy. This one could be expensive even
-	 * if it is just O(n)
-	 */
-	if (getLowerOP(op,opFilters))
+	if (getLowerOP(op, filters))
 		return true;
-	return getHigherOP(op,opFilters);
+	return getHigherOP(op, filters);
 }
 
 bool OPManager::getLowerOP(OperatingPoint &op, const OPFilterList &opFilters) {
-	for (unsigned int id = vectorId + 1;id < operatingPoints.size(); ++id) {
-		if (isValidOP(operatingPoints[id],opFilters)){
-			vectorId = id;
-			op = operatingPoints[id];
-			return true;
-		}
-	}
-	return false;
+	OPTable::CompiledFilterList filters;
+	opTable.compileFilters(opFilters, filters);
+	return getLowerOP(op, filters);
 }
 
 bool OPManager::getHigherOP(OperatingPoint &op, const OPFilterList &opFilters) {
-	for (int id = vectorId-1;id > 0; --id){
-		if (isValidOP(operatingPoints[id], opFilters)){
-			vectorId = id;
-			op = operatingPoints[id];
-			return true;
-		}
-	}
-	return false;
+	OPTable::CompiledFilterList filters;
+	opTable.compileFilters(opFilters, filters);
+	return getHigherOP(op, filters);
+}
+
+bool OPManager::getLowerOP(OperatingPoint &op,
+			   const OPTable::CompiledFilterList &filters) {
+	uint32_t id = opTable.findFirst(vectorId + 1, opTable.size(), filters);
+	if (id == OPTable::NoPoint)
+		return false;
+	selectOP(id, op);
+	return true;
+}
+
+bool OPManager::getHigherOP(OperatingPoint &op,
+			    const OPTable::CompiledFilterList &filters) {
+	uint32_t id = opTable.findLast(0, vectorId, filters);
+	if (id == OPTable::NoPoint)
+		return false;
+	selectOP(id, op);
+	return true;
 }
 
 bool OPManager::getNextOP(OperatingPoint &op, const OPFilterList &opFilters) {
-	/*
-	 * TODO Find a better search strategy. This one could be expensive
-	 * even if it is just O(n)
-	 */
 	vectorId = 0;
 	return getCurrentOP(op, opFilters);
 }
 
 void OPManager::setPolicy(PrioritiesList &orderingStrategy) {
-	sort(operatingPoints.begin(),
-	     operatingPoints.end(),
-	     operatingPointsComparator(orderingStrategy));
-
+	opTable.setPolicy(orderingStrategy);
 	vectorId = 0;
 }
 
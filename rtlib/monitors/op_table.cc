@@ -0,0 +1,347 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <bbque/monitors/op_table.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+using namespace std;
+
+namespace bbque { namespace rtlib { namespace as {
+
+const int OPTable::NoColumn;
+const uint32_t OPTable::NoPoint;
+const uint32_t OPTable::BlockSize;
+
+void OPTable::setPoints(const OperatingPointsList &opList) {
+	pointsCount = opList.size();
+
+	// Resolve the metric names into columns
+	columnIds.clear();
+	for (const OperatingPoint &op : opList) {
+		for (const auto &metric : op.metrics)
+			columnIds.emplace(metric.first, 0);
+	}
+	int id = 0;
+	for (auto &column : columnIds)
+		column.second = id++;
+
+	// Store the values column-wise, NaN marking the missing metrics
+	pointsColumns.assign(columnIds.size(), vector<double>(pointsCount,
+				numeric_limits<double>::quiet_NaN()));
+	columnMissing.assign(columnIds.size(), false);
+	for (uint32_t pos = 0; pos < pointsCount; ++pos) {
+		for (const auto &metric : opList[pos].metrics)
+			pointsColumns[columnIds[metric.first]][pos] = metric.second;
+	}
+	for (size_t col = 0; col < pointsColumns.size(); ++col) {
+		for (double value : pointsColumns[col]) {
+			if (!std::isnan(value))
+				continue;
+			columnMissing[col] = true;
+			break;
+		}
+	}
+
+	// Rows in the order of the list, until a policy is set
+	sortedIndexes.clear();
+	order.resize(pointsCount);
+	iota(order.begin(), order.end(), 0);
+	columns = pointsColumns;
+	sortColumn = NoColumn;
+}
+
+void OPTable::setPolicy(const PrioritiesList &orderingStrategy) {
+	vector<const SortingFunction *> sortFunctions;
+	vector<int> sortColumns;
+	bool cacheable = true;
+	std::string signature;
+
+	// Resolve the priorities, building the signature of standard ones
+	for (const MetricPriority &priority : orderingStrategy) {
+		sortColumns.push_back(getColumn(priority.metricName));
+		sortFunctions.push_back(&priority.comparisonFunction);
+		if (priority.comparisonFunction.target<less<double>>())
+			signature += priority.metricName + "<\n";
+		else if (priority.comparisonFunction.target<greater<double>>())
+			signature += priority.metricName + ">\n";
+		else
+			cacheable = false;
+	}
+
+	// The highest priority metric allows binary searches, if monotonic
+	sortColumn = NoColumn;
+	if (!orderingStrategy.empty() && (sortColumns[0] != NoColumn) &&
+			!columnMissing[sortColumns[0]]) {
+		const SortingFunction &sortFunction(*sortFunctions[0]);
+		if (sortFunction.target<less<double>>()) {
+			sortColumn = sortColumns[0];
+			sortAscending = true;
+		}
+		else if (sortFunction.target<greater<double>>()) {
+			sortColumn = sortColumns[0];
+			sortAscending = false;
+		}
+	}
+
+	auto sorted_it = sortedIndexes.end();
+	if (cacheable)
+		sorted_it = sortedIndexes.find(signature);
+
+	if (sorted_it != sortedIndexes.end()) {
+		order = sorted_it->second;
+	}
+	else {
+		order.resize(pointsCount);
+		iota(order.begin(), order.end(), 0);
+		stable_sort(order.begin(), order.end(),
+			[&](uint32_t pos1, uint32_t pos2) {
+			for (size_t i = 0; i < sortColumns.size(); ++i) {
+				if (sortColumns[i] == NoColumn)
+					continue;
+				const vector<double> &values(pointsColumns[sortColumns[i]]);
+				double val1 = values[pos1];
+				double val2 = values[pos2];
+				if (val1 == val2)
+					continue;
+				// Points missing the metric go last
+				bool missing1 = std::isnan(val1);
+				bool missing2 = std::isnan(val2);
+				if (missing1 || missing2) {
+					if (missing1 && missing2)
+						continue;
+					return missing2;
+				}
+				return (*sortFunctions[i])(val1, val2);
+			}
+			return false;
+		});
+		if (cacheable)
+			sortedIndexes[signature] = order;
+	}
+
+	// Lay out the rows in the new order
+	columns.resize(pointsColumns.size());
+	for (size_t col = 0; col < pointsColumns.size(); ++col) {
+		const vector<double> &values(pointsColumns[col]);
+		columns[col].resize(pointsCount);
+		for (uint32_t row = 0; row < pointsCount; ++row)
+			columns[col][row] = values[order[row]];
+	}
+}
+
+int OPTable::getColumn(const std::string &metricName) const {
+	auto const column_it(columnIds.find(metricName));
+	if (column_it == columnIds.end())
+		return NoColumn;
+	return column_it->second;
+}
+
+void OPTable::compileFilters(const OPFilterList &opFilters,
+			     CompiledFilterList &filters) const {
+	filters.clear();
+	filters.reserve(opFilters.size());
+	for (const OPFilter &opFilter : opFilters) {
+		CompiledFilter filter;
+		filter.column = getColumn(opFilter.name);
+		filter.value = opFilter.value;
+		filter.cFunction = &opFilter.cFunction;
+		if (opFilter.cFunction.target<less<double>>())
+			filter.kind = CompiledFilter::LESS;
+		else if (opFilter.cFunction.target<less_equal<double>>())
+			filter.kind = CompiledFilter::LESS_EQUAL;
+		else if (opFilter.cFunction.target<greater<double>>())
+			filter.kind = CompiledFilter::GREATER;
+		else if (opFilter.cFunction.target<greater_equal<double>>())
+			filter.kind = CompiledFilter::GREATER_EQUAL;
+		else
+			filter.kind = CompiledFilter::CUSTOM;
+		filters.push_back(filter);
+	}
+}
+
+bool OPTable::isValid(uint32_t row, const CompiledFilterList &filters) const {
+	for (const CompiledFilter &filter : filters) {
+		if (filter.column == NoColumn)
+			return false;
+		double value = columns[filter.column][row];
+		if (std::isnan(value))
+			return false;
+
+		bool result;
+		switch (filter.kind) {
+		case CompiledFilter::LESS:
+			result = (value < filter.value);
+			break;
+		case CompiledFilter::LESS_EQUAL:
+			result = (value <= filter.value);
+			break;
+		case CompiledFilter::GREATER:
+			result = (value > filter.value);
+			break;
+		case CompiledFilter::GREATER_EQUAL:
+			result = (value >= filter.value);
+			break;
+		default:
+			result = (*filter.cFunction)(value, filter.value);
+		}
+		if (!result)
+			return false;
+	}
+	return true;
+}
+
+void OPTable::boundRange(const CompiledFilterList &filters,
+			 uint32_t &from, uint32_t &to) const {
+	if (sortColumn == NoColumn)
+		return;
+
+	const double *first = columns[sortColumn].data();
+	const double *last  = first + pointsCount;
+	for (const CompiledFilter &filter : filters) {
+		if ((filter.column != sortColumn) ||
+				(filter.kind == CompiledFilter::CUSTOM))
+			continue;
+
+		// The rows respecting the filter are either a prefix or a suffix
+		uint32_t lo = 0;
+		uint32_t hi = pointsCount;
+		if (sortAscending) {
+			switch (filter.kind) {
+			case CompiledFilter::LESS:
+				hi = lower_bound(first, last, filter.value) - first;
+				break;
+			case CompiledFilter::LESS_EQUAL:
+				hi = upper_bound(first, last, filter.value) - first;
+				break;
+			case CompiledFilter::GREATER:
+				lo = upper_bound(first, last, filter.value) - first;
+				break;
+			default:
+				lo = lower_bound(first, last, filter.value) - first;
+			}
+		}
+		else {
+			greater<double> desc;
+			switch (filter.kind) {
+			case CompiledFilter::GREATER:
+				hi = lower_bound(first, last, filter.value, desc) - first;
+				break;
+			case CompiledFilter::GREATER_EQUAL:
+				hi = upper_bound(first, last, filter.value, desc) - first;
+				break;
+			case CompiledFilter::LESS:
+				lo = upper_bound(first, last, filter.value, desc) - first;
+				break;
+			default:
+				lo = lower_bound(first, last, filter.value, desc) - first;
+			}
+		}
+
+		from = max(from, lo);
+		to   = min(to, hi);
+		if (from >= to) {
+			to = from;
+			return;
+		}
+	}
+}
+
+void OPTable::checkBlock(uint32_t from, uint32_t count,
+			 const CompiledFilterList &filters, uint8_t *mask) const {
+	fill(mask, mask + count, 1);
+	for (const CompiledFilter &filter : filters) {
+		if (filter.column == NoColumn) {
+			fill(mask, mask + count, 0);
+			return;
+		}
+
+		// Plain comparisons on contiguous values, which the compiler
+		// can vectorize. NaN values never pass them.
+		const double *values = columns[filter.column].data() + from;
+		const double bound = filter.value;
+		switch (filter.kind) {
+		case CompiledFilter::LESS:
+			for (uint32_t i = 0; i < count; ++i)
+				mask[i] &= (values[i] < bound);
+			break;
+		case CompiledFilter::LESS_EQUAL:
+			for (uint32_t i = 0; i < count; ++i)
+				mask[i] &= (values[i] <= bound);
+			break;
+		case CompiledFilter::GREATER:
+			for (uint32_t i = 0; i < count; ++i)
+				mask[i] &= (values[i] > bound);
+			break;
+		case CompiledFilter::GREATER_EQUAL:
+			for (uint32_t i = 0; i < count; ++i)
+				mask[i] &= (values[i] >= bound);
+			break;
+		default:
+			for (uint32_t i = 0; i < count; ++i) {
+				if (mask[i])
+					mask[i] = !std::isnan(values[i]) &&
+						(*filter.cFunction)(values[i], bound);
+			}
+		}
+	}
+}
+
+uint32_t OPTable::findFirst(uint32_t from, uint32_t to,
+			    const CompiledFilterList &filters) const {
+	uint8_t mask[BlockSize];
+
+	to = min(to, pointsCount);
+	boundRange(filters, from, to);
+	for (uint32_t start = from; start < to; start += BlockSize) {
+		uint32_t count = min(BlockSize, to - start);
+		checkBlock(start, count, filters, mask);
+		for (uint32_t i = 0; i < count; ++i) {
+			if (mask[i])
+				return start + i;
+		}
+	}
+	return NoPoint;
+}
+
+uint32_t OPTable::findLast(uint32_t from, uint32_t to,
+			   const CompiledFilterList &filters) const {
+	uint8_t mask[BlockSize];
+
+	to = min(to, pointsCount);
+	boundRange(filters, from, to);
+	while (to > from) {
+		uint32_t count = min(BlockSize, to - from);
+		uint32_t start = to - count;
+		checkBlock(start, count, filters, mask);
+		for (uint32_t i = count; i > 0; --i) {
+			if (mask[i - 1])
+				return start + i - 1;
+		}
+		to = start;
+	}
+	return NoPoint;
+}
+
+} // namespace as
+
+} // namespace rtlib
+
+} // namespace bbque
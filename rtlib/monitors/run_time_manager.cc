@@ -31,17 +31,14 @@ void RunTimeManager::setGoals(GoalsList &goalsList) {
 bool RunTimeManager::checkGoals(GoalInfoList &goalsInfo) {
 
 	bool result = true;
-	GoalInfoPtr goalInfo;
 
-	goalsInfo.clear();
-	goalsInfo.reserve(goalsList.size());
+	// Reuse the GoalInfo of the previous checks, unless shared elsewhere
+	goalsInfo.resize(goalsList.size());
 
-	GoalsList::const_iterator it;
-
-	for (it = goalsList.begin(); it != goalsList.end(); ++it) {
-		goalInfo = (*it)->fullCheckGoal();
-		goalsInfo.push_back(goalInfo);
-		result = result && goalInfo->isAchieved();
+	for (size_t i = 0; i < goalsList.size(); ++i) {
+		if (!goalsInfo[i] || !goalsInfo[i].unique())
+			goalsInfo[i] = std::make_shared<GoalInfo>();
+		result = goalsList[i]->fullCheckGoal(*goalsInfo[i]) && result;
 	}
 
 	return result;
@@ -166,32 +163,19 @@ void RunTimeManager::adjustConstraints(const OperatingPoint &currentOp,
 void RunTimeManager::getNapAndRelativeError(const GoalInfoList &goalsInfo,
 		uint8_t &maxNap, float &maxRelativeError) {
 
-	vector<uint8_t> maxNaps;
-	vector<double> maxRelativeErrors;
 	GoalInfoList::const_iterator it;
-
-	maxNaps.reserve(goalsInfo.size());
-	maxRelativeErrors.reserve(goalsInfo.size());
-
-
-	for (it = goalsInfo.begin(); it != goalsInfo.end(); ++it) {
-		maxNaps.push_back((*it)->getMaxNap());
-		maxRelativeErrors.push_back((*it)->getMaxRelativeError());
-	}
-
-
 	double absRelError;
+
+	maxNap = 0;
 	maxRelativeError = 0;
-	std::vector<double>::const_iterator maxRit;
 
-	for (uint8_t i=0;i<maxRelativeErrors.size();++i) {
-		absRelError = fabs(maxRelativeErrors.at(i));
+	// A single pass over the goals, without temporary vectors
+	for (it = goalsInfo.begin(); it != goalsInfo.end(); ++it) {
+		maxNap = std::max(maxNap, (*it)->getMaxNap());
+		absRelError = fabs((*it)->getMaxRelativeError());
 		if (absRelError > maxRelativeError)
 			maxRelativeError = absRelError;
 	}
-
-	maxNap = *max_element(maxNaps.begin(), maxNaps.end());
-
 }
 
 bool RunTimeManager::getNextOp(OperatingPoint& op,
@@ -202,8 +186,6 @@ bool RunTimeManager::getNextOp(OperatingPoint& op,
 	bool goalAchieved;
 	float maxRelativeError;
 
-	GoalInfoList goalsInfo;
-
 	if (goalsList.empty())
 		return false;
 
@@ -184,6 +184,11 @@ void BbqueRPC_FIFO_Client::ChannelFetch()
 		RpcBbqGetRuntimeProfile();
 		break;
 
+	case RPC_BBQ_RESIZE:
+		logger->Debug("BBQ_RESIZE");
+		RpcBbqResize();
+		break;
+
 	case RPC_BBQ_SYNCP_PRECHANGE:
 		logger->Debug("BBQ_SYNCP_PRECHANGE");
 		RpcBbqSyncpPreChange();
@@ -565,7 +570,8 @@ RTLIB_ExitCode_t BbqueRPC_FIFO_Client::_Clear(pRegisteredEXC_t prec)
 }
 
 RTLIB_ExitCode_t BbqueRPC_FIFO_Client::_RTNotify(pRegisteredEXC_t prec, int gap,
-						 int cpu_usage, int cycle_time_ms)
+						 int cpu_usage, int cycle_time_ms,
+						 float llc_mpkc, uint32_t mem_bw_mbps)
 {
 	std::unique_lock<std::mutex> chCommand_ul(chCommand_mtx);
 	rpc_fifo_EXC_RTNOTIFY_t rf_EXC_RTNOTIFY = {
@@ -584,6 +590,8 @@ RTLIB_ExitCode_t BbqueRPC_FIFO_Client::_RTNotify(pRegisteredEXC_t prec, int gap,
 			gap,
 			cpu_usage,
 			cycle_time_ms,
+			llc_mpkc,
+			mem_bw_mbps,
 		}
 	};
 	logger->Debug("Set Goal-Gap for EXC [%d:%d]...",
@@ -861,6 +869,24 @@ void BbqueRPC_FIFO_Client::RpcBbqGetRuntimeProfile()
 	GetRuntimeProfile(msg);
 }
 
+void BbqueRPC_FIFO_Client::RpcBbqResize()
+{
+	rpc_msg_BBQ_RESIZE_t msg;
+	size_t bytes;
+	// Read RPC notification
+	bytes = ::read(client_fifo_fd, (void *) &msg,
+		RPC_PKT_SIZE(BBQ_RESIZE));
+
+	if (bytes <= 0) {
+		logger->Error("FAILED read from app fifo [%s] (Error %d: %s)",
+			app_fifo_path.c_str(), errno, strerror(errno));
+		return;
+	}
+
+	// Update the resources assigned (no response expected)
+	ResizeNotify(msg);
+}
+
 RTLIB_ExitCode_t BbqueRPC_FIFO_Client::_GetRuntimeProfileResp(
 							      rpc_msg_token_t token,
 							      pRegisteredEXC_t prec,
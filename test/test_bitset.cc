@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tests.h"
+
+#include <bitset>
+
+#include <bbque/res/bitset.h>
+
+// These are a set of useful debugging log formatters
+#define FMT_DBG(fmt) BBQUE_FMT(COLOR_LGRAY,  "BITSET     [DBG]", fmt)
+#define FMT_INF(fmt) BBQUE_FMT(COLOR_GREEN,  "BITSET     [INF]", fmt)
+#define FMT_WRN(fmt) BBQUE_FMT(COLOR_YELLOW, "BITSET     [WRN]", fmt)
+#define FMT_ERR(fmt) BBQUE_FMT(COLOR_RED,    "BITSET     [ERR]", fmt)
+
+using bbque::res::ResourceBitset;
+
+// The number of bits of the benchmark sets (e.g., processing elements)
+#define BS_BITS      1024
+// The number of iterations of each benchmark
+#define BS_LOOPS     10000
+
+/** The reference implementation */
+typedef std::bitset<BS_BITS> RefBitset_t;
+
+/**
+ * The cpuset-like ranges string of the reference set
+ */
+static std::string refToStringCG(RefBitset_t const & ref) {
+	std::string str;
+	for (int pos = 0; pos < BS_BITS; ++pos) {
+		if (!ref.test(pos))
+			continue;
+		int end = pos;
+		while ((end + 1 < BS_BITS) && ref.test(end + 1))
+			++end;
+		if (!str.empty())
+			str += ",";
+		str += std::to_string(pos);
+		if (end > pos)
+			str += "-" + std::to_string(end);
+		pos = end;
+	}
+	return str;
+}
+
+/**
+ * Check a set against the reference one
+ */
+static bool checkSet(ResourceBitset const & bs, RefBitset_t const & ref) {
+	if (bs.Count() != (BBQUE_RID_TYPE) ref.count()) {
+		fprintf(stderr, FMT_ERR("Count mismatch [%d != %zu]\n"),
+				bs.Count(), ref.count());
+		return false;
+	}
+
+	// Iteration over the bits set only
+	size_t visited = 0;
+	BBQUE_RID_TYPE last = R_ID_NONE;
+	for (BBQUE_RID_TYPE id = bs.FirstSet(); id >= 0; id = bs.NextSet(id)) {
+		if (!ref.test(id)) {
+			fprintf(stderr, FMT_ERR("Bit [%d] not expected\n"), id);
+			return false;
+		}
+		last = id;
+		++visited;
+	}
+	if ((visited != ref.count()) || (bs.LastSet() != last)) {
+		fprintf(stderr, FMT_ERR("Iteration mismatch [visited=%zu last=%d]\n"),
+				visited, bs.LastSet());
+		return false;
+	}
+
+	if (bs.ToStringCG() != refToStringCG(ref)) {
+		fprintf(stderr, FMT_ERR("String mismatch [%s != %s]\n"),
+				bs.ToStringCG().c_str(), refToStringCG(ref).c_str());
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * Fill a set and the reference one with random bits
+ */
+static void fillRandom(ResourceBitset & bs, RefBitset_t & ref,
+		std::uniform_int_distribution<int> & pos_dist, size_t count) {
+	for (size_t i = 0; i < count; ++i) {
+		int pos = pos_dist(rng_engine);
+		bs.Set(pos);
+		ref.set(pos);
+	}
+}
+
+/**
+ * Check the operators against the reference implementation
+ */
+static TestResult_t checkOperators() {
+	std::uniform_int_distribution<int> pos_dist(0, BS_BITS - 1);
+
+	for (int run = 0; run < 100; ++run) {
+		ResourceBitset a, b;
+		RefBitset_t ref_a, ref_b;
+		fillRandom(a, ref_a, pos_dist, run * 4);
+		fillRandom(b, ref_b, pos_dist, run * 2);
+		if (!checkSet(a, ref_a) || !checkSet(b, ref_b))
+			return TEST_FAILED;
+
+		// Single bit reset
+		int pos = pos_dist(rng_engine);
+		a.Reset(pos);
+		ref_a.reset(pos);
+		if (!checkSet(a, ref_a))
+			return TEST_FAILED;
+
+		if (a.Intersects(b) != (ref_a & ref_b).any()) {
+			fprintf(stderr, FMT_ERR("Intersects mismatch\n"));
+			return TEST_FAILED;
+		}
+
+		ResourceBitset c(a);
+		c |= b;
+		if (!checkSet(c, ref_a | ref_b))
+			return TEST_FAILED;
+		c = a;
+		c &= b;
+		if (!checkSet(c, ref_a & ref_b))
+			return TEST_FAILED;
+		c = a;
+		c -= b;
+		if (!checkSet(c, ref_a & ~ref_b))
+			return TEST_FAILED;
+	}
+
+	fprintf(stderr, FMT_INF("Operators matching the reference\n"));
+	return TEST_PASSED;
+}
+
+/**
+ * Benchmark the common accesses of the platform proxies and the policies
+ */
+static void runBenchmarks() {
+	std::uniform_int_distribution<int> pos_dist(0, BS_BITS - 1);
+	bbque::utils::Timer tmr;
+	ResourceBitset a, b;
+	RefBitset_t ref_a, ref_b;
+	fillRandom(a, ref_a, pos_dist, BS_BITS / 4);
+	fillRandom(b, ref_b, pos_dist, BS_BITS / 4);
+	BBQUE_RID_TYPE nr_set = a.Count();
+	volatile long sink = 0;
+
+	// Iteration over the bits set
+	tmr.start();
+	for (int i = 0; i < BS_LOOPS; ++i)
+		for (BBQUE_RID_TYPE id = a.FirstSet(); id >= 0; id = a.NextSet(id))
+			sink += id;
+	double next_ms = tmr.getElapsedTimeMs();
+
+	// The former idiom: testing each position up to the highest one
+	tmr.start();
+	for (int i = 0; i < BS_LOOPS; ++i)
+		for (BBQUE_RID_TYPE id = a.FirstSet(); id <= a.LastSet(); ++id)
+			if (a.Test(id))
+				sink += id;
+	double test_ms = tmr.getElapsedTimeMs();
+
+	// Set operations
+	tmr.start();
+	for (int i = 0; i < BS_LOOPS; ++i) {
+		ResourceBitset c(a);
+		c |= b;
+		c &= a;
+		c -= b;
+		sink += c.Count();
+	}
+	double ops_ms = tmr.getElapsedTimeMs();
+
+	// Cached cpuset string
+	tmr.start();
+	for (int i = 0; i < BS_LOOPS; ++i)
+		sink += a.ToStringCG().size();
+	double cg_cached_ms = tmr.getElapsedTimeMs();
+
+	// Cpuset string rebuilt at each update
+	tmr.start();
+	for (int i = 0; i < BS_LOOPS; ++i) {
+		a.Set(pos_dist(rng_engine));
+		sink += a.ToStringCG().size();
+	}
+	double cg_update_ms = tmr.getElapsedTimeMs();
+	(void) sink;
+
+	fprintf(stderr, FMT_INF("Benchmark: %d loops on %d bits [%d set]\n"),
+			BS_LOOPS, BS_BITS, nr_set);
+	fprintf(stderr, FMT_INF("  NextSet iteration : %9.3f[ms]\n"), next_ms);
+	fprintf(stderr, FMT_INF("  Test iteration    : %9.3f[ms]\n"), test_ms);
+	fprintf(stderr, FMT_INF("  |= &= -= Count    : %9.3f[ms]\n"), ops_ms);
+	fprintf(stderr, FMT_INF("  ToStringCG cached : %9.3f[ms]\n"), cg_cached_ms);
+	fprintf(stderr, FMT_INF("  ToStringCG update : %9.3f[ms]\n"), cg_update_ms);
+}
+
+TestResult_t test_bitset(int argc, char *argv[]) {
+	(void)argc;
+	(void)argv;
+
+	// Growing beyond the pre-allocated size
+	ResourceBitset bs(8);
+	RefBitset_t ref;
+	for (int pos: {0, 1, 2, 3, 7, 63, 64, 65, 200, BS_BITS - 1}) {
+		bs.Set(pos);
+		ref.set(pos);
+	}
+	if (!checkSet(bs, ref))
+		return TEST_FAILED;
+	if (bs.ToStringCG() != "0-3,7,63-65,200,1023") {
+		fprintf(stderr, FMT_ERR("Unexpected string [%s]\n"),
+				bs.ToStringCG().c_str());
+		return TEST_FAILED;
+	}
+	bs.Reset();
+	if (!bs.None() || (bs.FirstSet() != R_ID_NONE) || !bs.ToStringCG().empty())
+		return TEST_FAILED;
+
+	if (checkOperators() != TEST_PASSED)
+		return TEST_FAILED;
+
+	runBenchmarks();
+	return TEST_PASSED;
+}
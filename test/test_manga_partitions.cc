@@ -0,0 +1,293 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+#include <libhn/hn.h>
+
+// The task graph headers bring in the daemon logging formatter, which is
+// replaced by the one of the tests
+#include "partition_scorer.h"
+#include "tg/task.h"
+#include "tg/mem_buffer.h"
+#undef BBQUE_FMT
+
+#include "tests.h"
+
+// These are a set of useful debugging log formatters
+#define FMT_DBG(fmt) BBQUE_FMT(COLOR_LGRAY,  "MANGA_PART [DBG]", fmt)
+#define FMT_INF(fmt) BBQUE_FMT(COLOR_GREEN,  "MANGA_PART [INF]", fmt)
+#define FMT_WRN(fmt) BBQUE_FMT(COLOR_YELLOW, "MANGA_PART [WRN]", fmt)
+#define FMT_ERR(fmt) BBQUE_FMT(COLOR_RED,    "MANGA_PART [ERR]", fmt)
+
+using bbque::Bandwidth_t;
+using bbque::Buffer;
+using bbque::BufferMap_t;
+using bbque::Partition;
+using bbque::Task;
+using bbque::TaskGraph;
+using bbque::TaskMap_t;
+using bbque::plugins::PartitionScorer;
+
+// The simulated mesh of tiles
+#define MP_TILES_X      8
+#define MP_TILES_Y      8
+// The number of tasks of the pipeline task graphs
+#define MP_TASKS        6
+// The number of candidate partitions requested to the HN library
+#define MP_MAX_PARTS    64
+// The number of iterations of each benchmark
+#define MP_LOOPS        200
+
+/**
+ * A pipeline: each task reads the buffer written by the previous one
+ */
+static TaskGraph buildPipeline(uint32_t nr_tasks, uint32_t kbps) {
+	TaskMap_t tasks;
+	BufferMap_t buffers;
+	for (uint32_t b = 0; b <= nr_tasks; ++b)
+		buffers.emplace(b, boost::make_shared<Buffer>(b, 1 << 20));
+	for (uint32_t t = 0; t < nr_tasks; ++t) {
+		auto task = boost::make_shared<Task>(t);
+		task->AddInputBuffer(t);
+		task->AddOutputBuffer(t + 1);
+		Bandwidth_t bw;
+		bw.in_kbps  = kbps;
+		bw.out_kbps = kbps;
+		task->SetAssignedBandwidth(bw);
+		tasks.emplace(t, task);
+	}
+	return TaskGraph(tasks, buffers);
+}
+
+/**
+ * The HN request of a task graph, as filled by the MANGO platform proxy:
+ * the buffers of the graph, then a kernel image per task
+ */
+static hn_st_req buildRequest(TaskGraph const & tg) {
+	hn_st_req req = {};
+	req.num_comp_rsc    = tg.TaskCount();
+	req.num_mem_buffers = tg.BufferCount() + tg.TaskCount();
+	uint32_t i = 0;
+	for (auto const & b : tg.Buffers())
+		req.mem_buffers_size[i++] = b.second->Size();
+	i = 0;
+	for (auto const & t : tg.Tasks()) {
+		req.comp_rsc_types[i] = HN_PEAK_TYPE_1;
+		for (uint32_t buffer_id : t.second->InputBuffers())
+			req.bw_read_req[i][buffer_id] = 1;
+		for (uint32_t buffer_id : t.second->OutputBuffers())
+			req.bw_write_req[i][buffer_id] = 1;
+		uint32_t kimage = tg.BufferCount() + i;
+		req.mem_buffers_size[kimage] = 64 << 10;
+		req.bw_read_req[i][kimage] = 1;
+		++i;
+	}
+	return req;
+}
+
+/**
+ * The partition of a HN response, as built by the MANGO platform proxy
+ */
+static Partition buildPartition(TaskGraph const & tg, hn_st_response const & res,
+		uint32_t id) {
+	Partition part(id);
+	uint32_t nr_buffers = tg.BufferCount();
+	uint32_t i = 0;
+	for (auto const & t : tg.Tasks()) {
+		part.MapTask(t.second, res.comp_rsc_tiles[i],
+			res.mem_buffers_tiles[nr_buffers + i],
+			res.mem_buffers_addr[nr_buffers + i]);
+		++i;
+	}
+	i = 0;
+	for (auto const & b : tg.Buffers()) {
+		part.MapBuffer(b.second, res.mem_buffers_tiles[i],
+			res.mem_buffers_addr[i]);
+		++i;
+	}
+	return part;
+}
+
+/**
+ * Find the candidate partitions of a task graph
+ */
+static bool findPartitions(TaskGraph const & tg, std::vector<Partition> & parts) {
+	static hn_st_response res[MP_MAX_PARTS];
+	uint32_t ids[MP_MAX_PARTS];
+	uint32_t num_parts = 0;
+	parts.clear();
+	if (hn_find_partitions(buildRequest(tg), res, ids, MP_MAX_PARTS,
+			&num_parts) != HN_SUCCEEDED)
+		return false;
+	for (uint32_t i = 0; i < num_parts; ++i)
+		parts.push_back(buildPartition(tg, res[i], ids[i]));
+	return true;
+}
+
+/**
+ * Check the selection on hand-made partitions of a task graph
+ */
+static TestResult_t checkSelection() {
+	PartitionScorer scorer(MP_TILES_X);
+	TaskGraph tg(buildPipeline(2, 1000));
+	auto const & t0 = tg.Tasks().at(0);
+	auto const & t1 = tg.Tasks().at(1);
+
+	// Tasks next to the banks (tiles 0 and 8, first column)
+	Partition near(0);
+	near.MapTask(t0, 1, 0, 0);
+	near.MapTask(t1, 9, 8, 0);
+	// Tasks in the middle of the mesh, same banks
+	Partition far(1);
+	far.MapTask(t0, 3, 0, 0);
+	far.MapTask(t1, 12, 8, 0);
+	// Missing the mapping of a task
+	Partition partial(2);
+	partial.MapTask(t0, 1, 0, 0);
+	for (Partition * part : {&near, &far, &partial}) {
+		for (auto const & b : tg.Buffers())
+			part->MapBuffer(b.second, (b.first == 0) ? 0 : 8, 0);
+	}
+
+	std::vector<const Partition *> candidates = {&far, &partial, &near};
+	std::vector<PartitionScorer::PartitionCost_t> costs;
+	std::vector<double> scores;
+	size_t best = scorer.SelectBest(tg, candidates, costs, scores);
+	if ((best != 2) || !std::isinf(scores[1]) || (scores[2] >= scores[0])) {
+		fprintf(stderr, FMT_ERR("Unexpected selection [best=%zu]\n"), best);
+		return TEST_FAILED;
+	}
+
+	// The hops from a tile on the second row, to a bank on the first one
+	if (scorer.Hops(9, 0) != 2) {
+		fprintf(stderr, FMT_ERR("Unexpected hops [%d]\n"), scorer.Hops(9, 0));
+		return TEST_FAILED;
+	}
+
+	// The load of a partition selected makes the same banks less appealing
+	scorer.UpdateBanksLoad(tg, near);
+	std::vector<PartitionScorer::PartitionCost_t> loaded_costs;
+	scorer.EvaluatePartitions(tg, candidates, loaded_costs);
+	if (loaded_costs[2].memory <= costs[2].memory) {
+		fprintf(stderr, FMT_ERR("Banks load not accounted\n"));
+		return TEST_FAILED;
+	}
+
+	fprintf(stderr, FMT_INF("Selection of the closest partition\n"));
+	return TEST_PASSED;
+}
+
+/**
+ * Benchmark the partition search and scoring on the simulated platform
+ */
+static TestResult_t runBenchmarks() {
+	uint32_t nr_tiles, tiles_x, tiles_y;
+	hn_get_num_tiles(&nr_tiles, &tiles_x, &tiles_y);
+	PartitionScorer scorer(tiles_x);
+	TaskGraph tg(buildPipeline(MP_TASKS, 4000));
+	std::vector<Partition> parts;
+	std::vector<const Partition *> candidates;
+	std::vector<PartitionScorer::PartitionCost_t> costs;
+	std::vector<double> scores;
+	bbque::utils::Timer tmr;
+
+	// Partition search
+	tmr.start();
+	for (int i = 0; i < MP_LOOPS; ++i) {
+		if (!findPartitions(tg, parts) || parts.empty()) {
+			fprintf(stderr, FMT_ERR("No partition found\n"));
+			return TEST_FAILED;
+		}
+	}
+	double find_ms = tmr.getElapsedTimeMs();
+	size_t nr_candidates = parts.size();
+	for (auto const & part : parts)
+		candidates.push_back(&part);
+
+	// Scoring, on the calling thread only
+	tmr.start();
+	for (int i = 0; i < MP_LOOPS; ++i) {
+		costs.assign(candidates.size(), PartitionScorer::PartitionCost_t());
+		for (size_t c = 0; c < candidates.size(); ++c)
+			scorer.EvaluatePartition(tg, *candidates[c], costs[c]);
+	}
+	double serial_ms = tmr.getElapsedTimeMs();
+
+	// Scoring, in parallel over the candidates
+	tmr.start();
+	for (int i = 0; i < MP_LOOPS; ++i)
+		scorer.SelectBest(tg, candidates, costs, scores);
+	double parallel_ms = tmr.getElapsedTimeMs();
+
+	// Allocate the best partitions, until the platform is full
+	int nr_allocated = 0;
+	tmr.start();
+	while (findPartitions(tg, parts) && !parts.empty()) {
+		candidates.clear();
+		for (auto const & part : parts)
+			candidates.push_back(&part);
+		size_t best = scorer.SelectBest(tg, candidates, costs, scores);
+		if ((best == candidates.size()) ||
+				(hn_allocate_partition(parts[best].GetId()) != HN_SUCCEEDED))
+			break;
+		scorer.UpdateBanksLoad(tg, parts[best]);
+		++nr_allocated;
+	}
+	double fill_ms = tmr.getElapsedTimeMs();
+	hn_reset(0);
+
+	if (nr_allocated < int(nr_tiles / MP_TASKS) - 1) {
+		fprintf(stderr, FMT_ERR("Only %d task graphs allocated\n"),
+				nr_allocated);
+		return TEST_FAILED;
+	}
+
+	fprintf(stderr, FMT_INF("Benchmark: %d loops, %dx%d mesh, %d tasks\n"),
+			MP_LOOPS, tiles_x, tiles_y, MP_TASKS);
+	fprintf(stderr, FMT_INF("  Partition search  : %9.3f[ms] [%zu candidates]\n"),
+			find_ms, nr_candidates);
+	fprintf(stderr, FMT_INF("  Scoring (serial)  : %9.3f[ms]\n"), serial_ms);
+	fprintf(stderr, FMT_INF("  Scoring (parallel): %9.3f[ms]\n"), parallel_ms);
+	fprintf(stderr, FMT_INF("  Platform filling  : %9.3f[ms] [%d graphs]\n"),
+			fill_ms, nr_allocated);
+	return TEST_PASSED;
+}
+
+TestResult_t test_manga_partitions(int argc, char *argv[]) {
+	(void)argc;
+	(void)argv;
+
+	if (checkSelection() != TEST_PASSED)
+		return TEST_FAILED;
+
+	// The mesh geometry, unless overridden by the environment
+	setenv("HN_SIM_TILES_X", std::to_string(MP_TILES_X).c_str(), 0);
+	setenv("HN_SIM_TILES_Y", std::to_string(MP_TILES_Y).c_str(), 0);
+	hn_daemon_socket_filter filter = {TARGET_MANGO, APPL_MODE_SYNC_READS, 0, 0};
+	if (hn_initialize(filter, UPV_PARTITION_STRATEGY, 1, 0) != HN_SUCCEEDED) {
+		fprintf(stderr, FMT_ERR("Simulated platform initialization failed\n"));
+		return TEST_FAILED;
+	}
+
+	TestResult_t result = runBenchmarks();
+	hn_end();
+	return result;
+}
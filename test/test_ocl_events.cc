@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tests.h"
+
+#include <atomic>
+#include <map>
+#include <mutex>
+
+#include <bbque/rtlib/bbque_ocl.h>
+
+// These are a set of useful debugging log formatters
+#define FMT_DBG(fmt) BBQUE_FMT(COLOR_LGRAY,  "OCL_EVENTS [DBG]", fmt)
+#define FMT_INF(fmt) BBQUE_FMT(COLOR_GREEN,  "OCL_EVENTS [INF]", fmt)
+#define FMT_WRN(fmt) BBQUE_FMT(COLOR_YELLOW, "OCL_EVENTS [WRN]", fmt)
+#define FMT_ERR(fmt) BBQUE_FMT(COLOR_RED,    "OCL_EVENTS [ERR]", fmt)
+
+// The OpenCL calls forwarded by the RTLib
+extern RTLIB_OpenCL_t rtlib_ocl;
+
+/*******************************************************************************
+ *  Mock ICD: reference counted queues and events, without a device
+ ******************************************************************************/
+
+struct _cl_command_queue {
+	cl_uint refs;
+};
+
+struct _cl_event {
+	cl_uint refs;
+	cl_command_queue queue;
+};
+
+/** Events not released yet */
+static std::atomic<int> mock_live_events(0);
+
+/** Commands profiled (end time read), per command queue */
+static std::map<cl_command_queue, int> mock_profiled;
+
+static cl_ulong mock_time_ns = 0;
+
+/** The RTLib drainer reads the events from its own thread */
+static std::mutex mock_mtx;
+
+static cl_int mock_enqueueNDRangeKernel(cl_command_queue queue, cl_kernel,
+		cl_uint, const size_t *, const size_t *, const size_t *, cl_uint,
+		const cl_event *, cl_event * event) {
+	if (event == nullptr)
+		return CL_SUCCESS;
+	*event = new _cl_event{1, queue};
+	++mock_live_events;
+	return CL_SUCCESS;
+}
+
+static cl_int mock_retainEvent(cl_event event) {
+	std::unique_lock<std::mutex> mock_ul(mock_mtx);
+	++event->refs;
+	return CL_SUCCESS;
+}
+
+static cl_int mock_releaseEvent(cl_event event) {
+	std::unique_lock<std::mutex> mock_ul(mock_mtx);
+	if (event->refs == 0)
+		return CL_INVALID_EVENT;
+	if (--event->refs == 0) {
+		delete event;
+		--mock_live_events;
+	}
+	return CL_SUCCESS;
+}
+
+static cl_int mock_waitForEvents(cl_uint, const cl_event *) {
+	return CL_SUCCESS;
+}
+
+static cl_int mock_getEventInfo(cl_event, cl_event_info param_name,
+		size_t, void * param_value, size_t *) {
+	if (param_name != CL_EVENT_COMMAND_TYPE)
+		return CL_INVALID_VALUE;
+	*(cl_command_type *) param_value = CL_COMMAND_NDRANGE_KERNEL;
+	return CL_SUCCESS;
+}
+
+static cl_int mock_getEventProfilingInfo(cl_event event,
+		cl_profiling_info param_name, size_t, void * param_value, size_t *) {
+	std::unique_lock<std::mutex> mock_ul(mock_mtx);
+	if (param_name == CL_PROFILING_COMMAND_END)
+		++mock_profiled[event->queue];
+	*(cl_ulong *) param_value = (mock_time_ns += 1000);
+	return CL_SUCCESS;
+}
+
+static cl_int mock_getCommandQueueInfo(cl_command_queue queue,
+		cl_command_queue_info param_name, size_t, void * param_value,
+		size_t *) {
+	if (param_name != CL_QUEUE_REFERENCE_COUNT)
+		return CL_INVALID_VALUE;
+	*(cl_uint *) param_value = queue->refs;
+	return CL_SUCCESS;
+}
+
+static cl_int mock_retainCommandQueue(cl_command_queue queue) {
+	++queue->refs;
+	return CL_SUCCESS;
+}
+
+static cl_int mock_releaseCommandQueue(cl_command_queue queue) {
+	if (--queue->refs == 0)
+		delete queue;
+	return CL_SUCCESS;
+}
+
+static void mockInstall() {
+	rtlib_ocl.enqueueNDRangeKernel  = mock_enqueueNDRangeKernel;
+	rtlib_ocl.retainEvent           = mock_retainEvent;
+	rtlib_ocl.releaseEvent          = mock_releaseEvent;
+	rtlib_ocl.waitForEvents         = mock_waitForEvents;
+	rtlib_ocl.getEventInfo          = mock_getEventInfo;
+	rtlib_ocl.getEventProfilingInfo = mock_getEventProfilingInfo;
+	rtlib_ocl.getCommandQueueInfo   = mock_getCommandQueueInfo;
+	rtlib_ocl.retainCommandQueue    = mock_retainCommandQueue;
+	rtlib_ocl.releaseCommandQueue   = mock_releaseCommandQueue;
+}
+
+/*******************************************************************************
+ *  Test
+ ******************************************************************************/
+
+static void enqueueCommands(cl_command_queue queue, int count, bool app_event) {
+	size_t global_size = 64;
+	for (int i = 0; i < count; ++i) {
+		cl_event event = nullptr;
+		clEnqueueNDRangeKernel(queue, nullptr, 1, nullptr, &global_size,
+			nullptr, 0, nullptr, app_event ? &event : nullptr);
+		if (app_event)
+			clReleaseEvent(event);
+	}
+}
+
+static bool checkEvents(const char * step) {
+	rtlib_ocl_flush_events();
+	if (mock_live_events != 0) {
+		fprintf(stderr, FMT_ERR("%s: %d events leaked\n"),
+			step, mock_live_events.load());
+		return false;
+	}
+	fprintf(stderr, FMT_INF("%s: no events leaked\n"), step);
+	return true;
+}
+
+TestResult_t test_ocl_events(int argc, char *argv[]) {
+	(void)argc;
+	(void)argv;
+
+	rtlib_ocl_init();
+	mockInstall();
+
+	cl_command_queue queue = new _cl_command_queue{1};
+
+	// Profiling disabled
+	enqueueCommands(queue, 100, false);
+	enqueueCommands(queue, 100, true);
+	if (!checkEvents("Profiling disabled"))
+		return TEST_FAILED;
+
+	// Profiling enabled: only one command every 4 is pushed into the ring,
+	// the local events of the others must be released anyway
+	rtlib_ocl_prof_setup(4);
+	enqueueCommands(queue, 100, false);
+	if (!checkEvents("Profiling, local events"))
+		return TEST_FAILED;
+	enqueueCommands(queue, 100, true);
+	if (!checkEvents("Profiling, application events"))
+		return TEST_FAILED;
+
+	// The rings of the command queues released are recycled
+	clReleaseCommandQueue(queue);
+	for (int i = 0; i < 2 * RTLIB_OCL_MAX_QUEUES; ++i) {
+		cl_command_queue tmp_queue = new _cl_command_queue{1};
+		enqueueCommands(tmp_queue, 1, false);
+		clReleaseCommandQueue(tmp_queue);
+		std::unique_lock<std::mutex> mock_ul(mock_mtx);
+		if (mock_profiled[tmp_queue] == 0) {
+			fprintf(stderr, FMT_ERR("Command queue #%d not profiled\n"), i);
+			return TEST_FAILED;
+		}
+		mock_profiled.erase(tmp_queue);
+	}
+	fprintf(stderr, FMT_INF("Command queues rings recycled\n"));
+	if (!checkEvents("Command queues released"))
+		return TEST_FAILED;
+
+	return TEST_PASSED;
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tests.h"
+
+#include <algorithm>
+
+#include <bbque/monitors/op_manager.h>
+
+// These are a set of useful debugging log formatters
+#define FMT_DBG(fmt) BBQUE_FMT(COLOR_LGRAY,  "OPMGR      [DBG]", fmt)
+#define FMT_INF(fmt) BBQUE_FMT(COLOR_GREEN,  "OPMGR      [INF]", fmt)
+#define FMT_WRN(fmt) BBQUE_FMT(COLOR_YELLOW, "OPMGR      [WRN]", fmt)
+#define FMT_ERR(fmt) BBQUE_FMT(COLOR_RED,    "OPMGR      [ERR]", fmt)
+
+using namespace bbque::rtlib::as;
+
+// The number of operating points of the benchmark list
+#define OP_COUNT     10000
+// The number of operating point selections to run
+#define OP_LOOKUPS   1000
+
+/**
+ * The reference selection: the first point, in priority order, respecting
+ * all the filters, with the metrics looked up by name
+ */
+static int refNextOP(OperatingPointsList const & opList,
+		OPFilterList const & opFilters) {
+	for (size_t id = 0; id < opList.size(); ++id) {
+		bool valid = true;
+		for (OPFilter const & filter : opFilters) {
+			auto const metric_it(opList[id].metrics.find(filter.name));
+			if ((metric_it == opList[id].metrics.end()) ||
+					!filter.cFunction(metric_it->second, filter.value)) {
+				valid = false;
+				break;
+			}
+		}
+		if (valid)
+			return id;
+	}
+	return -1;
+}
+
+/**
+ * The reference sorting, with the metrics looked up by name
+ */
+static void refSort(OperatingPointsList & opList,
+		PrioritiesList const & priorities) {
+	std::stable_sort(opList.begin(), opList.end(),
+		[&](OperatingPoint const & op1, OperatingPoint const & op2) {
+		for (MetricPriority const & priority : priorities) {
+			double val1 = op1.metrics.find(priority.metricName)->second;
+			double val2 = op2.metrics.find(priority.metricName)->second;
+			if (val1 == val2)
+				continue;
+			return priority.comparisonFunction(val1, val2);
+		}
+		return false;
+	});
+}
+
+static TestResult_t checkPolicy(OperatingPointsList const & opList,
+		OPManager & opManager, PrioritiesList & priorities,
+		std::mt19937 & rng) {
+	std::uniform_real_distribution<double> rnd(0.0, 1.0);
+	OperatingPointsList refList(opList);
+	bbque::utils::Timer tmr;
+	double ref_ms = 0, opm_ms = 0;
+	OperatingPoint op;
+	uint16_t misses = 0;
+
+	tmr.start();
+	refSort(refList, priorities);
+	ref_ms = tmr.getElapsedTimeMs();
+	tmr.start();
+	opManager.setPolicy(priorities);
+	opm_ms = tmr.getElapsedTimeMs();
+	fprintf(stderr, FMT_INF("Sorting %d OPs: reference %9.3f[ms], "
+				"OPManager %9.3f[ms]\n"), OP_COUNT, ref_ms, opm_ms);
+
+	if (opManager.getOperatingPoints() != refList) {
+		fprintf(stderr, FMT_ERR("Sorted OPs mismatch\n"));
+		return TEST_FAILED;
+	}
+
+	ref_ms = opm_ms = 0;
+	for (int i = 0; i < OP_LOOKUPS; ++i) {
+		OPFilterList opFilters;
+		opFilters.push_back(OPFilter("Throughput",
+					ComparisonFunctors::GreaterOrEqual, 100 * rnd(rng)));
+		opFilters.push_back(OPFilter("Power",
+					ComparisonFunctors::LessOrEqual, 10 * rnd(rng)));
+		if (i % 2)
+			opFilters.push_back(OPFilter("Quality",
+					ComparisonFunctors::Greater, rnd(rng)));
+
+		tmr.start();
+		int ref_id = refNextOP(refList, opFilters);
+		ref_ms += tmr.getElapsedTimeMs();
+
+		tmr.start();
+		bool found = opManager.getNextOP(op, opFilters);
+		opm_ms += tmr.getElapsedTimeMs();
+
+		if (ref_id < 0)
+			++misses;
+		if ((found != (ref_id >= 0)) || (found && (op != refList[ref_id]))) {
+			fprintf(stderr, FMT_ERR("Lookup [%d]: selected OP mismatch\n"), i);
+			return TEST_FAILED;
+		}
+	}
+
+	fprintf(stderr, FMT_INF("%d lookups (%d misses): reference %9.3f[ms], "
+				"OPManager %9.3f[ms]\n"), OP_LOOKUPS, misses, ref_ms, opm_ms);
+	return TEST_PASSED;
+}
+
+TestResult_t test_opmanager(int argc, char *argv[]) {
+	std::uniform_real_distribution<double> rnd(0.0, 1.0);
+	std::mt19937 rng(1234);
+	OperatingPointsList opList;
+	(void)argc;
+	(void)argv;
+
+	fprintf(stderr, FMT_INF("Building a list of %d OPs...\n"), OP_COUNT);
+	opList.reserve(OP_COUNT);
+	for (int i = 0; i < OP_COUNT; ++i) {
+		OperatingPoint op;
+		op.parameters["threads"] = 1 + (i % 16);
+		op.parameters["tiles"]   = 1 + (i / 16);
+		op.metrics["Throughput"] = int(100 * rnd(rng));
+		op.metrics["Power"]      = 10 * rnd(rng);
+		op.metrics["Quality"]    = rnd(rng);
+		opList.push_back(op);
+	}
+	OPManager opManager(opList, PrioritiesList());
+
+	PrioritiesList perf;
+	perf.push_back(MetricPriority("Throughput", SortingOrder::HighestToLowest));
+	perf.push_back(MetricPriority("Power", SortingOrder::LowestToHighest));
+
+	PrioritiesList power;
+	power.push_back(MetricPriority("Power", SortingOrder::LowestToHighest));
+	power.push_back(MetricPriority("Quality", SortingOrder::HighestToLowest));
+
+	// The last run reuses the sorted indexes of the first policy
+	if (checkPolicy(opList, opManager, perf, rng) != TEST_PASSED)
+		return TEST_FAILED;
+	if (checkPolicy(opList, opManager, power, rng) != TEST_PASSED)
+		return TEST_FAILED;
+	if (checkPolicy(opList, opManager, perf, rng) != TEST_PASSED)
+		return TEST_FAILED;
+
+	return TEST_PASSED;
+}
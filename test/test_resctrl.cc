@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tests.h"
+
+#include <bbque/pp/resctrl.h>
+
+// These are a set of useful debugging log formatters
+#define FMT_DBG(fmt) BBQUE_FMT(COLOR_LGRAY,  "RESCTRL    [DBG]", fmt)
+#define FMT_INF(fmt) BBQUE_FMT(COLOR_GREEN,  "RESCTRL    [INF]", fmt)
+#define FMT_WRN(fmt) BBQUE_FMT(COLOR_YELLOW, "RESCTRL    [WRN]", fmt)
+#define FMT_ERR(fmt) BBQUE_FMT(COLOR_RED,    "RESCTRL    [ERR]", fmt)
+
+using bbque::pp::Resctrl;
+
+/*******************************************************************************
+ *  Fake resctrl filesystem
+ ******************************************************************************/
+
+/**
+ * A resctrl filesystem, written into a temporary directory
+ */
+class ResctrlTree : public TempTree {
+
+public:
+
+	ResctrlTree() : TempTree("/tmp/bbque_resctrl.XXXXXX") {
+	}
+
+	/**
+	 * Read a line of a file (the first one by default)
+	 */
+	std::string ReadLine(std::string const & path, int line_nr = 0) const {
+		std::ifstream ifs(Root() + "/" + path);
+		std::string line;
+		for (int i = 0; (i <= line_nr) && std::getline(ifs, line); ++i);
+		return line;
+	}
+
+	/**
+	 * Remove a group: on a resctrl filesystem the kernel drops the files of
+	 * the group on rmdir, here they are removed in advance
+	 */
+	bool RemoveGroup(Resctrl & resctrl, std::string const & name) {
+		unlink((Root() + "/" + name + "/schemata").c_str());
+		unlink((Root() + "/" + name + "/tasks").c_str());
+		return resctrl.RemoveGroup(name);
+	}
+};
+
+/**
+ * Two cache domains of 12 ways, groups of at least 2 ways, and 3 classes of
+ * service beside the default one
+ */
+static bool writeTree(ResctrlTree & tree) {
+	bool ok = true;
+	ok &= tree.Write("info/L3/cbm_mask", "fff");
+	ok &= tree.Write("info/L3/min_cbm_bits", "2");
+	ok &= tree.Write("info/L3/num_closids", "4");
+	ok &= tree.Write("info/MB/min_bandwidth", "10");
+	ok &= tree.Write("info/MB/bandwidth_gran", "10");
+	ok &= tree.Write("info/MB/num_closids", "8");
+	ok &= tree.Write("schemata", "L3:0=fff;1=fff\nMB:0=100;1=100");
+	return ok;
+}
+
+/*******************************************************************************
+ *  Test
+ ******************************************************************************/
+
+static bool checkMask(char const * what, uint64_t mask, uint64_t expected) {
+	if (mask == expected)
+		return true;
+	fprintf(stderr, FMT_ERR("%s: %lx (expected %lx)\n"), what,
+		(unsigned long) mask, (unsigned long) expected);
+	return false;
+}
+
+static bool checkLine(char const * what, std::string const & line,
+		std::string const & expected) {
+	if (line == expected)
+		return true;
+	fprintf(stderr, FMT_ERR("%s: '%s' (expected '%s')\n"), what,
+		line.c_str(), expected.c_str());
+	return false;
+}
+
+TestResult_t test_resctrl(int argc, char *argv[]) {
+	(void)argc;
+	(void)argv;
+
+	ResctrlTree tree;
+	if (tree.Root().empty() || !writeTree(tree)) {
+		fprintf(stderr, FMT_ERR("Cannot write the resctrl tree\n"));
+		return TEST_FAILED;
+	}
+
+	Resctrl resctrl(tree.Root());
+	if (!resctrl.Scan() || !resctrl.HasCacheAllocation() ||
+			!resctrl.HasMemBWAllocation() ||
+			(resctrl.GetCacheWays() != 12) || (resctrl.GetMaxGroups() != 3)) {
+		fprintf(stderr, FMT_ERR("Capabilities not detected\n"));
+		return TEST_FAILED;
+	}
+	fprintf(stderr, FMT_INF("Capabilities of the resctrl tree\n"));
+
+	// The highest ways to the groups, the lowest to the default one
+	Resctrl::Allocation_t alloc1;
+	alloc1.cache_ways[0] = 4;
+	Resctrl::Allocation_t alloc2;
+	alloc2.cache_ways[0] = 4;
+	alloc2.cache_ways[1] = 3;
+	alloc2.mem_bw_pct[0] = 25;
+	if (!resctrl.SetupGroup("app1", alloc1, getpid()) ||
+			!resctrl.SetupGroup("app2", alloc2, getpid())) {
+		fprintf(stderr, FMT_ERR("Groups not created\n"));
+		return TEST_FAILED;
+	}
+	bool ok = true;
+	ok &= checkMask("app1 domain 0", resctrl.GetCacheMask("app1", 0), 0xf00);
+	ok &= checkMask("app2 domain 0", resctrl.GetCacheMask("app2", 0), 0x0f0);
+	ok &= checkMask("app2 domain 1", resctrl.GetCacheMask("app2", 1), 0xe00);
+	ok &= checkLine("app1 shared domain", tree.ReadLine("app1/schemata"),
+		"L3:1=1ff");
+	ok &= checkLine("app2 schemata", tree.ReadLine("app2/schemata"),
+		"L3:0=f0;1=e00");
+	ok &= checkLine("app2 bandwidth", tree.ReadLine("app2/schemata", 1),
+		"MB:0=30;1=100");
+	ok &= checkLine("Default schemata", tree.ReadLine("schemata"),
+		"L3:0=f;1=1ff");
+	ok &= !tree.ReadLine("app1/tasks").empty();
+	if (!ok)
+		return TEST_FAILED;
+	fprintf(stderr, FMT_INF("Groups isolated from each other and the default one\n"));
+
+	// The ways of the default group are not given to a group
+	Resctrl::Allocation_t alloc3;
+	alloc3.cache_ways[0] = 4;
+	if (resctrl.SetupGroup("app3", alloc3, getpid()) ||
+			!checkLine("Default schemata", tree.ReadLine("schemata"),
+				"L3:0=f;1=1ff"))
+		return TEST_FAILED;
+	fprintf(stderr, FMT_INF("Ways of the default group reserved\n"));
+
+	// The ways released are given back to the default group
+	if (!tree.RemoveGroup(resctrl, "app2") ||
+			!checkLine("Default schemata", tree.ReadLine("schemata"),
+				"L3:0=ff;1=fff") ||
+			!checkLine("app1 shared domain", tree.ReadLine("app1/schemata"),
+				"L3:1=fff"))
+		return TEST_FAILED;
+	if (!tree.RemoveGroup(resctrl, "app1") ||
+			!checkLine("Default schemata", tree.ReadLine("schemata"),
+				"L3:0=fff;1=fff"))
+		return TEST_FAILED;
+	fprintf(stderr, FMT_INF("Ways released to the default group\n"));
+
+	return TEST_PASSED;
+}
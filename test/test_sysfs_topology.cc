@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2017  Politecnico di Milano
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tests.h"
+
+#include <set>
+
+#include <bbque/pp/sysfs_topology.h>
+
+// These are a set of useful debugging log formatters
+#define FMT_DBG(fmt) BBQUE_FMT(COLOR_LGRAY,  "SYSFS_TOPO [DBG]", fmt)
+#define FMT_INF(fmt) BBQUE_FMT(COLOR_GREEN,  "SYSFS_TOPO [INF]", fmt)
+#define FMT_WRN(fmt) BBQUE_FMT(COLOR_YELLOW, "SYSFS_TOPO [WRN]", fmt)
+#define FMT_ERR(fmt) BBQUE_FMT(COLOR_RED,    "SYSFS_TOPO [ERR]", fmt)
+
+using bbque::pp::PlatformDescription;
+using bbque::pp::SysfsTopology;
+
+typedef PlatformDescription PD;
+
+/*******************************************************************************
+ *  Captured sysfs tree
+ ******************************************************************************/
+
+#define SYSFS_TREE_PREFIX "/tmp/bbque_sysfs.XXXXXX"
+
+/**
+ * Two NUMA nodes of four CPUs each, the last one being offline:
+ * - SMT siblings: {0,1};
+ * - L2 caches: {0,1}, {2,3}, {4,5}, {6,7};
+ * - L3 caches (LLC): {0-3}, {4-7}.
+ */
+static bool captureTree(TempTree & tree) {
+	bool ok = tree.Write("cpu/online", "0-6");
+	for (int pe_id = 0; pe_id < 8; ++pe_id) {
+		std::string cpu_dir("cpu/cpu" + std::to_string(pe_id));
+		int pair = pe_id & ~1;
+		int package = pe_id / 4;
+		std::string siblings((pe_id < 2) ? "0-1" : std::to_string(pe_id));
+		std::string l2(std::to_string(pair) + "-" + std::to_string(pair + 1));
+		std::string l3((package == 0) ? "0-3" : "4-7");
+
+		ok &= tree.Write(cpu_dir + "/topology/core_id",
+			std::to_string((pe_id < 2) ? 0 : pe_id % 4));
+		ok &= tree.Write(cpu_dir + "/topology/physical_package_id",
+			std::to_string(package));
+		ok &= tree.Write(cpu_dir + "/topology/thread_siblings_list", siblings);
+		ok &= tree.Write(cpu_dir + "/cache/index0/level", "1");
+		ok &= tree.Write(cpu_dir + "/cache/index0/shared_cpu_list", siblings);
+		ok &= tree.Write(cpu_dir + "/cache/index1/level", "2");
+		ok &= tree.Write(cpu_dir + "/cache/index1/shared_cpu_list", l2);
+		ok &= tree.Write(cpu_dir + "/cache/index2/level", "3");
+		ok &= tree.Write(cpu_dir + "/cache/index2/shared_cpu_list", l3);
+	}
+
+	ok &= tree.Write("node/online", "0-1");
+	ok &= tree.Write("node/node0/cpulist", "0-3");
+	ok &= tree.Write("node/node0/distance", "10 21");
+	ok &= tree.Write("node/node0/meminfo",
+		"Node 0 MemTotal:        8388608 kB\nNode 0 MemFree:  1024 kB");
+	ok &= tree.Write("node/node1/cpulist", "4-7");
+	ok &= tree.Write("node/node1/distance", "21 10");
+	ok &= tree.Write("node/node1/meminfo",
+		"Node 1 MemTotal:        4194304 kB\nNode 1 MemFree:  1024 kB");
+	return ok;
+}
+
+/*******************************************************************************
+ *  Test
+ ******************************************************************************/
+
+static bool checkValue(char const * what, int value, int expected) {
+	if (value == expected)
+		return true;
+	fprintf(stderr, FMT_ERR("%s: %d (expected %d)\n"), what, value, expected);
+	return false;
+}
+
+static bool checkParseList() {
+	std::set<uint16_t> ids;
+	if (!SysfsTopology::ParseList("0-2,5,8-9\n", ids) ||
+			(ids != std::set<uint16_t>{0, 1, 2, 5, 8, 9})) {
+		fprintf(stderr, FMT_ERR("List not parsed\n"));
+		return false;
+	}
+	ids.clear();
+	if (SysfsTopology::ParseList("3-1", ids) ||
+			SysfsTopology::ParseList("x", ids)) {
+		fprintf(stderr, FMT_ERR("Malformed list accepted\n"));
+		return false;
+	}
+	return true;
+}
+
+static bool checkDistances(SysfsTopology const & topo) {
+	bool ok = true;
+	ok &= checkValue("PEs", topo.GetProcessingElements().size(), 7);
+	ok &= checkValue("Nodes", topo.GetNodes().size(), 2);
+	ok &= checkValue("Node of PE 5", topo.GetNode(5), 1);
+
+	ok &= checkValue("Distance 2-2", topo.GetPEDistance(2, 2), PD::PE_DIST_SAME);
+	ok &= checkValue("Distance 0-1", topo.GetPEDistance(0, 1), PD::PE_DIST_SMT);
+	ok &= checkValue("Distance 2-3", topo.GetPEDistance(2, 3), PD::PE_DIST_CACHE);
+	ok &= checkValue("Distance 1-3", topo.GetPEDistance(1, 3), PD::PE_DIST_LLC);
+	ok &= checkValue("Distance 0-4", topo.GetPEDistance(0, 4),
+		PD::PE_DIST_NODE + 21);
+	ok &= checkValue("Distance 6-7", topo.GetPEDistance(6, 7),
+		BBQUE_PP_DISTANCE_UNKNOWN);
+
+	ok &= checkValue("Node distance 0-0", topo.GetNodeDistance(0, 0), 0);
+	ok &= checkValue("Node distance 1-0", topo.GetNodeDistance(1, 0), 21);
+	return ok;
+}
+
+static bool checkSystem(SysfsTopology const & topo) {
+	// PE 1 described as an exclusive one in the platform XML
+	PD::System sys(0);
+	PD::CPU described_cpu(0);
+	PD::ProcessingElement described_pe(1, 0, 50, PD::MDEV);
+	described_cpu.AddProcessingElement(described_pe);
+	sys.AddCPU(described_cpu);
+	topo.BuildSystem(sys);
+
+	bool ok = true;
+	ok &= checkValue("CPUs", sys.GetCPUsAll().size(), 2);
+	ok &= checkValue("Memories", sys.GetMemoriesAll().size(), 2);
+	if (!ok)
+		return false;
+
+	PD::CPU const & cpu1(sys.GetCPUsAll()[1]);
+	ok &= checkValue("CPU 1 PEs", cpu1.GetProcessingElementsAll().size(), 3);
+	ok &= checkValue("CPU 1 socket", cpu1.GetSocketId(), 1);
+	ok &= checkValue("CPU 1 memory", cpu1.GetMemory()->GetId(), 1);
+	ok &= checkValue("Memory 1 size [MB]",
+		sys.GetMemoryById(1)->GetQuantity() >> 20, 4096);
+
+	PD::ProcessingElement const & pe1(
+		sys.GetCPUsAll()[0].GetProcessingElementsAll()[1]);
+	ok &= checkValue("PE 1 share", pe1.GetShare(), 50);
+	ok &= checkValue("PE 1 partition", pe1.GetPartitionType(), PD::MDEV);
+	ok &= checkValue("System distance 0-1",
+		sys.GetPEDistances().Get(0, 1), PD::PE_DIST_SMT);
+	return ok;
+}
+
+TestResult_t test_sysfs_topology(int argc, char *argv[]) {
+	(void)argc;
+	(void)argv;
+
+	if (!checkParseList())
+		return TEST_FAILED;
+	fprintf(stderr, FMT_INF("Lists parsed\n"));
+
+	TempTree tree(SYSFS_TREE_PREFIX);
+	if (tree.Root().empty() || !captureTree(tree)) {
+		fprintf(stderr, FMT_ERR("Cannot write the captured tree\n"));
+		return TEST_FAILED;
+	}
+
+	SysfsTopology topo(tree.Root());
+	if (!topo.Scan()) {
+		fprintf(stderr, FMT_ERR("No CPU found in %s\n"), tree.Root().c_str());
+		return TEST_FAILED;
+	}
+	if (!checkDistances(topo))
+		return TEST_FAILED;
+	fprintf(stderr, FMT_INF("Distances of the captured tree\n"));
+
+	if (!checkSystem(topo))
+		return TEST_FAILED;
+	fprintf(stderr, FMT_INF("System description of the captured tree\n"));
+
+	// Without NUMA support: a single node including all the CPUs
+	TempTree flat_tree(SYSFS_TREE_PREFIX);
+	if (flat_tree.Root().empty() || !flat_tree.Write("cpu/online", "0-3")) {
+		fprintf(stderr, FMT_ERR("Cannot write the captured tree\n"));
+		return TEST_FAILED;
+	}
+	SysfsTopology flat_topo(flat_tree.Root());
+	if (!flat_topo.Scan() ||
+			!checkValue("Nodes (no NUMA)", flat_topo.GetNodes().size(), 1) ||
+			!checkValue("Distance 0-3 (no NUMA)",
+				flat_topo.GetPEDistance(0, 3), PD::PE_DIST_NODE))
+		return TEST_FAILED;
+	fprintf(stderr, FMT_INF("Single node without NUMA support\n"));
+
+	return TEST_PASSED;
+}
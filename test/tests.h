@@ -19,15 +19,19 @@
 #define BBQUE_TESTS_H_
 
 #include <iostream>
+#include <fstream>
 #include <random>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <vector>
 
 #include <assert.h>
 #include <stdio.h>
 #include <cstdint>
 #include <string>
 #include <unistd.h>
+#include <sys/stat.h>
 #include <sys/syscall.h>
 
 #include <bbque/utils/timer.h>
@@ -112,4 +116,60 @@ inline pid_t gettid() {
 	        return syscall(SYS_gettid);
 }
 
+/**
+ * @brief A files tree, written into a temporary directory and removed on
+ * destruction (e.g., a captured sysfs or resctrl filesystem)
+ */
+class TempTree {
+
+public:
+
+	/**
+	 * @param dir_prefix The mkdtemp() template of the temporary directory
+	 * (e.g., "/tmp/bbque_test.XXXXXX")
+	 */
+	TempTree(char const * dir_prefix) {
+		std::vector<char> dir_template(
+			dir_prefix, dir_prefix + strlen(dir_prefix) + 1);
+		if (mkdtemp(dir_template.data()) != nullptr)
+			root = dir_template.data();
+	}
+
+	virtual ~TempTree() {
+		for (auto it = paths.rbegin(); it != paths.rend(); ++it)
+			remove(it->c_str());
+		if (!root.empty())
+			rmdir(root.c_str());
+	}
+
+	inline std::string const & Root() const {
+		return root;
+	}
+
+	/**
+	 * Write a file, creating the missing directories
+	 */
+	bool Write(std::string const & path, std::string const & content) {
+		size_t pos = 0;
+		while ((pos = path.find('/', pos + 1)) != std::string::npos) {
+			std::string dir(root + "/" + path.substr(0, pos));
+			if (mkdir(dir.c_str(), 0755) == 0)
+				paths.push_back(dir);
+		}
+		std::ofstream ofs(root + "/" + path);
+		if (!ofs.is_open())
+			return false;
+		paths.push_back(root + "/" + path);
+		ofs << content << "\n";
+		return true;
+	}
+
+private:
+
+	std::string root;
+
+	/** The files and directories created, in order */
+	std::vector<std::string> paths;
+};
+
 #endif // BBQUE_TESTS_H_